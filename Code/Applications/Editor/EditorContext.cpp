@@ -5,6 +5,7 @@
 #include "Tools/Entity/Workspaces/Workspace_EntityCollectionEditor.h"
 #include "Tools/Core/Workspaces/ResourceWorkspace.h"
 #include "Tools/Core/ThirdParty/pfd/portable-file-dialogs.h"
+#include "System/Core/Threading/TaskSystem.h"
 #include "Engine/Core/Entity/EntityWorld.h"
 #include "Engine/Core/Entity/EntityWorldManager.h"
 #include "System/Resource/ResourceSettings.h"
@@ -36,7 +37,7 @@ namespace KRG
         m_pWorldManager = context.GetSystem<EntityWorldManager>();
         m_pRenderingSystem = context.GetSystem<Render::RenderingSystem>();
 
-        m_resourceDB.Initialize( m_workspaceInitContext.m_pTypeRegistry, pResourceSettings->m_rawResourcePath, pResourceSettings->m_compiledResourcePath );
+        m_resourceDB.Initialize( m_workspaceInitContext.m_pTypeRegistry, pResourceSettings->m_rawResourcePath, pResourceSettings->m_compiledResourcePath, context.GetSystem<TaskSystem>() );
         m_workspaceInitContext.m_pResourceDatabase = &m_resourceDB;
 
         // Create map editor workspace
@@ -1,7 +1,6 @@
 #include "ClangParser.h"
 #include "ClangVisitors_TranslationUnit.h"
 #include "Applications/Reflector/ReflectorSettingsAndUtils.h"
-#include "Applications/Reflector/Database/ReflectionDatabase.h"
 #include "System/Core/Time/Timers.h"
 #include "System/Core/Platform/PlatformHelpers_Win32.h"
 #include <fstream>
@@ -14,37 +13,41 @@ namespace KRG
     {
         namespace Reflection
         {
-            ClangParser::ClangParser( SolutionInfo* pSolution, ReflectionDatabase* pDatabase, FileSystem::Path const& reflectionDataPath )
-                : m_context( pSolution, pDatabase )
+            ClangParser::ClangParser( SolutionInfo const* pSolution, FileSystem::Path const& amalgamatedHeaderPath )
+                : m_context( pSolution )
                 , m_totalParsingTime( 0 )
                 , m_totalVisitingTime( 0 )
-                , m_reflectionDataPath( reflectionDataPath )
+                , m_amalgamatedHeaderPath( amalgamatedHeaderPath )
             {}
 
-            bool ClangParser::Parse( TVector<HeaderInfo*> const& headers, Pass pass )
+            bool ClangParser::Parse( TVector<HeaderInfo const*> const& headers, TVector<HeaderReflectionData>& results, Pass pass )
             {
+                KRG_ASSERT( headers.size() == results.size() );
                 m_context.m_detectDevOnlyTypesAndProperties = ( pass == SecondPass );
 
                 // Create single amalgamated header file for all headers to parse
                 //-------------------------------------------------------------------------
 
                 std::ofstream reflectorFileStream;
-                FileSystem::Path const reflectorHeader = m_reflectionDataPath + "Reflector.h";
+                FileSystem::Path const& reflectorHeader = m_amalgamatedHeaderPath;
                 FileSystem::EnsurePathExists( reflectorHeader );
                 reflectorFileStream.open( reflectorHeader.c_str(), std::ios::out | std::ios::trunc );
                 KRG_ASSERT( !reflectorFileStream.fail() );
 
                 String includeStr;
                 m_context.m_headersToVisit.clear();
-                for ( HeaderInfo const* pHeader : headers )
+                for ( auto i = 0u; i < headers.size(); i++ )
                 {
+                    HeaderInfo const* pHeader = headers[i];
+                    KRG_ASSERT( results[i].m_headerID == pHeader->m_ID );
+
                     // Exclude dev tools
                     if ( pass == SecondPass && pHeader->IsInToolsLayer() )
                     {
                         continue;
                     }
 
-                    m_context.m_headersToVisit.push_back( pHeader->m_ID );
+                    m_context.m_headersToVisit[pHeader->m_ID] = &results[i];
                     includeStr += "#include \"" + pHeader->m_filePath.GetString() + "\"\n";
                 }
 
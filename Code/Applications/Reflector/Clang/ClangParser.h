@@ -11,6 +11,7 @@ namespace KRG
     {
         namespace Reflection
         {
+            // Each parser has its own clang index and amalgamated header, so multiple parsers can be run in parallel
             class ClangParser
             {
             public:
@@ -23,12 +24,13 @@ namespace KRG
 
             public:
 
-                ClangParser( SolutionInfo* pSolution, ReflectionDatabase* pDatabase, FileSystem::Path const& reflectionDataPath );
+                ClangParser( SolutionInfo const* pSolution, FileSystem::Path const& amalgamatedHeaderPath );
 
                 inline Milliseconds GetParsingTime() const { return m_totalParsingTime; }
                 inline Milliseconds GetVisitingTime() const { return m_totalVisitingTime; }
 
-                bool Parse( TVector<HeaderInfo*> const& headers, Pass pass );
+                // Parse the headers and write the reflected data for each header into the corresponding entry in the results array
+                bool Parse( TVector<HeaderInfo const*> const& headers, TVector<HeaderReflectionData>& results, Pass pass );
                 String GetErrorMessage() const { return m_context.GetErrorMessage(); }
 
             private:
@@ -36,7 +38,7 @@ namespace KRG
                 ClangParserContext                  m_context;
                 Milliseconds                        m_totalParsingTime;
                 Milliseconds                        m_totalVisitingTime;
-                FileSystem::Path                    m_reflectionDataPath;
+                FileSystem::Path                    m_amalgamatedHeaderPath;
             };
         }
     }
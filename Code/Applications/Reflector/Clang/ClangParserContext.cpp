@@ -70,11 +70,6 @@ namespace KRG::TypeSystem::Reflection
         m_errorMessage = buffer;
     }
 
-    bool ClangParserContext::ShouldVisitHeader( HeaderID headerID ) const
-    {
-        return eastl::find( m_headersToVisit.begin(), m_headersToVisit.end(), headerID ) != m_headersToVisit.end();
-    }
-
     void ClangParserContext::Reset( CXTranslationUnit* pTU )
     {
         KRG_ASSERT( m_namespaceStack.empty() );
@@ -116,14 +111,16 @@ namespace KRG::TypeSystem::Reflection
         return Reflection::Utils::IsValidModuleName( moduleClassName );
     }
 
-    bool ClangParserContext::SetModuleClassName( FileSystem::Path const& headerFilePath, String const& moduleClassName )
+    bool ClangParserContext::SetModuleClassName( FileSystem::Path const& headerFilePath, HeaderID headerID, String const& moduleClassName )
     {
-        for ( auto& prj : m_pSolution->m_projects )
+        // The project is only updated once all results are merged, but we validate that the originating project exists here
+        for ( auto const& prj : m_pSolution->m_projects )
         {
             if ( headerFilePath.IsUnderDirectory( prj.m_path ) )
             {
-                KRG_ASSERT( prj.m_moduleClassName.empty() );
-                prj.m_moduleClassName = moduleClassName;
+                HeaderReflectionData* pHeaderData = GetHeaderData( headerID );
+                KRG_ASSERT( pHeaderData->m_moduleClassName.empty() );
+                pHeaderData->m_moduleClassName = moduleClassName;
                 return true;
             }
         }
@@ -160,4 +157,52 @@ namespace KRG::TypeSystem::Reflection
 
         return false;
     }
+
+    //-------------------------------------------------------------------------
+
+    HeaderReflectionData* ClangParserContext::GetHeaderData( HeaderID headerID ) const
+    {
+        auto iter = m_headersToVisit.find( headerID );
+        KRG_ASSERT( iter != m_headersToVisit.end() );
+        return iter->second;
+    }
+
+    bool ClangParserContext::IsTypeRegistered( HeaderID headerID, TypeID typeID ) const
+    {
+        HeaderReflectionData* pHeaderData = GetHeaderData( headerID );
+        return pHeaderData->FindType( typeID ) != nullptr;
+    }
+
+    void ClangParserContext::RegisterType( ReflectedType const& type )
+    {
+        HeaderReflectionData* pHeaderData = GetHeaderData( type.m_headerID );
+
+        // On the second pass, we only clear the dev-only flags for all types and properties that exist in shipping builds
+        if ( m_detectDevOnlyTypesAndProperties )
+        {
+            ReflectedType* pRegisteredType = pHeaderData->FindType( type.m_ID );
+            KRG_ASSERT( pRegisteredType != nullptr );
+            pRegisteredType->m_isDevOnly = false;
+
+            for ( auto const& property : type.m_properties )
+            {
+                auto foundIter = VectorFind( pRegisteredType->m_properties, property );
+                if ( foundIter != pRegisteredType->m_properties.end() )
+                {
+                    foundIter->m_isDevOnly = false;
+                }
+            }
+        }
+        else
+        {
+            KRG_ASSERT( pHeaderData->FindType( type.m_ID ) == nullptr );
+            pHeaderData->m_types.push_back( type );
+        }
+    }
+
+    void ClangParserContext::RegisterResource( ReflectedResourceType const& resource )
+    {
+        HeaderReflectionData* pHeaderData = GetHeaderData( resource.m_headerID );
+        pHeaderData->m_resources.push_back( resource );
+    }
 }
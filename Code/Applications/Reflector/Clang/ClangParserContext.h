@@ -2,17 +2,13 @@
 
 #include "ClangUtils.h"
 #include "Applications/Reflector/ReflectorSettingsAndUtils.h"
-#include "Applications/Reflector/Database/ReflectionProjectTypes.h"
+#include "Applications/Reflector/Database/ReflectionDataTypes.h"
 #include "System/Core/Types/StringID.h"
 
 //-------------------------------------------------------------------------
 
 namespace KRG::TypeSystem::Reflection
 {
-    class ReflectionDatabase;
-
-    //-------------------------------------------------------------------------
-
     struct TypeRegistrationMacro
     {
 
@@ -88,28 +84,27 @@ namespace KRG::TypeSystem::Reflection
 
     public:
 
-        ClangParserContext( SolutionInfo* pSolution, ReflectionDatabase* pDatabase )
+        ClangParserContext( SolutionInfo const* pSolution )
             : m_pTU( nullptr )
-            , m_pDatabase( pDatabase )
             , m_pCurrentEntry( nullptr )
             , m_inEngineNamespace( false )
             , m_pSolution( pSolution )
         {
-            KRG_ASSERT( pSolution != nullptr && pDatabase != nullptr );
+            KRG_ASSERT( pSolution != nullptr );
         }
 
         void LogError( char const* pFormat, ... ) const;
         char const* GetErrorMessage() const { return m_errorMessage.c_str(); }
         inline bool ErrorOccured() const { return !m_errorMessage.empty(); }
 
-        bool ShouldVisitHeader( HeaderID headerID ) const;
+        bool ShouldVisitHeader( HeaderID headerID ) const { return m_headersToVisit.find( headerID ) != m_headersToVisit.end(); }
 
         void Reset( CXTranslationUnit* pTU );
         void PushNamespace( String const& name );
         void PopNamespace();
 
         bool IsValidModuleName( String const& moduleClassName );
-        bool SetModuleClassName( FileSystem::Path const& headerFilePath, String const& moduleClassName );
+        bool SetModuleClassName( FileSystem::Path const& headerFilePath, HeaderID headerID, String const& moduleClassName );
         inline StringID GenerateTypeID( String const& fullyQualifiedTypeName ) const { return StringID( fullyQualifiedTypeName ); }
 
         String const& GetCurrentNamespace() const { return m_currentNamespace; }
@@ -121,6 +116,12 @@ namespace KRG::TypeSystem::Reflection
         void AddFoundRegisteredPropertyMacro( RegisteredPropertyMacro const& foundMacro ) { m_registeredPropertyMacros.push_back( foundMacro ); }
         bool ShouldRegisterType( CXCursor const& cr, TypeRegistrationMacro* pMacro = nullptr );
 
+        // Results - these are only written to the visited header's data since multiple contexts run in parallel
+        // Any lookups of types from other headers are deferred until the results are merged into the database
+        bool IsTypeRegistered( HeaderID headerID, TypeID typeID ) const;
+        void RegisterType( ReflectedType const& type );
+        void RegisterResource( ReflectedResourceType const& resource );
+
     public:
 
         CXTranslationUnit*                  m_pTU;
@@ -129,15 +130,18 @@ namespace KRG::TypeSystem::Reflection
         bool                                m_detectDevOnlyTypesAndProperties = false;
 
         // Per solution
-        SolutionInfo*                       m_pSolution;
-        ReflectionDatabase*                 m_pDatabase;
-        TVector<HeaderID>                   m_headersToVisit;
+        SolutionInfo const*                 m_pSolution;
+        THashMap<HeaderID, HeaderReflectionData*>   m_headersToVisit;
 
         // Per Translation unit
         void*                               m_pCurrentEntry;
         TVector<RegisteredPropertyMacro>    m_registeredPropertyMacros;
         TVector<TypeRegistrationMacro>      m_typeRegistrationMacros;
 
+    private:
+
+        HeaderReflectionData* GetHeaderData( HeaderID headerID ) const;
+
     private:
 
         mutable String                      m_errorMessage;
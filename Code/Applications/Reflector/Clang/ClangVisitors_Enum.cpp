@@ -1,5 +1,4 @@
 #include "ClangVisitors_Enum.h"
-#include "Applications/Reflector/Database/ReflectionDatabase.h"
 
 //-------------------------------------------------------------------------
 
@@ -108,7 +107,7 @@ namespace KRG
 
                 if ( pContext->ShouldRegisterType( cr ) )
                 {
-                    if ( pContext->m_detectDevOnlyTypesAndProperties || !pContext->m_pDatabase->IsTypeRegistered( enumTypeID ) )
+                    if ( pContext->m_detectDevOnlyTypesAndProperties || !pContext->IsTypeRegistered( headerID, enumTypeID ) )
                     {
                         ReflectedType enumDescriptor( enumTypeID, cursorName );
                         enumDescriptor.m_headerID = headerID;
@@ -119,7 +118,7 @@ namespace KRG
 
                         clang_visitChildren( cr, VisitEnumContents, pContext );
 
-                        pContext->m_pDatabase->RegisterType( &enumDescriptor, pContext->m_detectDevOnlyTypesAndProperties );
+                        pContext->RegisterType( enumDescriptor );
                     }
                 }
 
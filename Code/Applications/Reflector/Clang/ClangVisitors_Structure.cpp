@@ -1,7 +1,6 @@
 #include "ClangVisitors_Structure.h"
 #include "ClangVisitors_Enum.h"
 #include "Applications/Reflector/ReflectorSettingsAndUtils.h"
-#include "Applications/Reflector/Database/ReflectionDatabase.h"
 #include "System/TypeSystem/TypeRegistry.h"
 #include "ClangVisitors_Macro.h"
 
@@ -79,22 +78,6 @@ namespace KRG::TypeSystem::Reflection
         }
     }
 
-    static void GetAllDerivedProperties( ReflectionDatabase const* pDatabase, TVector<TypeSystem::TypeID> const& parentTypes, TVector<ReflectedProperty>& results )
-    {
-        for ( auto const& parentID : parentTypes )
-        {
-            ReflectedType const* pParentDesc = pDatabase->GetType( parentID );
-            if ( pParentDesc != nullptr )
-            {
-                GetAllDerivedProperties( pDatabase, pParentDesc->m_parents, results );
-                for ( auto& parentProperty : pParentDesc->m_properties )
-                {
-                    results.push_back( parentProperty );
-                }
-            }
-        }
-    }
-
     //-------------------------------------------------------------------------
 
     CXChildVisitResult VisitStructureContents( CXCursor cr, CXCursor parent, CXClientData pClientData )
@@ -118,23 +101,8 @@ namespace KRG::TypeSystem::Reflection
                     return CXChildVisit_Break;
                 }
 
+                // The inherited properties are added when the type is resolved, since the parent might be in a header visited by another context
                 auto const parentID = TypeSystem::TypeID( fullyQualifiedName );
-                TVector<TypeSystem::TypeID> parentIDs = { parentID };
-                GetAllDerivedProperties( pContext->m_pDatabase, parentIDs, pClass->m_properties );
-
-                // Remove duplicate properties added via the parent property traversal - do not change the order of the array
-                for ( int32 i = 0; i < (int32) pClass->m_properties.size(); i++ )
-                {
-                    for ( int32 j = i + 1; j < (int32) pClass->m_properties.size(); j++ )
-                    {
-                        if ( pClass->m_properties[i].m_propertyID == pClass->m_properties[j].m_propertyID )
-                        {
-                            pClass->m_properties.erase( pClass->m_properties.begin() + j );
-                            j--;
-                        }
-                    }
-                }
-
                 pClass->m_parents.push_back( parentID );
                 break;
             }
@@ -231,6 +199,7 @@ namespace KRG::TypeSystem::Reflection
 
                     // Check for unsupported types
                     //-------------------------------------------------------------------------
+                    // Non-core types are validated and flagged when the type is resolved, since they may be declared in a header visited by another context
 
                     // Core Types
                     if ( IsCoreType( propertyDesc.m_typeID ) )
@@ -255,15 +224,8 @@ namespace KRG::TypeSystem::Reflection
                         }
                         else if ( propertyDesc.m_typeID == CoreTypeID::TBitFlags )
                         {
+                            // The enum type for the bit-flags is validated when the type is resolved
                             propertyDesc.m_flags.SetFlag( PropertyInfo::Flags::IsBitFlags );
-
-                            // Perform validation on the enum type for the bit-flags
-                            ReflectedType const* pFlagTypeDesc = pContext->m_pDatabase->GetType( propertyDesc.m_templateArgTypeName );
-                            if ( pFlagTypeDesc == nullptr || !pFlagTypeDesc->IsEnum() )
-                            {
-                                pContext->LogError( "Unsupported type encountered: %s for bitflags property: %s in class: %s", propertyDesc.m_typeName.c_str(), propertyDesc.m_name.c_str(), pClass->m_name.c_str() );
-                                return CXChildVisit_Break;
-                            }
                         }
 
                         // Arrays
@@ -273,33 +235,6 @@ namespace KRG::TypeSystem::Reflection
                             return CXChildVisit_Break;
                         }
                     }
-                    else // Non-Core Types
-                    {
-                        // Non-core types must have a valid type descriptor
-                        ReflectedType const* pPropertyTypeDesc = pContext->m_pDatabase->GetType( propertyDesc.m_typeID );
-                        if ( pPropertyTypeDesc == nullptr )
-                        {
-                            pContext->LogError( "Unsupported type encountered: %s for property: %s in class: %s", propertyDesc.m_typeName.c_str(), propertyDesc.m_name.c_str(), pClass->m_name.c_str() );
-                            return CXChildVisit_Break;
-                        }
-
-                        // Check for enum types - bitflags are a special case and are not an enum
-                        if ( pPropertyTypeDesc->IsEnum() )
-                        {
-                            propertyDesc.m_flags.SetFlag( PropertyInfo::Flags::IsEnum );
-                        }
-                        else
-                        {
-                            propertyDesc.m_flags.SetFlag( PropertyInfo::Flags::IsStructure );
-                        }
-
-                        // Check if this field is a entity type
-                        if ( pPropertyTypeDesc->IsEntity() || pPropertyTypeDesc->IsEntityComponent() || pPropertyTypeDesc->IsEntitySystem() )
-                        {
-                            pContext->LogError( "Entities may not contain other entities, please use a EntityPtr instead ( property: %s in class: %s )", propertyDesc.m_name.c_str(), pClass->m_name.c_str() );
-                            return CXChildVisit_Break;
-                        }
-                    }
 
                     //-------------------------------------------------------------------------
 
@@ -361,7 +296,7 @@ namespace KRG::TypeSystem::Reflection
                     return CXChildVisit_Break;
                 }
 
-                if ( !pContext->SetModuleClassName( headerFilePath, moduleName ) )
+                if ( !pContext->SetModuleClassName( headerFilePath, headerID, moduleName ) )
                 {
                     // Could not find originating project for detected registered module class
                     pContext->LogError( "Cant find the source project for this module class: %s", headerFilePath.c_str() );
@@ -388,15 +323,8 @@ namespace KRG::TypeSystem::Reflection
                 resource.m_namespace = pContext->GetCurrentNamespace();
                 resource.m_isVirtual = macro.m_type == ReflectionMacro::RegisterVirtualResource;
 
-                if ( !pContext->m_pDatabase->IsResourceRegistered( resource.m_resourceTypeID ) )
-                {
-                    pContext->m_pDatabase->RegisterResource( &resource );
-                }
-                else // We do not allow multiple resources registered with the same ID
-                {
-                    pContext->LogError( "Duplicate resource type ID encountered: %s in file: %s", resource.m_resourceTypeID.ToString().c_str(), headerFilePath.c_str() );
-                    return CXChildVisit_Break;
-                }
+                // Duplicate resource type IDs are detected when the results are merged into the database
+                pContext->RegisterResource( resource );
             }
 
             //-------------------------------------------------------------------------
@@ -418,7 +346,7 @@ namespace KRG::TypeSystem::Reflection
                 pContext->m_pCurrentEntry = &classDescriptor;
                 clang_visitChildren( cr, VisitStructureContents, pContext );
 
-                pContext->m_pDatabase->RegisterType( &classDescriptor, pContext->m_detectDevOnlyTypesAndProperties );
+                pContext->RegisterType( classDescriptor );
             }
         }
 
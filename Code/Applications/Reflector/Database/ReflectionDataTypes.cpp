@@ -156,4 +156,19 @@ namespace KRG::TypeSystem::Reflection
 
         return true;
     }
+
+    //-------------------------------------------------------------------------
+
+    ReflectedType* HeaderReflectionData::FindType( TypeID typeID )
+    {
+        for ( auto& type : m_types )
+        {
+            if ( type.m_ID == typeID )
+            {
+                return &type;
+            }
+        }
+
+        return nullptr;
+    }
 }
\ No newline at end of file
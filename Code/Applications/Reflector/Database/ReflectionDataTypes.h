@@ -4,6 +4,8 @@
 #include "System/TypeSystem/TypeInfo.h"
 #include "System/TypeSystem/CoreTypeIDs.h"
 #include "System/Resource/ResourceTypeID.h"
+#include "System/Core/Algorithm/Hash.h"
+#include "System/Core/Serialization/Serialization.h"
 
 //-------------------------------------------------------------------------
 
@@ -11,6 +13,7 @@ namespace KRG::TypeSystem::Reflection
 {
     struct ReflectedProperty
     {
+        KRG_SERIALIZE_MEMBERS( m_propertyID, m_lineNumber, m_typeID, m_name, m_typeName, m_templateArgTypeName, m_arraySize, m_flags, m_isDevOnly );
 
     public:
 
@@ -61,12 +64,16 @@ namespace KRG::TypeSystem::Reflection
 
     struct ReflectedEnumConstant
     {
+        KRG_SERIALIZE_MEMBERS( m_label, m_value );
+
         String                                          m_label;
         int32                                           m_value;
     };
 
     struct ReflectedType
     {
+        KRG_SERIALIZE_MEMBERS( m_ID, m_headerID, m_name, m_namespace, m_flags, m_parents, m_properties, m_underlyingType, m_enumConstants, m_isDevOnly );
+
         enum class Flags
         {
             IsAbstract = 0,
@@ -127,6 +134,8 @@ namespace KRG::TypeSystem::Reflection
 
     struct ReflectedResourceType
     {
+        KRG_SERIALIZE_MEMBERS( m_typeID, m_resourceTypeID, m_friendlyName, m_headerID, m_className, m_namespace, m_isVirtual );
+
         // Fill the resource type ID and the friendly name from the macro registration string
         bool TryParseRegistrationMacroString( String const& registrationStr );
 
@@ -140,4 +149,31 @@ namespace KRG::TypeSystem::Reflection
         String                                          m_namespace;
         bool                                            m_isVirtual = false;
     };
+
+    //-------------------------------------------------------------------------
+
+    // All the reflected data found in a single header, this is produced by the clang visitors and stored in the header cache
+    // The types are unresolved i.e. they only contain the properties declared in the header and the property type flags are not yet set
+    // Inherited properties and property types are resolved once the data for all headers has been registered with the database
+    struct HeaderReflectionData
+    {
+        KRG_SERIALIZE_MEMBERS( m_headerID, m_contentHash.m_low, m_contentHash.m_high, m_types, m_resources, m_moduleClassName );
+
+        HeaderReflectionData() = default;
+
+        HeaderReflectionData( HeaderID headerID, Hash::Hash128 const& contentHash )
+            : m_headerID( headerID )
+            , m_contentHash( contentHash )
+        {}
+
+        ReflectedType* FindType( TypeID typeID );
+
+    public:
+
+        HeaderID                                        m_headerID;
+        Hash::Hash128                                   m_contentHash;
+        TVector<ReflectedType>                          m_types;
+        TVector<ReflectedResourceType>                  m_resources;
+        String                                          m_moduleClassName;
+    };
 }
\ No newline at end of file
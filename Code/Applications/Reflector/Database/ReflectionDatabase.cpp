@@ -307,28 +307,147 @@ namespace KRG::TypeSystem::Reflection
         }
     }
 
-    void ReflectionDatabase::RegisterType( ReflectedType const* pType, bool onlyUpdateDevFlag )
+    void ReflectionDatabase::RegisterType( ReflectedType const* pType )
     {
-        if ( onlyUpdateDevFlag )
+        KRG_ASSERT( pType != nullptr && !IsTypeRegistered( pType->m_ID ) );
+        m_reflectedTypes.push_back( *pType );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ReflectionDatabase::GetAllDerivedProperties( TVector<TypeID> const& parentTypes, TVector<ReflectedProperty>& results ) const
+    {
+        for ( auto const& parentID : parentTypes )
         {
-            auto pRegisteredType = GetType( pType->m_ID );
-            KRG_ASSERT( pRegisteredType != nullptr );
-            pRegisteredType->m_isDevOnly = false;
+            ReflectedType const* pParentDesc = GetType( parentID );
+            if ( pParentDesc != nullptr )
+            {
+                GetAllDerivedProperties( pParentDesc->m_parents, results );
+                for ( auto& parentProperty : pParentDesc->m_properties )
+                {
+                    results.push_back( parentProperty );
+                }
+            }
+        }
+    }
 
-            for ( auto const& property : pType->m_properties )
+    bool ReflectionDatabase::ResolvePropertyType( ReflectedType const& type, ReflectedProperty& propertyDesc ) const
+    {
+        // Core Types
+        if ( IsCoreType( propertyDesc.m_typeID ) )
+        {
+            // Perform validation on the enum type for the bit-flags
+            if ( propertyDesc.m_typeID == CoreTypeID::TBitFlags )
             {
-                auto foundIter = VectorFind( pRegisteredType->m_properties, property );
-                if ( foundIter != pRegisteredType->m_properties.end() )
+                ReflectedType const* pFlagTypeDesc = GetType( propertyDesc.m_templateArgTypeName );
+                if ( pFlagTypeDesc == nullptr || !pFlagTypeDesc->IsEnum() )
                 {
-                    foundIter->m_isDevOnly = false;
+                    m_errorMessage.sprintf( "Unsupported type encountered: %s for bitflags property: %s in class: %s", propertyDesc.m_typeName.c_str(), propertyDesc.m_name.c_str(), type.m_name.c_str() );
+                    return false;
                 }
             }
         }
-        else
+        else // Non-Core Types
+        {
+            // Non-core types must have a valid type descriptor
+            ReflectedType const* pPropertyTypeDesc = GetType( propertyDesc.m_typeID );
+            if ( pPropertyTypeDesc == nullptr )
+            {
+                m_errorMessage.sprintf( "Unsupported type encountered: %s for property: %s in class: %s", propertyDesc.m_typeName.c_str(), propertyDesc.m_name.c_str(), type.m_name.c_str() );
+                return false;
+            }
+
+            // Check for enum types - bitflags are a special case and are not an enum
+            if ( pPropertyTypeDesc->IsEnum() )
+            {
+                propertyDesc.m_flags.SetFlag( PropertyInfo::Flags::IsEnum );
+            }
+            else
+            {
+                propertyDesc.m_flags.SetFlag( PropertyInfo::Flags::IsStructure );
+            }
+
+            // Check if this field is a entity type
+            if ( pPropertyTypeDesc->IsEntity() || pPropertyTypeDesc->IsEntityComponent() || pPropertyTypeDesc->IsEntitySystem() )
+            {
+                m_errorMessage.sprintf( "Entities may not contain other entities, please use a EntityPtr instead ( property: %s in class: %s )", propertyDesc.m_name.c_str(), type.m_name.c_str() );
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool ReflectionDatabase::ResolveType( TypeID typeID, TVector<TypeID>& unresolvedTypes )
+    {
+        auto unresolvedIter = VectorFind( unresolvedTypes, typeID );
+        if ( unresolvedIter == unresolvedTypes.end() )
+        {
+            return true;
+        }
+
+        unresolvedTypes.erase_unsorted( unresolvedIter );
+
+        ReflectedType* pType = GetType( typeID );
+        KRG_ASSERT( pType != nullptr );
+
+        if ( pType->IsEnum() )
         {
-            KRG_ASSERT( pType != nullptr && !IsTypeRegistered( pType->m_ID ) );
-            m_reflectedTypes.push_back( *pType );
+            return true;
         }
+
+        // Parents need to be resolved first since we copy their properties
+        for ( auto const& parentID : pType->m_parents )
+        {
+            if ( !ResolveType( parentID, unresolvedTypes ) )
+            {
+                return false;
+            }
+        }
+
+        // Validate and set the type flags for the properties declared in this type
+        for ( auto& propertyDesc : pType->m_properties )
+        {
+            if ( !ResolvePropertyType( *pType, propertyDesc ) )
+            {
+                return false;
+            }
+        }
+
+        // Add the inherited properties before the declared properties
+        TVector<ReflectedProperty> properties;
+        GetAllDerivedProperties( pType->m_parents, properties );
+
+        // Remove duplicate properties added via the parent property traversal - do not change the order of the array
+        for ( int32 i = 0; i < (int32) properties.size(); i++ )
+        {
+            for ( int32 j = i + 1; j < (int32) properties.size(); j++ )
+            {
+                if ( properties[i].m_propertyID == properties[j].m_propertyID )
+                {
+                    properties.erase( properties.begin() + j );
+                    j--;
+                }
+            }
+        }
+
+        properties.insert( properties.end(), pType->m_properties.begin(), pType->m_properties.end() );
+        pType->m_properties.swap( properties );
+        return true;
+    }
+
+    bool ReflectionDatabase::ResolveTypes( TVector<TypeID> const& typeIDs )
+    {
+        TVector<TypeID> unresolvedTypes = typeIDs;
+        while ( !unresolvedTypes.empty() )
+        {
+            if ( !ResolveType( unresolvedTypes.back(), unresolvedTypes ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
     }
 
     KRG::TypeSystem::Reflection::ReflectedProperty const* ReflectionDatabase::GetPropertyTypeDescriptor( TypeID typeID, PropertyPath const& pathID ) const
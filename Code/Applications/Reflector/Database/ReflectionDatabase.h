@@ -51,7 +51,11 @@ namespace KRG::TypeSystem::Reflection
         bool IsTypeDerivedFrom( TypeID typeID, TypeID parentTypeID ) const;
         void GetAllTypesForHeader( HeaderID headerID, TVector<ReflectedType>& types ) const;
         void GetAllTypesForProject( ProjectID projectID, TVector<ReflectedType>& types ) const;
-        void RegisterType( ReflectedType const* pType, bool onlyUpdateDevFlag );
+        void RegisterType( ReflectedType const* pType );
+
+        // Resolve the inherited properties and property types for newly registered types, all referenced types need to be registered at this point
+        // Returns false and sets the error message if any property has an unsupported type
+        bool ResolveTypes( TVector<TypeID> const& typeIDs );
 
         // Property functions
         //-------------------------------------------------------------------------
@@ -86,6 +90,13 @@ namespace KRG::TypeSystem::Reflection
         bool WriteAdditionalTypeData( ReflectedType const& type );
         bool WriteAdditionalEnumData( ReflectedType const& type );
 
+        // Type resolution
+        //-------------------------------------------------------------------------
+
+        void GetAllDerivedProperties( TVector<TypeID> const& parentTypes, TVector<ReflectedProperty>& results ) const;
+        bool ResolvePropertyType( ReflectedType const& type, ReflectedProperty& propertyDesc ) const;
+        bool ResolveType( TypeID typeID, TVector<TypeID>& unresolvedTypes );
+
         // SQLite
         //-------------------------------------------------------------------------
 
@@ -0,0 +1,85 @@
+#include "ReflectionHeaderCache.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/Serialization/BinaryArchive.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::TypeSystem::Reflection
+{
+    bool HeaderCache::Load( FileSystem::Path const& cacheFilePath )
+    {
+        KRG_ASSERT( cacheFilePath.IsFile() );
+
+        m_headers.clear();
+
+        if ( !FileSystem::Exists( cacheFilePath ) )
+        {
+            return false;
+        }
+
+        Serialization::BinaryFileArchive archive( Serialization::Mode::Read, cacheFilePath );
+        if ( !archive.IsValid() )
+        {
+            return false;
+        }
+
+        uint32 version = 0;
+        archive >> version;
+        if ( version != s_version )
+        {
+            return false;
+        }
+
+        archive >> m_headers;
+        return true;
+    }
+
+    bool HeaderCache::Save( FileSystem::Path const& cacheFilePath ) const
+    {
+        KRG_ASSERT( cacheFilePath.IsFile() );
+
+        FileSystem::EnsurePathExists( cacheFilePath );
+        Serialization::BinaryFileArchive archive( Serialization::Mode::Write, cacheFilePath );
+        if ( !archive.IsValid() )
+        {
+            return false;
+        }
+
+        archive << s_version << m_headers;
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+
+    HeaderReflectionData const* HeaderCache::FindHeaderData( HeaderID headerID, Hash::Hash128 const& contentHash ) const
+    {
+        auto iter = m_headers.find( headerID );
+        if ( iter == m_headers.end() || iter->second.m_contentHash != contentHash )
+        {
+            return nullptr;
+        }
+
+        return &iter->second;
+    }
+
+    void HeaderCache::UpdateHeaderData( HeaderReflectionData const& headerData )
+    {
+        KRG_ASSERT( headerData.m_headerID.IsValid() && headerData.m_contentHash.IsValid() );
+        m_headers[headerData.m_headerID] = headerData;
+    }
+
+    void HeaderCache::RemoveObseleteHeaders( TVector<HeaderID> const& registeredHeaders )
+    {
+        for ( auto iter = m_headers.begin(); iter != m_headers.end(); )
+        {
+            if ( VectorContains( registeredHeaders, iter->first ) )
+            {
+                ++iter;
+            }
+            else
+            {
+                iter = m_headers.erase( iter );
+            }
+        }
+    }
+}
\ No newline at end of file
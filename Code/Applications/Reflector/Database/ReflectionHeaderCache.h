@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ReflectionDataTypes.h"
+#include "System/Core/Types/Containers.h"
+
+//-------------------------------------------------------------------------
+// Header Cache
+//-------------------------------------------------------------------------
+// Stores the unresolved reflected data for each header, keyed on the content hash of the header file
+// This allows us to skip clang entirely for headers whose contents havent changed (e.g. after switching branches or touching files)
+//
+// The reflected data can depend on other headers (e.g. type aliases used for properties), so the cache is deleted when cleaning the solution
+
+namespace KRG::TypeSystem::Reflection
+{
+    class HeaderCache
+    {
+        // This needs to be incremented whenever the visitors or the reflected data types change
+        constexpr static uint32 const s_version = 1;
+
+    public:
+
+        bool Load( FileSystem::Path const& cacheFilePath );
+        bool Save( FileSystem::Path const& cacheFilePath ) const;
+
+        // Returns the cached data for a header if the header contents havent changed
+        HeaderReflectionData const* FindHeaderData( HeaderID headerID, Hash::Hash128 const& contentHash ) const;
+        void UpdateHeaderData( HeaderReflectionData const& headerData );
+        void RemoveObseleteHeaders( TVector<HeaderID> const& registeredHeaders );
+
+    private:
+
+        THashMap<HeaderID, HeaderReflectionData>    m_headers;
+    };
+}
\ No newline at end of file
@@ -7,11 +7,13 @@
 #include "System/Core/Logging/Log.h"
 #include "System/Core/FileSystem/FileSystem.h"
 #include "System/Core/Time/Timers.h"
+#include "System/Core/Math/Math.h"
 #include "System/Core/Algorithm/TopologicalSort.h"
 
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <thread>
 
 //-------------------------------------------------------------------------
 
@@ -82,6 +84,37 @@ namespace KRG::TypeSystem::Reflection
             projects.swap( sortedProjects );
             return true;
         }
+
+        //-------------------------------------------------------------------------
+
+        struct ParsingThreadContext
+        {
+            TVector<HeaderInfo const*>          m_headers;
+            TVector<HeaderReflectionData>       m_results;
+            String                              m_errorMessage;
+            Milliseconds                        m_parsingTime[2] = { 0, 0 };
+            Milliseconds                        m_visitingTime[2] = { 0, 0 };
+        };
+
+        // Each thread uses its own clang index and amalgamated header, and only writes to the reflected data for its own headers
+        void ParseHeadersOnThread( SolutionInfo const* pSolution, FileSystem::Path const& amalgamatedHeaderPath, ParsingThreadContext& context )
+        {
+            ClangParser clangParser( pSolution, amalgamatedHeaderPath );
+
+            ClangParser::Pass const passes[2] = { ClangParser::FirstPass, ClangParser::SecondPass };
+            for ( auto i = 0; i < 2; i++ )
+            {
+                // The second pass detects dev-only types
+                if ( !clangParser.Parse( context.m_headers, context.m_results, passes[i] ) )
+                {
+                    context.m_errorMessage = clangParser.GetErrorMessage();
+                    return;
+                }
+
+                context.m_parsingTime[i] = clangParser.GetParsingTime();
+                context.m_visitingTime[i] = clangParser.GetVisitingTime();
+            }
+        }
     }
 
     bool Reflector::ParseSolution( FileSystem::Path const& slnPath )
@@ -524,15 +557,19 @@ namespace KRG::TypeSystem::Reflection
 
         std::cout << std::endl;
 
-        FileSystem::Path const databasePath( m_reflectionDataPath + "TypeDatabase.db" );
-        bool const result = !FileSystem::Exists( databasePath ) || FileSystem::EraseFile( databasePath );
-        if ( result )
+        bool result = true;
+        FileSystem::Path const filesToDelete[] = { m_reflectionDataPath + "TypeDatabase.db", m_reflectionDataPath + "HeaderCache.bin" };
+        for ( auto const& filePath : filesToDelete )
         {
-            std::cout << " * Deleted: " << databasePath.c_str() << std::endl;
-        }
-        else
-        {
-            std::cout << " * Error deleting: " << databasePath.c_str() << std::endl;
+            if ( !FileSystem::Exists( filePath ) || FileSystem::EraseFile( filePath ) )
+            {
+                std::cout << " * Deleted: " << filePath.c_str() << std::endl;
+            }
+            else
+            {
+                std::cout << " * Error deleting: " << filePath.c_str() << std::endl;
+                result = false;
+            }
         }
 
         std::cout << std::endl;
@@ -666,7 +703,7 @@ namespace KRG::TypeSystem::Reflection
     bool Reflector::ReflectRegisteredHeaders()
     {
         // Create list of all headers to parse
-        TVector<HeaderInfo*> headersToParse;
+        TVector<HeaderInfo const*> headersToParse;
         for ( auto& prj : m_solution.m_projects )
         {
             if ( !prj.m_dirtyHeaders.empty() )
@@ -705,33 +742,95 @@ namespace KRG::TypeSystem::Reflection
 
         if ( !headersToParse.empty() )
         {
-            std::cout << " * Reflecting C++ Code - First Pass - ";
+            FileSystem::Path const headerCachePath( m_reflectionDataPath + "HeaderCache.bin" );
+            m_headerCache.Load( headerCachePath );
+
+            // Use the cached data for all headers whose contents havent changed
+            //-------------------------------------------------------------------------
+
+            TVector<HeaderReflectionData> headerData;
+            headerData.reserve( headersToParse.size() );
+
+            TVector<HeaderInfo const*> uncachedHeaders;
+            TVector<HeaderReflectionData> uncachedHeaderData;
+            TVector<uint32> uncachedHeaderIndices;
 
-            // Parse headers
-            ClangParser clangParser( &m_solution, &m_database, m_reflectionDataPath );
-            if ( !clangParser.Parse( headersToParse, ClangParser::FirstPass ) )
+            for ( auto i = 0u; i < headersToParse.size(); i++ )
             {
-                std::cout << "Error occurred!\n\n  Error: " << clangParser.GetErrorMessage().c_str() << std::endl;
-                return false;
+                HeaderInfo const* pHeader = headersToParse[i];
+
+                Hash::Hash128 contentHash;
+                if ( !FileSystem::GetFileContentHash( pHeader->m_filePath, contentHash ) )
+                {
+                    return LogError( "Failed to read header: %s", pHeader->m_filePath.c_str() );
+                }
+
+                HeaderReflectionData const* pCachedData = m_headerCache.FindHeaderData( pHeader->m_ID, contentHash );
+                if ( pCachedData != nullptr )
+                {
+                    headerData.emplace_back( *pCachedData );
+                }
+                else
+                {
+                    headerData.emplace_back( pHeader->m_ID, contentHash );
+                    uncachedHeaders.push_back( pHeader );
+                    uncachedHeaderData.emplace_back( pHeader->m_ID, contentHash );
+                    uncachedHeaderIndices.push_back( i );
+                }
             }
-            Milliseconds clangParsingTime = clangParser.GetParsingTime();
-            Milliseconds clangVisitingTime = clangParser.GetVisitingTime();
-            std::cout << "Complete! ( P:" << (float) clangParsingTime << "ms, V:" << (float) clangVisitingTime << "ms )" << std::endl;
 
-            std::cout << " * Reflecting C++ Code - Second Pass - ";
+            std::cout << " * Reflecting C++ Code - " << headersToParse.size() - uncachedHeaders.size() << " of " << headersToParse.size() << " headers retrieved from the header cache" << std::endl;
+
+            // Parse all remaining headers
+            //-------------------------------------------------------------------------
 
-            // Second parse to detect dev-only types
-            if ( !clangParser.Parse( headersToParse, ClangParser::SecondPass ) )
+            if ( !uncachedHeaders.empty() )
+            {
+                if ( !ParseHeaders( uncachedHeaders, uncachedHeaderData ) )
+                {
+                    return false;
+                }
+
+                for ( auto i = 0u; i < uncachedHeaderIndices.size(); i++ )
+                {
+                    headerData[uncachedHeaderIndices[i]] = uncachedHeaderData[i];
+                }
+            }
+
+            // Merge the results into the database
+            //-------------------------------------------------------------------------
+
+            if ( !MergeHeaderReflectionData( headersToParse, headerData ) )
             {
-                std::cout << "Error occurred!\n\n  Error: " << clangParser.GetErrorMessage().c_str() << std::endl;
                 return false;
             }
-            clangParsingTime = clangParser.GetParsingTime();
-            clangVisitingTime = clangParser.GetVisitingTime();
-            std::cout << "Complete! ( P:" << (float) clangParsingTime << "ms, V:" << (float) clangVisitingTime << "ms )" << std::endl;
 
             // Update module list in database
             m_database.UpdateProjectList( m_solution.m_projects );
+
+            // Update header cache
+            //-------------------------------------------------------------------------
+
+            TVector<HeaderID> registeredHeaders;
+            for ( auto const& prj : m_solution.m_projects )
+            {
+                for ( auto const& hdr : prj.m_headerFiles )
+                {
+                    registeredHeaders.push_back( hdr.m_ID );
+                }
+            }
+
+            for ( auto const& data : uncachedHeaderData )
+            {
+                m_headerCache.UpdateHeaderData( data );
+            }
+
+            m_headerCache.RemoveObseleteHeaders( registeredHeaders );
+
+            if ( !m_headerCache.Save( headerCachePath ) )
+            {
+                std::cout << " * Failed to write header cache: " << headerCachePath.c_str() << std::endl;
+            }
         }
 
         //-------------------------------------------------------------------------
@@ -761,6 +860,142 @@ namespace KRG::TypeSystem::Reflection
         return true;
     }
 
+    bool Reflector::ParseHeaders( TVector<HeaderInfo const*> const& headers, TVector<HeaderReflectionData>& results )
+    {
+        KRG_ASSERT( !headers.empty() && headers.size() == results.size() );
+
+        uint32 const numHeaders = (uint32) headers.size();
+        uint32 const maxThreads = ( m_maxParsingThreads > 0 ) ? m_maxParsingThreads : Math::Max( 1u, std::thread::hardware_concurrency() );
+        uint32 const numThreads = Math::Min( maxThreads, ( numHeaders + s_minHeadersPerParsingThread - 1 ) / s_minHeadersPerParsingThread );
+
+        std::cout << " * Reflecting C++ Code - Parsing " << numHeaders << " headers on " << numThreads << " threads - ";
+
+        // Split the headers into contiguous ranges, headers in the same project share most of their includes
+        //-------------------------------------------------------------------------
+
+        TVector<ParsingThreadContext> threadContexts( numThreads );
+        for ( auto t = 0u; t < numThreads; t++ )
+        {
+            uint32 const startIdx = ( numHeaders * t ) / numThreads;
+            uint32 const endIdx = ( numHeaders * ( t + 1 ) ) / numThreads;
+            for ( auto i = startIdx; i < endIdx; i++ )
+            {
+                threadContexts[t].m_headers.push_back( headers[i] );
+                threadContexts[t].m_results.push_back( results[i] );
+            }
+        }
+
+        // Parse
+        //-------------------------------------------------------------------------
+
+        Milliseconds time = 0;
+        {
+            ScopedTimer<PlatformClock> timer( time );
+
+            TVector<std::thread> threads;
+            for ( auto t = 1u; t < numThreads; t++ )
+            {
+                FileSystem::Path const amalgamatedHeaderPath( m_reflectionDataPath + String( String::CtorSprintf(), "Reflector_%u.h", t ) );
+                ParsingThreadContext& context = threadContexts[t];
+                threads.emplace_back( [this, amalgamatedHeaderPath, &context] () { ParseHeadersOnThread( &m_solution, amalgamatedHeaderPath, context ); } );
+            }
+
+            // Use the main thread for the first range
+            ParseHeadersOnThread( &m_solution, m_reflectionDataPath + "Reflector_0.h", threadContexts[0] );
+
+            for ( auto& thread : threads )
+            {
+                thread.join();
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        for ( auto const& context : threadContexts )
+        {
+            if ( !context.m_errorMessage.empty() )
+            {
+                std::cout << "Error occurred!\n\n  Error: " << context.m_errorMessage.c_str() << std::endl;
+                return false;
+            }
+        }
+
+        std::cout << "Complete! ( " << (float) time << "ms )" << std::endl;
+
+        uint32 headerIdx = 0;
+        for ( auto t = 0u; t < numThreads; t++ )
+        {
+            auto const& context = threadContexts[t];
+            std::cout << "   - Thread " << t << " ( " << context.m_headers.size() << " headers ) - First Pass ( P:" << (float) context.m_parsingTime[0] << "ms, V:" << (float) context.m_visitingTime[0] << "ms ), Second Pass ( P:" << (float) context.m_parsingTime[1] << "ms, V:" << (float) context.m_visitingTime[1] << "ms )" << std::endl;
+
+            for ( auto const& result : context.m_results )
+            {
+                results[headerIdx++] = result;
+            }
+        }
+
+        return true;
+    }
+
+    bool Reflector::MergeHeaderReflectionData( TVector<HeaderInfo const*> const& headers, TVector<HeaderReflectionData> const& results )
+    {
+        KRG_ASSERT( headers.size() == results.size() );
+
+        // Register all types and resources
+        //-------------------------------------------------------------------------
+
+        TVector<TypeID> registeredTypes;
+        for ( auto i = 0u; i < headers.size(); i++ )
+        {
+            FileSystem::Path const& headerFilePath = headers[i]->m_filePath;
+
+            for ( auto const& resource : results[i].m_resources )
+            {
+                // We do not allow multiple resources registered with the same ID
+                if ( m_database.IsResourceRegistered( resource.m_resourceTypeID ) )
+                {
+                    return LogError( "Duplicate resource type ID encountered: %s in file: %s", resource.m_resourceTypeID.ToString().c_str(), headerFilePath.c_str() );
+                }
+
+                m_database.RegisterResource( &resource );
+            }
+
+            for ( auto const& type : results[i].m_types )
+            {
+                if ( m_database.IsTypeRegistered( type.m_ID ) )
+                {
+                    return LogError( "Duplicate type encountered: %s%s in file: %s", type.m_namespace.c_str(), type.m_name.c_str(), headerFilePath.c_str() );
+                }
+
+                m_database.RegisterType( &type );
+                registeredTypes.push_back( type.m_ID );
+            }
+
+            if ( !results[i].m_moduleClassName.empty() )
+            {
+                for ( auto& prj : m_solution.m_projects )
+                {
+                    if ( headerFilePath.IsUnderDirectory( prj.m_path ) )
+                    {
+                        KRG_ASSERT( prj.m_moduleClassName.empty() );
+                        prj.m_moduleClassName = results[i].m_moduleClassName;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Resolve inherited properties and property types now that all types are registered
+        //-------------------------------------------------------------------------
+
+        if ( !m_database.ResolveTypes( registeredTypes ) )
+        {
+            return LogError( "%s", m_database.GetError().c_str() );
+        }
+
+        return true;
+    }
+
     bool Reflector::WriteTypeData()
     {
         std::cout << " * Writing Type Database - ";
@@ -800,6 +1035,7 @@ int main( int argc, char *argv[] )
     cmdParser.set_required<std::string>( "s", "SlnPath", "Solution Path." );
     cmdParser.set_optional<bool>( "clean", "Clean", false, "Clean Solution." );
     cmdParser.set_optional<bool>( "rebuild", "Rebuild", false, "Clean Solution." );
+    cmdParser.set_optional<int>( "j", "ParsingThreads", 0, "Max number of header parsing threads, 0 uses one per core." );
 
     if ( !cmdParser.run() )
     {
@@ -810,6 +1046,7 @@ int main( int argc, char *argv[] )
     KRG::FileSystem::Path slnPath = cmdParser.get<std::string>( "s" ).c_str();
     bool const shouldClean = cmdParser.get<bool>( "clean" );
     bool const shouldRebuild = cmdParser.get<bool>( "rebuild" );
+    int const maxParsingThreads = cmdParser.get<int>( "j" );
 
     // Execute reflector
     //-------------------------------------------------------------------------
@@ -820,7 +1057,7 @@ int main( int argc, char *argv[] )
     std::cout << "===============================================" << std::endl << std::endl;
 
     // Parse solution
-    KRG::TypeSystem::Reflection::Reflector reflector;
+    KRG::TypeSystem::Reflection::Reflector reflector( (KRG::uint32) KRG::Math::Max( maxParsingThreads, 0 ) );
     if ( reflector.ParseSolution( slnPath ) )
     {
         if ( shouldRebuild )
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Applications/Reflector/Database/ReflectionDatabase.h"
+#include "Applications/Reflector/Database/ReflectionHeaderCache.h"
 #include "System/Core/Time/Time.h"
 #include "System/Core/Types/String.h"
 
@@ -10,6 +11,9 @@ namespace KRG::TypeSystem::Reflection
 {
     class Reflector
     {
+        // Each parsing thread needs to parse all the includes for its headers, so we dont split the headers any further than this
+        constexpr static uint32 const s_minHeadersPerParsingThread = 24;
+
         enum class HeaderProcessResult
         {
             ErrorOccured,
@@ -27,7 +31,8 @@ namespace KRG::TypeSystem::Reflection
 
     public:
 
-        Reflector() = default;
+        // A max number of parsing threads of 0 will use one thread per core
+        Reflector( uint32 maxParsingThreads = 0 ) : m_maxParsingThreads( maxParsingThreads ) {}
 
         bool ParseSolution( FileSystem::Path const& slnPath );
         bool Clean();
@@ -43,6 +48,8 @@ namespace KRG::TypeSystem::Reflection
 
         bool UpToDateCheck();
         bool ReflectRegisteredHeaders();
+        bool ParseHeaders( TVector<HeaderInfo const*> const& headers, TVector<HeaderReflectionData>& results );
+        bool MergeHeaderReflectionData( TVector<HeaderInfo const*> const& headers, TVector<HeaderReflectionData> const& results );
         bool WriteTypeData();
 
     private:
@@ -50,6 +57,8 @@ namespace KRG::TypeSystem::Reflection
         FileSystem::Path                    m_reflectionDataPath;
         SolutionInfo                        m_solution;
         ReflectionDatabase                  m_database;
+        HeaderCache                         m_headerCache;
+        uint32                              m_maxParsingThreads = 0;
 
         // Up to data checks
         TVector<HeaderTimestamp>            m_registeredHeaderTimestamps;
@@ -5,9 +5,12 @@
 #include "Tools/Entity/_Module/Module.h"
 #include "Applications/Shared/ApplicationGlobalState.h"
 #include "Applications/Shared/cmdParser/krg_cmdparser.h"
+#include "Tools/Core/Resource/ResourcePackageBuilder.h"
+#include "Engine/Core/Entity/EntityDescriptors.h"
 #include "System/Resource/ResourceSettings.h"
 #include "System/Core/Settings/SettingsRegistry.h"
 #include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/Threading/TaskSystem.h"
 #include "System/Core/Logging/Log.h"
 
 #include <windows.h>
@@ -30,12 +33,36 @@ namespace KRG
             cli::Parser cmdParser( argc, argv );
             cmdParser.set_default<bool>( false );
             cmdParser.set_optional<std::string>( "compile", "compile", "", "Compile resource" );
+            cmdParser.set_optional<std::string>( "package", "package", "", "Build a resource package from all compiled resources" );
+            cmdParser.set_optional<bool>( "worker", "worker", false, "Run as a persistent compiler worker, resources to compile are read from stdin (one per line)." );
             cmdParser.set_optional<bool>( "debug", "debug", false, "Trigger debug break before execution." );
 
             if ( cmdParser.run() )
             {
                 m_triggerDebugBreak = cmdParser.get<bool>( "debug" );
 
+                // Get worker argument
+                if ( cmdParser.get<bool>( "worker" ) )
+                {
+                    m_isWorker = true;
+                    m_isValid = true;
+                    return;
+                }
+
+                // Get package argument
+                std::string const packagePath = cmdParser.get<std::string>( "package" );
+                if ( !packagePath.empty() )
+                {
+                    m_packagePath = FileSystem::Path( packagePath.c_str() );
+                    m_isValid = m_packagePath.IsFile();
+                    if ( !m_isValid )
+                    {
+                        KRG_LOG_ERROR( "ResourceCompiler", "Invalid package path: %s\n", packagePath.c_str() );
+                    }
+
+                    return;
+                }
+
                 // Get compile argument
                 ResourcePath const resourcePath( cmdParser.get<std::string>( "compile" ).c_str() );
                 if ( resourcePath.IsValid() )
@@ -57,18 +84,98 @@ namespace KRG
         }
 
         bool IsValid() const { return m_isValid; }
+        bool IsPackageRequest() const { return m_packagePath.IsValid(); }
+        bool IsWorkerRequest() const { return m_isWorker; }
 
     public:
 
         ResourceID          m_resourceID;
+        FileSystem::Path    m_packagePath;
         bool                m_triggerDebugBreak = false;
+        bool                m_isWorker = false;
         bool                m_isValid = false;
     };
 }
 
-static int32 CompileResource( TypeSystem::TypeRegistry const& typeRegistry, Resource::CompilerRegistry const& compilerRegistry, Resource::Settings const& settings, ResourceID const& resourceID )
+static int32 CompileResource( TypeSystem::TypeRegistry const& typeRegistry, Resource::CompilerRegistry const& compilerRegistry, Resource::Settings const& settings, TaskSystem* pTaskSystem, ResourceID const& resourceID )
+{
+    // Try create compilation context
+    Resource::CompileContext compileContext( typeRegistry, settings.m_rawResourcePath, settings.m_compiledResourcePath, resourceID );
+    if ( !compileContext.IsValid() )
+    {
+        return (int32) Resource::CompilationResult::Failure;
+    }
+
+    compileContext.m_pTaskSystem = pTaskSystem;
+
+    // Validate input path
+    if ( !FileSystem::Exists( compileContext.m_inputFilePath ) )
+    {
+        KRG_LOG_ERROR( "ResourceCompiler", "Source file for data path ('%s') does not exist: '%s'\n", settings.m_rawResourcePath.c_str(), compileContext.m_inputFilePath.c_str() );
+        return (int32) Resource::CompilationResult::Failure;
+    }
+
+    // Try find compiler
+    auto pCompiler = compilerRegistry.GetCompilerForResourceType( compileContext.m_resourceID.GetResourceTypeID() );
+    if ( pCompiler == nullptr )
+    {
+        KRG_LOG_ERROR( "ResourceCompiler", "Cant find appropriate resource compiler for type: %u", compileContext.m_resourceID.GetResourceTypeID() );
+        return (int32) Resource::CompilationResult::Failure;
+    }
+
+    // Compile
+    Resource::CompilationResult const result = pCompiler->Compile( compileContext );
+
+    // Apply the compression policy for this resource type
+    if ( result != Resource::CompilationResult::Failure && pCompiler->ShouldCompressOutput( compileContext.m_resourceID.GetResourceTypeID() ) )
+    {
+        if ( !pCompiler->CompressOutput( compileContext ) )
+        {
+            return (int32) Resource::CompilationResult::Failure;
+        }
+    }
+
+    return (int32) result;
+}
+
+// Keep compiling resources received on stdin until the input pipe is closed, the type and compiler registries are only created once for the lifetime of the worker
+static int32 RunCompilerWorker( TypeSystem::TypeRegistry const& typeRegistry, Resource::CompilerRegistry const& compilerRegistry, Resource::Settings const& settings, TaskSystem* pTaskSystem )
 {
-    
+    std::string inputLine;
+    while ( std::getline( std::cin, inputLine ) )
+    {
+        // Strip any trailing carriage return
+        if ( !inputLine.empty() && inputLine.back() == '\r' )
+        {
+            inputLine.pop_back();
+        }
+
+        if ( inputLine.empty() )
+        {
+            continue;
+        }
+
+        int32 result = (int32) Resource::CompilationResult::Failure;
+
+        ResourcePath const resourcePath( inputLine.c_str() );
+        ResourceID const resourceID = resourcePath.IsValid() ? ResourceID( resourcePath ) : ResourceID();
+        if ( resourceID.IsValid() )
+        {
+            result = CompileResource( typeRegistry, compilerRegistry, settings, pTaskSystem, resourceID );
+        }
+        else
+        {
+            KRG_LOG_ERROR( "ResourceCompiler", "Invalid compile request: %s\n", inputLine.c_str() );
+        }
+
+        // Make sure all the output for this job has been written before sending the result
+        Log::Flush();
+        fflush( stdout );
+        printf( "%s%d\n", Resource::CompilerWorker::s_resultPrefix, result );
+        fflush( stdout );
+    }
+
+    return 0;
 }
 
 //-------------------------------------------------------------------------
@@ -99,9 +206,13 @@ int main( int argc, char* argv[] )
 
     CommandLineArgumentParser argParser( argc, argv );
 
-    for ( int i = 0; i < argc; i++ )
+    // Workers only output compilation results
+    if ( !argParser.IsWorkerRequest() )
     {
-        std::cout << argv[i] << std::endl;
+        for ( int i = 0; i < argc; i++ )
+        {
+            std::cout << argv[i] << std::endl;
+        }
     }
 
     if ( !argParser.IsValid() )
@@ -133,6 +244,10 @@ int main( int argc, char* argv[] )
     physicsModule.RegisterCompilers( compilerRegistry );
     entityModule.RegisterCompilers( compilerRegistry );
 
+    // Compilers can go wide for expensive work (e.g. texture compression)
+    TaskSystem taskSystem;
+    taskSystem.Initialize();
+
     // Execute compilation command
     //-------------------------------------------------------------------------
 
@@ -142,36 +257,28 @@ int main( int argc, char* argv[] )
         KRG_HALT();
     }
 
-    auto CompileResource = [&] ()
+    auto BuildPackage = [&] ()
     {
-        // Try create compilation context
-        Resource::CompileContext compileContext( typeRegistry, settings.m_rawResourcePath, settings.m_compiledResourcePath, argParser.m_resourceID );
-        if ( !compileContext.IsValid() )
-        {
-            return -1;
-        }
-
-        // Validate input path
-        if ( !FileSystem::Exists( compileContext.m_inputFilePath ) )
-        {
-            KRG_LOG_ERROR( "ResourceCompiler", "Source file for data path ('%s') does not exist: '%s'\n", settings.m_rawResourcePath.c_str(), compileContext.m_inputFilePath.c_str() );
-            return -1;
-        }
-
-        // Try find compiler
-        auto pCompiler = compilerRegistry.GetCompilerForResourceType( compileContext.m_resourceID.GetResourceTypeID() );
-        if ( pCompiler == nullptr )
-        {
-            KRG_LOG_ERROR( "ResourceCompiler", "Cant find appropriate resource compiler for type: %u", compileContext.m_resourceID.GetResourceTypeID() );
-            return -1;
-        }
-
-        // Compile
-        Resource::CompilationResult const result = pCompiler->Compile( compileContext );
-        return (int32) result;
+        Resource::ResourcePackageBuilder packageBuilder( compilerRegistry, settings.m_compiledResourcePath );
+        packageBuilder.SetRootResourceTypes( { EntityModel::EntityMapDescriptor::GetStaticResourceTypeID() } );
+        return packageBuilder.Build( argParser.m_packagePath ) ? 0 : -1;
     };
 
-    int32 const result = CompileResource();
+    int32 result = 0;
+    if ( argParser.IsWorkerRequest() )
+    {
+        result = RunCompilerWorker( typeRegistry, compilerRegistry, settings, &taskSystem );
+    }
+    else if ( argParser.IsPackageRequest() )
+    {
+        result = BuildPackage();
+    }
+    else
+    {
+        result = CompileResource( typeRegistry, compilerRegistry, settings, &taskSystem, argParser.m_resourceID );
+    }
+
+    taskSystem.Shutdown();
 
     // Unregister all compilers and modules
     //-------------------------------------------------------------------------
@@ -0,0 +1,223 @@
+#include "CompilationCache.h"
+#include "ResourceCompilationRequest.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/FileSystem/DirectoryScanner.h"
+#include "System/Core/Logging/Log.h"
+#include "System/Core/Profiling/Profiling.h"
+#include <filesystem>
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource
+{
+    bool CompilationCache::Initialize( FileSystem::Path const& cacheDirectoryPath, uint64 maxSize )
+    {
+        KRG_ASSERT( !IsEnabled() );
+        KRG_ASSERT( cacheDirectoryPath.IsValid() && cacheDirectoryPath.IsDirectory() && maxSize > 0 );
+
+        if ( !FileSystem::EnsurePathExists( cacheDirectoryPath ) )
+        {
+            KRG_LOG_ERROR( "Resource", "Failed to create compilation cache directory: %s", cacheDirectoryPath.c_str() );
+            return false;
+        }
+
+        m_cacheDirectoryPath = cacheDirectoryPath;
+        m_stats = Stats();
+        m_stats.m_maxSize = maxSize;
+
+        // Get the current size of the cache
+        //-------------------------------------------------------------------------
+
+        TVector<FileSystem::ScannedFile> entries;
+        FileSystem::ScanDirectory( m_cacheDirectoryPath, entries, { s_entryExtension } );
+
+        for ( auto const& entry : entries )
+        {
+            m_stats.m_currentSize += entry.m_size;
+        }
+
+        m_stats.m_numEntries = (uint32) entries.size();
+
+        //-------------------------------------------------------------------------
+
+        if ( m_stats.m_currentSize > m_stats.m_maxSize )
+        {
+            EvictEntries();
+        }
+
+        return true;
+    }
+
+    void CompilationCache::Shutdown()
+    {
+        m_cacheDirectoryPath = FileSystem::Path();
+    }
+
+    CompilationCache::Stats CompilationCache::GetStats() const
+    {
+        Threading::ScopeLock lock( m_mutex );
+        return m_stats;
+    }
+
+    //-------------------------------------------------------------------------
+
+    Hash::Hash128 CompilationCache::CalculateKey( CompilationRequest const* pRequest )
+    {
+        KRG_ASSERT( pRequest != nullptr && pRequest->m_compilerVersion >= 0 );
+
+        // The resource path is included since compiled resources can reference their own ID
+        String const& resourcePathString = pRequest->GetResourceID().GetResourcePath().GetString();
+        uint32 const resourceTypeID = pRequest->GetResourceID().GetResourceTypeID();
+
+        Hash::StreamingHasher hasher;
+        hasher.Update( resourcePathString.c_str(), resourcePathString.length() );
+        hasher.Update( &resourceTypeID, sizeof( uint32 ) );
+        hasher.Update( &pRequest->m_compilerVersion, sizeof( int32 ) );
+        hasher.Update( &pRequest->m_sourceHash, sizeof( uint64 ) );
+        return hasher.GetHash128();
+    }
+
+    FileSystem::Path CompilationCache::GetEntryPath( Hash::Hash128 const& key ) const
+    {
+        // Split entries across sub-directories to keep the directory sizes manageable on network shares
+        String entryPath;
+        entryPath.sprintf( "%s%02llx%c%016llx%016llx%s", m_cacheDirectoryPath.c_str(), key.m_high >> 56, FileSystem::Path::s_pathDelimiter, key.m_high, key.m_low, s_entryExtension );
+        return FileSystem::Path( entryPath );
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool CompilationCache::TryRetrieve( Hash::Hash128 const& key, FileSystem::Path const& destinationFilePath )
+    {
+        KRG_PROFILE_FUNCTION_IO();
+        KRG_ASSERT( IsEnabled() );
+
+        FileSystem::Path const entryPath = GetEntryPath( key );
+
+        // The entry can be evicted by another machine at any time so we dont check for existence, we just try to copy it
+        std::error_code ec;
+        std::filesystem::copy_file( entryPath.c_str(), destinationFilePath.c_str(), std::filesystem::copy_options::overwrite_existing, ec );
+        if ( ec )
+        {
+            Threading::ScopeLock lock( m_mutex );
+            m_stats.m_numMisses++;
+            return false;
+        }
+
+        // Mark the entry as recently used, failure here only affects the eviction order
+        std::filesystem::last_write_time( entryPath.c_str(), std::filesystem::file_time_type::clock::now(), ec );
+
+        Threading::ScopeLock lock( m_mutex );
+        m_stats.m_numHits++;
+        return true;
+    }
+
+    void CompilationCache::Store( Hash::Hash128 const& key, FileSystem::Path const& compiledFilePath )
+    {
+        KRG_PROFILE_FUNCTION_IO();
+        KRG_ASSERT( IsEnabled() );
+
+        FileSystem::Path const entryPath = GetEntryPath( key );
+        if ( FileSystem::Exists( entryPath ) || !FileSystem::EnsurePathExists( entryPath ) )
+        {
+            return;
+        }
+
+        // Copy to a uniquely named temporary file and then rename it, this ensures that readers never see a partially written entry
+        //-------------------------------------------------------------------------
+
+        String tempPath;
+        tempPath.sprintf( "%s.%llx.tmp", entryPath.c_str(), (uint64) std::hash<std::thread::id>()( std::this_thread::get_id() ) ^ PlatformClock::GetTime() );
+
+        std::error_code ec;
+        std::filesystem::copy_file( compiledFilePath.c_str(), tempPath.c_str(), std::filesystem::copy_options::overwrite_existing, ec );
+        if ( ec )
+        {
+            KRG_LOG_WARNING( "Resource", "Failed to store compiled resource (%s) in compilation cache: %s", compiledFilePath.c_str(), ec.message().c_str() );
+            std::filesystem::remove( tempPath.c_str(), ec );
+            return;
+        }
+
+        std::filesystem::rename( tempPath.c_str(), entryPath.c_str(), ec );
+        if ( ec )
+        {
+            // Another machine might have stored the same entry in the meantime, which is fine
+            std::filesystem::remove( tempPath.c_str(), ec );
+            return;
+        }
+
+        // Update stats and evict if needed
+        //-------------------------------------------------------------------------
+
+        bool shouldEvict = false;
+        {
+            Threading::ScopeLock lock( m_mutex );
+            m_stats.m_numStores++;
+            m_stats.m_numEntries++;
+            m_stats.m_currentSize += FileSystem::GetFileSize( entryPath );
+            shouldEvict = m_stats.m_currentSize > m_stats.m_maxSize;
+        }
+
+        if ( shouldEvict )
+        {
+            EvictEntries();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void CompilationCache::EvictEntries()
+    {
+        KRG_PROFILE_FUNCTION_IO();
+
+        // Only a single worker needs to evict at a time
+        bool expected = false;
+        if ( !m_isEvicting.compare_exchange_strong( expected, true ) )
+        {
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        TVector<FileSystem::ScannedFile> entries;
+        FileSystem::ScanDirectory( m_cacheDirectoryPath, entries, { s_entryExtension } );
+
+        uint64 currentSize = 0;
+        for ( auto const& entry : entries )
+        {
+            currentSize += entry.m_size;
+        }
+
+        // Remove the least recently used entries first
+        eastl::sort( entries.begin(), entries.end(), [] ( FileSystem::ScannedFile const& a, FileSystem::ScannedFile const& b ) { return a.m_modifiedTime < b.m_modifiedTime; } );
+
+        uint64 const maxSize = GetStats().m_maxSize;
+        uint64 const targetSize = uint64( maxSize * s_evictionTargetFraction );
+        uint32 numEvicted = 0;
+
+        for ( auto const& entry : entries )
+        {
+            if ( currentSize <= targetSize )
+            {
+                break;
+            }
+
+            // Entries can be removed by other machines concurrently, so we dont care whether the erase succeeds
+            FileSystem::EraseFile( entry.m_path );
+            currentSize -= entry.m_size;
+            numEvicted++;
+        }
+
+        //-------------------------------------------------------------------------
+
+        {
+            Threading::ScopeLock lock( m_mutex );
+            m_stats.m_currentSize = currentSize;
+            m_stats.m_numEntries = (uint32) entries.size() - numEvicted;
+            m_stats.m_numEvictions += numEvicted;
+        }
+
+        KRG_LOG_MESSAGE( "Resource", "Compilation cache evicted %u entries", numEvicted );
+        m_isEvicting = false;
+    }
+}
\ No newline at end of file
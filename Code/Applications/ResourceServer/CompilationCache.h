@@ -0,0 +1,77 @@
+#pragma once
+
+#include "System/Core/FileSystem/FileSystemPath.h"
+#include "System/Core/Algorithm/Hash.h"
+#include "System/Core/Threading/Threading.h"
+
+//-------------------------------------------------------------------------
+// Compilation Cache
+//-------------------------------------------------------------------------
+// A content-addressed store of compiled resources, keyed on the resource type, the compiler version and the hash of all compile inputs
+// The cache directory can be located on a shared mount so that a resource compiled by one machine can be reused by all others
+//
+// Entries are written to a temporary file and then renamed so that other machines never see partially written entries
+// Retrieving an entry touches its modification time, and eviction removes the least recently touched entries once the size budget is exceeded
+// All functions are thread-safe since the cache is accessed by the compilation workers
+
+namespace KRG::Resource
+{
+    class CompilationRequest;
+
+    //-------------------------------------------------------------------------
+
+    class CompilationCache
+    {
+        constexpr static char const* const s_entryExtension = ".krgcache";
+
+        // Once the budget is exceeded, we evict entries until the cache is back under this fraction of the budget
+        constexpr static float const s_evictionTargetFraction = 0.9f;
+
+    public:
+
+        struct Stats
+        {
+            uint32                              m_numHits = 0;
+            uint32                              m_numMisses = 0;
+            uint32                              m_numStores = 0;
+            uint32                              m_numEvictions = 0;
+            uint32                              m_numEntries = 0;
+            uint64                              m_currentSize = 0;
+            uint64                              m_maxSize = 0;
+        };
+
+    public:
+
+        bool Initialize( FileSystem::Path const& cacheDirectoryPath, uint64 maxSize );
+        void Shutdown();
+
+        inline bool IsEnabled() const { return m_cacheDirectoryPath.IsValid(); }
+        inline FileSystem::Path const& GetCacheDirectoryPath() const { return m_cacheDirectoryPath; }
+
+        Stats GetStats() const;
+
+        // Calculate the cache key for a request, this requires the compiler version and source hash to have been set
+        static Hash::Hash128 CalculateKey( CompilationRequest const* pRequest );
+
+        // Try to copy a cached compiled resource to the request destination, returns false on a cache miss
+        bool TryRetrieve( Hash::Hash128 const& key, FileSystem::Path const& destinationFilePath );
+
+        // Store a compiled resource in the cache, will evict old entries if we exceed the size budget
+        void Store( Hash::Hash128 const& key, FileSystem::Path const& compiledFilePath );
+
+    private:
+
+        FileSystem::Path GetEntryPath( Hash::Hash128 const& key ) const;
+
+        // Rescan the cache directory and remove the least recently used entries until we are under budget
+        // We rescan since other machines sharing the cache will also have added and removed entries
+        void EvictEntries();
+
+    private:
+
+        FileSystem::Path                        m_cacheDirectoryPath;
+        mutable Threading::Mutex                m_mutex;
+        Stats                                   m_stats;
+        std::atomic<bool>                       m_isEvicting = false;
+    };
+}
\ No newline at end of file
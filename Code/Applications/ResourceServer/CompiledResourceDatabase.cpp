@@ -17,6 +17,20 @@ namespace KRG
                 return false;
             }
 
+            // Outdated tables cant be migrated since the up-to-date data is not comparable, so just start from scratch
+            if ( GetVersion() != s_version )
+            {
+                if ( !DropTables() )
+                {
+                    return false;
+                }
+
+                if ( !ExecuteSimpleQuery( "PRAGMA user_version = %d;", s_version ) )
+                {
+                    return false;
+                }
+            }
+
             if ( !CreateTables() )
             {
                 return false;
@@ -48,7 +62,12 @@ namespace KRG
         {
             KRG_ASSERT( m_pDatabase != nullptr );
 
-            if ( !ExecuteSimpleQuery( "CREATE TABLE IF NOT EXISTS `CompiledResources` ( `ResourcePath` TEXT UNIQUE,`ResourceType` INTEGER,`CompilerVersion` INTEGER,`FileTimestamp` INTEGER, `SourceTimestampHash` INTEGER, PRIMARY KEY( ResourcePath, ResourceType ) );" ) )
+            if ( !ExecuteSimpleQuery( "CREATE TABLE IF NOT EXISTS `CompiledResources` ( `ResourcePath` TEXT UNIQUE,`ResourceType` INTEGER,`CompilerVersion` INTEGER, `SourceHash` INTEGER, PRIMARY KEY( ResourcePath, ResourceType ) );" ) )
+            {
+                return false;
+            }
+
+            if ( !ExecuteSimpleQuery( "CREATE TABLE IF NOT EXISTS `SourceFileHashes` ( `FilePath` TEXT PRIMARY KEY, `FileSize` INTEGER, `ModifiedTime` INTEGER, `HashLow` INTEGER, `HashHigh` INTEGER );" ) )
             {
                 return false;
             }
@@ -66,9 +85,33 @@ namespace KRG
                 return false;
             }
 
+            if ( !ExecuteSimpleQuery( "DROP TABLE IF EXISTS `SourceFileHashes`;" ) )
+            {
+                return false;
+            }
+
             return true;
         }
 
+        int32 CompiledResourceDatabase::GetVersion() const
+        {
+            KRG_ASSERT( m_pDatabase != nullptr );
+
+            int32 version = 0;
+            sqlite3_stmt* pStatement = nullptr;
+            if ( IsValidSQLiteResult( sqlite3_prepare_v2( m_pDatabase, "PRAGMA user_version;", -1, &pStatement, nullptr ) ) )
+            {
+                if ( sqlite3_step( pStatement ) == SQLITE_ROW )
+                {
+                    version = sqlite3_column_int( pStatement, 0 );
+                }
+
+                IsValidSQLiteResult( sqlite3_finalize( pStatement ) );
+            }
+
+            return version;
+        }
+
         //-------------------------------------------------------------------------
 
         CompiledResourceRecord CompiledResourceDatabase::GetRecord( ResourceID resourceID ) const
@@ -88,8 +131,7 @@ namespace KRG
                     record.m_resourceID = ResourceID( resourcePath );
 
                     record.m_compilerVersion = sqlite3_column_int( pStatement, 2 );
-                    record.m_fileTimestamp = sqlite3_column_int64( pStatement, 3 );
-                    record.m_sourceTimestampHash = sqlite3_column_int64( pStatement, 4 );
+                    record.m_sourceHash = (uint64) sqlite3_column_int64( pStatement, 3 );
                 }
 
                 IsValidSQLiteResult( sqlite3_finalize( pStatement ) );
@@ -100,7 +142,39 @@ namespace KRG
 
         bool CompiledResourceDatabase::WriteRecord( CompiledResourceRecord const& record )
         {
-            return ExecuteSimpleQuery( "INSERT OR REPLACE INTO `CompiledResources` ( `ResourcePath`, `ResourceType`, `CompilerVersion`, `FileTimestamp`, `SourceTimestampHash` ) VALUES ( \"%s\", %d, %d, %llu, %llu );", record.m_resourceID.GetResourcePath().c_str(), (uint32) record.m_resourceID.GetResourceTypeID(), record.m_compilerVersion, record.m_fileTimestamp, record.m_sourceTimestampHash  );
+            // SQLite integers are signed so all hashes are stored as their signed bit patterns, otherwise they get converted to floating point
+            return ExecuteSimpleQuery( "INSERT OR REPLACE INTO `CompiledResources` ( `ResourcePath`, `ResourceType`, `CompilerVersion`, `SourceHash` ) VALUES ( \"%s\", %d, %d, %lld );", record.m_resourceID.GetResourcePath().c_str(), (uint32) record.m_resourceID.GetResourceTypeID(), record.m_compilerVersion, (int64) record.m_sourceHash );
+        }
+
+        //-------------------------------------------------------------------------
+
+        bool CompiledResourceDatabase::GetAllSourceFileHashes( TVector<SourceFileHashRecord>& outRecords ) const
+        {
+            outRecords.clear();
+
+            sqlite3_stmt* pStatement = nullptr;
+            if ( !IsValidSQLiteResult( sqlite3_prepare_v2( m_pDatabase, "SELECT * FROM `SourceFileHashes`;", -1, &pStatement, nullptr ) ) )
+            {
+                return false;
+            }
+
+            while ( sqlite3_step( pStatement ) == SQLITE_ROW )
+            {
+                auto& record = outRecords.emplace_back();
+                record.m_filePath = ( char const* ) sqlite3_column_text( pStatement, 0 );
+                record.m_fileSize = (uint64) sqlite3_column_int64( pStatement, 1 );
+                record.m_modifiedTime = (uint64) sqlite3_column_int64( pStatement, 2 );
+                record.m_hash.m_low = (uint64) sqlite3_column_int64( pStatement, 3 );
+                record.m_hash.m_high = (uint64) sqlite3_column_int64( pStatement, 4 );
+            }
+
+            return IsValidSQLiteResult( sqlite3_finalize( pStatement ) );
+        }
+
+        bool CompiledResourceDatabase::WriteSourceFileHash( SourceFileHashRecord const& record )
+        {
+            KRG_ASSERT( record.IsValid() );
+            return ExecuteSimpleQuery( "INSERT OR REPLACE INTO `SourceFileHashes` ( `FilePath`, `FileSize`, `ModifiedTime`, `HashLow`, `HashHigh` ) VALUES ( \"%s\", %lld, %lld, %lld, %lld );", record.m_filePath.c_str(), (int64) record.m_fileSize, (int64) record.m_modifiedTime, (int64) record.m_hash.m_low, (int64) record.m_hash.m_high );
         }
     }
 }
\ No newline at end of file
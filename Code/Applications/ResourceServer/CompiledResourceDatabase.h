@@ -3,6 +3,7 @@
 #include "Tools/Core/ThirdParty/sqlite/SqliteHelpers.h"
 #include "System/Resource/ResourceID.h"
 #include "System/Core/FileSystem/FileSystemPath.h"
+#include "System/Core/Algorithm/Hash.h"
 
 //-------------------------------------------------------------------------
 
@@ -16,14 +17,27 @@ namespace KRG
 
             ResourceID          m_resourceID;
             int32               m_compilerVersion = -1;         // The compiler version used for the last compilation
-            uint64              m_fileTimestamp = 0;            // The timestamp of the resource file
-            uint64              m_sourceTimestampHash = 0;      // The timestamp hash of any source assets used in the compilation
+            uint64              m_sourceHash = 0;               // The combined content hash of the resource file and any source assets used in the compilation
+        };
+
+        // The content hash of a source file, the hash is only valid as long as the file size and modification time match
+        struct SourceFileHashRecord final
+        {
+            inline bool IsValid() const { return !m_filePath.empty(); }
+
+            String              m_filePath;
+            uint64              m_fileSize = 0;
+            uint64              m_modifiedTime = 0;
+            Hash::Hash128       m_hash;
         };
 
         //-------------------------------------------------------------------------
 
         class CompiledResourceDatabase final : public SQLite::SQLiteDatabase
         {
+            // Bump this whenever the table layout changes, databases with an older version will be cleared
+            constexpr static int32 const s_version = 2;
+
         public:
 
             bool TryConnect( FileSystem::Path const& databasePath );
@@ -34,10 +48,15 @@ namespace KRG
             CompiledResourceRecord GetRecord( ResourceID resourceID ) const;
             bool WriteRecord( CompiledResourceRecord const& record );
 
+            // Source file content hash cache
+            bool GetAllSourceFileHashes( TVector<SourceFileHashRecord>& outRecords ) const;
+            bool WriteSourceFileHash( SourceFileHashRecord const& record );
+
         private:
 
             bool CreateTables();
             bool DropTables();
+            int32 GetVersion() const;
         };
     }
 }
\ No newline at end of file
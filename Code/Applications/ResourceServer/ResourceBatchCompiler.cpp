@@ -0,0 +1,391 @@
+#include "ResourceBatchCompiler.h"
+#include "ResourceServer.h"
+#include "System/Core/Algorithm/TopologicalSort.h"
+#include "System/Core/FileSystem/DirectoryScanner.h"
+#include "System/Core/Time/Timers.h"
+#include "System/Core/Logging/Log.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource
+{
+    ResourceBatchCompiler::ResourceBatchCompiler( ResourceServer& resourceServer )
+        : m_resourceServer( resourceServer )
+    {}
+
+    bool ResourceBatchCompiler::AddRootDirectory( ResourcePath const& directoryPath )
+    {
+        KRG_ASSERT( directoryPath.IsValid() && directoryPath.IsDirectory() );
+
+        FileSystem::Path const& rawResourceDirectoryPath = m_resourceServer.GetRawResourceDir();
+        FileSystem::Path const directoryFilePath = directoryPath.ToFileSystemPath( rawResourceDirectoryPath );
+
+        TVector<FileSystem::ScannedFile> files;
+        if ( !FileSystem::ScanDirectory( directoryFilePath, files ) )
+        {
+            KRG_LOG_ERROR( "Resource", "Failed to scan batch compilation directory: %s", directoryFilePath.c_str() );
+            return false;
+        }
+
+        for ( auto const& file : files )
+        {
+            ResourceID const resourceID = ResourceID::FromFileSystemPath( rawResourceDirectoryPath, file.m_path );
+            if ( resourceID.IsValid() && m_resourceServer.IsCompileableResourceType( resourceID.GetResourceTypeID() ) )
+            {
+                AddRootResource( resourceID );
+            }
+        }
+
+        return true;
+    }
+
+    void ResourceBatchCompiler::AddRootResource( ResourceID const& resourceID )
+    {
+        KRG_ASSERT( resourceID.IsValid() );
+        if ( !VectorContains( m_rootResources, resourceID ) )
+        {
+            m_rootResources.emplace_back( resourceID );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    int32 ResourceBatchCompiler::GetOrCreateBatchResource( ResourceID const& resourceID )
+    {
+        auto iter = m_resourceIndices.find( resourceID.GetID() );
+        if ( iter != m_resourceIndices.end() )
+        {
+            return iter->second;
+        }
+
+        int32 const resourceIdx = (int32) m_resources.size();
+        m_resources.emplace_back().m_resourceID = resourceID;
+        m_resourceIndices[resourceID.GetID()] = resourceIdx;
+        return resourceIdx;
+    }
+
+    bool ResourceBatchCompiler::BuildDependencyGraph()
+    {
+        m_resources.clear();
+        m_resourceIndices.clear();
+        m_compilationOrder.clear();
+
+        // Build the graph from the roots
+        //-------------------------------------------------------------------------
+        // We follow all resource references in the descriptors (including maps) so that we also discover all the resources that are needed at runtime
+
+        TVector<int32> resourcesToVisit;
+        for ( auto const& rootResourceID : m_rootResources )
+        {
+            resourcesToVisit.emplace_back( GetOrCreateBatchResource( rootResourceID ) );
+        }
+
+        TVector<ResourcePath> dependencies;
+        for ( int32 i = 0; i < (int32) resourcesToVisit.size(); i++ )
+        {
+            int32 const resourceIdx = resourcesToVisit[i];
+            FileSystem::Path const sourceFilePath = m_resources[resourceIdx].m_resourceID.GetResourcePath().ToFileSystemPath( m_resourceServer.GetRawResourceDir() );
+
+            // Missing or invalid descriptors will fail when compiled, so we dont need to report anything here
+            dependencies.clear();
+            if ( !m_resourceServer.TryReadCompileDependencies( sourceFilePath, dependencies ) )
+            {
+                continue;
+            }
+
+            for ( auto const& dependencyPath : dependencies )
+            {
+                // Only resources with a compiler are part of the graph, source assets are tracked by the up-to-date system
+                ResourceID const dependencyID( dependencyPath );
+                if ( !m_resourceServer.IsCompileableResourceType( dependencyID.GetResourceTypeID() ) || dependencyID == m_resources[resourceIdx].m_resourceID )
+                {
+                    continue;
+                }
+
+                size_t const numResources = m_resources.size();
+                int32 const dependencyIdx = GetOrCreateBatchResource( dependencyID );
+                if ( m_resources.size() != numResources )
+                {
+                    resourcesToVisit.emplace_back( dependencyIdx );
+                }
+
+                if ( !VectorContains( m_resources[resourceIdx].m_dependencies, dependencyIdx ) )
+                {
+                    m_resources[resourceIdx].m_dependencies.emplace_back( dependencyIdx );
+                    m_resources[dependencyIdx].m_dependents.emplace_back( resourceIdx );
+                }
+            }
+        }
+
+        for ( auto& resource : m_resources )
+        {
+            resource.m_numIncompleteDependencies = (int32) resource.m_dependencies.size();
+        }
+
+        // Sort so that dependencies are requested before their dependents
+        //-------------------------------------------------------------------------
+
+        TVector<TopologicalSorter::Node> list;
+        list.reserve( m_resources.size() );
+        for ( int32 i = 0; i < (int32) m_resources.size(); i++ )
+        {
+            list.push_back( TopologicalSorter::Node( i ) );
+        }
+
+        for ( int32 i = 0; i < (int32) m_resources.size(); i++ )
+        {
+            for ( int32 dependencyIdx : m_resources[i].m_dependencies )
+            {
+                list[i].m_children.push_back( &list[dependencyIdx] );
+            }
+        }
+
+        if ( !TopologicalSorter::Sort( list ) )
+        {
+            KRG_LOG_ERROR( "Resource", "Cyclic dependency detected in batch compilation resource graph!" );
+            return false;
+        }
+
+        m_compilationOrder.reserve( list.size() );
+        for ( auto const& node : list )
+        {
+            m_compilationOrder.emplace_back( node.m_ID );
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool ResourceBatchCompiler::Compile()
+    {
+        ScopedTimer<PlatformClock> timer( m_totalTime );
+
+        if ( !BuildDependencyGraph() )
+        {
+            return false;
+        }
+
+        printf( "Batch compiling %u resources (%u roots)\n", (uint32) m_resources.size(), (uint32) m_rootResources.size() );
+
+        // Requests are only completed once the server has accepted their results, we never poll the request status since it is written by the workers
+        m_requestIndices.clear();
+        m_completedRequests.clear();
+        m_requestCompletedBindingID = m_resourceServer.OnRequestCompleted().Bind( [this] ( CompilationRequest const* pRequest ) { OnRequestCompleted( pRequest ); } );
+
+        //-------------------------------------------------------------------------
+
+        TVector<int32> waitingResources = m_compilationOrder;
+        TVector<int32> requestedResources;
+        TVector<int32> remainingResources;
+
+        while ( !waitingResources.empty() || !requestedResources.empty() )
+        {
+            // Request all resources whose dependencies have completed, the server will process the requests in the order received
+            //-------------------------------------------------------------------------
+
+            uint32 numNewRequests = 0;
+            remainingResources.clear();
+
+            for ( int32 resourceIdx : waitingResources )
+            {
+                auto& resource = m_resources[resourceIdx];
+
+                // Resources can fail due to a failed dependency while waiting
+                if ( resource.m_state != State::Waiting )
+                {
+                    continue;
+                }
+
+                if ( resource.m_numIncompleteDependencies > 0 )
+                {
+                    remainingResources.emplace_back( resourceIdx );
+                    continue;
+                }
+
+                // Up-to-date and failed requests are completed immediately, before they are ever handed to a worker
+                resource.m_pRequest = m_resourceServer.RequestCompilation( resource.m_resourceID );
+                resource.m_wasCompletedOnRequest = resource.m_pRequest->IsComplete();
+                m_requestIndices[resource.m_pRequest] = resourceIdx;
+                resource.m_state = State::Requested;
+                requestedResources.emplace_back( resourceIdx );
+                numNewRequests++;
+            }
+
+            waitingResources.swap( remainingResources );
+
+            // The topological sort cant always detect cycles, so any resources that can never be requested are failed here
+            if ( numNewRequests == 0 && requestedResources.empty() && !waitingResources.empty() )
+            {
+                for ( int32 resourceIdx : waitingResources )
+                {
+                    KRG_LOG_ERROR( "Resource", "Resource (%s) is part of a dependency cycle and cant be compiled!", m_resources[resourceIdx].m_resourceID.c_str() );
+                    m_resources[resourceIdx].m_state = State::Failed;
+                }
+
+                break;
+            }
+
+            // Update the server and process completed requests
+            //-------------------------------------------------------------------------
+
+            m_resourceServer.Update();
+
+            uint32 numCompletedRequests = 0;
+
+            for ( auto pRequest : m_completedRequests )
+            {
+                auto iter = m_requestIndices.find( pRequest );
+                if ( iter == m_requestIndices.end() )
+                {
+                    continue;
+                }
+
+                int32 const resourceIdx = iter->second;
+                m_requestIndices.erase( iter );
+                requestedResources.erase_first_unsorted( resourceIdx );
+
+                OnResourceCompleted( resourceIdx, pRequest->HasSucceeded() );
+                numCompletedRequests++;
+            }
+
+            m_completedRequests.clear();
+
+            //-------------------------------------------------------------------------
+
+            if ( numNewRequests == 0 && numCompletedRequests == 0 )
+            {
+                Threading::Sleep( 1 );
+            }
+        }
+
+        m_resourceServer.OnRequestCompleted().Unbind( m_requestCompletedBindingID );
+
+        //-------------------------------------------------------------------------
+
+        for ( auto const& resource : m_resources )
+        {
+            if ( resource.m_state != State::Succeeded )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void ResourceBatchCompiler::OnRequestCompleted( CompilationRequest const* pRequest )
+    {
+        // Immediately completed requests are reported before we have recorded their index, so we only match them to resources after updating the server
+        m_completedRequests.emplace_back( pRequest );
+    }
+
+    void ResourceBatchCompiler::OnResourceCompleted( int32 resourceIdx, bool wasSuccessful )
+    {
+        auto& resource = m_resources[resourceIdx];
+        KRG_ASSERT( resource.m_state == State::Waiting || resource.m_state == State::Requested );
+
+        if ( wasSuccessful )
+        {
+            resource.m_state = State::Succeeded;
+        }
+        else
+        {
+            if ( resource.m_pRequest != nullptr )
+            {
+                KRG_LOG_ERROR( "Resource", "Failed to compile resource (%s):\n%s", resource.m_resourceID.c_str(), resource.m_pRequest->GetLog() );
+            }
+
+            resource.m_state = State::Failed;
+        }
+
+        // Update dependents, a failed resource will fail all resources that depend on it without compiling them
+        //-------------------------------------------------------------------------
+
+        for ( int32 dependentIdx : resource.m_dependents )
+        {
+            auto& dependent = m_resources[dependentIdx];
+            dependent.m_numIncompleteDependencies--;
+
+            if ( !wasSuccessful && dependent.m_state == State::Waiting )
+            {
+                KRG_LOG_ERROR( "Resource", "Skipping compilation of resource (%s) since its dependency (%s) failed to compile!", dependent.m_resourceID.c_str(), resource.m_resourceID.c_str() );
+                OnResourceCompleted( dependentIdx, false );
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceBatchCompiler::PrintSummary() const
+    {
+        // Gather stats
+        //-------------------------------------------------------------------------
+
+        THashMap<ResourceTypeID, ResourceTypeStats> typeStats;
+        ResourceTypeStats totalStats;
+
+        for ( auto const& resource : m_resources )
+        {
+            auto& stats = typeStats[resource.m_resourceID.GetResourceTypeID()];
+
+            if ( resource.m_state == State::Succeeded )
+            {
+                if ( resource.m_pRequest->WasRetrievedFromCompilationCache() )
+                {
+                    stats.m_numRetrievedFromCache++;
+                    totalStats.m_numRetrievedFromCache++;
+                }
+                else if ( resource.m_wasCompletedOnRequest )
+                {
+                    stats.m_numUpToDate++;
+                    totalStats.m_numUpToDate++;
+                }
+                else
+                {
+                    stats.m_numCompiled++;
+                    totalStats.m_numCompiled++;
+                }
+            }
+            else
+            {
+                stats.m_numFailed++;
+                totalStats.m_numFailed++;
+            }
+
+            // The compilation time includes the time spent retrieving resources from the compilation cache
+            if ( resource.m_pRequest != nullptr && !resource.m_wasCompletedOnRequest )
+            {
+                stats.m_compilationTime += resource.m_pRequest->GetCompilationElapsedTime();
+                totalStats.m_compilationTime += resource.m_pRequest->GetCompilationElapsedTime();
+            }
+        }
+
+        // Sort by time spent compiling
+        //-------------------------------------------------------------------------
+
+        TVector<TPair<ResourceTypeID, ResourceTypeStats>> sortedTypeStats( typeStats.begin(), typeStats.end() );
+        eastl::sort( sortedTypeStats.begin(), sortedTypeStats.end(), [] ( auto const& a, auto const& b ) { return a.second.m_compilationTime > b.second.m_compilationTime; } );
+
+        // Print
+        //-------------------------------------------------------------------------
+
+        auto PrintStats = [] ( char const* pTypeName, ResourceTypeStats const& stats )
+        {
+            uint32 const numExecuted = stats.m_numCompiled + stats.m_numRetrievedFromCache;
+            float const averageTime = ( numExecuted > 0 ) ? stats.m_compilationTime.ToFloat() / numExecuted : 0.0f;
+            printf( "%-6s %10u %10u %10u %10u %14.2f %12.2f\n", pTypeName, stats.m_numCompiled, stats.m_numRetrievedFromCache, stats.m_numUpToDate, stats.m_numFailed, stats.m_compilationTime.ToFloat(), averageTime );
+        };
+
+        printf( "\n%-6s %10s %10s %10s %10s %14s %12s\n", "Type", "Compiled", "Cached", "UpToDate", "Failed", "Time (ms)", "Avg (ms)" );
+        for ( auto const& typeStatsPair : sortedTypeStats )
+        {
+            PrintStats( typeStatsPair.first.ToString().c_str(), typeStatsPair.second );
+        }
+
+        PrintStats( "Total", totalStats );
+
+        // Compilation time is summed across all workers, so the wall time is reported separately
+        printf( "\nBatch compilation completed in %.2fs\n", Seconds( m_totalTime ).ToFloat() );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "System/Resource/ResourceID.h"
+#include "System/Core/Time/Time.h"
+#include "System/Core/Types/Containers.h"
+#include "System/Core/Types/Event.h"
+
+//-------------------------------------------------------------------------
+// Resource Batch Compiler
+//-------------------------------------------------------------------------
+// Compiles a set of root resources and everything they reference, used for release packaging and for pre-warming build machines
+//
+// The full dependency graph is built from the resource descriptors, and resources are requested in topological order so that
+// compile dependencies are always up-to-date before their dependents are compiled. Compilation is performed by a resource server
+// running in batch mode, so up-to-date resources are skipped and the compilation cache and workers are shared with the server
+
+namespace KRG::Resource
+{
+    class ResourceServer;
+    class CompilationRequest;
+
+    //-------------------------------------------------------------------------
+
+    class ResourceBatchCompiler
+    {
+        enum class State : uint8
+        {
+            Waiting,
+            Requested,
+            Succeeded,
+            Failed,
+        };
+
+        struct BatchResource
+        {
+            ResourceID                          m_resourceID;
+            TVector<int32>                      m_dependencies;
+            TVector<int32>                      m_dependents;
+            CompilationRequest const*           m_pRequest = nullptr;
+            int32                               m_numIncompleteDependencies = 0;
+            State                               m_state = State::Waiting;
+            bool                                m_wasCompletedOnRequest = false;
+        };
+
+        struct ResourceTypeStats
+        {
+            uint32                              m_numCompiled = 0;
+            uint32                              m_numRetrievedFromCache = 0;
+            uint32                              m_numUpToDate = 0;
+            uint32                              m_numFailed = 0;
+            Milliseconds                        m_compilationTime = 0;
+        };
+
+    public:
+
+        ResourceBatchCompiler( ResourceServer& resourceServer );
+
+        // Add all compileable resources in a directory (and its sub-directories) as roots
+        bool AddRootDirectory( ResourcePath const& directoryPath );
+
+        // Add a single root resource (e.g. a map)
+        void AddRootResource( ResourceID const& resourceID );
+
+        // Compile all roots and their dependencies, returns true if all resources compiled successfully
+        bool Compile();
+
+        // Print the per resource type summary of the last compilation
+        void PrintSummary() const;
+
+    private:
+
+        int32 GetOrCreateBatchResource( ResourceID const& resourceID );
+        bool BuildDependencyGraph();
+        void OnRequestCompleted( CompilationRequest const* pRequest );
+        void OnResourceCompleted( int32 resourceIdx, bool wasSuccessful );
+
+    private:
+
+        ResourceServer&                         m_resourceServer;
+        TVector<ResourceID>                     m_rootResources;
+        TVector<BatchResource>                  m_resources;
+        THashMap<uint32, int32>                 m_resourceIndices;
+        TVector<int32>                          m_compilationOrder;
+        THashMap<CompilationRequest const*, int32> m_requestIndices;
+        TVector<CompilationRequest const*>      m_completedRequests; // Requests accepted by the server that we havent processed yet
+        EventBindingID                          m_requestCompletedBindingID;
+        Milliseconds                            m_totalTime = 0;
+    };
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "System/Core/Time/Time.h"
 #include "System/Core/Types/UUID.h"
 #include "System/Core/Time/Timestamp.h"
+#include "System/Core/Algorithm/Hash.h"
 
 //-------------------------------------------------------------------------
 
@@ -49,6 +50,7 @@ namespace KRG::Resource
         inline char const* GetCompilerArgs() const { return m_compilerArgs.c_str(); }
         inline FileSystem::Path const& GetSourceFilePath() const { return m_sourceFile; }
         inline FileSystem::Path const& GetDestinationFilePath() const { return m_destinationFile; }
+        inline bool WasRetrievedFromCompilationCache() const { return m_wasRetrievedFromCompilationCache; }
 
         inline TimeStamp const& GetTimeRequested() const { return m_timeRequested; }
 
@@ -72,8 +74,8 @@ namespace KRG::Resource
         uint32                              m_clientID = 0;
         ResourceID                          m_resourceID;
         int32                               m_compilerVersion = -1;
-        uint64                              m_fileTimestamp = 0;
-        uint64                              m_sourceTimestampHash = 0;
+        uint64                              m_sourceHash = 0;
+        Hash::Hash128                       m_compilationCacheKey; // Only valid if this request can be served from/stored in the compilation cache
         FileSystem::Path                    m_sourceFile;
         FileSystem::Path                    m_destinationFile;
         String                              m_compilerArgs;
@@ -87,5 +89,6 @@ namespace KRG::Resource
         String                              m_log;
         Status                              m_status = Status::Pending;
         bool                                m_isHotReloadRequest = false;
+        bool                                m_wasRetrievedFromCompilationCache = false;
     };
 }
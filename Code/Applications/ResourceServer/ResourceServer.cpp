@@ -17,10 +17,11 @@ namespace KRG::Resource
         m_maxSimultaneousCompilationTasks = Threading::GetProcessorInfo().m_numPhysicalCores;
     }
 
-    bool ResourceServer::Initialize( Settings const& settings )
+    bool ResourceServer::Initialize( Settings const& settings, bool isBatchMode )
     {
         KRG_ASSERT( m_pSettings == nullptr );
         m_pSettings = &settings;
+        m_isBatchMode = isBatchMode;
 
         // Connect to compiled resource database
         //-------------------------------------------------------------------------
@@ -31,6 +32,27 @@ namespace KRG::Resource
             return false;
         }
 
+        TVector<SourceFileHashRecord> sourceFileHashes;
+        if ( m_compiledResourceDatabase.GetAllSourceFileHashes( sourceFileHashes ) )
+        {
+            for ( auto& sourceFileHash : sourceFileHashes )
+            {
+                m_sourceFileHashCache.insert( eastl::make_pair( sourceFileHash.m_filePath, sourceFileHash ) );
+            }
+        }
+
+        // Compilation cache
+        //-------------------------------------------------------------------------
+
+        if ( settings.m_compilationCachePath.IsValid() )
+        {
+            // The server can still operate without the cache so this isnt a fatal error
+            if ( !m_compilationCache.Initialize( settings.m_compilationCachePath, settings.m_compilationCacheMaxSize ) )
+            {
+                KRG_LOG_WARNING( "Resource", "Failed to initialize compilation cache (%s), compilation cache disabled!", settings.m_compilationCachePath.c_str() );
+            }
+        }
+
         // Register compilers
         //-------------------------------------------------------------------------
 
@@ -39,24 +61,25 @@ namespace KRG::Resource
         m_physicsModule.RegisterCompilers( m_compilerRegistry );
         m_entityModule.RegisterCompilers( m_compilerRegistry );
 
-        // Open network connection
+        // Open network connection and start watching for file changes
         //-------------------------------------------------------------------------
 
-        if ( !Network::NetworkSystem::Initialize() )
-        {
-            return false;
-        }
-
-        if ( !Network::NetworkSystem::StartServerConnection( &m_networkServer, settings.m_resourceServerPort ) )
+        if ( !m_isBatchMode )
         {
-            return false;
-        }
+            if ( !Network::NetworkSystem::Initialize() )
+            {
+                return false;
+            }
 
-        //-------------------------------------------------------------------------
+            if ( !Network::NetworkSystem::StartServerConnection( &m_networkServer, settings.m_resourceServerPort ) )
+            {
+                return false;
+            }
 
-        if ( m_fileSystemWatcher.StartWatching( m_pSettings->m_rawResourcePath ) )
-        {
-            m_fileSystemWatcher.RegisterChangeListener( this );
+            if ( m_fileSystemWatcher.StartWatching( m_pSettings->m_rawResourcePath ) )
+            {
+                m_fileSystemWatcher.RegisterChangeListener( this );
+            }
         }
 
         // Create Workers
@@ -66,7 +89,7 @@ namespace KRG::Resource
 
         for ( auto i = 0u; i < m_maxSimultaneousCompilationTasks; i++ )
         {
-            m_workers.emplace_back( KRG::New<ResourceServerWorker>( &m_taskSystem, m_pSettings->m_resourceCompilerExecutablePath.c_str() ) );
+            m_workers.emplace_back( KRG::New<ResourceServerWorker>( &m_taskSystem, m_pSettings->m_resourceCompilerExecutablePath.c_str(), m_compilationCache.IsEnabled() ? &m_compilationCache : nullptr ) );
         }
 
         return true;
@@ -111,6 +134,12 @@ namespace KRG::Resource
         }
 
         CleanupCompletedRequests();
+        m_sourceFileHashCache.clear();
+
+        if ( m_compilationCache.IsEnabled() )
+        {
+            m_compilationCache.Shutdown();
+        }
 
         // Unregister compilers
         //-------------------------------------------------------------------------
@@ -122,12 +151,16 @@ namespace KRG::Resource
 
         //-------------------------------------------------------------------------
 
-        Network::NetworkSystem::StopServerConnection( &m_networkServer );
-        Network::NetworkSystem::Shutdown();
+        if ( !m_isBatchMode )
+        {
+            Network::NetworkSystem::StopServerConnection( &m_networkServer );
+            Network::NetworkSystem::Shutdown();
+        }
 
         //-------------------------------------------------------------------------
 
         m_pSettings = nullptr;
+        m_isBatchMode = false;
     }
 
     //-------------------------------------------------------------------------
@@ -137,7 +170,10 @@ namespace KRG::Resource
         // Update network server
         //-------------------------------------------------------------------------
 
-        Network::NetworkSystem::Update();
+        if ( !m_isBatchMode )
+        {
+            Network::NetworkSystem::Update();
+        }
 
         if ( m_networkServer.IsRunning() )
         {
@@ -263,7 +299,7 @@ namespace KRG::Resource
 
     //-------------------------------------------------------------------------
 
-    void ResourceServer::ProcessResourceRequest( ResourceID const& resourceID, uint32 clientID, bool forceRecompile )
+    CompilationRequest const* ResourceServer::ProcessResourceRequest( ResourceID const& resourceID, uint32 clientID, bool forceRecompile )
     {
         KRG_ASSERT( m_compiledResourceDatabase.IsConnected() );
 
@@ -343,9 +379,9 @@ namespace KRG::Resource
                 }
 
                 // Run Up-to-date check
-                if ( pRequest->m_status != CompilationRequest::Status::Failed && !forceRecompile )
+                if ( pRequest->m_status != CompilationRequest::Status::Failed )
                 {
-                    PerformResourceUpToDateCheck( pRequest, compileDependencies );
+                    PerformResourceUpToDateCheck( pRequest, compileDependencies, forceRecompile );
                 }
             }
         }
@@ -368,10 +404,21 @@ namespace KRG::Resource
             KRG_ASSERT( pRequest->IsComplete() );
             NotifyClientOnCompletedRequest( pRequest );
         }
+
+        return pRequest;
     }
 
     void ResourceServer::NotifyClientOnCompletedRequest( CompilationRequest* pRequest )
     {
+        m_requestCompletedEvent.Execute( pRequest );
+
+        //-------------------------------------------------------------------------
+
+        if ( m_isBatchMode )
+        {
+            return;
+        }
+
         NetworkResourceResponse response;
         response.m_resourceID = pRequest->GetResourceID();
         if ( pRequest->HasSucceeded() )
@@ -407,7 +454,7 @@ namespace KRG::Resource
 
     //-------------------------------------------------------------------------
 
-    void ResourceServer::PerformResourceUpToDateCheck( CompilationRequest* pRequest, TVector<ResourcePath> const& compileDependencies ) const
+    void ResourceServer::PerformResourceUpToDateCheck( CompilationRequest* pRequest, TVector<ResourcePath> const& compileDependencies, bool forceRecompile )
     {
         KRG_ASSERT( pRequest != nullptr && pRequest->IsPending() );
 
@@ -419,37 +466,27 @@ namespace KRG::Resource
         pRequest->m_compilerVersion = m_compilerRegistry.GetVersionForType( pRequest->m_resourceID.GetResourceTypeID() );
         KRG_ASSERT( pRequest->m_compilerVersion >= 0 );
 
-        pRequest->m_fileTimestamp = FileSystem::GetFileModifiedTime( pRequest->m_sourceFile );
-
-        bool areCompileDependenciesAreUpToDate = true;
-        for ( auto const& compileDep : compileDependencies )
-        {
-            KRG_ASSERT( compileDep.IsValid() );
+        bool isResourceUpToDate = CalculateSourceHash( pRequest->m_sourceFile, compileDependencies, pRequest->m_sourceHash ) && !forceRecompile;
 
-            ResourceTypeID const extension( compileDep.GetExtension() );
-            if ( IsCompileableResourceType( extension ) && !IsResourceUpToDate( ResourceID( compileDep ) ) )
-            {
-                areCompileDependenciesAreUpToDate = false;
-                break;
-            }
+        // Check compile dependency state
+        //-------------------------------------------------------------------------
 
-            auto const compileDependencyPath = ResourcePath::ToFileSystemPath( m_pSettings->m_rawResourcePath, compileDep );
-            if ( !FileSystem::Exists( compileDependencyPath ) )
+        if ( isResourceUpToDate )
+        {
+            for ( auto const& compileDep : compileDependencies )
             {
-                areCompileDependenciesAreUpToDate = false;
-                break;
+                ResourceTypeID const extension( compileDep.GetExtension() );
+                if ( IsCompileableResourceType( extension ) && !IsResourceUpToDate( ResourceID( compileDep ) ) )
+                {
+                    isResourceUpToDate = false;
+                    break;
+                }
             }
-
-            pRequest->m_sourceTimestampHash += FileSystem::GetFileModifiedTime( compileDependencyPath );
         }
 
-        // Check source file for changes
+        // Check against previous compilation result
         //-------------------------------------------------------------------------
 
-        // Check compile dependency state
-        bool isResourceUpToDate = areCompileDependenciesAreUpToDate;
-
-        // Check against previous compilation result
         if ( isResourceUpToDate )
         {
             auto existingRecord = m_compiledResourceDatabase.GetRecord( pRequest->m_resourceID );
@@ -460,12 +497,7 @@ namespace KRG::Resource
                     isResourceUpToDate = false;
                 }
 
-                if ( pRequest->m_fileTimestamp != existingRecord.m_fileTimestamp )
-                {
-                    isResourceUpToDate = false;
-                }
-
-                if ( pRequest->m_sourceTimestampHash != existingRecord.m_sourceTimestampHash )
+                if ( pRequest->m_sourceHash != existingRecord.m_sourceHash )
                 {
                     isResourceUpToDate = false;
                 }
@@ -489,6 +521,13 @@ namespace KRG::Resource
             pRequest->m_log.sprintf( "Resource up to date! (%s)", pRequest->m_sourceFile.GetFullPath().c_str() );
             pRequest->m_status = CompilationRequest::Status::Succeeded;
         }
+        else // Resources that need compilation will first be looked up in the compilation cache by the worker, forced recompiles always skip the cache
+        {
+            if ( !forceRecompile && m_compilationCache.IsEnabled() && pRequest->m_sourceHash != 0 && CanUseCompilationCache( pRequest->m_resourceID.GetResourceTypeID() ) )
+            {
+                pRequest->m_compilationCacheKey = CompilationCache::CalculateKey( pRequest );
+            }
+        }
 
         //-------------------------------------------------------------------------
 
@@ -537,7 +576,7 @@ namespace KRG::Resource
         return true;
     }
 
-    bool ResourceServer::IsResourceUpToDate( ResourceID const& resourceID ) const
+    bool ResourceServer::IsResourceUpToDate( ResourceID const& resourceID )
     {
         // Check that the target file exists
         //-------------------------------------------------------------------------
@@ -559,9 +598,6 @@ namespace KRG::Resource
             return false;
         }
 
-        uint64 const fileTimestamp = FileSystem::GetFileModifiedTime( sourceFilePath );
-        uint64 sourceTimestampHash = 0;
-
         TVector<ResourcePath> compileDependencies;
         if ( !TryReadCompileDependencies( sourceFilePath, compileDependencies ) )
         {
@@ -570,8 +606,6 @@ namespace KRG::Resource
 
         for ( auto const& compileDep : compileDependencies )
         {
-            sourceTimestampHash += FileSystem::GetFileModifiedTime( ResourcePath::ToFileSystemPath( m_pSettings->m_rawResourcePath, compileDep ) );
-
             ResourceTypeID const extension( compileDep.GetExtension() );
             if ( IsCompileableResourceType( extension ) && !IsResourceUpToDate( ResourceID( compileDep ) ) )
             {
@@ -579,6 +613,12 @@ namespace KRG::Resource
             }
         }
 
+        uint64 sourceHash = 0;
+        if ( !CalculateSourceHash( sourceFilePath, compileDependencies, sourceHash ) )
+        {
+            return false;
+        }
+
         // Check source file for changes
         //-------------------------------------------------------------------------
 
@@ -591,12 +631,7 @@ namespace KRG::Resource
                 return false;
             }
 
-            if ( fileTimestamp != existingRecord.m_fileTimestamp )
-            {
-                return false;
-            }
-
-            if ( sourceTimestampHash != existingRecord.m_sourceTimestampHash )
+            if ( sourceHash != existingRecord.m_sourceHash )
             {
                 return false;
             }
@@ -614,8 +649,7 @@ namespace KRG::Resource
         CompiledResourceRecord record;
         record.m_resourceID = pRequest->m_resourceID;
         record.m_compilerVersion = pRequest->m_compilerVersion;
-        record.m_fileTimestamp = pRequest->m_fileTimestamp;
-        record.m_sourceTimestampHash = pRequest->m_sourceTimestampHash;
+        record.m_sourceHash = pRequest->m_sourceHash;
         m_compiledResourceDatabase.WriteRecord( record );
     }
 
@@ -623,4 +657,79 @@ namespace KRG::Resource
     {
         return ( ID.IsValid() && m_compilerRegistry.HasCompilerForResourceType( ID ) );
     }
+
+    bool ResourceServer::CanUseCompilationCache( ResourceTypeID ID ) const
+    {
+        auto pCompiler = m_compilerRegistry.GetCompilerForResourceType( ID );
+        return pCompiler != nullptr && pCompiler->GetVirtualTypes().empty();
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool ResourceServer::GetSourceFileHash( FileSystem::Path const& filePath, Hash::Hash128& outHash )
+    {
+        KRG_ASSERT( filePath.IsFile() );
+
+        // The size and modification time are a cheap invalidation key, we only re-hash the file content when either of them changes
+        // Since the resulting hash is content based, touching a file or switching branches will not cause the resource to recompile
+        uint64 const fileSize = FileSystem::GetFileSize( filePath );
+        uint64 const modifiedTime = FileSystem::GetFileModifiedTime( filePath );
+
+        auto const iter = m_sourceFileHashCache.find( filePath.GetFullPath() );
+        if ( iter != m_sourceFileHashCache.end() && iter->second.m_fileSize == fileSize && iter->second.m_modifiedTime == modifiedTime )
+        {
+            outHash = iter->second.m_hash;
+            return true;
+        }
+
+        //-------------------------------------------------------------------------
+
+        SourceFileHashRecord record;
+        record.m_filePath = filePath.GetFullPath();
+        record.m_fileSize = fileSize;
+        record.m_modifiedTime = modifiedTime;
+
+        if ( !FileSystem::GetFileContentHash( filePath, record.m_hash ) )
+        {
+            return false;
+        }
+
+        m_compiledResourceDatabase.WriteSourceFileHash( record );
+        m_sourceFileHashCache[record.m_filePath] = record;
+
+        outHash = record.m_hash;
+        return true;
+    }
+
+    bool ResourceServer::CalculateSourceHash( FileSystem::Path const& resourceFilePath, TVector<ResourcePath> const& compileDependencies, uint64& outSourceHash )
+    {
+        Hash::StreamingHasher hasher;
+        Hash::Hash128 fileHash;
+
+        if ( !GetSourceFileHash( resourceFilePath, fileHash ) )
+        {
+            return false;
+        }
+
+        hasher.Update( &fileHash, sizeof( Hash::Hash128 ) );
+
+        // The dependency paths are included so that swapping dependencies with identical contents is still detected
+        for ( auto const& compileDep : compileDependencies )
+        {
+            KRG_ASSERT( compileDep.IsValid() );
+
+            auto const compileDependencyPath = ResourcePath::ToFileSystemPath( m_pSettings->m_rawResourcePath, compileDep );
+            if ( !FileSystem::Exists( compileDependencyPath ) || !GetSourceFileHash( compileDependencyPath, fileHash ) )
+            {
+                return false;
+            }
+
+            String const& dependencyPathString = compileDep.GetString();
+            hasher.Update( dependencyPathString.c_str(), dependencyPathString.length() );
+            hasher.Update( &fileHash, sizeof( Hash::Hash128 ) );
+        }
+
+        outSourceHash = hasher.GetHash64();
+        return true;
+    }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "ResourceServerWorker.h"
 #include "ResourceCompilationRequest.h"
 #include "CompiledResourceDatabase.h"
+#include "CompilationCache.h"
 #include "Tools/Core/FileSystem/FileSystemWatcher.h"
 #include "Tools/Core/Resource/Compilers/ResourceCompilerRegistry.h"
 #include "Tools/Animation/_Module/Module.h"
@@ -13,12 +14,14 @@
 #include "System/Resource/ResourceSettings.h"
 #include "System/Core/Settings/SettingsRegistry.h"
 #include "System/Core/Threading/TaskSystem.h"
+#include "System/Core/Types/Event.h"
 
 //-------------------------------------------------------------------------
 // The network resource server
 //-------------------------------------------------------------------------
 // Receives resource requests, triggers the compilation of said requests and returns the results
 // Runs in a separate thread from the main UI
+// In batch mode, the server doesnt accept network connections or watch the file system, it is only used to drive batch compilations
 //-------------------------------------------------------------------------
 
 namespace KRG::Resource
@@ -30,7 +33,7 @@ namespace KRG::Resource
 
         ResourceServer();
 
-        bool Initialize( Settings const& settings );
+        bool Initialize( Settings const& settings, bool isBatchMode = false );
         void Shutdown();
         void Update();
 
@@ -45,6 +48,14 @@ namespace KRG::Resource
         // Compilers and Compilation
         inline CompilerRegistry const* GetCompilerRegistry() const { return &m_compilerRegistry; }
         inline void RecompileResource( ResourceID const& resourceID ) { ProcessResourceRequest( resourceID, 0, true ); }
+        inline CompilationRequest const* RequestCompilation( ResourceID const& resourceID ) { return ProcessResourceRequest( resourceID ); }
+        bool TryReadCompileDependencies( FileSystem::Path const& resourceFilePath, TVector<ResourcePath>& outDependencies, String* pErrorLog = nullptr ) const;
+        bool IsCompileableResourceType( ResourceTypeID ID ) const;
+
+        // Compilation Cache
+        inline bool IsCompilationCacheEnabled() const { return m_compilationCache.IsEnabled(); }
+        inline FileSystem::Path const& GetCompilationCachePath() const { return m_compilationCache.GetCacheDirectoryPath(); }
+        inline CompilationCache::Stats GetCompilationCacheStats() const { return m_compilationCache.GetStats(); }
 
         // Requests
         TVector<CompilationRequest const*> const& GetActiveRequests() const { return ( TVector<CompilationRequest const*>& ) m_activeRequests; }
@@ -52,6 +63,9 @@ namespace KRG::Resource
         TVector<CompilationRequest const*> const& GetCompletedRequests() const { return ( TVector<CompilationRequest const*>& ) m_completedRequests; }
         inline void RequestCleanupOfCompletedRequests() { m_cleanupRequested = true; }
 
+        // Event fired on the main thread once a request has completed and its result has been accepted by the server
+        inline TEventHandle<CompilationRequest const*> OnRequestCompleted() { return m_requestCompletedEvent; }
+
         // Workers
         inline int32 GetNumWorkers() const { return (int32) m_workers.size(); }
         inline ResourceServerWorker::Status GetWorkerStatus( int32 workerIdx ) const { return m_workers[workerIdx]->GetStatus(); }
@@ -67,15 +81,24 @@ namespace KRG::Resource
         void CleanupCompletedRequests();
 
         // Request Actions
-        void ProcessResourceRequest( ResourceID const& resourceID, uint32 clientID = 0, bool forceRecompile = false );
+        CompilationRequest const* ProcessResourceRequest( ResourceID const& resourceID, uint32 clientID = 0, bool forceRecompile = false );
         void NotifyClientOnCompletedRequest( CompilationRequest* pRequest );
 
         // Up-to-date system
-        void PerformResourceUpToDateCheck( CompilationRequest* pRequest, TVector<ResourcePath> const& compileDependencies ) const;
-        bool TryReadCompileDependencies( FileSystem::Path const& resourceFilePath, TVector<ResourcePath>& outDependencies, String* pErrorLog = nullptr ) const;
-        bool IsResourceUpToDate( ResourceID const& resourceID ) const;
+        // Resources are only recompiled if the compiler version or the content of the resource file or any of its compile dependencies changes
+        // Forced recompiles skip the check, but still need the up-to-date info since its written to the database once the compilation completes
+        void PerformResourceUpToDateCheck( CompilationRequest* pRequest, TVector<ResourcePath> const& compileDependencies, bool forceRecompile = false );
+        bool IsResourceUpToDate( ResourceID const& resourceID );
         void WriteCompiledResourceRecord( CompilationRequest* pRequest );
-        bool IsCompileableResourceType( ResourceTypeID ID ) const;
+
+        // Compilers that produce additional output files (i.e. virtual resource types) cannot use the compilation cache since we only cache a single file
+        bool CanUseCompilationCache( ResourceTypeID ID ) const;
+
+        // Get the content hash for a source file, hashes are cached per path and only recalculated when the file size or modification time changes
+        bool GetSourceFileHash( FileSystem::Path const& filePath, Hash::Hash128& outHash );
+
+        // Calculate the combined content hash of a resource file and all its compile dependencies, fails if any of the files are missing
+        bool CalculateSourceHash( FileSystem::Path const& resourceFilePath, TVector<ResourcePath> const& compileDependencies, uint64& outSourceHash );
 
         // File system listener
         virtual void OnFileModified( FileSystem::Path const& filePath ) override final;
@@ -84,6 +107,7 @@ namespace KRG::Resource
 
         String                                  m_errorMessage;
         bool                                    m_cleanupRequested = false;
+        bool                                    m_isBatchMode = false;
         Network::IPC::Server                    m_networkServer;
 
         // Settings
@@ -99,9 +123,12 @@ namespace KRG::Resource
 
         // Compilation Requests
         CompiledResourceDatabase                m_compiledResourceDatabase;
+        THashMap<String, SourceFileHashRecord>  m_sourceFileHashCache;
+        CompilationCache                        m_compilationCache;
         TVector<CompilationRequest*>            m_completedRequests;
         TVector<CompilationRequest*>            m_pendingRequests;
         TVector<CompilationRequest*>            m_activeRequests;
+        TEvent<CompilationRequest const*>       m_requestCompletedEvent;
 
         // Workers
         TaskSystem                              m_taskSystem;
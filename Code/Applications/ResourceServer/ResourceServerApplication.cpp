@@ -1,5 +1,7 @@
 #include "ResourceServerApplication.h"
+#include "ResourceBatchCompiler.h"
 #include "Resources/Resource.h"
+#include "Applications/Shared/cmdParser/krg_cmdparser.h"
 #include "System/Render/RenderSettings.h"
 #include "System/Core/Logging/Log.h"
 #include "System/Core/Time/Timers.h"
@@ -335,10 +337,117 @@ namespace KRG
     }
 }
 
+//-------------------------------------------------------------------------
+// Batch Compilation
+//-------------------------------------------------------------------------
+// Headless compilation of a comma separated list of root resources and/or resource directories, as well as everything they reference
+// e.g. -batch data://Maps/TestMap.map,data://Characters/
+
+static int RunBatchCompilation( char const* pBatchArgument )
+{
+    using namespace KRG;
+
+    // We are a windows application so we need to attach to the calling console to be able to output anything
+    if ( AttachConsole( ATTACH_PARENT_PROCESS ) || AllocConsole() )
+    {
+        freopen( "CONOUT$", "w", stdout );
+        freopen( "CONOUT$", "w", stderr );
+    }
+
+    ApplicationGlobalState globalState;
+
+    // Read settings
+    //-------------------------------------------------------------------------
+
+    Resource::Settings settings;
+    SettingsRegistry settingsRegistry;
+    settingsRegistry.RegisterSettings( &settings );
+
+    FileSystem::Path const iniPath = FileSystem::GetCurrentProcessPath().Append( "KRG.ini" );
+    if ( !settingsRegistry.LoadFromFile( iniPath ) )
+    {
+        printf( "Failed to read required settings from INI file: %s\n", iniPath.c_str() );
+        return 1;
+    }
+
+    // Start the server in batch mode, this doesnt open any network connections
+    //-------------------------------------------------------------------------
+
+    Resource::ResourceServer resourceServer;
+    if ( !resourceServer.Initialize( settings, true ) )
+    {
+        printf( "Resource server failed to initialize: %s\n", resourceServer.GetErrorMessage().c_str() );
+        resourceServer.Shutdown();
+        return 1;
+    }
+
+    // Add roots and compile
+    //-------------------------------------------------------------------------
+
+    Resource::ResourceBatchCompiler batchCompiler( resourceServer );
+
+    bool wasSuccessful = true;
+    TVector<String> rootPaths;
+    StringUtils::Split( StringUtils::StripWhitespace( pBatchArgument ), rootPaths, "," );
+    for ( auto const& rootPath : rootPaths )
+    {
+        ResourcePath const resourcePath( rootPath );
+        if ( !resourcePath.IsValid() )
+        {
+            printf( "Invalid batch compilation root: %s\n", rootPath.c_str() );
+            wasSuccessful = false;
+        }
+        else if ( resourcePath.IsDirectory() )
+        {
+            wasSuccessful &= batchCompiler.AddRootDirectory( resourcePath );
+        }
+        else
+        {
+            batchCompiler.AddRootResource( ResourceID( resourcePath ) );
+        }
+    }
+
+    if ( wasSuccessful )
+    {
+        wasSuccessful = batchCompiler.Compile();
+        batchCompiler.PrintSummary();
+    }
+
+    // Wait for any outstanding requests to be accepted before shutting down the workers
+    //-------------------------------------------------------------------------
+
+    while ( resourceServer.IsBusy() )
+    {
+        resourceServer.Update();
+        Threading::Sleep( 1 );
+    }
+
+    resourceServer.Shutdown();
+    return wasSuccessful ? 0 : 1;
+}
+
 //-------------------------------------------------------------------------
 
 int APIENTRY _tWinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdLine, int nCmdShow )
 {
+    // Batch compilation runs headless and can run alongside the interactive server
+    //-------------------------------------------------------------------------
+
+    {
+        cli::Parser cmdParser( __argc, __argv );
+        cmdParser.set_optional<std::string>( "batch", "batch", "", "Batch compile a comma separated list of resources and/or resource directories, as well as all their dependencies." );
+        if ( cmdParser.run() )
+        {
+            std::string const batchArgument = cmdParser.get<std::string>( "batch" );
+            if ( !batchArgument.empty() )
+            {
+                return RunBatchCompilation( batchArgument.c_str() );
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     HANDLE pSingletonMutex = CreateMutex( NULL, TRUE, "Kruger Resource Server" );
     if ( GetLastError() == ERROR_ALREADY_EXISTS )
     {
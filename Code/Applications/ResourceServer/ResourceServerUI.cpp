@@ -156,8 +156,16 @@ namespace KRG::Resource
 
                             case CompilationRequest::Status::Succeeded:
                             {
-                                itemColor = Colors::Lime.ToFloat4();
-                                ImGui::TextColored( itemColor, KRG_ICON_CHECK );
+                                if ( pRequest->WasRetrievedFromCompilationCache() )
+                                {
+                                    itemColor = Colors::LightSkyBlue.ToFloat4();
+                                    ImGui::TextColored( itemColor, KRG_ICON_DATABASE );
+                                }
+                                else
+                                {
+                                    itemColor = Colors::Lime.ToFloat4();
+                                    ImGui::TextColored( itemColor, KRG_ICON_CHECK );
+                                }
                             }
                             break;
 
@@ -343,6 +351,28 @@ namespace KRG::Resource
 
             //-------------------------------------------------------------------------
 
+            if ( m_pResourceServer->IsCompilationCacheEnabled() )
+            {
+                auto const cacheStats = m_pResourceServer->GetCompilationCacheStats();
+                uint32 const numLookups = cacheStats.m_numHits + cacheStats.m_numMisses;
+                float const hitRate = ( numLookups > 0 ) ? float( cacheStats.m_numHits ) / numLookups * 100.0f : 0.0f;
+                float const sizeInMB = float( cacheStats.m_currentSize ) / ( 1024 * 1024 );
+                float const maxSizeInMB = float( cacheStats.m_maxSize ) / ( 1024 * 1024 );
+
+                ImGui::Text( "Compilation Cache Path: %s", m_pResourceServer->GetCompilationCachePath().c_str() );
+                ImGui::Text( "Compilation Cache Size: %.2fMB / %.2fMB (%u entries)", sizeInMB, maxSizeInMB, cacheStats.m_numEntries );
+                ImGui::Text( "Compilation Cache Hits: %u, Misses: %u, Hit Rate: %.1f%%", cacheStats.m_numHits, cacheStats.m_numMisses, hitRate );
+                ImGui::Text( "Compilation Cache Stores: %u, Evictions: %u", cacheStats.m_numStores, cacheStats.m_numEvictions );
+            }
+            else
+            {
+                ImGui::TextColored( ImGuiX::ConvertColor( Colors::Yellow ), "Compilation Cache: Disabled" );
+            }
+
+            ImGui::NewLine();
+
+            //-------------------------------------------------------------------------
+
             if ( ImGui::BeginTable( "Registered Compilers Table", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg ) )
             {
                 ImGui::TableSetupColumn( "Name", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 150 );
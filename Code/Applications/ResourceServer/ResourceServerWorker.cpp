@@ -1,12 +1,15 @@
 #include "ResourceServerWorker.h"
+#include "CompilationCache.h"
+#include "Tools/Core/Resource/Compilers/ResourceCompiler.h"
 
 //-------------------------------------------------------------------------
 
 namespace KRG::Resource
 {
-    ResourceServerWorker::ResourceServerWorker( TaskSystem* pTaskSystem, String const& workerFullPath )
+    ResourceServerWorker::ResourceServerWorker( TaskSystem* pTaskSystem, String const& workerFullPath, CompilationCache* pCompilationCache )
         : m_pTaskSystem( pTaskSystem )
         , m_workerFullPath( workerFullPath )
+        , m_pCompilationCache( pCompilationCache )
     {
         KRG_ASSERT( pTaskSystem != nullptr && !m_workerFullPath.empty() );
         m_SetSize = 1;
@@ -14,7 +17,8 @@ namespace KRG::Resource
 
     ResourceServerWorker::~ResourceServerWorker()
     {
-        KRG_ASSERT( !subprocess_alive( &m_subProcess ) );
+        KRG_ASSERT( !IsCompiling() );
+        StopCompilerProcess();
     }
 
     void ResourceServerWorker::Compile( CompilationRequest* pRequest )
@@ -27,81 +31,175 @@ namespace KRG::Resource
         m_pTaskSystem->ScheduleTask( this );
     }
 
-    void ResourceServerWorker::ExecuteRange( TaskSetPartition range, uint32 threadnum )
+    //-------------------------------------------------------------------------
+
+    bool ResourceServerWorker::StartCompilerProcess()
     {
-        KRG_ASSERT( IsCompiling() );
-        KRG_ASSERT( !m_pRequest->m_compilerArgs.empty() );
-        char const* processCommandLineArgs[4] = { m_workerFullPath.c_str(), "-compile", m_pRequest->m_compilerArgs.c_str(), nullptr };
+        KRG_ASSERT( !m_isCompilerProcessRunning );
 
-        // Start compiler process
-        //-------------------------------------------------------------------------
+        char const* processCommandLineArgs[3] = { m_workerFullPath.c_str(), "-worker", nullptr };
+        int32 const result = subprocess_create( processCommandLineArgs, subprocess_option_combined_stdout_stderr | subprocess_option_inherit_environment | subprocess_option_no_window, &m_subProcess );
+        if ( result != 0 )
+        {
+            return false;
+        }
 
-        m_pRequest->m_compilationTimeStarted = PlatformClock::GetTime();
+        m_isCompilerProcessRunning = true;
+        m_numJobsExecutedByProcess = 0;
+        return true;
+    }
 
-        int32 result = subprocess_create( processCommandLineArgs, subprocess_option_combined_stdout_stderr | subprocess_option_inherit_environment | subprocess_option_no_window, &m_subProcess );
-        if ( result != 0 )
+    void ResourceServerWorker::StopCompilerProcess( bool forceTermination )
+    {
+        if ( !m_isCompilerProcessRunning )
         {
-            m_pRequest->m_status = CompilationRequest::Status::Failed;
-            m_pRequest->m_log = "Resource compiler failed to start!";
-            m_pRequest->m_compilationTimeFinished = PlatformClock::GetTime();
-            m_status = Status::Complete;
             return;
         }
 
-        // Wait for compilation to complete
-        //-------------------------------------------------------------------------
+        // Joining closes the input pipe which tells the compiler process to exit, dead processes need to be terminated
+        if ( forceTermination )
+        {
+            subprocess_terminate( &m_subProcess );
+        }
 
         int32 exitCode;
-        result = subprocess_join( &m_subProcess, &exitCode );
-        if ( result != 0 )
+        subprocess_join( &m_subProcess, &exitCode );
+        subprocess_destroy( &m_subProcess );
+        m_isCompilerProcessRunning = false;
+    }
+
+    bool ResourceServerWorker::TryExecuteCompilation( int32& outResult )
+    {
+        KRG_ASSERT( m_isCompilerProcessRunning );
+
+        // Send job
+        //-------------------------------------------------------------------------
+
+        FILE* pInputPipe = subprocess_stdin( &m_subProcess );
+        if ( fprintf( pInputPipe, "%s\n", m_pRequest->m_compilerArgs.c_str() ) < 0 || fflush( pInputPipe ) != 0 )
         {
-            m_pRequest->m_status = CompilationRequest::Status::Failed;
-            m_pRequest->m_log = "Resource compiler failed to complete!";
+            return false;
+        }
+
+        // Read the output of the compiler until we receive the result
+        //-------------------------------------------------------------------------
+
+        size_t const resultPrefixLength = strlen( CompilerWorker::s_resultPrefix );
+        FILE* pOutputPipe = subprocess_stdout( &m_subProcess );
+
+        char readBuffer[512];
+        bool isStartOfLine = true;
+        while ( fgets( readBuffer, 512, pOutputPipe ) )
+        {
+            if ( isStartOfLine && strncmp( readBuffer, CompilerWorker::s_resultPrefix, resultPrefixLength ) == 0 )
+            {
+                outResult = atoi( readBuffer + resultPrefixLength );
+                m_numJobsExecutedByProcess++;
+                return true;
+            }
+
+            m_pRequest->m_log += readBuffer;
+
+            // Long lines are read in multiple chunks
+            size_t const readLength = strlen( readBuffer );
+            isStartOfLine = ( readLength > 0 && readBuffer[readLength - 1] == '\n' );
+        }
+
+        // The pipe was closed before we received a result, so the compiler process died
+        return false;
+    }
+
+    void ResourceServerWorker::ExecuteRange( TaskSetPartition range, uint32 threadnum )
+    {
+        KRG_ASSERT( IsCompiling() );
+        KRG_ASSERT( !m_pRequest->m_compilerArgs.empty() );
+
+        m_pRequest->m_compilationTimeStarted = PlatformClock::GetTime();
+
+        // Check the compilation cache
+        //-------------------------------------------------------------------------
+
+        bool const isCacheable = m_pCompilationCache != nullptr && m_pRequest->m_compilationCacheKey.IsValid();
+        if ( isCacheable && m_pCompilationCache->TryRetrieve( m_pRequest->m_compilationCacheKey, m_pRequest->m_destinationFile ) )
+        {
+            m_pRequest->m_log.sprintf( "Retrieved from compilation cache! (%s)", m_pRequest->m_sourceFile.GetFullPath().c_str() );
+            m_pRequest->m_wasRetrievedFromCompilationCache = true;
+            m_pRequest->m_status = CompilationRequest::Status::Succeeded;
             m_pRequest->m_compilationTimeFinished = PlatformClock::GetTime();
             m_status = Status::Complete;
-            subprocess_destroy( &m_subProcess );
             return;
         }
 
-        // Handle completed compilation
+        // Execute compilation, if the compiler process dies we restart it and retry the job once
         //-------------------------------------------------------------------------
 
-        m_pRequest->m_compilationTimeFinished = PlatformClock::GetTime();
+        int32 compilationResult = (int32) CompilationResult::Failure;
+        bool wasCompilationExecuted = false;
 
-        switch ( exitCode )
+        for ( int32 attempt = 0; attempt < 2 && !wasCompilationExecuted; attempt++ )
         {
-            case 0:
+            if ( !m_isCompilerProcessRunning && !StartCompilerProcess() )
             {
-                m_pRequest->m_status = CompilationRequest::Status::Succeeded;
+                m_pRequest->m_status = CompilationRequest::Status::Failed;
+                m_pRequest->m_log += "Resource compiler failed to start!";
+                m_pRequest->m_compilationTimeFinished = PlatformClock::GetTime();
+                m_status = Status::Complete;
+                return;
             }
-            break;
 
-            case 1:
+            wasCompilationExecuted = TryExecuteCompilation( compilationResult );
+            if ( !wasCompilationExecuted )
             {
-                m_pRequest->m_status = CompilationRequest::Status::SucceededWithWarnings;
+                m_pRequest->m_log += ( attempt == 0 ) ? "\nResource compiler process died, restarting and retrying compilation!\n" : "\nResource compiler process died again, giving up!\n";
+                StopCompilerProcess( true );
             }
-            break;
+        }
 
-            default:
-            {
-                m_pRequest->m_status = CompilationRequest::Status::Failed;
-            }
-            break;
+        // Recycle the compiler process once it has executed enough jobs
+        if ( m_numJobsExecutedByProcess >= s_maxJobsPerCompilerProcess )
+        {
+            StopCompilerProcess();
         }
 
-        // Read error and output of process
+        // Handle completed compilation
         //-------------------------------------------------------------------------
 
-        char readBuffer[512];
-        while ( fgets( readBuffer, 512, subprocess_stdout( &m_subProcess ) ) )
+        m_pRequest->m_compilationTimeFinished = PlatformClock::GetTime();
+
+        if ( !wasCompilationExecuted )
         {
-            m_pRequest->m_log += readBuffer;
+            m_pRequest->m_status = CompilationRequest::Status::Failed;
+        }
+        else
+        {
+            switch ( (CompilationResult) compilationResult )
+            {
+                case CompilationResult::Success:
+                {
+                    m_pRequest->m_status = CompilationRequest::Status::Succeeded;
+
+                    // Results with warnings are not cached so that the warnings keep getting reported
+                    if ( isCacheable )
+                    {
+                        m_pCompilationCache->Store( m_pRequest->m_compilationCacheKey, m_pRequest->m_destinationFile );
+                    }
+                }
+                break;
+
+                case CompilationResult::SuccessWithWarnings:
+                {
+                    m_pRequest->m_status = CompilationRequest::Status::SucceededWithWarnings;
+                }
+                break;
+
+                default:
+                {
+                    m_pRequest->m_status = CompilationRequest::Status::Failed;
+                }
+                break;
+            }
         }
 
         m_status = Status::Complete;
-
-        //-------------------------------------------------------------------------
-
-        subprocess_destroy( &m_subProcess );
     }
 }
\ No newline at end of file
@@ -7,11 +7,24 @@
 #include "System/Core/Threading/TaskSystem.h"
 
 //-------------------------------------------------------------------------
+// Resource Server Worker
+//-------------------------------------------------------------------------
+// Each worker owns a persistent resource compiler process (started in worker mode) and sends it compilation jobs over its stdin
+// This saves us from paying the process startup, type registration and module initialization costs for every resource
+// If the compiler process dies, it is restarted and the job is retried once
+// Requests with a compilation cache key are first looked up in the compilation cache, and successful compilations are stored in it
 
 namespace KRG::Resource
 {
+    class CompilationCache;
+
+    //-------------------------------------------------------------------------
+
     class ResourceServerWorker final : public ITaskSet
     {
+        // Compiler processes are periodically recycled so that any memory leaked by the compilers doesnt accumulate
+        constexpr static uint32 const s_maxJobsPerCompilerProcess = 500;
+
     public:
 
         enum class Status : uint8
@@ -23,7 +36,7 @@ namespace KRG::Resource
 
     public:
 
-        ResourceServerWorker( TaskSystem* pTaskSystem, String const& workerFullPath );
+        ResourceServerWorker( TaskSystem* pTaskSystem, String const& workerFullPath, CompilationCache* pCompilationCache = nullptr );
         ~ResourceServerWorker();
 
         // Worker Status
@@ -61,12 +74,22 @@ namespace KRG::Resource
 
         virtual void ExecuteRange( TaskSetPartition range, uint32 threadnum ) override final;
 
+        // Compiler process management
+        bool StartCompilerProcess();
+        void StopCompilerProcess( bool forceTermination = false );
+
+        // Send the current request to the compiler process and read back the result, returns false if the compiler process died
+        bool TryExecuteCompilation( int32& outResult );
+
     private:
 
         TaskSystem*                             m_pTaskSystem = nullptr;
         String const                            m_workerFullPath;
+        CompilationCache*                       m_pCompilationCache = nullptr;
         CompilationRequest*                     m_pRequest = nullptr;
         subprocess_s                            m_subProcess;
+        uint32                                  m_numJobsExecutedByProcess = 0;
+        bool                                    m_isCompilerProcessRunning = false;
         std::atomic<Status>                     m_status = Status::Idle;
     };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Application_Win32.h"
 #include "iniparser/krg_ini.h"
 #include "System/Core/Logging/Log.h"
+#include "System/Core/Profiling/Profiling.h"
 
 #include "../Platform/PlatformHelpers_Win32.h"
 
@@ -224,6 +225,12 @@ namespace KRG
 
     int Win32Application::Run( int32 argc, char** argv )
     {
+        // Log output
+        //-------------------------------------------------------------------------
+
+        FileSystem::Path const logFilePath( m_applicationNameNoWhitespace + "Log.txt" );
+        Log::SetOutputFile( logFilePath );
+
         // Read Settings
         //-------------------------------------------------------------------------
 
@@ -279,8 +286,12 @@ namespace KRG
         bool const shutdownResult = Shutdown();
         m_initialized = false;
 
-        FileSystem::Path const LogFilePath( m_applicationNameNoWhitespace + "Log.txt" );
-        Log::SaveToFile( LogFilePath );
+        #if KRG_DEVELOPMENT_TOOLS
+        FileSystem::Path const countersFilePath( m_applicationNameNoWhitespace + "Counters.csv" );
+        Profiling::ExportCountersToCSV( countersFilePath );
+        #endif
+
+        Log::Flush();
 
         //-------------------------------------------------------------------------
 
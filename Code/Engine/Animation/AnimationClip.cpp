@@ -26,7 +26,7 @@ namespace KRG::Animation
 
     //-------------------------------------------------------------------------
 
-    void AnimationClip::GetPose( FrameTime const& frameTime, Pose* pOutPose ) const
+    void AnimationClip::GetPose( FrameTime const& frameTime, Pose* pOutPose, AnimationClipCursor* pCursor ) const
     {
         KRG_ASSERT( IsValid() );
         KRG_ASSERT( pOutPose != nullptr && pOutPose->GetSkeleton() == m_pSkeleton.GetPtr() );
@@ -34,27 +34,36 @@ namespace KRG::Animation
 
         pOutPose->ClearGlobalTransforms();
 
+        auto const numBones = m_pSkeleton->GetNumBones();
+        if ( pCursor != nullptr && pCursor->m_pAnimation != this )
+        {
+            pCursor->m_pAnimation = this;
+            pCursor->m_trackCursors.clear();
+            pCursor->m_trackCursors.resize( numBones );
+        }
+
         //-------------------------------------------------------------------------
 
         Transform boneTransform;
-        uint16 const* pTrackData = m_compressedPoseData.data();
 
         // Read exact key frame
         if ( frameTime.IsExactlyAtKeyFrame() )
         {
-            auto const numBones = m_pSkeleton->GetNumBones();
             for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
             {
-                pTrackData = ReadCompressedTrackKeyFrame( pTrackData, m_trackCompressionSettings[boneIdx], frameTime.GetFrameIndex(), boneTransform );
+                TrackCompression::TrackCursor temporaryCursor;
+                auto& trackCursor = ( pCursor != nullptr ) ? pCursor->m_trackCursors[boneIdx] : temporaryCursor;
+                ReadCompressedTrackKeyFrame( boneIdx, frameTime.GetFrameIndex(), trackCursor, boneTransform );
                 pOutPose->SetTransform( boneIdx, boneTransform );
             }
         }
         else // Read interpolated anim pose
         {
-            auto const numBones = m_pSkeleton->GetNumBones();
             for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
             {
-                pTrackData = ReadCompressedTrackTransform( pTrackData, m_trackCompressionSettings[boneIdx], frameTime, boneTransform );
+                TrackCompression::TrackCursor temporaryCursor;
+                auto& trackCursor = ( pCursor != nullptr ) ? pCursor->m_trackCursors[boneIdx] : temporaryCursor;
+                ReadCompressedTrackTransform( boneIdx, frameTime, trackCursor, boneTransform );
                 pOutPose->SetTransform( boneIdx, boneTransform );
             }
         }
@@ -97,20 +106,16 @@ namespace KRG::Animation
 
         //-------------------------------------------------------------------------
 
-        auto const& trackSettings = m_trackCompressionSettings[boneIdx];
-        uint16 const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-
-        //-------------------------------------------------------------------------
-
         Transform boneLocalTransform;
+        TrackCompression::TrackCursor trackCursor;
 
         if ( frameTime.IsExactlyAtKeyFrame() )
         {
-            ReadCompressedTrackKeyFrame( pTrackData, trackSettings, frameIdx, boneLocalTransform );
+            ReadCompressedTrackKeyFrame( boneIdx, frameIdx, trackCursor, boneLocalTransform );
         }
         else
         {
-            ReadCompressedTrackTransform( pTrackData, trackSettings, frameTime, boneLocalTransform );
+            ReadCompressedTrackTransform( boneIdx, frameTime, trackCursor, boneLocalTransform );
         }
         return boneLocalTransform;
     }
@@ -139,24 +144,19 @@ namespace KRG::Animation
         //-------------------------------------------------------------------------
 
         Transform globalTransform;
+        TrackCompression::TrackCursor trackCursor;
 
         if ( frameTime.IsExactlyAtKeyFrame() )
         {
             // Read root transform
-            {
-                auto const& trackSettings = m_trackCompressionSettings[boneHierarchy.back()];
-                uint16 const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackKeyFrame( pTrackData, trackSettings, frameIdx, globalTransform );
-            }
+            ReadCompressedTrackKeyFrame( boneHierarchy.back(), frameIdx, trackCursor, globalTransform );
 
             // Read and multiply out all the transforms moving down the hierarchy
             Transform localTransform;
             for ( int32 i = (int32) boneHierarchy.size() - 2; i >= 0; i-- )
             {
-                int32 const trackIdx = boneHierarchy[i];
-                auto const& trackSettings = m_trackCompressionSettings[trackIdx];
-                uint16 const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackKeyFrame( pTrackData, trackSettings, frameIdx, localTransform );
+                trackCursor.Reset();
+                ReadCompressedTrackKeyFrame( boneHierarchy[i], frameIdx, trackCursor, localTransform );
 
                 globalTransform = localTransform * globalTransform;
             }
@@ -164,20 +164,14 @@ namespace KRG::Animation
         else // Interpolate key-frames
         {
             // Read root transform
-            {
-                auto const& trackSettings = m_trackCompressionSettings[boneHierarchy.back()];
-                uint16 const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackTransform( pTrackData, trackSettings, frameTime, globalTransform );
-            }
+            ReadCompressedTrackTransform( boneHierarchy.back(), frameTime, trackCursor, globalTransform );
 
             // Read and multiply out all the transforms moving down the hierarchy
             Transform localTransform;
             for ( int32 i = (int32) boneHierarchy.size() - 2; i >= 0; i-- )
             {
-                int32 const trackIdx = boneHierarchy[i];
-                auto const& trackSettings = m_trackCompressionSettings[trackIdx];
-                uint16 const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackTransform( pTrackData, trackSettings, frameTime, localTransform );
+                trackCursor.Reset();
+                ReadCompressedTrackTransform( boneHierarchy[i], frameTime, trackCursor, localTransform );
 
                 globalTransform = localTransform * globalTransform;
             }
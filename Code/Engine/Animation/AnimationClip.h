@@ -4,12 +4,12 @@
 #include "AnimationSyncTrack.h"
 #include "AnimationEvent.h"
 #include "AnimationFrameTime.h"
+#include "AnimationClipCompression.h"
 #include "System/Animation/AnimationSkeleton.h"
 #include "System/Resource/ResourcePtr.h"
 #include "System/Core/Math/NumericRange.h"
 #include "System/Core/Types/Percentage.h"
 #include "System/Core/Time/Time.h"
-#include "System/Core/Algorithm/Quantization.h"
 
 //-------------------------------------------------------------------------
 
@@ -17,60 +17,29 @@ namespace KRG::Animation
 {
     class Pose;
     class Event;
+    class AnimationClip;
 
     //-------------------------------------------------------------------------
 
-    struct QuantizationRange
+    // The decoding state for sampling a clip, each playback instance should have its own cursor
+    // Sampling sequentially through a cursor only decodes a track's segment once per segment and its keys once per key interval
+    class AnimationClipCursor
     {
-        KRG_SERIALIZE_MEMBERS( m_rangeStart, m_rangeLength );
-
-        QuantizationRange() = default;
-
-        QuantizationRange( float start, float length )
-            : m_rangeStart( start )
-            , m_rangeLength( length )
-        {}
-
-        inline bool IsValid() const { return m_rangeLength > 0; }
-
-    public:
-
-        float                                     m_rangeStart = 0;
-        float                                     m_rangeLength = -1;
-    };
-
-    //-------------------------------------------------------------------------
-
-    struct TrackCompressionSettings
-    {
-        KRG_SERIALIZE_MEMBERS( m_translationRangeX, m_translationRangeY, m_translationRangeZ, m_scaleRangeX, m_scaleRangeY, m_scaleRangeZ, m_trackStartIndex, m_isTranslationStatic, m_isScaleStatic );
-
-        friend class AnimationClipCompiler;
+        friend class AnimationClip;
 
     public:
 
-        TrackCompressionSettings() = default;
-
-        // Is the translation for this track static i.e. a fixed value for the duration of the animation
-        inline bool IsTranslationTrackStatic() const { return m_isTranslationStatic; }
-
-        // Is the scale for this track static i.e. a fixed value for the duration of the animation
-        inline bool IsScaleTrackStatic() const { return m_isScaleStatic; }
-
-    public:
-
-        QuantizationRange                       m_translationRangeX;
-        QuantizationRange                       m_translationRangeY;
-        QuantizationRange                       m_translationRangeZ;
-        QuantizationRange                       m_scaleRangeX;
-        QuantizationRange                       m_scaleRangeY;
-        QuantizationRange                       m_scaleRangeZ;
-        uint32                                  m_trackStartIndex = 0; // The start offset for this track in the compressed data block (in number of uint16s)
+        // The cursor is also reset automatically when it is used with a different clip
+        inline void Reset()
+        {
+            m_pAnimation = nullptr;
+            m_trackCursors.clear();
+        }
 
     private:
 
-        bool                                    m_isTranslationStatic = false;
-        bool                                    m_isScaleStatic = false;
+        AnimationClip const*                            m_pAnimation = nullptr;
+        TVector<TrackCompression::TrackCursor>          m_trackCursors;
     };
 
     //-------------------------------------------------------------------------
@@ -78,35 +47,11 @@ namespace KRG::Animation
     class KRG_ENGINE_ANIMATION_API AnimationClip : public Resource::IResource
     {
         KRG_REGISTER_RESOURCE( 'ANIM', "Animation Clip" );
-        KRG_SERIALIZE_MEMBERS( m_pSkeleton, m_numFrames, m_duration, m_compressedPoseData, m_trackCompressionSettings, m_rootMotionTrack, m_averageLinearVelocity, m_averageAngularVelocity, m_totalRootMotionDelta, m_isAdditive );
+        KRG_SERIALIZE_MEMBERS( m_pSkeleton, m_numFrames, m_duration, m_compressedPoseData, m_trackSegmentOffsets, m_trackCompressionSettings, m_rootMotionTrack, m_averageLinearVelocity, m_averageAngularVelocity, m_totalRootMotionDelta, m_isAdditive );
 
         friend class AnimationClipCompiler;
         friend class AnimationClipLoader;
 
-    private:
-
-        inline static Quaternion DecodeRotation( uint16 const* pData )
-        {
-            Quantization::EncodedQuaternion const encodedQuat( pData[0], pData[1], pData[2] );
-            return encodedQuat.ToQuaternion();
-        }
-
-        inline static Vector DecodeTranslation( uint16 const* pData, TrackCompressionSettings const& settings )
-        {
-            float const m_x = Quantization::DecodeFloat( pData[0], settings.m_translationRangeX.m_rangeStart, settings.m_translationRangeX.m_rangeLength );
-            float const m_y = Quantization::DecodeFloat( pData[1], settings.m_translationRangeY.m_rangeStart, settings.m_translationRangeY.m_rangeLength );
-            float const m_z = Quantization::DecodeFloat( pData[2], settings.m_translationRangeZ.m_rangeStart, settings.m_translationRangeZ.m_rangeLength );
-            return Vector( m_x, m_y, m_z );
-        }
-
-        inline static Vector DecodeScale( uint16 const* pData, TrackCompressionSettings const& settings )
-        {
-            float const m_x = Quantization::DecodeFloat( pData[0], settings.m_scaleRangeX.m_rangeStart, settings.m_scaleRangeX.m_rangeLength );
-            float const m_y = Quantization::DecodeFloat( pData[1], settings.m_scaleRangeY.m_rangeStart, settings.m_scaleRangeY.m_rangeLength );
-            float const m_z = Quantization::DecodeFloat( pData[2], settings.m_scaleRangeZ.m_rangeStart, settings.m_scaleRangeZ.m_rangeLength );
-            return Vector( m_x, m_y, m_z );
-        }
-
     public:
 
         AnimationClip() = default;
@@ -131,8 +76,9 @@ namespace KRG::Animation
         // Pose
         //-------------------------------------------------------------------------
 
-        void GetPose( FrameTime const& frameTime, Pose* pOutPose ) const;
-        inline void GetPose( Percentage percentageThrough, Pose* pOutPose ) const { GetPose( GetFrameTime( percentageThrough ), pOutPose ); }
+        // The optional cursor caches the decoded data between calls, use it when sampling the clip continuously
+        void GetPose( FrameTime const& frameTime, Pose* pOutPose, AnimationClipCursor* pCursor = nullptr ) const;
+        inline void GetPose( Percentage percentageThrough, Pose* pOutPose, AnimationClipCursor* pCursor = nullptr ) const { GetPose( GetFrameTime( percentageThrough ), pOutPose, pCursor ); }
 
         Transform GetLocalSpaceTransform( int32 boneIdx, FrameTime const& frameTime ) const;
         inline Transform GetLocalSpaceTransform( int32 boneIdx, Percentage percentageThrough ) const{ return GetLocalSpaceTransform( boneIdx, GetFrameTime( percentageThrough ) ); }
@@ -199,16 +145,22 @@ namespace KRG::Animation
 
     private:
 
-        // Read a compressed transform from a track and return a pointer to the data for the next track
-        inline uint16 const* ReadCompressedTrackTransform( uint16 const* pTrackData, TrackCompressionSettings const& trackSettings, FrameTime const& frameTime, Transform& outTransform ) const;
-        inline uint16 const* ReadCompressedTrackKeyFrame( uint16 const* pTrackData, TrackCompressionSettings const& trackSettings, uint32 frameIdx, Transform& outTransform ) const;
+        // Make sure the track cursor has the segment decoded
+        inline void UpdateTrackCursor( int32 trackIdx, uint32 segmentIdx, TrackCompression::TrackCursor& cursor ) const;
+
+        // Read an interpolated transform from a track
+        inline void ReadCompressedTrackTransform( int32 trackIdx, FrameTime const& frameTime, TrackCompression::TrackCursor& cursor, Transform& outTransform ) const;
+
+        // Read an exact key-frame transform from a track
+        inline void ReadCompressedTrackKeyFrame( int32 trackIdx, uint32 frameIdx, TrackCompression::TrackCursor& cursor, Transform& outTransform ) const;
 
     private:
 
         TResourcePtr<Skeleton>                  m_pSkeleton;
         uint32                                  m_numFrames = 0;
         Seconds                                 m_duration = 0.0f;
-        TVector<uint16>                         m_compressedPoseData;
+        TVector<uint32>                         m_compressedPoseData; // Variable bit rate stream, see AnimationClipCompression.h for the layout
+        TVector<uint32>                         m_trackSegmentOffsets; // The bit offset of each track's data for each segment ( segmentIdx * numTracks + trackIdx )
         TVector<TrackCompressionSettings>       m_trackCompressionSettings;
         TVector<Transform>                      m_rootMotionTrack;
         TVector<Event*>                         m_events;
@@ -229,180 +181,48 @@ namespace KRG::Animation
 
 namespace KRG::Animation
 {
-    inline uint16 const* AnimationClip::ReadCompressedTrackTransform( uint16 const* pTrackData, TrackCompressionSettings const& trackSettings, FrameTime const& frameTime, Transform& outTransform ) const
+    inline void AnimationClip::UpdateTrackCursor( int32 trackIdx, uint32 segmentIdx, TrackCompression::TrackCursor& cursor ) const
     {
-        KRG_ASSERT( pTrackData != nullptr );
-
-        uint32 const frameIdx = frameTime.GetFrameIndex();
-        Percentage const percentageThrough = frameTime.GetPercentageThrough();
-        KRG_ASSERT( frameIdx < m_numFrames - 1 );
-
-        //-------------------------------------------------------------------------
-
-        Transform transform0;
-        Transform transform1;
-
-        //-------------------------------------------------------------------------
-        // Read rotation
-        //-------------------------------------------------------------------------
-
-        // Rotations are 48bits (3 x uint16)
-        static constexpr uint32 const rotationStride = 3;
-
-        uint32 PoseDataIdx0 = frameIdx * rotationStride;
-        uint32 PoseDataIdx1 = PoseDataIdx0 + rotationStride;
-        KRG_ASSERT( PoseDataIdx1 < ( m_numFrames * rotationStride ) );
-
-        transform0.SetRotation( DecodeRotation( &pTrackData[PoseDataIdx0] ) );
-        transform1.SetRotation( DecodeRotation( &pTrackData[PoseDataIdx1] ) );
-
-        // Shift the track data ptr to the translation data
-        pTrackData += ( m_numFrames * rotationStride );
-
-        //-------------------------------------------------------------------------
-        // Read translation
-        //-------------------------------------------------------------------------
-
-        // Translations are 48bits (3 x uint16)
-        static constexpr uint32 const translationStride = 3;
-
-        if ( trackSettings.IsTranslationTrackStatic() )
+        if ( cursor.m_segmentIdx != segmentIdx )
         {
-            Vector const translation = DecodeTranslation( pTrackData, trackSettings );
-            transform0.SetTranslation( translation );
-            transform1.SetTranslation( translation );
-
-            // Shift the track data ptr to the scale data
-            pTrackData += translationStride;
+            uint32 const numTracks = (uint32) m_trackCompressionSettings.size();
+            uint32 const numSegmentFrames = TrackCompression::GetNumSegmentFrames( m_numFrames, segmentIdx );
+            TrackCompression::DecodeTrackSegment( m_compressedPoseData.data(), m_trackSegmentOffsets[segmentIdx * numTracks + trackIdx], m_trackCompressionSettings[trackIdx], segmentIdx, numSegmentFrames, cursor );
         }
-        else // Read the translation key-frames
-        {
-            PoseDataIdx0 = frameIdx * translationStride;
-            PoseDataIdx1 = PoseDataIdx0 + translationStride;
-            KRG_ASSERT( PoseDataIdx1 < ( m_numFrames * translationStride ) );
-
-            transform0.SetTranslation( DecodeTranslation( &pTrackData[PoseDataIdx0], trackSettings ) );
-            transform1.SetTranslation( DecodeTranslation( &pTrackData[PoseDataIdx1], trackSettings ) );
-
-            // Shift the track data ptr to the translation data
-            pTrackData += ( m_numFrames * rotationStride );
-        }
-
-        //-------------------------------------------------------------------------
-        // Read scale
-        //-------------------------------------------------------------------------
-
-        // Scales are 48bits (3 x uint16)
-        static constexpr uint32 const scaleStride = 3;
-
-        if ( trackSettings.IsScaleTrackStatic() )
-        {
-            Vector const scale = DecodeScale( pTrackData, trackSettings );
-            transform0.SetScale( scale );
-            transform1.SetScale( scale );
+    }
 
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += scaleStride;
-        }
-        else // Read the scale key-frames
-        {
-            PoseDataIdx0 = frameIdx * scaleStride;
-            PoseDataIdx1 = PoseDataIdx0 + scaleStride;
-            KRG_ASSERT( PoseDataIdx1 < ( m_numFrames * scaleStride ) );
+    //-------------------------------------------------------------------------
 
-            transform0.SetScale( DecodeScale( &pTrackData[PoseDataIdx0], trackSettings ) );
-            transform1.SetScale( DecodeScale( &pTrackData[PoseDataIdx1], trackSettings ) );
+    inline void AnimationClip::ReadCompressedTrackTransform( int32 trackIdx, FrameTime const& frameTime, TrackCompression::TrackCursor& cursor, Transform& outTransform ) const
+    {
+        uint32 const frameIdx = frameTime.GetFrameIndex();
+        KRG_ASSERT( frameIdx < m_numFrames - 1 );
 
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += ( m_numFrames * scaleStride );
-        }
+        // Segments also store the first frame of the next segment, so both key-frames are always in the same segment
+        uint32 const segmentIdx = frameIdx / TrackCompression::s_numFramesPerSegment;
+        uint32 const segmentFrameIdx = frameIdx - ( segmentIdx * TrackCompression::s_numFramesPerSegment );
+        UpdateTrackCursor( trackIdx, segmentIdx, cursor );
 
         //-------------------------------------------------------------------------
 
-        outTransform = Transform::Slerp( transform0, transform1, percentageThrough );
+        Transform transform0( NoInit );
+        Transform transform1( NoInit );
+        TrackCompression::DecodeTrackSegmentFrames( m_compressedPoseData.data(), cursor, segmentFrameIdx, transform0, transform1 );
 
-        //-------------------------------------------------------------------------
-
-        return pTrackData;
+        outTransform = Transform::Slerp( transform0, transform1, frameTime.GetPercentageThrough() );
     }
 
     //-------------------------------------------------------------------------
 
-    inline uint16 const* AnimationClip::ReadCompressedTrackKeyFrame( uint16 const* pTrackData, TrackCompressionSettings const& trackSettings, uint32 frameIdx, Transform& outTransform ) const
+    inline void AnimationClip::ReadCompressedTrackKeyFrame( int32 trackIdx, uint32 frameIdx, TrackCompression::TrackCursor& cursor, Transform& outTransform ) const
     {
-        KRG_ASSERT( pTrackData != nullptr );
         KRG_ASSERT( frameIdx < m_numFrames );
 
-        //-------------------------------------------------------------------------
-        // Read rotation
-        //-------------------------------------------------------------------------
-
-        // Rotations are 48bits (3 x uint16)
-        static constexpr uint32 const rotationStride = 3;
-
-        uint32 PoseDataIdx = frameIdx * rotationStride;
-        KRG_ASSERT( PoseDataIdx < ( m_numFrames * rotationStride ) );
-
-        outTransform.SetRotation( DecodeRotation( &pTrackData[PoseDataIdx] ) );
-
-        // Shift the track data ptr to the translation data
-        pTrackData += ( m_numFrames * rotationStride );
-
-        //-------------------------------------------------------------------------
-        // Read translation
-        //-------------------------------------------------------------------------
-
-        // Translations are 48bits (3 x uint16)
-        static constexpr uint32 const translationStride = 3;
-
-        if ( trackSettings.IsTranslationTrackStatic() )
-        {
-            Vector const translation = DecodeTranslation( pTrackData, trackSettings );
-            outTransform.SetTranslation( translation );
-
-            // Shift the track data ptr to the scale data
-            pTrackData += translationStride;
-        }
-        else // Read the translation key-frames
-        {
-            PoseDataIdx = frameIdx * translationStride;
-            KRG_ASSERT( PoseDataIdx < ( m_numFrames * translationStride ) );
-
-            outTransform.SetTranslation( DecodeTranslation( &pTrackData[PoseDataIdx], trackSettings ) );
-
-            // Shift the track data ptr to the translation data
-            pTrackData += ( m_numFrames * rotationStride );
-        }
-
-        //-------------------------------------------------------------------------
-        // Read scale
-        //-------------------------------------------------------------------------
-
-         // Scales are 48bits (3 x uint16)
-        static constexpr uint32 const scaleStride = 3;
-
-        if ( trackSettings.IsScaleTrackStatic() )
-        {
-            Vector const scale = DecodeScale( pTrackData, trackSettings );
-            outTransform.SetScale( scale );
-
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += scaleStride;
-        }
-        else // Read the scale key-frames
-        {
-            PoseDataIdx = frameIdx * scaleStride;
-            KRG_ASSERT( PoseDataIdx < ( m_numFrames * scaleStride ) );
-
-            outTransform.SetScale( DecodeScale( &pTrackData[PoseDataIdx], trackSettings ) );
-
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += ( m_numFrames * scaleStride );
-        }
-
-        //-------------------------------------------------------------------------
-
-        return pTrackData;
+        // The last frame of the clip can be the extra frame stored at the end of the last segment
+        uint32 const segmentIdx = Math::Min( frameIdx / TrackCompression::s_numFramesPerSegment, TrackCompression::GetNumSegments( m_numFrames ) - 1 );
+        uint32 const segmentFrameIdx = frameIdx - ( segmentIdx * TrackCompression::s_numFramesPerSegment );
+        UpdateTrackCursor( trackIdx, segmentIdx, cursor );
+        TrackCompression::DecodeTrackSegmentFrame( m_compressedPoseData.data(), cursor, segmentFrameIdx, outTransform );
     }
 
     //-------------------------------------------------------------------------
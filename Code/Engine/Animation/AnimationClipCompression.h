@@ -0,0 +1,408 @@
+#pragma once
+
+#include "System/Core/Math/Transform.h"
+#include "System/Core/Serialization/Serialization.h"
+
+//-------------------------------------------------------------------------
+// Animation Clip Compression
+//-------------------------------------------------------------------------
+// Clips are split into segments of 16 frames and each track is stored as a variable bit rate block per segment:
+//
+// [ 3 x 4-bit rate index (rotation, translation, scale) ][ 2-bit dropped rotation component ][ 3 x 2-bit channel flags ]
+// [ per channel: key mask (1 bit per segment frame, only if flagged), segment ranges (8-bit start, 8-bit length per component) ]
+// [ per channel: key samples ]
+//
+// Rotations are stored as three of the quaternion components, the dropped component is the one furthest from zero over the segment.
+// The quaternion is negated as needed so that the dropped component is always positive, and it is reconstructed when decoding.
+// Each component is normalized to its clip range and then to its segment range within the clip range, samples use the bit rate of their channel.
+// A segment also stores the first frame of the next segment, so the two frames we interpolate between are always in the same segment.
+//
+// Static channels use the zero bit rate and a zero length clip range, this means that they decode to the clip range start with the same code path.
+// The bit rates are chosen per segment by the compiler, as the lowest rates that keep the object space error of the track below the error threshold.
+//
+// With key reduction enabled, the compiler removes the keys that can be interpolated within the error threshold. Reduced channels store a key mask and
+// are interpolated either linearly or with a Catmull-Rom spline. At runtime a track cursor caches the decoded segment and the keys around the last
+// sampled frame, so sequential sampling only decodes new data when crossing a key or a segment boundary.
+
+namespace KRG::Animation
+{
+    struct QuantizationRange
+    {
+        KRG_SERIALIZE_MEMBERS( m_rangeStart, m_rangeLength );
+
+        QuantizationRange() = default;
+
+        QuantizationRange( float start, float length )
+            : m_rangeStart( start )
+            , m_rangeLength( length )
+        {}
+
+        // Zero length ranges are valid and always decode to the range start
+        inline bool IsValid() const { return m_rangeLength >= 0; }
+
+    public:
+
+        float                                     m_rangeStart = 0;
+        float                                     m_rangeLength = -1;
+    };
+
+    //-------------------------------------------------------------------------
+
+    struct TrackCompressionSettings
+    {
+        KRG_SERIALIZE_MEMBERS( m_rotationRanges, m_translationRangeX, m_translationRangeY, m_translationRangeZ, m_scaleRangeX, m_scaleRangeY, m_scaleRangeZ, m_isRotationStatic, m_isTranslationStatic, m_isScaleStatic );
+
+        friend class AnimationClipCompiler;
+
+    public:
+
+        TrackCompressionSettings() = default;
+
+        // Is the rotation for this track static i.e. a fixed value for the duration of the animation
+        inline bool IsRotationTrackStatic() const { return m_isRotationStatic; }
+
+        // Is the translation for this track static i.e. a fixed value for the duration of the animation
+        inline bool IsTranslationTrackStatic() const { return m_isTranslationStatic; }
+
+        // Is the scale for this track static i.e. a fixed value for the duration of the animation
+        inline bool IsScaleTrackStatic() const { return m_isScaleStatic; }
+
+    public:
+
+        QuantizationRange                       m_rotationRanges[4]; // The quaternion XYZW component ranges, only three of them are used by each segment
+        QuantizationRange                       m_translationRangeX;
+        QuantizationRange                       m_translationRangeY;
+        QuantizationRange                       m_translationRangeZ;
+        QuantizationRange                       m_scaleRangeX;
+        QuantizationRange                       m_scaleRangeY;
+        QuantizationRange                       m_scaleRangeZ;
+
+    private:
+
+        bool                                    m_isRotationStatic = false;
+        bool                                    m_isTranslationStatic = false;
+        bool                                    m_isScaleStatic = false;
+    };
+
+    //-------------------------------------------------------------------------
+
+    namespace TrackCompression
+    {
+        static constexpr uint32 const s_numFramesPerSegment = 16;
+        static constexpr uint32 const s_numBitsPerRateIndex = 4;
+        static constexpr uint32 const s_rateIndexMask = ( 1 << s_numBitsPerRateIndex ) - 1;
+        static constexpr uint32 const s_numBitsPerDroppedComponentIdx = 2;
+        static constexpr uint32 const s_numBitsPerChannelFlags = 2;
+        static constexpr uint32 const s_numBitsPerTrackSegmentHeader = 3 * s_numBitsPerRateIndex + s_numBitsPerDroppedComponentIdx + 3 * s_numBitsPerChannelFlags;
+        static constexpr uint32 const s_numBitsPerSegmentRangeValue = 8;
+        static constexpr uint32 const s_maxSegmentRangeValue = ( 1 << s_numBitsPerSegmentRangeValue ) - 1;
+
+        static constexpr uint32 const s_numRates = 16;
+        static constexpr uint32 const s_staticRate = 0;
+        static constexpr uint32 const s_lowestRate = 1;
+        static constexpr uint32 const s_highestRate = s_numRates - 1;
+
+        // The number of bits used per component for each rate
+        static constexpr uint32 const s_numBitsPerRate[s_numRates] = { 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 16, 18, 20 };
+
+        // The stored quaternion components for each dropped component
+        static constexpr uint32 const s_storedRotationComponents[4][3] = { { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 3 }, { 0, 1, 2 } };
+
+        // Channel flags
+        static constexpr uint32 const s_channelFlagHasKeyMask = 1 << 0;
+        static constexpr uint32 const s_channelFlagSpline = 1 << 1;
+
+        static constexpr uint32 const s_invalidKeyFrame = 0xFFFFFFFF;
+
+        //-------------------------------------------------------------------------
+
+        inline uint32 GetNumSegments( uint32 numFrames )
+        {
+            return ( numFrames > 1 ) ? ( numFrames + s_numFramesPerSegment - 2 ) / s_numFramesPerSegment : 1;
+        }
+
+        // Get the number of frames stored in a segment, this includes the first frame of the next segment
+        inline uint32 GetNumSegmentFrames( uint32 numFrames, uint32 segmentIdx )
+        {
+            uint32 const segmentStartFrame = segmentIdx * s_numFramesPerSegment;
+            KRG_ASSERT( segmentStartFrame < numFrames );
+            return Math::Min( numFrames - segmentStartFrame, s_numFramesPerSegment + 1 );
+        }
+
+        // Read up to 32 bits from the bit stream, the stream needs to be padded with two extra words
+        KRG_FORCE_INLINE uint32 ReadBits( uint32 const* pData, uint32 bitOffset, uint32 numBits )
+        {
+            uint32 const wordIdx = bitOffset >> 5;
+            uint64 const words = uint64( pData[wordIdx] ) | ( uint64( pData[wordIdx + 1] ) << 32 );
+            uint64 const mask = ( uint64( 1 ) << numBits ) - 1;
+            return uint32( ( words >> ( bitOffset & 31 ) ) & mask );
+        }
+
+        // Key mask helpers, these are branchless so that seeking within a segment has a fixed cost
+        //-------------------------------------------------------------------------
+
+        KRG_FORCE_INLINE uint32 CountSetBits( uint32 value )
+        {
+            value = value - ( ( value >> 1 ) & 0x55555555 );
+            value = ( value & 0x33333333 ) + ( ( value >> 2 ) & 0x33333333 );
+            return ( ( ( value + ( value >> 4 ) ) & 0x0F0F0F0F ) * 0x01010101 ) >> 24;
+        }
+
+        // The value must not be zero
+        KRG_FORCE_INLINE uint32 GetHighestSetBitIndex( uint32 value )
+        {
+            KRG_ASSERT( value != 0 );
+            value |= value >> 1;
+            value |= value >> 2;
+            value |= value >> 4;
+            value |= value >> 8;
+            value |= value >> 16;
+            return CountSetBits( value ) - 1;
+        }
+
+        // The value must not be zero
+        KRG_FORCE_INLINE uint32 GetLowestSetBitIndex( uint32 value )
+        {
+            KRG_ASSERT( value != 0 );
+            return CountSetBits( ( value & ( 0 - value ) ) - 1 );
+        }
+
+        //-------------------------------------------------------------------------
+
+        // A component value is decoded as 'm_rangeStart + ( encodedValue * m_rangeScale )'
+        // Each channel stores samples only for its key frames, the frames in between are interpolated either linearly or with a Catmull-Rom spline
+        struct ChannelSegment
+        {
+            Vector                              m_rangeStart;
+            Vector                              m_rangeScale;
+            uint32                              m_numBits;
+            uint32                              m_keyMask; // Bit N is set if frame N of the segment is a key, the first and last frames are always keys
+            uint32                              m_samplesBitOffset;
+            float                               m_splineWeight; // 1 for Catmull-Rom channels, 0 for linear channels
+        };
+
+        struct TrackSegment
+        {
+            ChannelSegment                      m_rotation;
+            ChannelSegment                      m_translation;
+            ChannelSegment                      m_scale;
+            uint32                              m_droppedRotationComponentIdx;
+        };
+
+        // The decoded keys around the last sampled frame: previous, start, end and next
+        struct ChannelCursor
+        {
+            Vector                              m_keyValues[4];
+            uint32                              m_keyFrames[4];
+        };
+
+        // The decoding state for a single track, the segment is only decoded when the sampled segment changes and the channel keys are only
+        // decoded when the sampled frame leaves the current key interval. This means that sequential sampling has a fixed cost per sample.
+        struct TrackCursor
+        {
+            inline void Reset() { m_segmentIdx = s_invalidKeyFrame; }
+
+        public:
+
+            TrackSegment                        m_segment;
+            ChannelCursor                       m_rotation;
+            ChannelCursor                       m_translation;
+            ChannelCursor                       m_scale;
+            uint32                              m_segmentIdx = s_invalidKeyFrame;
+        };
+
+        //-------------------------------------------------------------------------
+
+        // Decode the key mask and the segment ranges for a channel and return the bit offset of the data following them
+        inline uint32 DecodeChannelSegment( uint32 const* pData, uint32 bitOffset, uint32 rate, uint32 flags, uint32 numSegmentFrames, QuantizationRange const& rangeX, QuantizationRange const& rangeY, QuantizationRange const& rangeZ, ChannelSegment& outChannel )
+        {
+            // Channels without a key mask have a key on every frame, except for static channels that only have a single key
+            uint32 const numKeyMaskBits = ( flags & s_channelFlagHasKeyMask ) ? numSegmentFrames : 0;
+            uint32 const allKeysMask = ( rate != s_staticRate ) ? ( 1u << numSegmentFrames ) - 1 : 1;
+            outChannel.m_keyMask = ( numKeyMaskBits > 0 ) ? ReadBits( pData, bitOffset, numKeyMaskBits ) : allKeysMask;
+            outChannel.m_splineWeight = ( flags & s_channelFlagSpline ) ? 1.0f : 0.0f;
+            bitOffset += numKeyMaskBits;
+
+            // Static channels have no segment ranges, and reading zero bits always returns zero
+            uint32 const numRangeBits = ( rate != s_staticRate ) ? s_numBitsPerSegmentRangeValue : 0;
+            uint32 const numBits = s_numBitsPerRate[rate];
+
+            Vector const segmentRangeStart( (float) ReadBits( pData, bitOffset, numRangeBits ), (float) ReadBits( pData, bitOffset + 2 * numRangeBits, numRangeBits ), (float) ReadBits( pData, bitOffset + 4 * numRangeBits, numRangeBits ), 0.0f );
+            Vector const segmentRangeLength( (float) ReadBits( pData, bitOffset + numRangeBits, numRangeBits ), (float) ReadBits( pData, bitOffset + 3 * numRangeBits, numRangeBits ), (float) ReadBits( pData, bitOffset + 5 * numRangeBits, numRangeBits ), 0.0f );
+
+            Vector const clipRangeStart( rangeX.m_rangeStart, rangeY.m_rangeStart, rangeZ.m_rangeStart, 0.0f );
+            Vector const clipRangeLength( rangeX.m_rangeLength, rangeY.m_rangeLength, rangeZ.m_rangeLength, 0.0f );
+            Vector const clipRangeStep = clipRangeLength * ( 1.0f / s_maxSegmentRangeValue );
+
+            float const maxEncodedValue = float( ( 1u << numBits ) - 1 );
+            float const invMaxEncodedValue = ( numBits > 0 ) ? 1.0f / maxEncodedValue : 0.0f;
+
+            outChannel.m_rangeStart = Vector::MultiplyAdd( segmentRangeStart, clipRangeStep, clipRangeStart );
+            outChannel.m_rangeScale = segmentRangeLength * clipRangeStep * invMaxEncodedValue;
+            outChannel.m_numBits = numBits;
+
+            return bitOffset + 6 * numRangeBits;
+        }
+
+        // Decode the header of a track's segment block
+        inline void DecodeTrackSegment( uint32 const* pData, uint32 bitOffset, TrackCompressionSettings const& settings, uint32 numSegmentFrames, TrackSegment& outSegment )
+        {
+            KRG_ASSERT( pData != nullptr );
+
+            uint32 const header = ReadBits( pData, bitOffset, s_numBitsPerTrackSegmentHeader );
+            bitOffset += s_numBitsPerTrackSegmentHeader;
+
+            outSegment.m_droppedRotationComponentIdx = ( header >> ( 3 * s_numBitsPerRateIndex ) ) & ( ( 1 << s_numBitsPerDroppedComponentIdx ) - 1 );
+            uint32 const* pStoredComponents = s_storedRotationComponents[outSegment.m_droppedRotationComponentIdx];
+
+            uint32 const channelFlags = header >> ( 3 * s_numBitsPerRateIndex + s_numBitsPerDroppedComponentIdx );
+            uint32 const channelFlagsMask = ( 1 << s_numBitsPerChannelFlags ) - 1;
+
+            bitOffset = DecodeChannelSegment( pData, bitOffset, header & s_rateIndexMask, channelFlags & channelFlagsMask, numSegmentFrames, settings.m_rotationRanges[pStoredComponents[0]], settings.m_rotationRanges[pStoredComponents[1]], settings.m_rotationRanges[pStoredComponents[2]], outSegment.m_rotation );
+            bitOffset = DecodeChannelSegment( pData, bitOffset, ( header >> s_numBitsPerRateIndex ) & s_rateIndexMask, ( channelFlags >> s_numBitsPerChannelFlags ) & channelFlagsMask, numSegmentFrames, settings.m_translationRangeX, settings.m_translationRangeY, settings.m_translationRangeZ, outSegment.m_translation );
+            bitOffset = DecodeChannelSegment( pData, bitOffset, ( header >> ( 2 * s_numBitsPerRateIndex ) ) & s_rateIndexMask, ( channelFlags >> ( 2 * s_numBitsPerChannelFlags ) ) & channelFlagsMask, numSegmentFrames, settings.m_scaleRangeX, settings.m_scaleRangeY, settings.m_scaleRangeZ, outSegment.m_scale );
+
+            // The samples are stored per channel
+            outSegment.m_rotation.m_samplesBitOffset = bitOffset;
+            outSegment.m_translation.m_samplesBitOffset = outSegment.m_rotation.m_samplesBitOffset + CountSetBits( outSegment.m_rotation.m_keyMask ) * 3 * outSegment.m_rotation.m_numBits;
+            outSegment.m_scale.m_samplesBitOffset = outSegment.m_translation.m_samplesBitOffset + CountSetBits( outSegment.m_translation.m_keyMask ) * 3 * outSegment.m_translation.m_numBits;
+        }
+
+        // Decode a track's segment into the cursor, this invalidates the channel cursors
+        inline void DecodeTrackSegment( uint32 const* pData, uint32 bitOffset, TrackCompressionSettings const& settings, uint32 segmentIdx, uint32 numSegmentFrames, TrackCursor& cursor )
+        {
+            DecodeTrackSegment( pData, bitOffset, settings, numSegmentFrames, cursor.m_segment );
+            cursor.m_segmentIdx = segmentIdx;
+
+            for ( ChannelCursor* pChannelCursor : { &cursor.m_rotation, &cursor.m_translation, &cursor.m_scale } )
+            {
+                pChannelCursor->m_keyFrames[1] = pChannelCursor->m_keyFrames[2] = s_invalidKeyFrame;
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        KRG_FORCE_INLINE Vector DecodeChannelSample( uint32 const* pData, uint32 bitOffset, ChannelSegment const& channel )
+        {
+            uint32 const numBits = channel.m_numBits;
+            Vector const encodedValue( (float) ReadBits( pData, bitOffset, numBits ), (float) ReadBits( pData, bitOffset + numBits, numBits ), (float) ReadBits( pData, bitOffset + 2 * numBits, numBits ), 0.0f );
+            return Vector::MultiplyAdd( encodedValue, channel.m_rangeScale, channel.m_rangeStart );
+        }
+
+        // Find and decode the keys around a segment frame
+        inline void SeekChannelCursor( uint32 const* pData, ChannelSegment const& channel, uint32 segmentFrameIdx, ChannelCursor& cursor )
+        {
+            uint32 const keyMask = channel.m_keyMask;
+            uint32 const framesUpToMask = ( 2u << segmentFrameIdx ) - 1;
+            uint32 const keysUpToFrame = keyMask & framesUpToMask;
+            uint32 const keysAfterFrame = keyMask & ~framesUpToMask;
+
+            // The first frame of a segment is always a key
+            uint32 const startKey = GetHighestSetBitIndex( keysUpToFrame );
+            uint32 const keysBeforeStart = keysUpToFrame ^ ( 1u << startKey );
+            uint32 const endKey = ( keysAfterFrame != 0 ) ? GetLowestSetBitIndex( keysAfterFrame ) : startKey;
+            uint32 const keysAfterEnd = keyMask & ~( ( 2u << endKey ) - 1 );
+
+            cursor.m_keyFrames[0] = ( keysBeforeStart != 0 ) ? GetHighestSetBitIndex( keysBeforeStart ) : startKey;
+            cursor.m_keyFrames[1] = startKey;
+            cursor.m_keyFrames[2] = endKey;
+            cursor.m_keyFrames[3] = ( keysAfterEnd != 0 ) ? GetLowestSetBitIndex( keysAfterEnd ) : endKey;
+
+            uint32 const sampleNumBits = 3 * channel.m_numBits;
+            uint32 const startSampleBitOffset = channel.m_samplesBitOffset + ( CountSetBits( keysUpToFrame ) - 1 ) * sampleNumBits;
+            uint32 const endSampleBitOffset = startSampleBitOffset + ( ( endKey != startKey ) ? sampleNumBits : 0 );
+            cursor.m_keyValues[1] = DecodeChannelSample( pData, startSampleBitOffset, channel );
+            cursor.m_keyValues[2] = DecodeChannelSample( pData, endSampleBitOffset, channel );
+
+            // The previous and next keys are only needed for the spline tangents
+            if ( channel.m_splineWeight > 0.0f )
+            {
+                cursor.m_keyValues[0] = DecodeChannelSample( pData, startSampleBitOffset - ( ( cursor.m_keyFrames[0] != startKey ) ? sampleNumBits : 0 ), channel );
+                cursor.m_keyValues[3] = DecodeChannelSample( pData, endSampleBitOffset + ( ( cursor.m_keyFrames[3] != endKey ) ? sampleNumBits : 0 ), channel );
+            }
+            else
+            {
+                cursor.m_keyValues[0] = cursor.m_keyValues[1];
+                cursor.m_keyValues[3] = cursor.m_keyValues[2];
+            }
+        }
+
+        // Make sure the cursor's keys cover the frame range, a single key covers all the following frames since it is either static or the last segment frame
+        KRG_FORCE_INLINE void UpdateChannelCursor( uint32 const* pData, ChannelSegment const& channel, uint32 firstSegmentFrameIdx, uint32 lastSegmentFrameIdx, ChannelCursor& cursor )
+        {
+            bool const isCovered = ( cursor.m_keyFrames[1] <= firstSegmentFrameIdx ) && ( lastSegmentFrameIdx <= cursor.m_keyFrames[2] || cursor.m_keyFrames[1] == cursor.m_keyFrames[2] );
+            if ( !isCovered )
+            {
+                SeekChannelCursor( pData, channel, firstSegmentFrameIdx, cursor );
+            }
+        }
+
+        // Evaluate a channel from the cursor's keys, the frame needs to be within the cursor's key interval
+        // Splines use Catmull-Rom tangents for non-uniformly spaced keys, linear channels use the chord as both tangents which reduces the Hermite curve to a line
+        inline Vector EvaluateChannel( ChannelSegment const& channel, ChannelCursor const& cursor, uint32 segmentFrameIdx )
+        {
+            uint32 const* pKeyFrames = cursor.m_keyFrames;
+            Vector const* pKeyValues = cursor.m_keyValues;
+
+            float const intervalLength = float( pKeyFrames[2] - pKeyFrames[1] );
+            float const t = ( intervalLength > 0.0f ) ? float( segmentFrameIdx - pKeyFrames[1] ) / intervalLength : 0.0f;
+
+            Vector const chord = pKeyValues[2] - pKeyValues[1];
+            Vector const splineStartTangent = ( pKeyValues[2] - pKeyValues[0] ) * ( intervalLength / Math::Max( float( pKeyFrames[2] - pKeyFrames[0] ), 1.0f ) );
+            Vector const splineEndTangent = ( pKeyValues[3] - pKeyValues[1] ) * ( intervalLength / Math::Max( float( pKeyFrames[3] - pKeyFrames[1] ), 1.0f ) );
+            Vector const startTangent = Vector::Lerp( chord, splineStartTangent, channel.m_splineWeight );
+            Vector const endTangent = Vector::Lerp( chord, splineEndTangent, channel.m_splineWeight );
+
+            float const t2 = t * t;
+            float const t3 = t2 * t;
+            Vector result = pKeyValues[1] * ( 2 * t3 - 3 * t2 + 1 );
+            result = Vector::MultiplyAdd( startTangent, Vector( t3 - 2 * t2 + t ), result );
+            result = Vector::MultiplyAdd( pKeyValues[2], Vector( 3 * t2 - 2 * t3 ), result );
+            result = Vector::MultiplyAdd( endTangent, Vector( t3 - t2 ), result );
+            return result;
+        }
+
+        // Evaluate a frame from the cursor's keys, the frame index is relative to the segment start
+        inline void EvaluateTrackCursor( TrackCursor const& cursor, uint32 segmentFrameIdx, Transform& outTransform )
+        {
+            TrackSegment const& segment = cursor.m_segment;
+            Vector const storedRotationComponents = EvaluateChannel( segment.m_rotation, cursor.m_rotation, segmentFrameIdx );
+            Vector const translation = EvaluateChannel( segment.m_translation, cursor.m_translation, segmentFrameIdx );
+            Vector const scale = EvaluateChannel( segment.m_scale, cursor.m_scale, segmentFrameIdx );
+
+            // The dropped component is always positive
+            uint32 const* pStoredComponents = s_storedRotationComponents[segment.m_droppedRotationComponentIdx];
+            float rotationComponents[4];
+            rotationComponents[pStoredComponents[0]] = storedRotationComponents.m_x;
+            rotationComponents[pStoredComponents[1]] = storedRotationComponents.m_y;
+            rotationComponents[pStoredComponents[2]] = storedRotationComponents.m_z;
+            rotationComponents[segment.m_droppedRotationComponentIdx] = Math::Sqrt( Math::Max( 1.0f - storedRotationComponents.GetLengthSquared3(), 0.0f ) );
+
+            Quaternion rotation( rotationComponents[0], rotationComponents[1], rotationComponents[2], rotationComponents[3] );
+            rotation.Normalize();
+
+            outTransform = Transform( rotation, translation, scale );
+        }
+
+        // Decode a single frame of the cursor's segment, the frame index is relative to the segment start
+        inline void DecodeTrackSegmentFrame( uint32 const* pData, TrackCursor& cursor, uint32 segmentFrameIdx, Transform& outTransform )
+        {
+            KRG_ASSERT( cursor.m_segmentIdx != s_invalidKeyFrame );
+            UpdateChannelCursor( pData, cursor.m_segment.m_rotation, segmentFrameIdx, segmentFrameIdx, cursor.m_rotation );
+            UpdateChannelCursor( pData, cursor.m_segment.m_translation, segmentFrameIdx, segmentFrameIdx, cursor.m_translation );
+            UpdateChannelCursor( pData, cursor.m_segment.m_scale, segmentFrameIdx, segmentFrameIdx, cursor.m_scale );
+            EvaluateTrackCursor( cursor, segmentFrameIdx, outTransform );
+        }
+
+        // Decode a frame and the frame after it from the cursor's segment, the frame index is relative to the segment start
+        inline void DecodeTrackSegmentFrames( uint32 const* pData, TrackCursor& cursor, uint32 segmentFrameIdx, Transform& outTransform0, Transform& outTransform1 )
+        {
+            KRG_ASSERT( cursor.m_segmentIdx != s_invalidKeyFrame );
+            UpdateChannelCursor( pData, cursor.m_segment.m_rotation, segmentFrameIdx, segmentFrameIdx + 1, cursor.m_rotation );
+            UpdateChannelCursor( pData, cursor.m_segment.m_translation, segmentFrameIdx, segmentFrameIdx + 1, cursor.m_translation );
+            UpdateChannelCursor( pData, cursor.m_segment.m_scale, segmentFrameIdx, segmentFrameIdx + 1, cursor.m_scale );
+            EvaluateTrackCursor( cursor, segmentFrameIdx, outTransform0 );
+            EvaluateTrackCursor( cursor, segmentFrameIdx + 1, outTransform1 );
+        }
+    }
+}
\ No newline at end of file
@@ -44,6 +44,7 @@ namespace KRG::Animation
     void AnimationClipPlayerComponent::Shutdown()
     {
         KRG::Delete( m_pPose );
+        m_cursor.Reset();
         m_previousAnimTime = -1.0f;
         EntityComponent::Shutdown();
     }
@@ -103,7 +104,7 @@ namespace KRG::Animation
 
         if ( bShouldUpdate )
         {
-            m_pAnimation->GetPose( m_animTime, m_pPose );
+            m_pAnimation->GetPose( m_animTime, m_pPose, &m_cursor );
             m_pPose->CalculateGlobalTransforms();
             m_rootMotionDelta = m_pAnimation->GetRootMotionDelta( m_previousAnimTime, m_animTime );
         }
@@ -71,6 +71,7 @@ namespace KRG::Animation
 
         Transform                                       m_rootMotionDelta = Transform::Identity;
         Pose*                                           m_pPose = nullptr;
+        AnimationClipCursor                             m_cursor;
         Percentage                                      m_previousAnimTime = Percentage( 0.0f );
         Percentage                                      m_animTime = Percentage( 0.0f );
         KRG_EXPOSE bool                                 m_requiresManualUpdate = false;
@@ -35,6 +35,7 @@ namespace KRG::Animation::GraphNodes
         m_duration = m_pAnimation->GetDuration();
         m_shouldSampleRootMotion = pSettings->m_sampleRootMotion;
         m_shouldPlayInReverse = false;
+        m_cursor.Reset();
 
         // Calculate start time
         m_currentTime = m_previousTime = m_pAnimation->GetSyncTrack().GetPercentageThrough( initialTime );
@@ -49,6 +50,7 @@ namespace KRG::Animation::GraphNodes
         }
 
         m_currentTime = m_previousTime = 0.0f;
+        m_cursor.Reset();
         AnimationClipReferenceNode::ShutdownInternal( context );
     }
 
@@ -147,7 +149,7 @@ namespace KRG::Animation::GraphNodes
         return CalculateResult( context, true );
     }
 
-    GraphPoseNodeResult AnimationClipNode::CalculateResult( GraphContext& context, bool isSynchronizedUpdate ) const
+    GraphPoseNodeResult AnimationClipNode::CalculateResult( GraphContext& context, bool isSynchronizedUpdate )
     {
         KRG_ASSERT( m_pAnimation != nullptr );
         auto pSettings = GetSettings<AnimationClipNode>();
@@ -235,7 +237,7 @@ namespace KRG::Animation::GraphNodes
         //-------------------------------------------------------------------------
 
         Percentage const sampleTime = m_shouldPlayInReverse ? Percentage( 1.0f - m_currentTime.ToFloat() ) : m_currentTime;
-        result.m_taskIdx = context.m_pTaskSystem->RegisterTask<Tasks::SampleTask>( GetNodeIndex(), m_pAnimation, sampleTime );
+        result.m_taskIdx = context.m_pTaskSystem->RegisterTask<Tasks::SampleTask>( GetNodeIndex(), m_pAnimation, sampleTime, &m_cursor );
         return result;
     }
 }
\ No newline at end of file
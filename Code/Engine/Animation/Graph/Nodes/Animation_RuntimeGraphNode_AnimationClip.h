@@ -44,7 +44,7 @@ namespace KRG::Animation::GraphNodes
         virtual void InitializeInternal( GraphContext& context, SyncTrackTime const& initialTime ) override;
         virtual void ShutdownInternal( GraphContext& context ) override;
 
-        GraphPoseNodeResult CalculateResult( GraphContext& context, bool bIsSynchronizedUpdate ) const;
+        GraphPoseNodeResult CalculateResult( GraphContext& context, bool bIsSynchronizedUpdate );
 
     private:
 
@@ -52,5 +52,6 @@ namespace KRG::Animation::GraphNodes
         BoolValueNode*                                  m_pPlayInReverseValueNode = nullptr;
         bool                                            m_shouldPlayInReverse = false;
         bool                                            m_shouldSampleRootMotion = true;
+        AnimationClipCursor                             m_cursor;
     };
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ namespace KRG::Animation
     AnimationClipLoader::AnimationClipLoader()
     {
         m_loadableTypes.push_back( AnimationClip::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     void AnimationClipLoader::SetTypeRegistry( TypeSystem::TypeRegistry const* pTypeRegistry )
@@ -13,6 +13,7 @@ namespace KRG::Animation
         m_loadableTypes.push_back( GraphDataSet::GetStaticResourceTypeID() );
         m_loadableTypes.push_back( GraphDefinition::GetStaticResourceTypeID() );
         m_loadableTypes.push_back( GraphVariation::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     bool GraphLoader::LoadInternal( ResourceID const& resID, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryMemoryArchive& archive ) const
@@ -9,6 +9,7 @@ namespace KRG::Animation
     SkeletonLoader::SkeletonLoader()
     {
         m_loadableTypes.push_back( Skeleton::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     bool SkeletonLoader::LoadInternal( ResourceID const& resID, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryMemoryArchive& archive ) const
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Animation_Task.h"
+#include "System/Core/Profiling/Counters.h"
 
 //-------------------------------------------------------------------------
 
@@ -55,6 +56,7 @@ namespace KRG::Animation
         inline TaskIndex RegisterTask( ConstructorParams&&... params )
         {
             KRG_ASSERT( m_tasks.size() < 0xFF );
+            KRG_PROFILE_COUNTER_INCREMENT( "Animation Tasks Registered", 1 );
             auto pNewTask = m_tasks.emplace_back( KRG::New<T>( std::forward<ConstructorParams>( params )... ) );
             m_hasPhysicsDependency |= pNewTask->HasPhysicsDependency();
             return (TaskIndex) ( m_tasks.size() - 1 );
@@ -4,10 +4,11 @@
 
 namespace KRG::Animation::Tasks
 {
-    SampleTask::SampleTask( TaskSourceID sourceID, AnimationClip const* pAnimation, Percentage time )
+    SampleTask::SampleTask( TaskSourceID sourceID, AnimationClip const* pAnimation, Percentage time, AnimationClipCursor* pCursor )
         : Task( sourceID )
         , m_pAnimation( pAnimation )
         , m_time( time )
+        , m_pCursor( pCursor )
     {
         KRG_ASSERT( m_pAnimation != nullptr );
     }
@@ -17,7 +18,7 @@ namespace KRG::Animation::Tasks
         KRG_ASSERT( m_pAnimation != nullptr );
 
         auto pResultBuffer = GetNewPoseBuffer( context );
-        m_pAnimation->GetPose( m_time, &pResultBuffer->m_pose );
+        m_pAnimation->GetPose( m_time, &pResultBuffer->m_pose, m_pCursor );
         MarkTaskComplete( context );
     }
 
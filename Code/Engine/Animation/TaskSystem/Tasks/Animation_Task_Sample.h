@@ -12,7 +12,8 @@ namespace KRG::Animation::Tasks
 
     public:
 
-        SampleTask( TaskSourceID sourceID, AnimationClip const* pAnimation, Percentage time );
+        // The optional cursor is owned by the task's source and needs to outlive the task
+        SampleTask( TaskSourceID sourceID, AnimationClip const* pAnimation, Percentage time, AnimationClipCursor* pCursor = nullptr );
         virtual void Execute( TaskContext const& context ) override;
 
         #if KRG_DEVELOPMENT_TOOLS
@@ -24,5 +25,6 @@ namespace KRG::Animation::Tasks
 
         AnimationClip const*    m_pAnimation;
         Percentage              m_time;
+        AnimationClipCursor*    m_pCursor = nullptr;
     };
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "DebugView_Resource.h"
 #include "System/Resource/ResourceSystem.h"
 #include "System/Core/Systems/SystemRegistry.h"
+#include "System/Core/Logging/Log.h"
 #include "System/Render/Imgui/ImguiX.h"
 
 //-------------------------------------------------------------------------
@@ -38,6 +39,30 @@ namespace KRG::Resource
             ImGui::SetNextWindowBgAlpha( 0.75f );
             DrawReferenceTrackerWindow( m_pResourceSystem, &m_isReferenceTrackerWindowOpen );
         }
+
+        if ( m_isCompressionStatsWindowOpen )
+        {
+            ImGui::SetNextWindowBgAlpha( 0.75f );
+            DrawCompressionStatsWindow( m_pResourceSystem, &m_isCompressionStatsWindowOpen );
+        }
+
+        if ( m_isLoadTimeStatsWindowOpen )
+        {
+            ImGui::SetNextWindowBgAlpha( 0.75f );
+            DrawLoadTimeStatsWindow( m_pResourceSystem, &m_isLoadTimeStatsWindowOpen );
+        }
+
+        if ( m_isResidentCacheWindowOpen )
+        {
+            ImGui::SetNextWindowBgAlpha( 0.75f );
+            DrawResidentCacheWindow( m_pResourceSystem, &m_isResidentCacheWindowOpen );
+        }
+
+        if ( m_isLoadTimelineWindowOpen )
+        {
+            ImGui::SetNextWindowBgAlpha( 0.75f );
+            DrawLoadTimelineWindow( m_pResourceSystem, &m_isLoadTimelineWindowOpen );
+        }
     }
 
     void ResourceDebugView::DrawResourceMenu( EntityWorldUpdateContext const& context )
@@ -51,6 +76,26 @@ namespace KRG::Resource
         {
             m_isReferenceTrackerWindowOpen = true;
         }
+
+        if ( ImGui::MenuItem( "Show Compression Stats" ) )
+        {
+            m_isCompressionStatsWindowOpen = true;
+        }
+
+        if ( ImGui::MenuItem( "Show Load Time Stats" ) )
+        {
+            m_isLoadTimeStatsWindowOpen = true;
+        }
+
+        if ( ImGui::MenuItem( "Show Resident Cache" ) )
+        {
+            m_isResidentCacheWindowOpen = true;
+        }
+
+        if ( ImGui::MenuItem( "Show Load Timeline" ) )
+        {
+            m_isLoadTimelineWindowOpen = true;
+        }
     }
 
     //-------------------------------------------------------------------------
@@ -258,5 +303,340 @@ namespace KRG::Resource
         }
         ImGui::End();
     }
+
+    void ResourceDebugView::DrawCompressionStatsWindow( ResourceSystem* pResourceSystem, bool* pIsOpen )
+    {
+        KRG_ASSERT( pResourceSystem != nullptr );
+
+        if ( ImGui::Begin( "Resource Compression Stats", pIsOpen ) )
+        {
+            if ( ImGui::BeginTable( "Resource Compression Stats Table", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
+            {
+                ImGui::TableSetupColumn( "Type", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 30 );
+                ImGui::TableSetupColumn( "Count", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 40 );
+                ImGui::TableSetupColumn( "Compressed (KB)", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupColumn( "Uncompressed (KB)", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupColumn( "Ratio", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 50 );
+                ImGui::TableSetupColumn( "Decode (MB/s)", ImGuiTableColumnFlags_WidthStretch );
+
+                //-------------------------------------------------------------------------
+
+                ImGui::TableHeadersRow();
+
+                //-------------------------------------------------------------------------
+
+                for ( auto const& statsPair : pResourceSystem->m_compressionStats )
+                {
+                    auto const& stats = statsPair.second;
+
+                    ImGui::TableNextRow();
+
+                    ImGui::TableSetColumnIndex( 0 );
+                    ImGui::Text( "%s", statsPair.first.ToString().c_str() );
+
+                    ImGui::TableSetColumnIndex( 1 );
+                    ImGui::Text( "%u", stats.m_numResources );
+
+                    ImGui::TableSetColumnIndex( 2 );
+                    ImGui::Text( "%.2f", stats.m_compressedSize / 1024.0f );
+
+                    ImGui::TableSetColumnIndex( 3 );
+                    ImGui::Text( "%.2f", stats.m_uncompressedSize / 1024.0f );
+
+                    ImGui::TableSetColumnIndex( 4 );
+                    ImGui::Text( "%.2f", stats.GetCompressionRatio() );
+
+                    ImGui::TableSetColumnIndex( 5 );
+                    ImGui::Text( "%.2f", stats.GetDecodeThroughput() );
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+    }
+
+    void ResourceDebugView::DrawLoadTimeStatsWindow( ResourceSystem* pResourceSystem, bool* pIsOpen )
+    {
+        KRG_ASSERT( pResourceSystem != nullptr );
+
+        if ( ImGui::Begin( "Resource Load Time Stats", pIsOpen ) )
+        {
+            if ( ImGui::BeginTable( "Resource Load Time Stats Table", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
+            {
+                ImGui::TableSetupColumn( "Priority", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 70 );
+                ImGui::TableSetupColumn( "Count", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 40 );
+                ImGui::TableSetupColumn( "Avg Time To Ready (ms)", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupColumn( "Max Time To Ready (ms)", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupColumn( "Missed Deadlines", ImGuiTableColumnFlags_WidthStretch );
+
+                //-------------------------------------------------------------------------
+
+                ImGui::TableHeadersRow();
+
+                //-------------------------------------------------------------------------
+
+                for ( int32 i = (int32) LoadPriority::NumPriorities - 1; i >= 0; i-- )
+                {
+                    auto const& stats = pResourceSystem->m_loadTimeStats[i];
+
+                    ImGui::TableNextRow();
+
+                    ImGui::TableSetColumnIndex( 0 );
+                    ImGui::Text( GetLoadPriorityName( (LoadPriority) i ) );
+
+                    ImGui::TableSetColumnIndex( 1 );
+                    ImGui::Text( "%u", stats.m_numLoads );
+
+                    ImGui::TableSetColumnIndex( 2 );
+                    ImGui::Text( "%.2f", stats.GetAverageTimeToReady().ToFloat() );
+
+                    ImGui::TableSetColumnIndex( 3 );
+                    ImGui::Text( "%.2f", stats.m_maxTimeToReady.ToFloat() );
+
+                    ImGui::TableSetColumnIndex( 4 );
+                    if ( stats.m_numMissedDeadlines > 0 )
+                    {
+                        ImGui::TextColored( Colors::Red.ToFloat4(), "%u", stats.m_numMissedDeadlines );
+                    }
+                    else
+                    {
+                        ImGui::Text( "0" );
+                    }
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+    }
+
+    void ResourceDebugView::DrawResidentCacheWindow( ResourceSystem* pResourceSystem, bool* pIsOpen )
+    {
+        KRG_ASSERT( pResourceSystem != nullptr );
+
+        if ( ImGui::Begin( "Resource Resident Cache", pIsOpen ) )
+        {
+            if ( ImGui::Button( "Clear Cache" ) )
+            {
+                pResourceSystem->ClearResidentCache();
+            }
+
+            if ( ImGui::BeginTable( "Resource Resident Cache Table", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
+            {
+                ImGui::TableSetupColumn( "Type", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 30 );
+                ImGui::TableSetupColumn( "Count", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 40 );
+                ImGui::TableSetupColumn( "Budget Usage", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupColumn( "Used / Budget (MB)", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupColumn( "Hit Rate", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 60 );
+                ImGui::TableSetupColumn( "Evictions", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 60 );
+
+                //-------------------------------------------------------------------------
+
+                ImGui::TableHeadersRow();
+
+                //-------------------------------------------------------------------------
+
+                for ( auto const& typeCachePair : pResourceSystem->m_residentCache.GetTypeCaches() )
+                {
+                    auto const& typeCache = typeCachePair.second;
+                    float const usedMemoryMB = typeCache.m_usedMemory / ( 1024.0f * 1024.0f );
+                    float const budgetMB = typeCache.m_budget / ( 1024.0f * 1024.0f );
+
+                    ImGui::TableNextRow();
+
+                    ImGui::TableSetColumnIndex( 0 );
+                    ImGui::Text( typeCachePair.first.ToString().c_str() );
+
+                    ImGui::TableSetColumnIndex( 1 );
+                    ImGui::Text( "%u", (uint32) typeCache.m_records.size() );
+
+                    ImGui::TableSetColumnIndex( 2 );
+                    ImGui::ProgressBar( ( typeCache.m_budget > 0 ) ? float( typeCache.m_usedMemory ) / typeCache.m_budget : 0.0f );
+
+                    ImGui::TableSetColumnIndex( 3 );
+                    ImGui::Text( "%.2f / %.2f", usedMemoryMB, budgetMB );
+
+                    ImGui::TableSetColumnIndex( 4 );
+                    ImGui::Text( "%.1f%%", typeCache.GetHitRate() * 100.0f );
+                    if ( ImGui::IsItemHovered() )
+                    {
+                        ImGui::SetTooltip( "Hits: %u, Misses: %u", typeCache.m_numHits, typeCache.m_numMisses );
+                    }
+
+                    ImGui::TableSetColumnIndex( 5 );
+                    ImGui::Text( "%u", typeCache.m_numEvictions );
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+    }
+
+    void ResourceDebugView::DrawLoadTimelineWindow( ResourceSystem* pResourceSystem, bool* pIsOpen )
+    {
+        KRG_ASSERT( pResourceSystem != nullptr );
+
+        using LoadTrace = ResourceRequest::LoadTrace;
+
+        static Color const stageColors[LoadTrace::NumStages] = { Colors::Gray, Colors::Gold, Colors::DodgerBlue, Colors::LimeGreen, Colors::Orange, Colors::MediumPurple };
+        static char exportPath[256] = "ResourceLoadTrace.json";
+        static float timeWindow = 2000.0f;
+
+        if ( ImGui::Begin( "Resource Load Timeline", pIsOpen ) )
+        {
+            auto const& loadTraces = pResourceSystem->GetLoadTraces();
+
+            if ( ImGui::Button( "Clear" ) )
+            {
+                pResourceSystem->ClearLoadTraces();
+            }
+
+            ImGui::SameLine();
+            if ( ImGui::Button( "Export" ) )
+            {
+                FileSystem::Path const exportFilePath( exportPath );
+                if ( pResourceSystem->ExportLoadTraces( exportFilePath ) )
+                {
+                    KRG_LOG_MESSAGE( "Resource", "Exported %u resource load traces (%s)", (uint32) loadTraces.size(), exportFilePath.c_str() );
+                }
+            }
+
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth( 250 );
+            ImGui::InputText( "##ExportPath", exportPath, 256 );
+
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth( 100 );
+            ImGui::DragFloat( "Window (ms)", &timeWindow, 10.0f, 10.0f, 60000.0f, "%.0f" );
+
+            // Legend
+            //-------------------------------------------------------------------------
+
+            for ( uint8 i = 0; i < LoadTrace::NumStages; i++ )
+            {
+                if ( i > 0 )
+                {
+                    ImGui::SameLine();
+                }
+
+                ImGui::TextColored( stageColors[i].ToFloat4(), "%s", LoadTrace::GetStageName( (LoadTrace::Stage) i ) );
+            }
+
+            ImGui::Separator();
+
+            if ( loadTraces.empty() )
+            {
+                ImGui::Text( "No loads recorded" );
+                ImGui::End();
+                return;
+            }
+
+            // Timeline - the window ends at the last completed load, the most recent loads are at the top
+            //-------------------------------------------------------------------------
+
+            Milliseconds const timelineEnd = loadTraces.back().GetEndTime();
+            Milliseconds const timelineStart = timelineEnd - Milliseconds( timeWindow );
+
+            int32 numVisibleTraces = 0;
+            for ( int32 i = (int32) loadTraces.size() - 1; i >= 0; i-- )
+            {
+                if ( loadTraces[i].GetEndTime() < timelineStart )
+                {
+                    break;
+                }
+
+                numVisibleTraces++;
+            }
+
+            if ( ImGui::BeginTable( "Resource Load Timeline Table", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY ) )
+            {
+                ImGui::TableSetupColumn( "Resource", ImGuiTableColumnFlags_WidthFixed, 300 );
+                ImGui::TableSetupColumn( "Total (ms)", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 70 );
+                ImGui::TableSetupColumn( "Timeline", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupScrollFreeze( 0, 1 );
+
+                //-------------------------------------------------------------------------
+
+                ImGui::TableHeadersRow();
+
+                //-------------------------------------------------------------------------
+
+                int32 const lastEntryIdx = (int32) loadTraces.size() - 1;
+                float const rowHeight = ImGui::GetTextLineHeight();
+                ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+
+                ImGuiListClipper clipper;
+                clipper.Begin( numVisibleTraces );
+                while ( clipper.Step() )
+                {
+                    for ( int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++ )
+                    {
+                        auto const& loadTrace = loadTraces[lastEntryIdx - i];
+
+                        ImGui::TableNextRow();
+
+                        //-------------------------------------------------------------------------
+
+                        ImGui::TableSetColumnIndex( 0 );
+                        if ( loadTrace.m_wasSuccessful )
+                        {
+                            ImGui::Text( loadTrace.m_resourceID.c_str() );
+                        }
+                        else
+                        {
+                            ImGui::TextColored( Colors::Red.ToFloat4(), loadTrace.m_resourceID.c_str() );
+                        }
+
+                        //-------------------------------------------------------------------------
+
+                        ImGui::TableSetColumnIndex( 1 );
+                        ImGui::Text( "%.2f", ( loadTrace.GetEndTime() - loadTrace.GetStartTime() ).ToFloat() );
+
+                        //-------------------------------------------------------------------------
+
+                        ImGui::TableSetColumnIndex( 2 );
+                        ImVec2 const rowStart = ImGui::GetCursorScreenPos();
+                        float const rowWidth = ImGui::GetContentRegionAvail().x;
+                        float const pixelsPerMillisecond = rowWidth / timeWindow;
+
+                        for ( uint8 s = 0; s < LoadTrace::NumStages; s++ )
+                        {
+                            auto const stage = (LoadTrace::Stage) s;
+                            if ( !loadTrace.WasStageReached( stage ) )
+                            {
+                                continue;
+                            }
+
+                            float const stageStartX = Math::Max( 0.0f, ( loadTrace.m_stageStartTimes[s] - timelineStart ).ToFloat() * pixelsPerMillisecond );
+                            float const stageEndX = Math::Max( stageStartX + 1.0f, ( loadTrace.m_stageEndTimes[s] - timelineStart ).ToFloat() * pixelsPerMillisecond );
+                            pDrawList->AddRectFilled( ImVec2( rowStart.x + stageStartX, rowStart.y ), ImVec2( rowStart.x + stageEndX, rowStart.y + rowHeight ), ImGuiX::ConvertColor( stageColors[s] ) );
+                        }
+
+                        ImGui::Dummy( ImVec2( rowWidth, rowHeight ) );
+                        if ( ImGui::IsItemHovered() )
+                        {
+                            ImGui::BeginTooltip();
+                            ImGui::Text( loadTrace.m_resourceID.c_str() );
+                            ImGui::Separator();
+                            for ( uint8 s = 0; s < LoadTrace::NumStages; s++ )
+                            {
+                                auto const stage = (LoadTrace::Stage) s;
+                                ImGui::TextColored( stageColors[s].ToFloat4(), "%s: %.3fms", LoadTrace::GetStageName( stage ), loadTrace.GetStageDuration( stage ).ToFloat() );
+                            }
+                            ImGui::Separator();
+                            ImGui::Text( "Bytes Read: %.2f KB", loadTrace.m_bytesRead / 1024.0f );
+                            ImGui::Text( "Load Thread: %u, Install Thread: %u", loadTrace.m_loadThreadID, loadTrace.m_installThreadID );
+                            ImGui::EndTooltip();
+                        }
+                    }
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+    }
 }
 #endif
\ No newline at end of file
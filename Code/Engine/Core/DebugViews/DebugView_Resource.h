@@ -19,6 +19,10 @@ namespace KRG::Resource
 
         static void DrawResourceLogWindow( ResourceSystem* pResourceSystem, bool* pIsOpen );
         static void DrawReferenceTrackerWindow( ResourceSystem* pResourceSystem, bool* pIsOpen );
+        static void DrawCompressionStatsWindow( ResourceSystem* pResourceSystem, bool* pIsOpen );
+        static void DrawLoadTimeStatsWindow( ResourceSystem* pResourceSystem, bool* pIsOpen );
+        static void DrawResidentCacheWindow( ResourceSystem* pResourceSystem, bool* pIsOpen );
+        static void DrawLoadTimelineWindow( ResourceSystem* pResourceSystem, bool* pIsOpen );
 
     public:
 
@@ -37,6 +41,10 @@ namespace KRG::Resource
         ResourceSystem*         m_pResourceSystem = nullptr;
         bool                    m_isHistoryWindowOpen = false;
         bool                    m_isReferenceTrackerWindowOpen = false;
+        bool                    m_isCompressionStatsWindowOpen = false;
+        bool                    m_isLoadTimeStatsWindowOpen = false;
+        bool                    m_isResidentCacheWindowOpen = false;
+        bool                    m_isLoadTimelineWindowOpen = false;
     };
 }
 #endif
\ No newline at end of file
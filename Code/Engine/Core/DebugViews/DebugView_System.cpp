@@ -131,6 +131,85 @@ namespace KRG
         {
             Profiling::OpenProfiler();
         }
+
+        if ( ImGui::MenuItem( "Show Counters" ) )
+        {
+            m_isCountersWindowOpen = true;
+        }
+    }
+
+    void SystemDebugView::DrawWindows( EntityWorldUpdateContext const& context, ImGuiWindowClass* pWindowClass )
+    {
+        if ( m_isCountersWindowOpen )
+        {
+            ImGui::SetNextWindowBgAlpha( 0.75f );
+            DrawCountersWindow( &m_isCountersWindowOpen );
+        }
+    }
+
+    void SystemDebugView::DrawCountersWindow( bool* pIsOpen )
+    {
+        if ( ImGui::Begin( "Counters", pIsOpen ) )
+        {
+            if ( ImGui::Button( "Export CSV" ) )
+            {
+                Profiling::ExportCountersToCSV( FileSystem::Path( "Counters.csv" ) );
+            }
+
+            //-------------------------------------------------------------------------
+
+            if ( ImGui::BeginTable( "Counters Table", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
+            {
+                ImGui::TableSetupColumn( "Counter", ImGuiTableColumnFlags_WidthStretch );
+                ImGui::TableSetupColumn( "Last", ImGuiTableColumnFlags_WidthFixed, 60 );
+                ImGui::TableSetupColumn( "Avg", ImGuiTableColumnFlags_WidthFixed, 60 );
+                ImGui::TableSetupColumn( "Min", ImGuiTableColumnFlags_WidthFixed, 60 );
+                ImGui::TableSetupColumn( "Max", ImGuiTableColumnFlags_WidthFixed, 60 );
+                ImGui::TableSetupColumn( "P50", ImGuiTableColumnFlags_WidthFixed, 60 );
+                ImGui::TableSetupColumn( "P95", ImGuiTableColumnFlags_WidthFixed, 60 );
+                ImGui::TableSetupColumn( "P99", ImGuiTableColumnFlags_WidthFixed, 60 );
+
+                //-------------------------------------------------------------------------
+
+                ImGui::TableHeadersRow();
+
+                //-------------------------------------------------------------------------
+
+                for ( Profiling::Counter const* pCounter = Profiling::GetFirstCounter(); pCounter != nullptr; pCounter = pCounter->GetNext() )
+                {
+                    Profiling::Counter::Stats const stats = pCounter->GetStats();
+
+                    ImGui::TableNextRow();
+
+                    ImGui::TableSetColumnIndex( 0 );
+                    ImGui::Text( pCounter->GetName() );
+
+                    ImGui::TableSetColumnIndex( 1 );
+                    ImGui::Text( "%lld", (long long) stats.m_lastValue );
+
+                    ImGui::TableSetColumnIndex( 2 );
+                    ImGui::Text( "%.1f", stats.m_average );
+
+                    ImGui::TableSetColumnIndex( 3 );
+                    ImGui::Text( "%lld", (long long) stats.m_minValue );
+
+                    ImGui::TableSetColumnIndex( 4 );
+                    ImGui::Text( "%lld", (long long) stats.m_maxValue );
+
+                    ImGui::TableSetColumnIndex( 5 );
+                    ImGui::Text( "%lld", (long long) stats.m_p50 );
+
+                    ImGui::TableSetColumnIndex( 6 );
+                    ImGui::Text( "%lld", (long long) stats.m_p95 );
+
+                    ImGui::TableSetColumnIndex( 7 );
+                    ImGui::Text( "%lld", (long long) stats.m_p99 );
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
     }
 
     //-------------------------------------------------------------------------
@@ -181,15 +260,16 @@ namespace KRG
 
                 //-------------------------------------------------------------------------
 
-                auto const& logEntries = Log::GetLogEntries();
+                // Only copy the visible entries, the log can contain a large number of entries
+                TVector<Log::LogEntry> logEntries;
 
                 ImGuiListClipper clipper;
-                clipper.Begin( (int32) logEntries.size() );
+                clipper.Begin( Log::GetNumLogEntries() );
                 while ( clipper.Step() )
                 {
-                    for ( int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++ )
+                    Log::GetLogEntries( clipper.DisplayStart, clipper.DisplayEnd - clipper.DisplayStart, logEntries );
+                    for ( auto const& entry : logEntries )
                     {
-                        auto const& entry = logEntries[i];
 
                         switch ( entry.m_severity )
                         {
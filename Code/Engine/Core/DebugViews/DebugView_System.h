@@ -19,6 +19,7 @@ namespace KRG
     public:
 
         static bool DrawDebugSettingsView( UpdateContext const& context );
+        static void DrawCountersWindow( bool* pIsOpen );
 
     public:
 
@@ -26,8 +27,12 @@ namespace KRG
 
     private:
 
-        virtual void DrawWindows( EntityWorldUpdateContext const& context, ImGuiWindowClass* pWindowClass ) override {};
+        virtual void DrawWindows( EntityWorldUpdateContext const& context, ImGuiWindowClass* pWindowClass ) override;
         void DrawMenu( EntityWorldUpdateContext const& context );
+
+    private:
+
+        bool                                                m_isCountersWindowOpen = false;
     };
 
     //-------------------------------------------------------------------------
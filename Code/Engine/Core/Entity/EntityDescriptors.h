@@ -91,6 +91,9 @@ namespace KRG::EntityModel
 //-------------------------------------------------------------------------
 // This is a read-only resource that contains a collection of serialized entity descriptors
 // We used this to instantiate a collection of entities
+//
+// The compiler also emits a flattened manifest of every resource the collection transitively references
+// This allows all the loads to be issued at once rather than discovering them one level at a time
 //-------------------------------------------------------------------------
 
 namespace KRG::EntityModel
@@ -98,9 +101,10 @@ namespace KRG::EntityModel
     class KRG_ENGINE_CORE_API EntityCollectionDescriptor : public Resource::IResource
     {
         KRG_REGISTER_RESOURCE( 'EC', "Entity Collection" );
-        KRG_SERIALIZE_MEMBERS( m_entityDescriptors, m_entityLookupMap, m_entitySpatialAttachmentInfo );
+        KRG_SERIALIZE_MEMBERS( m_entityDescriptors, m_entityLookupMap, m_entitySpatialAttachmentInfo, m_resourceManifest );
 
         friend class EntityCollectionLoader;
+        friend class EntityCollectionCompiler;
 
     public:
 
@@ -148,7 +152,13 @@ namespace KRG::EntityModel
 
         void GenerateSpatialAttachmentInfo();
 
-        void Clear() { m_entityDescriptors.clear(); m_entityLookupMap.clear(); m_entitySpatialAttachmentInfo.clear(); }
+        void Clear() { m_entityDescriptors.clear(); m_entityLookupMap.clear(); m_entitySpatialAttachmentInfo.clear(); m_resourceManifest.clear(); }
+
+        // Resource Manifest
+        //-------------------------------------------------------------------------
+
+        // All resources (direct and transitive) that are needed by this collection's entities, only valid for compiled collections
+        inline TVector<ResourceID> const& GetResourceManifest() const { return m_resourceManifest; }
 
         // Entity Access
         //-------------------------------------------------------------------------
@@ -233,6 +243,7 @@ namespace KRG::EntityModel
         TVector<EntityDescriptor>                                   m_entityDescriptors;
         THashMap<StringID, int32>                                   m_entityLookupMap;
         TVector<SpatialAttachmentInfo>                              m_entitySpatialAttachmentInfo;
+        TVector<ResourceID>                                         m_resourceManifest;
     };
 }
 
@@ -36,6 +36,7 @@ namespace KRG::EntityModel
         KRG_ASSERT( IsUnloaded() && !m_isMapInstantiated );
         KRG_ASSERT( m_entities.empty() && m_entityIDLookupMap.empty() );
         KRG_ASSERT( m_entitiesToAdd.empty() && m_entitiesToRemove.empty() );
+        KRG_ASSERT( m_prefetchedResources.empty() );
 
         #if KRG_DEVELOPMENT_TOOLS
         KRG_ASSERT( m_entitiesToHotReload.empty() );
@@ -114,6 +115,7 @@ namespace KRG::EntityModel
         m_entities.swap( map.m_entities );
         m_entityIDLookupMap.swap( map.m_entityIDLookupMap );
         m_pMapDesc = eastl::move( map.m_pMapDesc );
+        m_prefetchedResources.swap( map.m_prefetchedResources );
         m_entitiesCurrentlyLoading = eastl::move( map.m_entitiesCurrentlyLoading );
         m_status = map.m_status;
         m_isUnloadRequested = map.m_isUnloadRequested;
@@ -506,6 +508,8 @@ namespace KRG::EntityModel
                 loadingContext.m_pResourceSystem->UnloadResource( m_pMapDesc );
             }
 
+            ReleasePrefetchedResources( loadingContext );
+
             m_status = Status::Unloaded;
             m_isUnloadRequested = false;
             return true;
@@ -534,6 +538,9 @@ namespace KRG::EntityModel
         {
             if ( m_pMapDesc->IsValid() )
             {
+                // Start loading everything the map needs before we instantiate it, so the IO overlaps with the instantiation
+                PrefetchMapResources( loadingContext );
+
                 // Create entities
                 TVector<Entity*> const createdEntities = m_pMapDesc.GetPtr()->InstantiateCollection( loadingContext.m_pTaskSystem, *loadingContext.m_pTypeRegistry );
 
@@ -568,6 +575,34 @@ namespace KRG::EntityModel
         return true;
     }
 
+    void EntityMap::PrefetchMapResources( EntityLoadingContext const& loadingContext )
+    {
+        KRG_ASSERT( m_pMapDesc.IsLoaded() && m_prefetchedResources.empty() );
+
+        // Prefetches are low priority, any real request for the same resource will raise the priority of the in-flight load
+        auto const& resourceManifest = m_pMapDesc->GetResourceManifest();
+        m_prefetchedResources.reserve( resourceManifest.size() );
+        for ( auto const& resourceID : resourceManifest )
+        {
+            auto& prefetchedResource = m_prefetchedResources.emplace_back( resourceID );
+            loadingContext.m_pResourceSystem->LoadResource( prefetchedResource, Resource::ResourceRequesterID(), Resource::LoadPriority::Background );
+        }
+
+        KRG_PROFILE_COUNTER_INCREMENT( "Resources Prefetched", (int64) resourceManifest.size() );
+    }
+
+    void EntityMap::ReleasePrefetchedResources( EntityLoadingContext const& loadingContext )
+    {
+        for ( auto& prefetchedResource : m_prefetchedResources )
+        {
+            loadingContext.m_pResourceSystem->UnloadResource( prefetchedResource );
+        }
+
+        m_prefetchedResources.clear();
+    }
+
+    //-------------------------------------------------------------------------
+
     void EntityMap::ProcessEntityAdditionAndRemoval( EntityLoadingContext const& loadingContext, EntityModel::ActivationContext& activationContext )
     {
         // Edited Entities
@@ -728,6 +763,9 @@ namespace KRG::EntityModel
         {
             KRG_ASSERT( !m_isTransientMap );
             m_status = Status::Loaded;
+
+            // The entities now hold their own references to all their resources
+            ReleasePrefetchedResources( loadingContext );
         }
 
         //-------------------------------------------------------------------------
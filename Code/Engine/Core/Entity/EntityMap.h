@@ -28,6 +28,7 @@ namespace KRG
         //
         // * Maps manage lifetime, loading and activation of entities
         // * All map operations are threadsafe using a standard mutex
+        // * Once the map descriptor is loaded, all resources in its manifest are prefetched so that their IO overlaps with instantiation
         //
         // There are some quirks with the addition/removal of entities:
         // * When adding an entity, it may take a frame to make it to the actual entities list but is immediately added to the lookup maps
@@ -201,11 +202,16 @@ namespace KRG
             // Destroy all created entity instances
             void DestroyAllEntities();
 
+            // Request all the resources in the map's manifest, these are held until the map's entities have finished loading
+            void PrefetchMapResources( EntityLoadingContext const& loadingContext );
+            void ReleasePrefetchedResources( EntityLoadingContext const& loadingContext );
+
         private:
 
             EntityMapID                                 m_ID = UUID::GenerateID(); // ID is always regenerated at creation time, do not rely on the ID being the same for a map on different runs
             Threading::RecursiveMutex                   m_mutex;
             TResourcePtr<EntityMapDescriptor>           m_pMapDesc;
+            TVector<Resource::ResourcePtr>              m_prefetchedResources;
             TVector<Entity*>                            m_entities;
             THashMap<EntityID, Entity*>                 m_entityIDLookupMap;
             TVector<Entity*>                            m_entitiesCurrentlyLoading;
@@ -249,6 +249,8 @@ namespace KRG
 
             virtual void ExecuteRange( TaskSetPartition range, uint32 threadnum ) override final
             {
+                int64 numEntitiesUpdated = 0;
+
                 for ( uint64 i = range.start; i < range.end; ++i )
                 {
                     auto pEntity = m_updateList[i];
@@ -259,6 +261,8 @@ namespace KRG
                         continue;
                     }
 
+                    numEntitiesUpdated++;
+
                     //-------------------------------------------------------------------------
 
                     if ( pEntity->HasAttachedEntities() )
@@ -272,6 +276,8 @@ namespace KRG
                         pEntity->UpdateSystems( m_context );
                     }
                 }
+
+                KRG_PROFILE_COUNTER_INCREMENT( "Entities Updated", numEntitiesUpdated );
             }
 
         private:
@@ -10,6 +10,7 @@ namespace KRG::EntityModel
     {
         m_loadableTypes.push_back( EntityCollectionDescriptor::GetStaticResourceTypeID() );
         m_loadableTypes.push_back( EntityMapDescriptor::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     void EntityCollectionLoader::SetTypeRegistry( TypeSystem::TypeRegistry const* pTypeRegistry )
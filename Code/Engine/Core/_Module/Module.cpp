@@ -63,6 +63,11 @@ namespace KRG::EngineCore
 
         m_taskSystem.Initialize();
         m_resourceSystem.Initialize( m_pResourceProvider );
+
+        for ( auto const& budgetPair : pResourceSettings->m_residentCacheBudgets )
+        {
+            m_resourceSystem.SetResidentCacheBudget( budgetPair.first, budgetPair.second );
+        }
         m_inputSystem.Initialize();
 
         #if KRG_DEVELOPMENT_TOOLS
@@ -9,6 +9,7 @@ namespace KRG::Navmesh
     NavmeshLoader::NavmeshLoader()
     {
         m_loadableTypes.push_back( NavmeshData::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     bool NavmeshLoader::LoadInternal( ResourceID const& resID, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryMemoryArchive& archive ) const
@@ -3,6 +3,7 @@
 #include "Engine/Physics/_Module/API.h"
 #include "Engine/Physics/PhysicsQuery.h"
 #include "Engine/Physics/PhysX.h"
+#include "System/Core/Profiling/Counters.h"
 
 //-------------------------------------------------------------------------
 
@@ -88,6 +89,7 @@ namespace KRG::Physics
             outResults.m_start = start;
             outResults.m_end = Vector::MultiplyAdd( unitDirection, Vector( distance ), start );
 
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->raycast( ToPx( start ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             return result;
         }
@@ -108,6 +110,7 @@ namespace KRG::Physics
             KRG_ASSERT( !unitDirection.IsNearZero3() );
 
             physx::PxSphereGeometry const sphereGeo( radius );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( sphereGeo, physx::PxTransform( ToPx( start ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -123,6 +126,7 @@ namespace KRG::Physics
             outResults.m_sweepEnd = Vector::MultiplyAdd( unitDirection, Vector( distance ), start );
 
             physx::PxSphereGeometry const sphereGeo( radius );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( sphereGeo, physx::PxTransform( ToPx( start ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -140,6 +144,7 @@ namespace KRG::Physics
             // Set the no block value for overlaps
             TScopedGuardValue guard( filter.m_filterData.flags, filter.m_filterData.flags | physx::PxQueryFlag::eNO_BLOCK );
             physx::PxSphereGeometry const sphereGeo( radius );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->overlap( sphereGeo, physx::PxTransform( ToPx( position ) ), outResults, filter.m_filterData, &filter );
             return result;
         }
@@ -165,6 +170,7 @@ namespace KRG::Physics
             physx::PxCapsuleGeometry const capsuleGeo( radius, cylinderPortionHalfHeight );
             physx::PxTransform Test( ToPx( start ), ToPx( orientation ) );
             KRG_ASSERT( Test.isValid() );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( capsuleGeo, physx::PxTransform( ToPx( start ), ToPx( orientation ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -185,6 +191,7 @@ namespace KRG::Physics
             physx::PxCapsuleGeometry const capsuleGeo( radius, cylinderPortionHalfHeight );
             physx::PxTransform Test( ToPx( start ), ToPx( orientation ) );
             KRG_ASSERT( Test.isValid() );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( capsuleGeo, physx::PxTransform( ToPx( start ), ToPx( orientation ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -204,6 +211,7 @@ namespace KRG::Physics
             // Set the no block value for overlaps
             TScopedGuardValue guard( filter.m_filterData.flags, filter.m_filterData.flags | physx::PxQueryFlag::eNO_BLOCK );
             physx::PxCapsuleGeometry const capsuleGeo( radius, cylinderPortionHalfHeight );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool result = m_pScene->overlap( capsuleGeo, physx::PxTransform( ToPx( position ), ToPx( orientation ) ), outResults, filter.m_filterData, &filter );
             return result;
         }
@@ -223,6 +231,7 @@ namespace KRG::Physics
             KRG_ASSERT( !unitDirection.IsNearZero3() );
 
             physx::PxConvexMeshGeometry const cylinderGeo( SharedMeshes::s_pUnitCylinderMesh, physx::PxMeshScale( physx::PxVec3( 2.0f * halfHeight, 2.0f * radius, 2.0f * radius ) ) );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( cylinderGeo, physx::PxTransform( ToPx( start ), ToPx( orientation ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -240,6 +249,7 @@ namespace KRG::Physics
             outResults.m_orientation = orientation;
 
             physx::PxConvexMeshGeometry const cylinderGeo( SharedMeshes::s_pUnitCylinderMesh, physx::PxMeshScale( physx::PxVec3( 2.0f * halfHeight, 2.0f * radius, 2.0f * radius ) ) );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( cylinderGeo, physx::PxTransform( ToPx( start ), ToPx( orientation ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -258,6 +268,7 @@ namespace KRG::Physics
             // Set the no block value for overlaps
             TScopedGuardValue guard( filter.m_filterData.flags, filter.m_filterData.flags | physx::PxQueryFlag::eNO_BLOCK );
             physx::PxConvexMeshGeometry const cylinderGeo( SharedMeshes::s_pUnitCylinderMesh, physx::PxMeshScale( physx::PxVec3( 2.0f * halfHeight, 2.0f * radius, 2.0f * radius ) ) );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->overlap( cylinderGeo, physx::PxTransform( ToPx( position ), ToPx( orientation ) ), outResults, filter.m_filterData, &filter );
             return result;
         }
@@ -275,6 +286,7 @@ namespace KRG::Physics
             outResults.m_orientation = orientation;
 
             physx::PxBoxGeometry const boxGeo( ToPx( halfExtents ) );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( boxGeo, physx::PxTransform( ToPx( start ), ToPx( orientation ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -294,6 +306,7 @@ namespace KRG::Physics
             outResults.m_orientation = orientation;
 
             physx::PxBoxGeometry const boxGeo( ToPx( halfExtents ) );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( boxGeo, physx::PxTransform( ToPx( start ), ToPx( orientation ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -312,6 +325,7 @@ namespace KRG::Physics
             // Set the no block value for overlaps
             TScopedGuardValue guard( filter.m_filterData.flags, filter.m_filterData.flags | physx::PxQueryFlag::eNO_BLOCK );
             physx::PxBoxGeometry const boxGeo( ToPx( halfExtents ) );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->overlap( boxGeo, physx::PxTransform( ToPx( position ), ToPx( orientation ) ), outResults, filter.m_filterData, &filter );
             return result;
         }
@@ -328,6 +342,7 @@ namespace KRG::Physics
             outResults.m_sweepEnd = Vector::MultiplyAdd( unitDirection, Vector( distance ), start );
             outResults.m_orientation = orientation;
 
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( pShape->getGeometry().any(), ToPx( Transform( orientation, start ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -345,6 +360,7 @@ namespace KRG::Physics
             outResults.m_sweepEnd = end;
             outResults.m_orientation = orientation;
 
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->sweep( pShape->getGeometry().any(), ToPx( Transform( orientation, start ) ), ToPx( unitDirection ), distance, outResults, filter.m_hitFlags, filter.m_filterData, &filter );
             outResults.CalculateFinalShapePosition( s_sweepSeperationDistance );
             return result;
@@ -362,6 +378,7 @@ namespace KRG::Physics
 
             // Set the no block value for overlaps
             TScopedGuardValue guard( filter.m_filterData.flags, filter.m_filterData.flags | physx::PxQueryFlag::eNO_BLOCK );
+            KRG_PROFILE_COUNTER_INCREMENT( "Physics Queries", 1 );
             bool const result = m_pScene->overlap( pShape->getGeometry().any(), ToPx( Transform( orientation, start ) ), outResults, filter.m_filterData, &filter );
             return result;
         }
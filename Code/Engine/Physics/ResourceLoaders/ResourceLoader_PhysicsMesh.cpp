@@ -37,6 +37,7 @@ namespace KRG::Physics
     PhysicsMeshLoader::PhysicsMeshLoader()
     {
         m_loadableTypes.push_back( PhysicsMesh::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     void PhysicsMeshLoader::SetPhysics( PhysicsSystem* pPhysicsSystem )
@@ -12,6 +12,78 @@ namespace KRG::Render
 
     //-------------------------------------------------------------------------
 
+    uint32 Mesh::SelectLOD( float screenSize ) const
+    {
+        // LOD thresholds are sorted from the most to the least detailed
+        uint32 lodIdx = 0;
+        for ( auto const& lod : m_LODs )
+        {
+            if ( screenSize > lod.m_maxScreenSize )
+            {
+                break;
+            }
+
+            lodIdx++;
+        }
+
+        return lodIdx;
+    }
+
+    float Mesh::CalculateScreenSize( OBB const& worldBounds, Vector const& viewPosition, Radians horizontalFOV )
+    {
+        float const boundsRadius = worldBounds.m_extents.GetLength3();
+        float const distance = viewPosition.GetDistance3( worldBounds.m_center );
+
+        // The camera is inside the bounds
+        if ( distance <= boundsRadius )
+        {
+            return FLT_MAX;
+        }
+
+        float const viewWidthAtDistance = 2.0f * distance * Math::Tan( horizontalFOV.ToFloat() / 2.0f );
+        return ( 2.0f * boundsRadius ) / viewWidthAtDistance;
+    }
+
+    //-------------------------------------------------------------------------
+
+    Vector Mesh::GetVertexPosition( int32 vertexIdx ) const
+    {
+        KRG_ASSERT( vertexIdx >= 0 && vertexIdx < GetNumVertices() );
+        Byte const* pVertexData = m_vertices.data() + ( vertexIdx * m_vertexBuffer.m_byteStride );
+
+        // All vertex formats start with the position
+        if ( HasCompactVertexFormat() )
+        {
+            auto pVertex = reinterpret_cast<StaticMeshCompactVertex const*>( pVertexData );
+            Vector const normalizedPosition( VertexCompression::DequantizeUNorm16( pVertex->m_position[0] ), VertexCompression::DequantizeUNorm16( pVertex->m_position[1] ), VertexCompression::DequantizeUNorm16( pVertex->m_position[2] ) );
+            return Vector::MultiplyAdd( normalizedPosition, m_positionDequantizationScale, m_positionDequantizationOffset ).GetWithW1();
+        }
+        else
+        {
+            auto pVertex = reinterpret_cast<StaticMeshVertex const*>( pVertexData );
+            return Vector( pVertex->m_position ).GetWithW1();
+        }
+    }
+
+    Vector Mesh::GetVertexNormal( int32 vertexIdx ) const
+    {
+        KRG_ASSERT( vertexIdx >= 0 && vertexIdx < GetNumVertices() );
+        Byte const* pVertexData = m_vertices.data() + ( vertexIdx * m_vertexBuffer.m_byteStride );
+
+        if ( HasCompactVertexFormat() )
+        {
+            auto pVertex = reinterpret_cast<StaticMeshCompactVertex const*>( pVertexData );
+            return VertexCompression::DecodeOctahedralNormal( pVertex->m_normal );
+        }
+        else
+        {
+            auto pVertex = reinterpret_cast<StaticMeshVertex const*>( pVertexData );
+            return Vector( pVertex->m_normal ).GetWithW0();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     #if KRG_DEVELOPMENT_TOOLS
     void Mesh::DrawNormals( Drawing::DrawContext& drawingContext, Transform const& worldTransform ) const
     {
@@ -20,6 +20,9 @@ namespace KRG::Drawing { class DrawContext; }
 // Notes:
 // * KRG uses CCW to determine the facing direction
 // * Meshes use the triangle list topology
+// * Lower detail LODs share the vertex buffer and store their indices after the LOD0 indices, each LOD has the same sections (and materials) as LOD0
+// * Screen size is the diameter of the mesh bounds projected onto the viewport, relative to the viewport width
+// * Compact vertex formats store positions normalized to the mesh bounds, position = offset + ( quantized position * scale )
 
 namespace KRG::Render
 {
@@ -28,7 +31,7 @@ namespace KRG::Render
         friend class MeshCompiler;
         friend class MeshLoader;
 
-        KRG_SERIALIZE_MEMBERS( KRG_NVP( m_vertices ), KRG_NVP( m_indices ), KRG_NVP( m_sections ), KRG_NVP( m_materials ), KRG_NVP( m_vertexBuffer ), KRG_NVP( m_indexBuffer ), KRG_NVP( m_bounds ) );
+        KRG_SERIALIZE_MEMBERS( KRG_NVP( m_vertices ), KRG_NVP( m_indices ), KRG_NVP( m_sections ), KRG_NVP( m_LODs ), KRG_NVP( m_materials ), KRG_NVP( m_vertexBuffer ), KRG_NVP( m_indexBuffer ), KRG_NVP( m_bounds ), KRG_NVP( m_positionDequantizationOffset ), KRG_NVP( m_positionDequantizationScale ) );
 
     public:
 
@@ -44,6 +47,15 @@ namespace KRG::Render
             uint32                          m_numIndices = 0;
         };
 
+        struct KRG_ENGINE_RENDER_API LOD
+        {
+            KRG_SERIALIZE_MEMBERS( m_sections, m_maxScreenSize, m_error );
+
+            TVector<GeometrySection>        m_sections;
+            float                           m_maxScreenSize = 0.0f;     // This LOD is used when the screen size of the mesh is below this value
+            float                           m_error = 0.0f;             // The simplification error relative to the mesh bounds diameter
+        };
+
     public:
 
         virtual bool IsValid() const override
@@ -59,6 +71,13 @@ namespace KRG::Render
         inline int32 const GetNumVertices() const { return m_vertexBuffer.m_byteSize / m_vertexBuffer.m_byteStride; }
         inline VertexFormat const& GetVertexFormat() const { return m_vertexBuffer.m_vertexFormat; }
         inline RenderBuffer const& GetVertexBuffer() const { return m_vertexBuffer; }
+        inline bool HasCompactVertexFormat() const { return VertexCompression::IsCompactFormat( m_vertexBuffer.m_vertexFormat ); }
+        inline Vector const& GetPositionDequantizationOffset() const { return m_positionDequantizationOffset; }
+        inline Vector const& GetPositionDequantizationScale() const { return m_positionDequantizationScale; }
+
+        // Decode the vertex data (for any vertex format) - this matches the vertex shader decode
+        Vector GetVertexPosition( int32 vertexIdx ) const;
+        Vector GetVertexNormal( int32 vertexIdx ) const;
 
         // Indices
         inline TVector<uint32> const& GetIndices() const { return m_indices; }
@@ -70,6 +89,17 @@ namespace KRG::Render
         inline uint32 GetNumSections() const { return (uint32) m_sections.size(); }
         inline GeometrySection GetSection( uint32 i ) const { KRG_ASSERT( i < GetNumSections() ); return m_sections[i]; }
 
+        // LODs - LOD0 is the full detail mesh (i.e. the mesh sections)
+        inline uint32 GetNumLODs() const { return (uint32) m_LODs.size() + 1; }
+        inline TVector<GeometrySection> const& GetLODSections( uint32 lodIdx ) const { KRG_ASSERT( lodIdx < GetNumLODs() ); return ( lodIdx == 0 ) ? m_sections : m_LODs[lodIdx - 1].m_sections; }
+        inline GeometrySection GetLODSection( uint32 lodIdx, uint32 i ) const { KRG_ASSERT( i < GetNumSections() ); return GetLODSections( lodIdx )[i]; }
+
+        // Returns the lowest detail LOD that is allowed for the specified screen size
+        uint32 SelectLOD( float screenSize ) const;
+
+        // Calculate the screen size of the supplied world bounds for a perspective view with the specified horizontal FOV
+        static float CalculateScreenSize( OBB const& worldBounds, Vector const& viewPosition, Radians horizontalFOV );
+
         // Materials
         TVector<TResourcePtr<Material>> const& GetMaterials() const { return m_materials; }
 
@@ -83,9 +113,12 @@ namespace KRG::Render
         TVector<Byte>                       m_vertices;
         TVector<uint32>                     m_indices;
         TVector<GeometrySection>            m_sections;
+        TVector<LOD>                        m_LODs;
         TVector<TResourcePtr<Material>>     m_materials;
         VertexBuffer                        m_vertexBuffer;
         RenderBuffer                        m_indexBuffer;
         OBB                                 m_bounds;
+        Vector                              m_positionDequantizationOffset = Vector::Zero;
+        Vector                              m_positionDequantizationScale = Vector::One;
     };
 }
\ No newline at end of file
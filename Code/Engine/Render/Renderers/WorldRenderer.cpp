@@ -16,6 +16,18 @@
 
 namespace KRG::Render
 {
+    // Select the mesh LOD based on the screen size of the component, all passes use the LOD selected for the main view
+    static uint32 SelectMeshLOD( Viewport const& viewport, Mesh const* pMesh, OBB const& worldBounds )
+    {
+        if ( pMesh->GetNumLODs() == 1 || !viewport.GetViewVolume().IsPerspective() )
+        {
+            return 0;
+        }
+
+        float const screenSize = Mesh::CalculateScreenSize( worldBounds, viewport.GetViewPosition(), viewport.GetViewVolume().GetFOV() );
+        return pMesh->SelectLOD( screenSize );
+    }
+
     static Matrix ComputeShadowMatrix( Viewport const& viewport, Transform const& lightWorldTransform, float shadowDistance )
     {
         Transform lightTransform = lightWorldTransform;
@@ -92,6 +104,10 @@ namespace KRG::Render
         m_vertexShaderStatic = VertexShader( g_byteCode_VS_StaticPrimitive, sizeof( g_byteCode_VS_StaticPrimitive ), cbuffers, vertexLayoutDescStatic );
         m_pRenderDevice->CreateShader( m_vertexShaderStatic );
 
+        auto const vertexLayoutDescStaticCompact = VertexLayoutRegistry::GetDescriptorForFormat( VertexFormat::StaticMeshCompact );
+        m_vertexShaderStaticCompact = VertexShader( g_byteCode_VS_StaticPrimitiveCompact, sizeof( g_byteCode_VS_StaticPrimitiveCompact ), cbuffers, vertexLayoutDescStaticCompact );
+        m_pRenderDevice->CreateShader( m_vertexShaderStaticCompact );
+
         // Create Skeletal Mesh Vertex Shader
         //-------------------------------------------------------------------------
 
@@ -107,7 +123,13 @@ namespace KRG::Render
         m_vertexShaderSkeletal = VertexShader( g_byteCode_VS_SkinnedPrimitive, sizeof( g_byteCode_VS_SkinnedPrimitive ), cbuffers, vertexLayoutDescSkeletal );
         pRenderDevice->CreateShader( m_vertexShaderSkeletal );
 
-        if ( !m_vertexShaderStatic.IsValid() )
+        // Both compact skeletal formats use the same shader, the bone weights are expanded from the normalized integer formats
+        auto const vertexLayoutDescSkeletalCompact = VertexLayoutRegistry::GetDescriptorForFormat( VertexFormat::SkeletalMeshCompact );
+        auto const vertexLayoutDescSkeletalCompactWeights16 = VertexLayoutRegistry::GetDescriptorForFormat( VertexFormat::SkeletalMeshCompactWeights16 );
+        m_vertexShaderSkeletalCompact = VertexShader( g_byteCode_VS_SkinnedPrimitiveCompact, sizeof( g_byteCode_VS_SkinnedPrimitiveCompact ), cbuffers, vertexLayoutDescSkeletalCompact );
+        pRenderDevice->CreateShader( m_vertexShaderSkeletalCompact );
+
+        if ( !m_vertexShaderStatic.IsValid() || !m_vertexShaderStaticCompact.IsValid() || !m_vertexShaderSkeletalCompact.IsValid() )
         {
             return false;
         }
@@ -287,6 +309,24 @@ namespace KRG::Render
             return false;
         }
 
+        m_pRenderDevice->CreateShaderInputBinding( m_vertexShaderStaticCompact, vertexLayoutDescStaticCompact, m_inputBindingStaticCompact );
+        if ( !m_inputBindingStaticCompact.IsValid() )
+        {
+            return false;
+        }
+
+        m_pRenderDevice->CreateShaderInputBinding( m_vertexShaderSkeletalCompact, vertexLayoutDescSkeletalCompact, m_inputBindingSkeletalCompact );
+        if ( !m_inputBindingSkeletalCompact.IsValid() )
+        {
+            return false;
+        }
+
+        m_pRenderDevice->CreateShaderInputBinding( m_vertexShaderSkeletalCompact, vertexLayoutDescSkeletalCompactWeights16, m_inputBindingSkeletalCompactWeights16 );
+        if ( !m_inputBindingSkeletalCompactWeights16.IsValid() )
+        {
+            return false;
+        }
+
         // Set up pipeline states
         //-------------------------------------------------------------------------
 
@@ -316,6 +356,21 @@ namespace KRG::Render
         m_pipelineStateSkeletalShadow.m_pBlendState = &m_blendState;
         m_pipelineStateSkeletalShadow.m_pRasterizerState = &m_rasterizerState;
 
+        // The compact vertex format pipelines only differ in the vertex shader
+        m_pipelineStateStaticCompact = m_pipelineStateStatic;
+        m_pipelineStateStaticCompact.m_pVertexShader = &m_vertexShaderStaticCompact;
+        m_pipelineStateStaticCompactPicking = m_pipelineStateStaticPicking;
+        m_pipelineStateStaticCompactPicking.m_pVertexShader = &m_vertexShaderStaticCompact;
+        m_pipelineStateStaticCompactShadow = m_pipelineStateStaticShadow;
+        m_pipelineStateStaticCompactShadow.m_pVertexShader = &m_vertexShaderStaticCompact;
+
+        m_pipelineStateSkeletalCompact = m_pipelineStateSkeletal;
+        m_pipelineStateSkeletalCompact.m_pVertexShader = &m_vertexShaderSkeletalCompact;
+        m_pipelineStateSkeletalCompactPicking = m_pipelineStateSkeletalPicking;
+        m_pipelineStateSkeletalCompactPicking.m_pVertexShader = &m_vertexShaderSkeletalCompact;
+        m_pipelineStateSkeletalCompactShadow = m_pipelineStateSkeletalShadow;
+        m_pipelineStateSkeletalCompactShadow.m_pVertexShader = &m_vertexShaderSkeletalCompact;
+
         m_pipelineSkybox.m_pVertexShader = &m_vertexShaderSkybox;
         m_pipelineSkybox.m_pPixelShader = &m_pixelShaderSkybox;
 
@@ -341,6 +396,8 @@ namespace KRG::Render
     {
         m_pipelineStateStatic.Clear();
         m_pipelineStateSkeletal.Clear();
+        m_pipelineStateStaticCompact.Clear();
+        m_pipelineStateSkeletalCompact.Clear();
 
         if ( m_inputBindingStatic.IsValid() )
         {
@@ -352,6 +409,21 @@ namespace KRG::Render
             m_pRenderDevice->DestroyShaderInputBinding( m_inputBindingSkeletal );
         }
 
+        if ( m_inputBindingStaticCompact.IsValid() )
+        {
+            m_pRenderDevice->DestroyShaderInputBinding( m_inputBindingStaticCompact );
+        }
+
+        if ( m_inputBindingSkeletalCompact.IsValid() )
+        {
+            m_pRenderDevice->DestroyShaderInputBinding( m_inputBindingSkeletalCompact );
+        }
+
+        if ( m_inputBindingSkeletalCompactWeights16.IsValid() )
+        {
+            m_pRenderDevice->DestroyShaderInputBinding( m_inputBindingSkeletalCompactWeights16 );
+        }
+
         if ( m_rasterizerState.IsValid() )
         {
             m_pRenderDevice->DestroyRasterizerState( m_rasterizerState );
@@ -387,6 +459,16 @@ namespace KRG::Render
             m_pRenderDevice->DestroyShader( m_vertexShaderSkeletal );
         }
 
+        if ( m_vertexShaderStaticCompact.IsValid() )
+        {
+            m_pRenderDevice->DestroyShader( m_vertexShaderStaticCompact );
+        }
+
+        if ( m_vertexShaderSkeletalCompact.IsValid() )
+        {
+            m_pRenderDevice->DestroyShader( m_vertexShaderSkeletalCompact );
+        }
+
         if ( m_pixelShader.IsValid() )
         {
             m_pRenderDevice->DestroyShader( m_pixelShader );
@@ -518,6 +600,60 @@ namespace KRG::Render
         }
     }
 
+    PipelineState const* WorldRenderer::SetMeshPipelineState( VertexFormat vertexFormat, MeshPass pass )
+    {
+        PipelineState const* pPipelineState = nullptr;
+        ShaderInputBindingHandle const* pInputBinding = nullptr;
+
+        switch ( vertexFormat )
+        {
+            case VertexFormat::StaticMesh:
+            {
+                PipelineState const* pipelineStates[] = { &m_pipelineStateStatic, &m_pipelineStateStaticPicking, &m_pipelineStateStaticShadow };
+                pPipelineState = pipelineStates[(int32) pass];
+                pInputBinding = &m_inputBindingStatic;
+            }
+            break;
+
+            case VertexFormat::StaticMeshCompact:
+            {
+                PipelineState const* pipelineStates[] = { &m_pipelineStateStaticCompact, &m_pipelineStateStaticCompactPicking, &m_pipelineStateStaticCompactShadow };
+                pPipelineState = pipelineStates[(int32) pass];
+                pInputBinding = &m_inputBindingStaticCompact;
+            }
+            break;
+
+            case VertexFormat::SkeletalMesh:
+            {
+                PipelineState const* pipelineStates[] = { &m_pipelineStateSkeletal, &m_pipelineStateSkeletalPicking, &m_pipelineStateSkeletalShadow };
+                pPipelineState = pipelineStates[(int32) pass];
+                pInputBinding = &m_inputBindingSkeletal;
+            }
+            break;
+
+            case VertexFormat::SkeletalMeshCompact:
+            case VertexFormat::SkeletalMeshCompactWeights16:
+            {
+                PipelineState const* pipelineStates[] = { &m_pipelineStateSkeletalCompact, &m_pipelineStateSkeletalCompactPicking, &m_pipelineStateSkeletalCompactShadow };
+                pPipelineState = pipelineStates[(int32) pass];
+                pInputBinding = ( vertexFormat == VertexFormat::SkeletalMeshCompact ) ? &m_inputBindingSkeletalCompact : &m_inputBindingSkeletalCompactWeights16;
+            }
+            break;
+
+            default:
+            {
+                KRG_UNREACHABLE_CODE();
+                return nullptr;
+            }
+        }
+
+        // Setting the pipeline state clears the input binding
+        auto const& renderContext = m_pRenderDevice->GetImmediateContext();
+        renderContext.SetPipelineState( *pPipelineState );
+        renderContext.SetShaderInputBinding( *pInputBinding );
+        return pPipelineState;
+    }
+
     void WorldRenderer::RenderStaticMeshes( Viewport const& viewport, RenderTarget const& renderTarget, RenderData const& data )
     {
         KRG_PROFILE_FUNCTION_RENDER();
@@ -527,24 +663,34 @@ namespace KRG::Render
         // Set primary render state and clear the render buffer
         //-------------------------------------------------------------------------
 
-        PipelineState* pPipelineState = renderTarget.HasPickingRT() ? &m_pipelineStateStaticPicking : &m_pipelineStateStatic;
-        SetupRenderStates( viewport, pPipelineState->m_pPixelShader, data );
-
-        renderContext.SetPipelineState( *pPipelineState );
-        renderContext.SetShaderInputBinding( m_inputBindingStatic );
+        MeshPass const meshPass = renderTarget.HasPickingRT() ? MeshPass::Picking : MeshPass::Default;
+        SetupRenderStates( viewport, renderTarget.HasPickingRT() ? &m_pixelShaderPicking : &m_pixelShader, data );
         renderContext.SetPrimitiveTopology( Topology::TriangleList );
 
         //-------------------------------------------------------------------------
 
+        VertexFormat currentVertexFormat = VertexFormat::Unknown;
+        PipelineState const* pPipelineState = nullptr;
+
         for ( StaticMeshComponent const* pMeshComponent : data.m_staticMeshComponents )
         {
             auto pMesh = pMeshComponent->GetMesh();
+
+            // Switch the vertex shader and input binding whenever the vertex format changes
+            if ( pMesh->GetVertexFormat() != currentVertexFormat )
+            {
+                currentVertexFormat = pMesh->GetVertexFormat();
+                pPipelineState = SetMeshPipelineState( currentVertexFormat, meshPass );
+            }
+
             Matrix worldTransform = pMeshComponent->GetWorldTransform().ToMatrix();
             ObjectTransforms transforms = data.m_transforms;
             transforms.m_worldTransform = worldTransform;
             transforms.m_worldTransform.SetTranslation( worldTransform.GetTranslation() );
             transforms.m_normalTransform = transforms.m_worldTransform.GetInverse().Transpose();
-            renderContext.WriteToBuffer( m_vertexShaderStatic.GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
+            transforms.m_positionDequantizationOffset = pMesh->GetPositionDequantizationOffset();
+            transforms.m_positionDequantizationScale = pMesh->GetPositionDequantizationScale();
+            renderContext.WriteToBuffer( pPipelineState->m_pVertexShader->GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
 
             if ( renderTarget.HasPickingRT() )
             {
@@ -556,10 +702,18 @@ namespace KRG::Render
             renderContext.SetIndexBuffer( pMesh->GetIndexBuffer() );
 
             TVector<Material const*> const& materials = pMeshComponent->GetMaterials();
+            uint32 const lodIdx = SelectMeshLOD( viewport, pMesh, pMeshComponent->GetWorldBounds() );
 
             auto const numSubMeshes = pMesh->GetNumSections();
             for ( auto i = 0u; i < numSubMeshes; i++ )
             {
+                // Sections can be fully simplified away in lower LODs
+                auto const subMesh = pMesh->GetLODSection( lodIdx, i );
+                if ( subMesh.m_numIndices == 0 )
+                {
+                    continue;
+                }
+
                 if ( i < materials.size() && materials[i] )
                 {
                     SetMaterial( renderContext, *pPipelineState->m_pPixelShader, materials[i] );
@@ -569,7 +723,6 @@ namespace KRG::Render
                     SetDefaultMaterial( renderContext, *pPipelineState->m_pPixelShader );
                 }
 
-                auto const& subMesh = pMesh->GetSection( i );
                 renderContext.DrawIndexed( subMesh.m_numIndices, subMesh.m_startIndex );
             }
         }
@@ -585,16 +738,15 @@ namespace KRG::Render
         // Set primary render state and clear the render buffer
         //-------------------------------------------------------------------------
 
-        PipelineState* pPipelineState = renderTarget.HasPickingRT() ? &m_pipelineStateSkeletalPicking : &m_pipelineStateSkeletal;
-        SetupRenderStates( viewport, pPipelineState->m_pPixelShader, data );
-
-        renderContext.SetPipelineState( *pPipelineState );
-        renderContext.SetShaderInputBinding( m_inputBindingSkeletal );
+        MeshPass const meshPass = renderTarget.HasPickingRT() ? MeshPass::Picking : MeshPass::Default;
+        SetupRenderStates( viewport, renderTarget.HasPickingRT() ? &m_pixelShaderPicking : &m_pixelShader, data );
         renderContext.SetPrimitiveTopology( Topology::TriangleList );
 
         //-------------------------------------------------------------------------
 
         SkeletalMesh const* pCurrentMesh = nullptr;
+        VertexFormat currentVertexFormat = VertexFormat::Unknown;
+        PipelineState const* pPipelineState = nullptr;
 
         for ( SkeletalMeshComponent const* pMeshComponent : data.m_skeletalMeshComponents )
         {
@@ -603,6 +755,13 @@ namespace KRG::Render
                 pCurrentMesh = pMeshComponent->GetMesh();
                 KRG_ASSERT( pCurrentMesh != nullptr && pCurrentMesh->IsValid() );
 
+                // Switch the vertex shader and input binding whenever the vertex format changes
+                if ( pCurrentMesh->GetVertexFormat() != currentVertexFormat )
+                {
+                    currentVertexFormat = pCurrentMesh->GetVertexFormat();
+                    pPipelineState = SetMeshPipelineState( currentVertexFormat, meshPass );
+                }
+
                 renderContext.SetVertexBuffer( pCurrentMesh->GetVertexBuffer() );
                 renderContext.SetIndexBuffer( pCurrentMesh->GetIndexBuffer() );
             }
@@ -615,9 +774,11 @@ namespace KRG::Render
             transforms.m_worldTransform = worldTransform;
             transforms.m_worldTransform.SetTranslation( worldTransform.GetTranslation() );
             transforms.m_normalTransform = transforms.m_worldTransform.GetInverse().Transpose();
-            renderContext.WriteToBuffer( m_vertexShaderSkeletal.GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
+            transforms.m_positionDequantizationOffset = pCurrentMesh->GetPositionDequantizationOffset();
+            transforms.m_positionDequantizationScale = pCurrentMesh->GetPositionDequantizationScale();
+            renderContext.WriteToBuffer( pPipelineState->m_pVertexShader->GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
 
-            auto const& bonesConstBuffer = m_vertexShaderSkeletal.GetConstBuffer( 1 );
+            auto const& bonesConstBuffer = pPipelineState->m_pVertexShader->GetConstBuffer( 1 );
             auto const& boneTransforms = pMeshComponent->GetSkinningTransforms();
             KRG_ASSERT( boneTransforms.size() == pCurrentMesh->GetNumBones() );
             renderContext.WriteToBuffer( bonesConstBuffer, boneTransforms.data(), sizeof( Matrix ) * pCurrentMesh->GetNumBones() );
@@ -632,10 +793,18 @@ namespace KRG::Render
             //-------------------------------------------------------------------------
 
             TVector<Material const*> const& materials = pMeshComponent->GetMaterials();
+            uint32 const lodIdx = SelectMeshLOD( viewport, pCurrentMesh, pMeshComponent->GetWorldBounds() );
 
             auto const numSubMeshes = pCurrentMesh->GetNumSections();
             for ( auto i = 0u; i < numSubMeshes; i++ )
             {
+                // Sections can be fully simplified away in lower LODs
+                auto const subMesh = pCurrentMesh->GetLODSection( lodIdx, i );
+                if ( subMesh.m_numIndices == 0 )
+                {
+                    continue;
+                }
+
                 if ( i < materials.size() && materials[i] )
                 {
                     SetMaterial( renderContext, *pPipelineState->m_pPixelShader, materials[i] );
@@ -646,7 +815,6 @@ namespace KRG::Render
                 }
 
                 // Draw mesh
-                auto const& subMesh = pCurrentMesh->GetSection( i );
                 renderContext.DrawIndexed( subMesh.m_numIndices, subMesh.m_startIndex );
             }
         }
@@ -695,48 +863,68 @@ namespace KRG::Render
         // Static Meshes
         //-------------------------------------------------------------------------
 
-        renderContext.SetPipelineState( m_pipelineStateStaticShadow );
-        renderContext.SetShaderInputBinding( m_inputBindingStatic );
         renderContext.SetPrimitiveTopology( Topology::TriangleList );
 
+        VertexFormat currentVertexFormat = VertexFormat::Unknown;
+        PipelineState const* pPipelineState = nullptr;
+
         for ( StaticMeshComponent const* pMeshComponent : data.m_staticMeshComponents )
         {
             auto pMesh = pMeshComponent->GetMesh();
+
+            if ( pMesh->GetVertexFormat() != currentVertexFormat )
+            {
+                currentVertexFormat = pMesh->GetVertexFormat();
+                pPipelineState = SetMeshPipelineState( currentVertexFormat, MeshPass::Shadow );
+            }
+
             Matrix worldTransform = pMeshComponent->GetWorldTransform().ToMatrix();
             transforms.m_worldTransform = worldTransform;
-            renderContext.WriteToBuffer( m_vertexShaderStatic.GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
+            transforms.m_positionDequantizationOffset = pMesh->GetPositionDequantizationOffset();
+            transforms.m_positionDequantizationScale = pMesh->GetPositionDequantizationScale();
+            renderContext.WriteToBuffer( pPipelineState->m_pVertexShader->GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
 
             renderContext.SetVertexBuffer( pMesh->GetVertexBuffer() );
             renderContext.SetIndexBuffer( pMesh->GetIndexBuffer() );
 
+            uint32 const lodIdx = SelectMeshLOD( viewport, pMesh, pMeshComponent->GetWorldBounds() );
             auto const numSubMeshes = pMesh->GetNumSections();
             for ( auto i = 0u; i < numSubMeshes; i++ )
             {
-                auto const& subMesh = pMesh->GetSection( i );
-                renderContext.DrawIndexed( subMesh.m_numIndices, subMesh.m_startIndex );
+                auto const subMesh = pMesh->GetLODSection( lodIdx, i );
+                if ( subMesh.m_numIndices > 0 )
+                {
+                    renderContext.DrawIndexed( subMesh.m_numIndices, subMesh.m_startIndex );
+                }
             }
         }
 
         // Skeletal Meshes
         //-------------------------------------------------------------------------
 
-        renderContext.SetPipelineState( m_pipelineStateSkeletalShadow );
-        renderContext.SetShaderInputBinding( m_inputBindingSkeletal );
-        renderContext.SetPrimitiveTopology( Topology::TriangleList );
+        currentVertexFormat = VertexFormat::Unknown;
 
         for ( SkeletalMeshComponent const* pMeshComponent : data.m_skeletalMeshComponents )
         {
             auto pMesh = pMeshComponent->GetMesh();
 
+            if ( pMesh->GetVertexFormat() != currentVertexFormat )
+            {
+                currentVertexFormat = pMesh->GetVertexFormat();
+                pPipelineState = SetMeshPipelineState( currentVertexFormat, MeshPass::Shadow );
+            }
+
             // Update Bones and Transforms
             //-------------------------------------------------------------------------
 
             Matrix worldTransform = pMeshComponent->GetWorldTransform().ToMatrix();
             transforms.m_worldTransform = worldTransform;
             transforms.m_worldTransform.SetTranslation( worldTransform.GetTranslation() );
-            renderContext.WriteToBuffer( m_vertexShaderSkeletal.GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
+            transforms.m_positionDequantizationOffset = pMesh->GetPositionDequantizationOffset();
+            transforms.m_positionDequantizationScale = pMesh->GetPositionDequantizationScale();
+            renderContext.WriteToBuffer( pPipelineState->m_pVertexShader->GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
 
-            auto const& bonesConstBuffer = m_vertexShaderSkeletal.GetConstBuffer( 1 );
+            auto const& bonesConstBuffer = pPipelineState->m_pVertexShader->GetConstBuffer( 1 );
             auto const& boneTransforms = pMeshComponent->GetSkinningTransforms();
             KRG_ASSERT( boneTransforms.size() == pMesh->GetNumBones() );
             renderContext.WriteToBuffer( bonesConstBuffer, boneTransforms.data(), sizeof( Matrix ) * pMesh->GetNumBones() );
@@ -746,12 +934,16 @@ namespace KRG::Render
 
             // Draw sub-meshes
             //-------------------------------------------------------------------------
+            uint32 const lodIdx = SelectMeshLOD( viewport, pMesh, pMeshComponent->GetWorldBounds() );
             auto const numSubMeshes = pMesh->GetNumSections();
             for ( auto i = 0u; i < numSubMeshes; i++ )
             {
                 // Draw mesh
-                auto const& subMesh = pMesh->GetSection( i );
-                renderContext.DrawIndexed( subMesh.m_numIndices, subMesh.m_startIndex );
+                auto const subMesh = pMesh->GetLODSection( lodIdx, i );
+                if ( subMesh.m_numIndices > 0 )
+                {
+                    renderContext.DrawIndexed( subMesh.m_numIndices, subMesh.m_startIndex );
+                }
             }
         }
     }
@@ -47,6 +47,13 @@ namespace KRG::Render
             MAX_PUNCTUAL_LIGHTS = 16,
         };
 
+        enum class MeshPass
+        {
+            Default,
+            Picking,
+            Shadow,
+        };
+
         struct PunctualLight
         {
             Vector m_positionInvRadiusSqr;
@@ -96,6 +103,8 @@ namespace KRG::Render
             Matrix  m_worldTransform = Matrix( ZeroInit );
             Matrix  m_normalTransform = Matrix( ZeroInit );
             Matrix  m_viewprojTransform = Matrix( ZeroInit );
+            Vector  m_positionDequantizationOffset = Vector::Zero;
+            Vector  m_positionDequantizationScale = Vector::One;
         };
 
         struct RenderData //TODO: optimize - there should not be per frame updates
@@ -132,6 +141,9 @@ namespace KRG::Render
 
         void SetupRenderStates( Viewport const& viewport, PixelShader* pShader, RenderData const& data );
 
+        // Set the pipeline state and the input binding for the mesh vertex format, returns the pipeline state that was set
+        PipelineState const* SetMeshPipelineState( VertexFormat vertexFormat, MeshPass pass );
+
     private:
 
         bool                                                    m_initialized = false;
@@ -164,5 +176,18 @@ namespace KRG::Render
         PixelShader                                             m_pixelShaderPicking;
         PipelineState                                           m_pipelineStateStaticPicking;
         PipelineState                                           m_pipelineStateSkeletalPicking;
+
+        // Compact vertex formats
+        VertexShader                                            m_vertexShaderStaticCompact;
+        VertexShader                                            m_vertexShaderSkeletalCompact;
+        ShaderInputBindingHandle                                m_inputBindingStaticCompact;
+        ShaderInputBindingHandle                                m_inputBindingSkeletalCompact;
+        ShaderInputBindingHandle                                m_inputBindingSkeletalCompactWeights16;
+        PipelineState                                           m_pipelineStateStaticCompact;
+        PipelineState                                           m_pipelineStateSkeletalCompact;
+        PipelineState                                           m_pipelineStateStaticCompactShadow;
+        PipelineState                                           m_pipelineStateSkeletalCompactShadow;
+        PipelineState                                           m_pipelineStateStaticCompactPicking;
+        PipelineState                                           m_pipelineStateSkeletalCompactPicking;
     };
 }
\ No newline at end of file
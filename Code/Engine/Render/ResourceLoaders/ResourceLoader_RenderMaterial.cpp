@@ -10,6 +10,7 @@ namespace KRG::Render
     MaterialLoader::MaterialLoader()
     {
         m_loadableTypes.push_back( Material::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     bool MaterialLoader::LoadInternal( ResourceID const& resID, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryMemoryArchive& archive ) const
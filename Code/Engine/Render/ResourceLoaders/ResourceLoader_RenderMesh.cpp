@@ -13,6 +13,7 @@ namespace KRG::Render
     {
         m_loadableTypes.push_back( StaticMesh::GetStaticResourceTypeID() );
         m_loadableTypes.push_back( SkeletalMesh::GetStaticResourceTypeID() );
+        m_isThreadSafe = true;
     }
 
     bool MeshLoader::LoadInternal( ResourceID const& resourceID, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryMemoryArchive& archive ) const
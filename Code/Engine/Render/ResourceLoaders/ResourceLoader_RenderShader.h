@@ -17,6 +17,7 @@ namespace KRG::Render
         {
             m_loadableTypes.push_back( PixelShader::GetStaticResourceTypeID() );
             m_loadableTypes.push_back( VertexShader::GetStaticResourceTypeID() );
+            m_isThreadSafe = true;
         }
 
         inline void SetRenderDevice( RenderDevice* pRenderDevice )
@@ -17,6 +17,7 @@ namespace KRG::Render
         {
             m_loadableTypes.push_back( Texture::GetStaticResourceTypeID() );
             m_loadableTypes.push_back( CubemapTexture::GetStaticResourceTypeID() );
+            m_isThreadSafe = true;
         }
 
         inline void SetRenderDevice( RenderDevice* pRenderDevice )
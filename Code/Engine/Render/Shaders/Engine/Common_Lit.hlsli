@@ -3,6 +3,8 @@ cbuffer Transforms : register( b0 )
     matrix m_worldTransform; // TODO: move to per instance data and apply camera centric world transform in veretx shader(campos=(0, 0, 0)), currently done on CPU
     matrix m_normalTransform;
     matrix m_viewprojTransform;
+    float4 m_positionDequantizationOffset; // Only used for meshes with compact vertex formats
+    float4 m_positionDequantizationScale;
 };
 
 // TODO sync with ENGINE, via header file!!!!
@@ -73,6 +75,21 @@ PixelShaderInput GeneratePixelShaderInput(float3 objectPos, float3 objectNormal,
     return output;
 }
 
+// Compact vertex formats store positions normalized to the mesh bounds
+float3 DequantizePosition(float3 normalizedPos)
+{
+    return m_positionDequantizationOffset.xyz + normalizedPos * m_positionDequantizationScale.xyz;
+}
+
+// Compact vertex formats store octahedral encoded normals, needs to match the CPU decode
+float3 DecodeOctahedralNormal(float2 encodedNormal)
+{
+    float3 normal = float3(encodedNormal.x, encodedNormal.y, 1.0 - abs(encodedNormal.x) - abs(encodedNormal.y));
+    float t = saturate(-normal.z);
+    normal.xy += (normal.xy >= 0.0) ? -t : t;
+    return normalize(normal);
+}
+
 float3 ReconstructNormal(float4 sampleNormal, float intensity)
 {
     float3 tangentNormal;
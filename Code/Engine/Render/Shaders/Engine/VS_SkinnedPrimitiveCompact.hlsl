@@ -0,0 +1,40 @@
+#include "Common_Lit.hlsli"
+
+cbuffer Skeleton : register( b1 )
+{
+    matrix m_boneTransforms[255];
+};
+
+// Unused influences in the compact vertex format
+static const uint INVALID_BONE_INDEX = 255;
+
+struct VertexShaderInput
+{
+    float3 m_pos : POSITION;
+    float2 m_normal : NORMAL;
+    float2 m_uv0 : TEXCOORD0;
+    float2 m_uv1 : TEXCOORD1;
+    uint4  m_boneIndices : BLENDINDICES0;
+    float4 m_boneWeights : BLENDWEIGHTS0;
+};
+
+PixelShaderInput main( VertexShaderInput vsInput )
+{
+    float3 pos = DequantizePosition(vsInput.m_pos);
+    float3 normal = DecodeOctahedralNormal(vsInput.m_normal);
+
+    float3 blendPos = float3(0, 0, 0);
+    float3 blendNormal = float3(0, 0, 0);
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        if ( vsInput.m_boneIndices[i] != INVALID_BONE_INDEX )
+        {
+            matrix boneTransform = m_boneTransforms[vsInput.m_boneIndices[i]];
+            blendPos += mul( boneTransform, float4(pos, 1.0) ).xyz * vsInput.m_boneWeights[i];
+            blendNormal += mul( boneTransform, float4(normal, 0.0) ).xyz * vsInput.m_boneWeights[i]; // HACK: check idea, assumes orthonormal matrix, without scaling
+        }
+    }
+
+    return GeneratePixelShaderInput(blendPos, blendNormal, vsInput.m_uv0);
+}
\ No newline at end of file
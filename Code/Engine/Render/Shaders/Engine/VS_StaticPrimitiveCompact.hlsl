@@ -0,0 +1,14 @@
+#include "Common_Lit.hlsli"
+
+struct VertexShaderInput
+{
+    float3 m_pos : POSITION;
+    float2 m_normal : NORMAL;
+    float2 m_uv0 : TEXCOORD0;
+    float2 m_uv1 : TEXCOORD1;
+};
+
+PixelShaderInput main( VertexShaderInput vsInput )
+{
+    return GeneratePixelShaderInput(DequantizePosition(vsInput.m_pos), DecodeOctahedralNormal(vsInput.m_normal), vsInput.m_uv0);
+}
\ No newline at end of file
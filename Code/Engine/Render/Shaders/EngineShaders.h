@@ -16,6 +16,8 @@
         #include "_AutoGenerated/VS_Cube_x64_Debug.h"
         #include "_AutoGenerated/VS_SkinnedPrimitive_x64_Debug.h"
         #include "_AutoGenerated/VS_StaticPrimitive_x64_Debug.h"
+        #include "_AutoGenerated/VS_SkinnedPrimitiveCompact_x64_Debug.h"
+        #include "_AutoGenerated/VS_StaticPrimitiveCompact_x64_Debug.h"
         #include "_AutoGenerated/PS_LitPicking_x64_Debug.h"
     #else
         #include "_AutoGenerated/CS_PrecomputeDFG_x64_Release.h"
@@ -25,6 +27,8 @@
         #include "_AutoGenerated/VS_Cube_x64_Release.h"
         #include "_AutoGenerated/VS_SkinnedPrimitive_x64_Release.h"
         #include "_AutoGenerated/VS_StaticPrimitive_x64_Release.h"
+        #include "_AutoGenerated/VS_SkinnedPrimitiveCompact_x64_Release.h"
+        #include "_AutoGenerated/VS_StaticPrimitiveCompact_x64_Release.h"
         #include "_AutoGenerated/PS_LitPicking_x64_Release.h"
     #endif
 #endif
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "Compression.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Compression::LZ
+{
+    // Format constants
+    static constexpr uint32 const g_minMatchLength = 4;
+    static constexpr uint32 const g_numLastLiterals = 5;                  // The last 5 bytes of a block are always literals
+    static constexpr uint32 const g_matchFindLimit = 12;                  // The last match must start at least 12 bytes before the end of the block
+    static constexpr uint32 const g_maxOffset = 65535;
+    static constexpr uint32 const g_tokenLengthMask = 15;
+
+    // Compressor hash table
+    static constexpr uint32 const g_hashLog = 14;
+    static constexpr uint32 const g_hashTableSize = 1 << g_hashLog;
+
+    //-------------------------------------------------------------------------
+
+    KRG_FORCE_INLINE static uint32 Read32( Byte const* pData )
+    {
+        uint32 value;
+        memcpy( &value, pData, sizeof( uint32 ) );
+        return value;
+    }
+
+    KRG_FORCE_INLINE static uint32 Hash( uint32 sequence )
+    {
+        return ( sequence * 2654435761U ) >> ( 32 - g_hashLog );
+    }
+
+    // Writes the extended length bytes for a length that didnt fit in the token
+    KRG_FORCE_INLINE static Byte* WriteExtendedLength( Byte* pOutput, size_t length )
+    {
+        while ( length >= 255 )
+        {
+            *pOutput++ = 255;
+            length -= 255;
+        }
+
+        *pOutput++ = (Byte) length;
+        return pOutput;
+    }
+
+    //-------------------------------------------------------------------------
+
+    size_t GetMaxCompressedSize( size_t uncompressedSize )
+    {
+        return uncompressedSize + ( uncompressedSize / 255 ) + 16;
+    }
+
+    size_t CompressBlock( Byte const* pSourceData, size_t sourceSize, Byte* pDestinationBuffer, size_t destinationBufferSize )
+    {
+        KRG_ASSERT( pSourceData != nullptr && pDestinationBuffer != nullptr );
+        KRG_ASSERT( sourceSize < 0x7E000000 );
+
+        Byte const* const pInputEnd = pSourceData + sourceSize;
+        Byte const* const pMatchFindLimit = pInputEnd - g_matchFindLimit;
+        Byte const* const pMatchLimit = pInputEnd - g_numLastLiterals;
+        Byte* const pOutputEnd = pDestinationBuffer + destinationBufferSize;
+
+        Byte const* pInput = pSourceData;
+        Byte const* pAnchor = pSourceData;
+        Byte* pOutput = pDestinationBuffer;
+
+        // Find and emit all matches
+        //-------------------------------------------------------------------------
+        // Blocks that are too small to contain a match are stored as a single literal run
+
+        if ( sourceSize > g_matchFindLimit )
+        {
+            TVector<uint32> hashTable( g_hashTableSize, 0 );
+
+            pInput++;
+            while ( pInput < pMatchFindLimit )
+            {
+                uint32 const sequence = Read32( pInput );
+                uint32 const hash = Hash( sequence );
+                Byte const* pMatch = pSourceData + hashTable[hash];
+                hashTable[hash] = uint32( pInput - pSourceData );
+
+                if ( pMatch >= pInput || ( pInput - pMatch ) > g_maxOffset || Read32( pMatch ) != sequence )
+                {
+                    pInput++;
+                    continue;
+                }
+
+                // Extend the match backwards into the pending literals
+                while ( pInput > pAnchor && pMatch > pSourceData && pInput[-1] == pMatch[-1] )
+                {
+                    pInput--;
+                    pMatch--;
+                }
+
+                // Extend the match forwards
+                size_t matchLength = g_minMatchLength;
+                while ( pInput + matchLength < pMatchLimit && pInput[matchLength] == pMatch[matchLength] )
+                {
+                    matchLength++;
+                }
+
+                // Emit sequence: token, literals, offset, match length
+                size_t const literalLength = size_t( pInput - pAnchor );
+                size_t const requiredSize = 1 + ( literalLength / 255 ) + 1 + literalLength + 2 + ( matchLength / 255 ) + 1;
+                if ( pOutput + requiredSize > pOutputEnd )
+                {
+                    return 0;
+                }
+
+                Byte* pToken = pOutput++;
+                if ( literalLength >= g_tokenLengthMask )
+                {
+                    *pToken = Byte( g_tokenLengthMask << 4 );
+                    pOutput = WriteExtendedLength( pOutput, literalLength - g_tokenLengthMask );
+                }
+                else
+                {
+                    *pToken = Byte( literalLength << 4 );
+                }
+
+                memcpy( pOutput, pAnchor, literalLength );
+                pOutput += literalLength;
+
+                uint16 const offset = uint16( pInput - pMatch );
+                *pOutput++ = Byte( offset & 0xFF );
+                *pOutput++ = Byte( offset >> 8 );
+
+                size_t const encodedMatchLength = matchLength - g_minMatchLength;
+                if ( encodedMatchLength >= g_tokenLengthMask )
+                {
+                    *pToken |= g_tokenLengthMask;
+                    pOutput = WriteExtendedLength( pOutput, encodedMatchLength - g_tokenLengthMask );
+                }
+                else
+                {
+                    *pToken |= Byte( encodedMatchLength );
+                }
+
+                pInput += matchLength;
+                pAnchor = pInput;
+            }
+        }
+
+        // Emit the remaining literals
+        //-------------------------------------------------------------------------
+
+        size_t const lastLiteralLength = size_t( pInputEnd - pAnchor );
+        if ( pOutput + 1 + ( lastLiteralLength / 255 ) + 1 + lastLiteralLength > pOutputEnd )
+        {
+            return 0;
+        }
+
+        if ( lastLiteralLength >= g_tokenLengthMask )
+        {
+            *pOutput++ = Byte( g_tokenLengthMask << 4 );
+            pOutput = WriteExtendedLength( pOutput, lastLiteralLength - g_tokenLengthMask );
+        }
+        else
+        {
+            *pOutput++ = Byte( lastLiteralLength << 4 );
+        }
+
+        memcpy( pOutput, pAnchor, lastLiteralLength );
+        pOutput += lastLiteralLength;
+
+        return size_t( pOutput - pDestinationBuffer );
+    }
+
+    bool DecompressBlock( Byte const* pCompressedData, size_t compressedSize, Byte* pDestinationBuffer, size_t uncompressedSize )
+    {
+        KRG_ASSERT( pCompressedData != nullptr && pDestinationBuffer != nullptr );
+
+        Byte const* pInput = pCompressedData;
+        Byte const* const pInputEnd = pCompressedData + compressedSize;
+        Byte* pOutput = pDestinationBuffer;
+        Byte* const pOutputEnd = pDestinationBuffer + uncompressedSize;
+
+        // Reads an extended length, returns false if we ran out of input
+        auto ReadExtendedLength = [&pInput, pInputEnd] ( size_t& length )
+        {
+            Byte value;
+            do
+            {
+                if ( pInput >= pInputEnd )
+                {
+                    return false;
+                }
+
+                value = *pInput++;
+                length += value;
+            } while ( value == 255 );
+
+            return true;
+        };
+
+        //-------------------------------------------------------------------------
+
+        while ( pInput < pInputEnd )
+        {
+            Byte const token = *pInput++;
+
+            // Literals
+            //-------------------------------------------------------------------------
+
+            size_t literalLength = token >> 4;
+            if ( literalLength == g_tokenLengthMask && !ReadExtendedLength( literalLength ) )
+            {
+                return false;
+            }
+
+            if ( literalLength > size_t( pInputEnd - pInput ) || literalLength > size_t( pOutputEnd - pOutput ) )
+            {
+                return false;
+            }
+
+            memcpy( pOutput, pInput, literalLength );
+            pInput += literalLength;
+            pOutput += literalLength;
+
+            // The last sequence only contains literals
+            if ( pInput == pInputEnd )
+            {
+                break;
+            }
+
+            // Match
+            //-------------------------------------------------------------------------
+
+            if ( pInputEnd - pInput < 2 )
+            {
+                return false;
+            }
+
+            size_t const offset = size_t( pInput[0] ) | ( size_t( pInput[1] ) << 8 );
+            pInput += 2;
+
+            if ( offset == 0 || offset > size_t( pOutput - pDestinationBuffer ) )
+            {
+                return false;
+            }
+
+            size_t matchLength = token & g_tokenLengthMask;
+            if ( matchLength == g_tokenLengthMask && !ReadExtendedLength( matchLength ) )
+            {
+                return false;
+            }
+            matchLength += g_minMatchLength;
+
+            if ( matchLength > size_t( pOutputEnd - pOutput ) )
+            {
+                return false;
+            }
+
+            Byte const* pMatch = pOutput - offset;
+            if ( offset >= matchLength )
+            {
+                memcpy( pOutput, pMatch, matchLength );
+                pOutput += matchLength;
+            }
+            else // Overlapping copy i.e. repeating pattern
+            {
+                for ( size_t i = 0; i < matchLength; i++ )
+                {
+                    *pOutput++ = *pMatch++;
+                }
+            }
+        }
+
+        return pOutput == pOutputEnd;
+    }
+}
\ No newline at end of file
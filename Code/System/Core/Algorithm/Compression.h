@@ -0,0 +1,27 @@
+#pragma once
+#include "System/Core/Types/Containers.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Compression
+{
+    //-------------------------------------------------------------------------
+    // LZ Block Compression
+    //-------------------------------------------------------------------------
+    // Fast byte-oriented LZ77 codec (LZ4 block format compatible)
+    // Optimized for decompression speed, blocks are fully independent so can be decoded in parallel
+    // Note: the uncompressed size of a block is not stored, the user is responsible for tracking it
+
+    namespace LZ
+    {
+        // Get the worst case size of the compressed data for a given input size
+        KRG_SYSTEM_CORE_API size_t GetMaxCompressedSize( size_t uncompressedSize );
+
+        // Compress a block of data, returns the compressed size or 0 if the destination buffer is too small
+        KRG_SYSTEM_CORE_API size_t CompressBlock( Byte const* pSourceData, size_t sourceSize, Byte* pDestinationBuffer, size_t destinationBufferSize );
+
+        // Decompress a block of data, the uncompressed size needs to match the size of the originally compressed data
+        // Returns false if the compressed data is malformed
+        KRG_SYSTEM_CORE_API bool DecompressBlock( Byte const* pCompressedData, size_t compressedSize, Byte* pDestinationBuffer, size_t uncompressedSize );
+    }
+}
\ No newline at end of file
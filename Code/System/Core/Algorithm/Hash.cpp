@@ -1,4 +1,5 @@
 #include "Hash.h"
+#include "System/Core/Memory/Memory.h"
 
 #define XXH_INLINE_ALL
 #include <xxhash/xxhash.h>
@@ -23,5 +24,54 @@ namespace KRG
         {
             return XXH64( pData, size, g_hashSeed );
         }
+
+        //-------------------------------------------------------------------------
+
+        uint64 XXH3::GetHash64( void const* pData, size_t size )
+        {
+            return XXH3_64bits_withSeed( pData, size, XXHash::g_hashSeed );
+        }
+
+        Hash128 XXH3::GetHash128( void const* pData, size_t size )
+        {
+            XXH128_hash_t const hash = XXH3_128bits_withSeed( pData, size, XXHash::g_hashSeed );
+            return Hash128{ hash.low64, hash.high64 };
+        }
+
+        //-------------------------------------------------------------------------
+
+        StreamingHasher::StreamingHasher()
+        {
+            // The XXH3 state has strict alignment requirements
+            m_pState = KRG::Alloc( sizeof( XXH3_state_t ), alignof( XXH3_state_t ) );
+            Reset();
+        }
+
+        StreamingHasher::~StreamingHasher()
+        {
+            KRG::Free( m_pState );
+        }
+
+        void StreamingHasher::Reset()
+        {
+            XXH3_128bits_reset_withSeed( (XXH3_state_t*) m_pState, XXHash::g_hashSeed );
+        }
+
+        void StreamingHasher::Update( void const* pData, size_t size )
+        {
+            KRG_ASSERT( pData != nullptr || size == 0 );
+            XXH3_128bits_update( (XXH3_state_t*) m_pState, pData, size );
+        }
+
+        uint64 StreamingHasher::GetHash64() const
+        {
+            return XXH3_64bits_digest( (XXH3_state_t const*) m_pState );
+        }
+
+        Hash128 StreamingHasher::GetHash128() const
+        {
+            XXH128_hash_t const hash = XXH3_128bits_digest( (XXH3_state_t const*) m_pState );
+            return Hash128{ hash.low64, hash.high64 };
+        }
     }
 }
\ No newline at end of file
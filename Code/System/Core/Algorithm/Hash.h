@@ -52,6 +52,94 @@ namespace KRG
             }
         }
 
+        // XXH3
+        //-------------------------------------------------------------------------
+        // Significantly faster than XXHash for short keys and large buffers
+        // The 128bit variant should be used for content addressing (i.e. file contents) where collisions are not acceptable
+
+        struct Hash128
+        {
+            inline bool IsValid() const { return m_low != 0 || m_high != 0; }
+            inline bool operator==( Hash128 const& rhs ) const { return m_low == rhs.m_low && m_high == rhs.m_high; }
+            inline bool operator!=( Hash128 const& rhs ) const { return m_low != rhs.m_low || m_high != rhs.m_high; }
+
+            uint64      m_low = 0;
+            uint64      m_high = 0;
+        };
+
+        namespace XXH3
+        {
+            KRG_SYSTEM_CORE_API uint64 GetHash64( void const* pData, size_t size );
+
+            inline uint64 GetHash64( String const& string )
+            {
+                return GetHash64( string.c_str(), string.length() );
+            }
+
+            inline uint64 GetHash64( char const* pString )
+            {
+                return GetHash64( pString, strlen( pString ) );
+            }
+
+            inline uint64 GetHash64( TVector<Byte> const& data )
+            {
+                return GetHash64( data.data(), data.size() );
+            }
+
+            //-------------------------------------------------------------------------
+
+            KRG_SYSTEM_CORE_API Hash128 GetHash128( void const* pData, size_t size );
+
+            inline Hash128 GetHash128( String const& string )
+            {
+                return GetHash128( string.c_str(), string.length() );
+            }
+
+            inline Hash128 GetHash128( char const* pString )
+            {
+                return GetHash128( pString, strlen( pString ) );
+            }
+
+            inline Hash128 GetHash128( TVector<Byte> const& data )
+            {
+                return GetHash128( data.data(), data.size() );
+            }
+        }
+
+        // Streaming Hasher
+        //-------------------------------------------------------------------------
+        // Incremental XXH3 hasher, allows us to hash large data sets (i.e. files) without having them fully in memory
+        // Feeding the same data in any number of blocks will produce the same result as the one-shot XXH3 functions
+
+        class KRG_SYSTEM_CORE_API StreamingHasher
+        {
+        public:
+
+            StreamingHasher();
+            ~StreamingHasher();
+
+            // Reset the hasher so that it can be reused
+            void Reset();
+
+            // Add data to the hash
+            void Update( void const* pData, size_t size );
+
+            inline void Update( TVector<Byte> const& data ) { Update( data.data(), data.size() ); }
+
+            // Get the hash of all the data added so far, this doesnt modify the hasher state so you can continue adding data afterwards
+            uint64 GetHash64() const;
+            Hash128 GetHash128() const;
+
+        private:
+
+            StreamingHasher( StreamingHasher const& ) = delete;
+            StreamingHasher& operator=( StreamingHasher const& ) = delete;
+
+        private:
+
+            void*       m_pState = nullptr;
+        };
+
         // FNV1a
         //-------------------------------------------------------------------------
         // This is a const expression hash
@@ -0,0 +1,299 @@
+#include "DirectoryScanner.h"
+#include "FileSystem.h"
+#include "System/Core/Serialization/BinaryArchive.h"
+#include "System/Core/Threading/TaskSystem.h"
+#include "System/Core/Profiling/Profiling.h"
+#include <filesystem>
+
+//-------------------------------------------------------------------------
+
+namespace KRG::FileSystem
+{
+    bool DirectoryScanCache::Load( Path const& cacheFilePath )
+    {
+        KRG_ASSERT( cacheFilePath.IsFile() );
+
+        m_directories.clear();
+
+        if ( !Exists( cacheFilePath ) )
+        {
+            return false;
+        }
+
+        Serialization::BinaryFileArchive archive( Serialization::Mode::Read, cacheFilePath );
+        if ( !archive.IsValid() )
+        {
+            return false;
+        }
+
+        uint32 version = 0;
+        archive >> version;
+        if ( version != s_version )
+        {
+            return false;
+        }
+
+        archive >> m_directories;
+        return true;
+    }
+
+    bool DirectoryScanCache::Save( Path const& cacheFilePath ) const
+    {
+        KRG_ASSERT( cacheFilePath.IsFile() );
+
+        EnsurePathExists( cacheFilePath );
+        Serialization::BinaryFileArchive archive( Serialization::Mode::Write, cacheFilePath );
+        if ( !archive.IsValid() )
+        {
+            return false;
+        }
+
+        archive << s_version << m_directories;
+        return true;
+    }
+
+    DirectoryScanCache::CachedDirectory const* DirectoryScanCache::FindCachedDirectory( String const& directoryPath ) const
+    {
+        auto iter = m_directories.find( directoryPath );
+        return ( iter != m_directories.end() ) ? &iter->second : nullptr;
+    }
+
+    //-------------------------------------------------------------------------
+
+    namespace
+    {
+        struct DirectoryScanResult
+        {
+            String                                          m_path;
+            DirectoryScanCache::CachedDirectory             m_contents;
+            TVector<ScannedFile>                            m_files;
+            bool                                            m_wasReused = false;
+            bool                                            m_failed = false;
+        };
+
+        //-------------------------------------------------------------------------
+
+        static bool PassesExtensionFilter( String const& fileName, TVector<String> const& lowercaseExtensionFilters )
+        {
+            if ( lowercaseExtensionFilters.empty() )
+            {
+                return true;
+            }
+
+            size_t const extensionIdx = fileName.find_last_of( '.' );
+            if ( extensionIdx == String::npos )
+            {
+                return false;
+            }
+
+            TInlineString<15> fileLowercaseExtension( fileName.c_str() + extensionIdx );
+            fileLowercaseExtension.make_lower();
+
+            for ( auto const& extensionFilter : lowercaseExtensionFilters )
+            {
+                if ( fileLowercaseExtension == extensionFilter.c_str() )
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Reads the immediate contents of a single directory, this is safe to call from multiple threads as long as the cache is not modified
+        static void ScanSingleDirectory( DirectoryScanResult& result, TVector<String> const& lowercaseExtensionFilters, DirectoryScanCache const* pCache )
+        {
+            DirectoryScanCache::CachedDirectory const* pCachedDirectory = ( pCache != nullptr ) ? pCache->FindCachedDirectory( result.m_path ) : nullptr;
+
+            std::error_code ec;
+            std::filesystem::path const directoryPath( result.m_path.c_str() );
+
+            auto const directoryModifiedTime = std::filesystem::last_write_time( directoryPath, ec );
+            if ( ec )
+            {
+                result.m_failed = true;
+                return;
+            }
+
+            // Reuse the cached contents if the directory hasnt changed
+            //-------------------------------------------------------------------------
+
+            uint64 const modifiedTime = directoryModifiedTime.time_since_epoch().count();
+            if ( pCachedDirectory != nullptr && pCachedDirectory->m_modifiedTime == modifiedTime )
+            {
+                result.m_contents = *pCachedDirectory;
+                result.m_wasReused = true;
+            }
+            else
+            {
+                result.m_contents.m_modifiedTime = modifiedTime;
+
+                std::filesystem::directory_iterator directoryIter( directoryPath, ec );
+                if ( ec )
+                {
+                    result.m_failed = true;
+                    return;
+                }
+
+                // Entries that cant be queried (e.g. deleted while scanning) are simply skipped
+                std::error_code entryEC;
+                for ( auto const& directoryEntry : directoryIter )
+                {
+                    if ( directoryEntry.is_directory( entryEC ) )
+                    {
+                        result.m_contents.m_subdirectories.emplace_back( directoryEntry.path().filename().string().c_str() );
+                    }
+                    else if ( directoryEntry.is_regular_file( entryEC ) )
+                    {
+                        auto& cachedFile = result.m_contents.m_files.emplace_back();
+                        cachedFile.m_name = directoryEntry.path().filename().string().c_str();
+                        cachedFile.m_size = directoryEntry.file_size( entryEC );
+                        cachedFile.m_modifiedTime = directoryEntry.last_write_time( entryEC ).time_since_epoch().count();
+                    }
+                }
+            }
+
+            // Create the output file entries
+            //-------------------------------------------------------------------------
+            // Path creation is not cheap so we do this here rather than on the calling thread
+
+            for ( auto const& cachedFile : result.m_contents.m_files )
+            {
+                if ( PassesExtensionFilter( cachedFile.m_name, lowercaseExtensionFilters ) )
+                {
+                    auto& scannedFile = result.m_files.emplace_back();
+                    scannedFile.m_path = Path( result.m_path + cachedFile.m_name );
+                    scannedFile.m_size = cachedFile.m_size;
+                    scannedFile.m_modifiedTime = cachedFile.m_modifiedTime;
+                }
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool ScanDirectory( Path const& directoryPath, TVector<ScannedFile>& outFiles, TVector<String> const& extensionFilters, TaskSystem* pTaskSystem, DirectoryScanCache* pCache )
+    {
+        KRG_PROFILE_FUNCTION_IO();
+        KRG_ASSERT( directoryPath.IsDirectory() );
+
+        outFiles.clear();
+
+        if ( !Exists( directoryPath ) )
+        {
+            return false;
+        }
+
+        TVector<String> lowercaseExtensionFilters = extensionFilters;
+        for ( auto& extFilter : lowercaseExtensionFilters )
+        {
+            extFilter.make_lower();
+        }
+
+        // Breadth-first scan, each level of the tree is scanned in parallel
+        //-------------------------------------------------------------------------
+
+        THashMap<String, DirectoryScanCache::CachedDirectory> updatedCache;
+        uint32 numDirectoriesReused = 0;
+        uint32 numDirectoriesScanned = 0;
+        bool wasSuccessful = true;
+
+        TVector<DirectoryScanResult> currentLevel;
+        currentLevel.emplace_back().m_path = directoryPath.GetFullPath();
+
+        while ( !currentLevel.empty() )
+        {
+            if ( pTaskSystem == nullptr || currentLevel.size() == 1 )
+            {
+                for ( auto& result : currentLevel )
+                {
+                    ScanSingleDirectory( result, lowercaseExtensionFilters, pCache );
+                }
+            }
+            else // Go wide
+            {
+                struct DirectoryScanTask : public ITaskSet
+                {
+                    DirectoryScanTask( TVector<DirectoryScanResult>& results, TVector<String> const& lowercaseExtensionFilters, DirectoryScanCache const* pCache )
+                        : m_results( results )
+                        , m_lowercaseExtensionFilters( lowercaseExtensionFilters )
+                        , m_pCache( pCache )
+                    {
+                        m_SetSize = (uint32) results.size();
+                        m_MinRange = 1;
+                    }
+
+                    virtual void ExecuteRange( TaskSetPartition range, uint32 threadnum ) override final
+                    {
+                        KRG_PROFILE_SCOPE_IO( "Scan Directories" );
+                        for ( uint64 i = range.start; i < range.end; ++i )
+                        {
+                            ScanSingleDirectory( m_results[i], m_lowercaseExtensionFilters, m_pCache );
+                        }
+                    }
+
+                public:
+
+                    TVector<DirectoryScanResult>&                   m_results;
+                    TVector<String> const&                          m_lowercaseExtensionFilters;
+                    DirectoryScanCache const*                       m_pCache = nullptr;
+                };
+
+                //-------------------------------------------------------------------------
+
+                DirectoryScanTask task( currentLevel, lowercaseExtensionFilters, pCache );
+                pTaskSystem->ScheduleTask( &task );
+                pTaskSystem->WaitForTask( &task );
+            }
+
+            // Collect results and build the next level
+            //-------------------------------------------------------------------------
+
+            TVector<DirectoryScanResult> nextLevel;
+            for ( auto& result : currentLevel )
+            {
+                if ( result.m_failed )
+                {
+                    wasSuccessful = false;
+                    continue;
+                }
+
+                if ( result.m_wasReused )
+                {
+                    numDirectoriesReused++;
+                }
+                else
+                {
+                    numDirectoriesScanned++;
+                }
+
+                for ( auto const& subdirectoryName : result.m_contents.m_subdirectories )
+                {
+                    auto& subdirectoryResult = nextLevel.emplace_back();
+                    subdirectoryResult.m_path.sprintf( "%s%s%c", result.m_path.c_str(), subdirectoryName.c_str(), Path::s_pathDelimiter );
+                }
+
+                outFiles.insert( outFiles.end(), eastl::make_move_iterator( result.m_files.begin() ), eastl::make_move_iterator( result.m_files.end() ) );
+
+                if ( pCache != nullptr )
+                {
+                    updatedCache.insert( eastl::make_pair( eastl::move( result.m_path ), eastl::move( result.m_contents ) ) );
+                }
+            }
+
+            currentLevel.swap( nextLevel );
+        }
+
+        // Replace the cache contents, this also removes any directories that no longer exist
+        //-------------------------------------------------------------------------
+
+        if ( pCache != nullptr )
+        {
+            pCache->m_directories.swap( updatedCache );
+            pCache->m_numDirectoriesReused = numDirectoriesReused;
+            pCache->m_numDirectoriesScanned = numDirectoriesScanned;
+        }
+
+        return wasSuccessful;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "FileSystemPath.h"
+#include "System/Core/Serialization/Serialization.h"
+#include "System/Core/Types/Containers.h"
+
+//-------------------------------------------------------------------------
+// Parallel Directory Scanner
+//-------------------------------------------------------------------------
+// Recursively scans a directory tree and returns all files along with their sizes and modification times
+// Each level of the tree is split across the task system workers, and the results are returned in a deterministic order
+//
+// An optional persistent cache can be provided to skip re-reading directories whose modification time hasnt changed.
+// A directory's modification time only changes when entries are added, removed or renamed in it, so the cached size and
+// timestamps of files that were modified in-place can be stale. Use the cache for listing and re-stat files if accurate stats are needed
+
+namespace KRG { class TaskSystem; }
+
+//-------------------------------------------------------------------------
+
+namespace KRG::FileSystem
+{
+    struct ScannedFile
+    {
+        Path                                    m_path;
+        uint64                                  m_size = 0;
+        uint64                                  m_modifiedTime = 0;
+    };
+
+    //-------------------------------------------------------------------------
+
+    class KRG_SYSTEM_CORE_API DirectoryScanCache
+    {
+        friend KRG_SYSTEM_CORE_API bool ScanDirectory( Path const&, TVector<ScannedFile>&, TVector<String> const&, TaskSystem*, DirectoryScanCache* );
+
+        constexpr static uint32 const s_version = 1;
+
+    public:
+
+        struct CachedFile
+        {
+            KRG_SERIALIZE_MEMBERS( m_name, m_size, m_modifiedTime );
+
+            String                              m_name;
+            uint64                              m_size = 0;
+            uint64                              m_modifiedTime = 0;
+        };
+
+        struct CachedDirectory
+        {
+            KRG_SERIALIZE_MEMBERS( m_modifiedTime, m_files, m_subdirectories );
+
+            uint64                              m_modifiedTime = 0;
+            TVector<CachedFile>                 m_files;
+            TVector<String>                     m_subdirectories;
+        };
+
+    public:
+
+        bool Load( Path const& cacheFilePath );
+        bool Save( Path const& cacheFilePath ) const;
+        inline void Clear() { m_directories.clear(); }
+
+        inline uint32 GetNumCachedDirectories() const { return (uint32) m_directories.size(); }
+
+        // Get the cached contents for a directory, the path needs to be the full directory path string
+        CachedDirectory const* FindCachedDirectory( String const& directoryPath ) const;
+
+        // Stats for the last scan that used this cache
+        inline uint32 GetNumDirectoriesReused() const { return m_numDirectoriesReused; }
+        inline uint32 GetNumDirectoriesScanned() const { return m_numDirectoriesScanned; }
+
+    private:
+
+        THashMap<String, CachedDirectory>       m_directories;
+        uint32                                  m_numDirectoriesReused = 0;
+        uint32                                  m_numDirectoriesScanned = 0;
+    };
+
+    //-------------------------------------------------------------------------
+
+    // Recursively get all files in a directory together with their size and modification time
+    // The extension filter is a list of extensions including the period e.g. extensionfilter = { ".txt", ".exe" }
+    // If no task system is supplied the scan is performed on the calling thread
+    KRG_SYSTEM_CORE_API bool ScanDirectory( Path const& directoryPath, TVector<ScannedFile>& outFiles, TVector<String> const& extensionFilters = TVector<String>(), TaskSystem* pTaskSystem = nullptr, DirectoryScanCache* pCache = nullptr );
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "FileSystem.h"
 #include "System/Core/Logging/Log.h"
 #include <filesystem>
+#include <fstream>
 #include <regex>
 
 //-------------------------------------------------------------------------
@@ -103,6 +104,62 @@ namespace KRG::FileSystem
         return timepoint.time_since_epoch().count();
     }
 
+    uint64 GetFileSize( Path const& filePath )
+    {
+        KRG_ASSERT( filePath.IsFile() );
+
+        std::error_code ec;
+        uintmax_t const fileSize = std::filesystem::file_size( filePath.c_str(), ec );
+        KRG_ASSERT( ec.value() == 0 );
+        return (uint64) fileSize;
+    }
+
+    bool ReadFileRange( Path const& filePath, uint64 offset, uint64 size, Byte* pDestination )
+    {
+        ReadOnlyFile file;
+        if ( !file.Open( filePath ) )
+        {
+            return false;
+        }
+
+        return file.ReadRange( offset, size, pDestination );
+    }
+
+    bool GetFileContentHash( Path const& filePath, Hash::Hash128& outHash )
+    {
+        KRG_ASSERT( filePath.IsFile() );
+
+        std::ifstream file( filePath.c_str(), std::ios::in | std::ios::binary );
+        if ( !file.is_open() )
+        {
+            return false;
+        }
+
+        constexpr static size_t const bufferSize = 64 * 1024;
+        TVector<Byte> buffer( bufferSize );
+
+        Hash::StreamingHasher hasher;
+        while ( file )
+        {
+            file.read( (char*) buffer.data(), bufferSize );
+            size_t const numBytesRead = (size_t) file.gcount();
+            if ( numBytesRead == 0 )
+            {
+                break;
+            }
+
+            hasher.Update( buffer.data(), numBytesRead );
+        }
+
+        if ( file.bad() )
+        {
+            return false;
+        }
+
+        outHash = hasher.GetHash128();
+        return true;
+    }
+
     void EnsureCorrectPathStringFormat( Path& filePath )
     {
         std::error_code ec;
@@ -2,6 +2,7 @@
 
 #include "System/Core/_Module/API.h"
 #include "System/Core/Types/String.h"
+#include "System/Core/Algorithm/Hash.h"
 #include "FileSystemPath.h"
 
 //-------------------------------------------------------------------------
@@ -28,8 +29,15 @@ namespace KRG::FileSystem
 
     KRG_SYSTEM_CORE_API bool IsFileReadOnly( Path const& filePath );
     KRG_SYSTEM_CORE_API uint64 GetFileModifiedTime( Path const& filePath );
+    KRG_SYSTEM_CORE_API uint64 GetFileSize( Path const& filePath );
     KRG_SYSTEM_CORE_API bool EraseFile( Path const& filePath );
     KRG_SYSTEM_CORE_API bool LoadFile( Path const& filePath, TVector<Byte>& fileData );
+
+    // Read a range of a file directly into the supplied buffer (positional read, safe to call concurrently for the same file)
+    KRG_SYSTEM_CORE_API bool ReadFileRange( Path const& filePath, uint64 offset, uint64 size, Byte* pDestination );
+
+    // Calculates a content hash for the file, the file is streamed through the hasher so it is never fully loaded into memory
+    KRG_SYSTEM_CORE_API bool GetFileContentHash( Path const& filePath, Hash::Hash128& outHash );
     
     KRG_SYSTEM_CORE_API bool CreateDir( Path const& path );
     KRG_SYSTEM_CORE_API bool EraseDir( Path const& path );
@@ -39,6 +47,86 @@ namespace KRG::FileSystem
     KRG_SYSTEM_CORE_API void EnsureCorrectPathStringFormat( Path& filePath );
 }
 
+//-------------------------------------------------------------------------
+// Memory mapped files
+//-------------------------------------------------------------------------
+// Read-only view of a file's contents, pages are faulted in by the OS on access so there is no intermediate copy of the file data
+// The access hint is forwarded to the OS to control read-ahead (madvise / PrefetchVirtualMemory)
+
+namespace KRG::FileSystem
+{
+    class KRG_SYSTEM_CORE_API MappedFile
+    {
+    public:
+
+        enum class AccessHint
+        {
+            Sequential,     // Aggressive read-ahead, the whole file will be read (e.g. deserialization)
+            Random,         // No read-ahead, only parts of the file will be accessed
+        };
+
+    public:
+
+        MappedFile() = default;
+        MappedFile( MappedFile const& ) = delete;
+        ~MappedFile() { Close(); }
+
+        MappedFile& operator=( MappedFile const& ) = delete;
+
+        // Map the entire file, empty files cannot be mapped
+        bool Open( Path const& filePath, AccessHint hint = AccessHint::Sequential );
+        void Close();
+
+        inline bool IsOpen() const { return m_pData != nullptr; }
+        inline Byte const* GetData() const { return m_pData; }
+        inline size_t GetSize() const { return m_size; }
+
+    private:
+
+        Byte const*         m_pData = nullptr;
+        size_t              m_size = 0;
+        void*               m_pFileHandle = nullptr;
+        void*               m_pMappingHandle = nullptr;
+    };
+}
+
+//-------------------------------------------------------------------------
+// Read-only file handles
+//-------------------------------------------------------------------------
+// Keeps a file open for positional reads, reads dont share a file cursor so a single handle can be read from concurrently
+
+namespace KRG::FileSystem
+{
+    class KRG_SYSTEM_CORE_API ReadOnlyFile
+    {
+        constexpr static intptr_t const s_invalidHandle = -1;
+
+    public:
+
+        ReadOnlyFile() = default;
+        ReadOnlyFile( ReadOnlyFile const& ) = delete;
+        ~ReadOnlyFile() { Close(); }
+
+        ReadOnlyFile& operator=( ReadOnlyFile const& ) = delete;
+
+        bool Open( Path const& filePath );
+        void Close();
+
+        inline bool IsOpen() const { return m_fileHandle != s_invalidHandle; }
+        inline Path const& GetPath() const { return m_path; }
+        inline uint64 GetSize() const { return m_size; }
+
+        // Read a range of the file into the supplied buffer, safe to call from multiple threads
+        bool ReadRange( uint64 offset, uint64 size, Byte* pDestination ) const;
+
+    private:
+
+        Path                m_path;
+        uint64              m_size = 0;
+        intptr_t            m_fileHandle = s_invalidHandle;
+    };
+}
+
 //-------------------------------------------------------------------------
 // Directory functions
 //-------------------------------------------------------------------------
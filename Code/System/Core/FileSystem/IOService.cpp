@@ -0,0 +1,426 @@
+#include "IOService.h"
+#include "System/Core/Profiling/Profiling.h"
+#include "System/Core/Math/Math.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::FileSystem
+{
+    IOService::~IOService()
+    {
+        KRG_ASSERT( !IsInitialized() );
+    }
+
+    void IOService::Initialize( uint32 numThreads, uint32 maxRequestsInFlight )
+    {
+        KRG_ASSERT( !IsInitialized() );
+        KRG_ASSERT( numThreads > 0 && maxRequestsInFlight > 0 );
+
+        m_maxRequestsInFlight = maxRequestsInFlight;
+        m_exitRequested = false;
+
+        for ( uint32 i = 0; i < numThreads; i++ )
+        {
+            m_threads.emplace_back( std::thread( [this] () { ProcessRequests(); } ) );
+        }
+    }
+
+    void IOService::Shutdown()
+    {
+        {
+            Threading::ScopeLock lock( m_mutex );
+            m_exitRequested = true;
+        }
+        m_wakeCondition.notify_all();
+
+        for ( auto& thread : m_threads )
+        {
+            thread.join();
+        }
+        m_threads.clear();
+
+        // All requests need to be released by their owners before shutting down
+        for ( auto const& queue : m_pendingRequests )
+        {
+            KRG_ASSERT( queue.empty() );
+        }
+        KRG_ASSERT( m_numRequestsInFlight == 0 );
+    }
+
+    //-------------------------------------------------------------------------
+
+    IORequest* IOService::MapFile( Path const& filePath, IOPriority priority, IORequest::CompletionCallback&& callback )
+    {
+        KRG_ASSERT( filePath.IsFile() );
+
+        auto pRequest = KRG::New<IORequest>();
+        pRequest->m_type = IORequest::Type::MapFile;
+        pRequest->m_filePath = filePath;
+        pRequest->m_priority = priority;
+        pRequest->m_completionCallback = eastl::move( callback );
+        return SubmitRequest( pRequest );
+    }
+
+    IORequest* IOService::ReadRange( Path const& filePath, uint64 offset, uint64 size, IOPriority priority, IORequest::CompletionCallback&& callback )
+    {
+        KRG_ASSERT( filePath.IsFile() && size > 0 );
+
+        auto pRequest = KRG::New<IORequest>();
+        pRequest->m_type = IORequest::Type::ReadRange;
+        pRequest->m_filePath = filePath;
+        pRequest->m_offset = offset;
+        pRequest->m_size = size;
+        pRequest->m_priority = priority;
+        pRequest->m_completionCallback = eastl::move( callback );
+        return SubmitRequest( pRequest );
+    }
+
+    IORequest* IOService::ReadRange( ReadOnlyFile const* pFile, uint64 offset, uint64 size, IOPriority priority, IORequest::CompletionCallback&& callback )
+    {
+        KRG_ASSERT( pFile != nullptr && pFile->IsOpen() && size > 0 );
+        KRG_ASSERT( offset + size <= pFile->GetSize() );
+
+        auto pRequest = KRG::New<IORequest>();
+        pRequest->m_type = IORequest::Type::ReadRange;
+        pRequest->m_filePath = pFile->GetPath();
+        pRequest->m_pFile = pFile;
+        pRequest->m_offset = offset;
+        pRequest->m_size = size;
+        pRequest->m_priority = priority;
+        pRequest->m_completionCallback = eastl::move( callback );
+        return SubmitRequest( pRequest );
+    }
+
+    IORequest* IOService::SubmitRequest( IORequest* pRequest )
+    {
+        KRG_ASSERT( IsInitialized() );
+
+        {
+            Threading::ScopeLock lock( m_mutex );
+            pRequest->m_submissionIdx = m_nextSubmissionIdx++;
+            m_pendingRequests[(uint8) pRequest->m_priority].emplace_back( pRequest );
+        }
+        m_wakeCondition.notify_one();
+
+        return pRequest;
+    }
+
+    void IOService::SetPriority( IORequest* pRequest, IOPriority priority )
+    {
+        KRG_ASSERT( pRequest != nullptr && priority != IOPriority::NumPriorities );
+
+        Threading::ScopeLock lock( m_mutex );
+
+        if ( pRequest->m_priority == priority || pRequest->m_isInFlight || pRequest->IsComplete() )
+        {
+            return;
+        }
+
+        auto& oldQueue = m_pendingRequests[(uint8) pRequest->m_priority];
+        oldQueue.erase_first( pRequest );
+
+        // Keep the new queue in submission order so that re-prioritized requests dont jump ahead of older ones
+        auto& newQueue = m_pendingRequests[(uint8) priority];
+        auto insertIter = newQueue.begin();
+        while ( insertIter != newQueue.end() && ( *insertIter )->m_submissionIdx < pRequest->m_submissionIdx )
+        {
+            ++insertIter;
+        }
+        newQueue.insert( insertIter, pRequest );
+
+        pRequest->m_priority = priority;
+    }
+
+    void IOService::ReleaseRequest( IORequest*& pRequest )
+    {
+        KRG_ASSERT( pRequest != nullptr );
+
+        {
+            Threading::ScopeLock lock( m_mutex );
+
+            // The IO thread will delete the request once it is done with it
+            if ( pRequest->m_isInFlight )
+            {
+                pRequest->m_isReleased = true;
+                pRequest = nullptr;
+                return;
+            }
+
+            // Cancel requests that havent been started
+            if ( !pRequest->IsComplete() )
+            {
+                m_pendingRequests[(uint8) pRequest->m_priority].erase_first( pRequest );
+            }
+        }
+
+        KRG::Delete( pRequest );
+    }
+
+    uint32 IOService::GetNumPendingRequests() const
+    {
+        Threading::ScopeLock lock( m_mutex );
+
+        uint32 numPendingRequests = 0;
+        for ( auto const& queue : m_pendingRequests )
+        {
+            numPendingRequests += (uint32) queue.size();
+        }
+        return numPendingRequests;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void IOService::ProcessRequests()
+    {
+        Threading::SetCurrentThreadName( "IO Thread" );
+        KRG_PROFILE_THREAD_START( "IO Thread" );
+
+        TInlineVector<IORequest*, s_maxBatchSize> batch;
+
+        while ( true )
+        {
+            {
+                Threading::Lock lock( m_mutex );
+
+                auto CanProcessRequests = [this] ()
+                {
+                    if ( m_exitRequested )
+                    {
+                        return true;
+                    }
+
+                    if ( m_numRequestsInFlight >= m_maxRequestsInFlight )
+                    {
+                        return false;
+                    }
+
+                    for ( auto const& queue : m_pendingRequests )
+                    {
+                        if ( !queue.empty() )
+                        {
+                            return true;
+                        }
+                    }
+
+                    return false;
+                };
+
+                m_wakeCondition.wait( lock, CanProcessRequests );
+
+                if ( m_exitRequested )
+                {
+                    break;
+                }
+
+                DequeueNextBatch( batch );
+            }
+
+            uint32 const numBatchRequests = (uint32) batch.size();
+            ExecuteBatch( batch );
+            batch.clear();
+
+            //-------------------------------------------------------------------------
+
+            {
+                Threading::ScopeLock lock( m_mutex );
+                KRG_ASSERT( m_numRequestsInFlight >= numBatchRequests );
+                m_numRequestsInFlight -= numBatchRequests;
+            }
+            m_wakeCondition.notify_one();
+        }
+
+        KRG_PROFILE_THREAD_END();
+    }
+
+    void IOService::DequeueNextBatch( TInlineVector<IORequest*, s_maxBatchSize>& outBatch )
+    {
+        KRG_ASSERT( outBatch.empty() );
+
+        // Get the oldest request from the highest priority queue
+        //-------------------------------------------------------------------------
+
+        IORequest* pFirstRequest = nullptr;
+        for ( int32 i = (int32) IOPriority::NumPriorities - 1; i >= 0; i-- )
+        {
+            auto& queue = m_pendingRequests[i];
+            if ( !queue.empty() )
+            {
+                pFirstRequest = queue.front();
+                queue.erase( queue.begin() );
+                break;
+            }
+        }
+
+        KRG_ASSERT( pFirstRequest != nullptr );
+        pFirstRequest->m_isInFlight = true;
+        outBatch.emplace_back( pFirstRequest );
+        m_numRequestsInFlight++;
+
+        if ( pFirstRequest->m_type != IORequest::Type::ReadRange )
+        {
+            return;
+        }
+
+        // Coalesce any other range reads of the same file that are close enough to the batch span
+        // Lower priority requests are also included since they come for free with the read
+        // Every coalesced request counts towards the in-flight limit since each one holds a destination buffer
+        //-------------------------------------------------------------------------
+
+        uint64 spanStart = pFirstRequest->m_offset;
+        uint64 spanEnd = pFirstRequest->GetRangeEnd();
+
+        bool requestAdded = true;
+        while ( requestAdded && outBatch.size() < s_maxBatchSize && m_numRequestsInFlight < m_maxRequestsInFlight )
+        {
+            requestAdded = false;
+
+            for ( auto& queue : m_pendingRequests )
+            {
+                for ( auto iter = queue.begin(); iter != queue.end(); ++iter )
+                {
+                    IORequest* pRequest = *iter;
+                    if ( pRequest->m_type != IORequest::Type::ReadRange || !pRequest->IsSameFile( pFirstRequest ) )
+                    {
+                        continue;
+                    }
+
+                    bool const isCloseEnough = ( pRequest->m_offset <= spanEnd + s_maxCoalescingGap ) && ( pRequest->GetRangeEnd() + s_maxCoalescingGap >= spanStart );
+                    if ( !isCloseEnough )
+                    {
+                        continue;
+                    }
+
+                    uint64 const newSpanStart = Math::Min( spanStart, pRequest->m_offset );
+                    uint64 const newSpanEnd = Math::Max( spanEnd, pRequest->GetRangeEnd() );
+                    if ( newSpanEnd - newSpanStart > s_maxCoalescedReadSize )
+                    {
+                        continue;
+                    }
+
+                    spanStart = newSpanStart;
+                    spanEnd = newSpanEnd;
+
+                    pRequest->m_isInFlight = true;
+                    outBatch.emplace_back( pRequest );
+                    m_numRequestsInFlight++;
+                    queue.erase( iter );
+                    requestAdded = true;
+                    break;
+                }
+
+                if ( requestAdded )
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    void IOService::ExecuteBatch( TInlineVector<IORequest*, s_maxBatchSize>& batch )
+    {
+        KRG_ASSERT( !batch.empty() );
+
+        // Whole file requests
+        //-------------------------------------------------------------------------
+        // Touch each page so that the consumer of the data never stalls on a page fault
+
+        if ( batch[0]->m_type == IORequest::Type::MapFile )
+        {
+            KRG_ASSERT( batch.size() == 1 );
+            KRG_PROFILE_SCOPE_IO( "Map File" );
+
+            IORequest* pRequest = batch[0];
+            bool const wasSuccessful = pRequest->m_mappedFile.Open( pRequest->m_filePath, MappedFile::AccessHint::Sequential );
+            if ( wasSuccessful )
+            {
+                constexpr static size_t const pageSize = 4096;
+                Byte const* pData = pRequest->m_mappedFile.GetData();
+                size_t const dataSize = pRequest->m_mappedFile.GetSize();
+
+                volatile Byte touchedValue = 0;
+                for ( size_t i = 0; i < dataSize; i += pageSize )
+                {
+                    touchedValue += pData[i];
+                }
+
+                KRG_PROFILE_COUNTER_INCREMENT( "IO Bytes Read", (int64) dataSize );
+            }
+
+            CompleteRequest( pRequest, wasSuccessful );
+            return;
+        }
+
+        // Range requests
+        //-------------------------------------------------------------------------
+
+        KRG_PROFILE_SCOPE_IO( "Read File Range" );
+
+        if ( batch.size() == 1 )
+        {
+            IORequest* pRequest = batch[0];
+            pRequest->m_buffer.resize( pRequest->m_size );
+            bool const wasSuccessful = ReadRequestRange( pRequest, pRequest->m_offset, pRequest->m_size, pRequest->m_buffer.data() );
+            KRG_PROFILE_COUNTER_INCREMENT( "IO Bytes Read", (int64) pRequest->m_size );
+            CompleteRequest( pRequest, wasSuccessful );
+            return;
+        }
+
+        // Read the whole span once and then split it up between the requests
+        uint64 spanStart = batch[0]->m_offset;
+        uint64 spanEnd = batch[0]->GetRangeEnd();
+        for ( IORequest* pRequest : batch )
+        {
+            spanStart = Math::Min( spanStart, pRequest->m_offset );
+            spanEnd = Math::Max( spanEnd, pRequest->GetRangeEnd() );
+        }
+
+        TVector<Byte> spanData;
+        spanData.resize( spanEnd - spanStart );
+        bool const wasSuccessful = ReadRequestRange( batch[0], spanStart, spanEnd - spanStart, spanData.data() );
+        KRG_PROFILE_COUNTER_INCREMENT( "IO Bytes Read", (int64) spanData.size() );
+        KRG_PROFILE_COUNTER_INCREMENT( "IO Reads Coalesced", (int64) batch.size() - 1 );
+
+        for ( IORequest* pRequest : batch )
+        {
+            if ( wasSuccessful )
+            {
+                pRequest->m_buffer.resize( pRequest->m_size );
+                memcpy( pRequest->m_buffer.data(), spanData.data() + ( pRequest->m_offset - spanStart ), pRequest->m_size );
+            }
+
+            CompleteRequest( pRequest, wasSuccessful );
+        }
+    }
+
+    bool IOService::ReadRequestRange( IORequest const* pRequest, uint64 offset, uint64 size, Byte* pDestination ) const
+    {
+        if ( pRequest->m_pFile != nullptr )
+        {
+            return pRequest->m_pFile->ReadRange( offset, size, pDestination );
+        }
+
+        return ReadFileRange( pRequest->m_filePath, offset, size, pDestination );
+    }
+
+    void IOService::CompleteRequest( IORequest* pRequest, bool wasSuccessful )
+    {
+        pRequest->m_status.store( wasSuccessful ? IORequest::Status::Succeeded : IORequest::Status::Failed, std::memory_order_release );
+
+        if ( pRequest->m_completionCallback )
+        {
+            pRequest->m_completionCallback( pRequest );
+        }
+
+        bool shouldDeleteRequest = false;
+        {
+            Threading::ScopeLock lock( m_mutex );
+            pRequest->m_isInFlight = false;
+            shouldDeleteRequest = pRequest->m_isReleased;
+        }
+
+        if ( shouldDeleteRequest )
+        {
+            KRG::Delete( pRequest );
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "FileSystem.h"
+#include "System/Core/Types/Function.h"
+#include "System/Core/Threading/Threading.h"
+#include <atomic>
+#include <thread>
+
+//-------------------------------------------------------------------------
+// Asynchronous File IO Service
+//-------------------------------------------------------------------------
+// Services read requests on a small pool of dedicated IO threads, callers submit a request and then poll it (or get a callback)
+//
+// * Requests are serviced in priority order (FIFO within a priority)
+// * The number of reads in flight is capped so that low priority bulk reads cannot saturate the device
+// * Range reads of the same file that are adjacent (or close enough) are coalesced into a single read
+// * Whole file requests are memory mapped and paged in on the IO thread, so the consumer never stalls on page faults
+// * Range reads can target an already open file, this avoids reopening large archives for every request
+//
+// Completion callbacks are executed on the IO thread, so they need to be thread-safe and cheap
+
+namespace KRG::FileSystem
+{
+    enum class IOPriority : uint8
+    {
+        Low = 0,
+        Normal,
+        High,
+        Critical,
+
+        NumPriorities
+    };
+
+    //-------------------------------------------------------------------------
+
+    class KRG_SYSTEM_CORE_API IORequest
+    {
+        friend class IOService;
+
+    public:
+
+        enum class Type : uint8
+        {
+            MapFile,
+            ReadRange,
+        };
+
+        enum class Status : uint8
+        {
+            Pending,
+            Succeeded,
+            Failed,
+        };
+
+        using CompletionCallback = TFunction<void( IORequest const* )>;
+
+    public:
+
+        IORequest() = default;
+        IORequest( IORequest const& ) = delete;
+        IORequest& operator=( IORequest const& ) = delete;
+
+        inline Type GetType() const { return m_type; }
+        inline IOPriority GetPriority() const { return m_priority; }
+        inline Path const& GetFilePath() const { return m_filePath; }
+        inline ReadOnlyFile const* GetFile() const { return m_pFile; }
+
+        inline bool IsComplete() const { return m_status.load( std::memory_order_acquire ) != Status::Pending; }
+        inline bool WasSuccessful() const { return m_status.load( std::memory_order_acquire ) == Status::Succeeded; }
+
+        // The read data, only valid once the request has completed successfully
+        inline Byte const* GetData() const { KRG_ASSERT( WasSuccessful() ); return ( m_type == Type::MapFile ) ? m_mappedFile.GetData() : m_buffer.data(); }
+        inline size_t GetSize() const { KRG_ASSERT( WasSuccessful() ); return ( m_type == Type::MapFile ) ? m_mappedFile.GetSize() : m_buffer.size(); }
+
+    private:
+
+        inline uint64 GetRangeEnd() const { return m_offset + m_size; }
+
+        inline bool IsSameFile( IORequest const* pOther ) const
+        {
+            return ( m_pFile != nullptr ) ? ( m_pFile == pOther->m_pFile ) : ( pOther->m_pFile == nullptr && m_filePath == pOther->m_filePath );
+        }
+
+    private:
+
+        Path                                    m_filePath;
+        ReadOnlyFile const*                     m_pFile = nullptr;
+        uint64                                  m_offset = 0;
+        uint64                                  m_size = 0;
+        uint64                                  m_submissionIdx = 0;
+        CompletionCallback                      m_completionCallback;
+        MappedFile                              m_mappedFile;
+        TVector<Byte>                           m_buffer;
+        Type                                    m_type = Type::MapFile;
+        IOPriority                              m_priority = IOPriority::Normal;
+        std::atomic<Status>                     m_status = Status::Pending;
+        bool                                    m_isInFlight = false;
+        bool                                    m_isReleased = false;       // The owner released the request while it was in flight
+    };
+
+    //-------------------------------------------------------------------------
+
+    class KRG_SYSTEM_CORE_API IOService
+    {
+        constexpr static uint32 const s_defaultNumThreads = 2;
+        constexpr static uint32 const s_defaultMaxRequestsInFlight = 8;
+        constexpr static uint64 const s_maxCoalescingGap = 64 * 1024;
+        constexpr static uint64 const s_maxCoalescedReadSize = 8 * 1024 * 1024;
+        constexpr static uint32 const s_maxBatchSize = 8;
+
+    public:
+
+        IOService() = default;
+        ~IOService();
+
+        inline bool IsInitialized() const { return !m_threads.empty(); }
+        void Initialize( uint32 numThreads = s_defaultNumThreads, uint32 maxRequestsInFlight = s_defaultMaxRequestsInFlight );
+        void Shutdown();
+
+        // Map and page-in an entire file
+        IORequest* MapFile( Path const& filePath, IOPriority priority = IOPriority::Normal, IORequest::CompletionCallback&& callback = IORequest::CompletionCallback() );
+
+        // Read a range of a file into a buffer
+        IORequest* ReadRange( Path const& filePath, uint64 offset, uint64 size, IOPriority priority = IOPriority::Normal, IORequest::CompletionCallback&& callback = IORequest::CompletionCallback() );
+
+        // Read a range of an already open file into a buffer, the file needs to stay open until the request has been released
+        IORequest* ReadRange( ReadOnlyFile const* pFile, uint64 offset, uint64 size, IOPriority priority = IOPriority::Normal, IORequest::CompletionCallback&& callback = IORequest::CompletionCallback() );
+
+        // Change the priority of a request that has not yet been started
+        void SetPriority( IORequest* pRequest, IOPriority priority );
+
+        // Release a request and its data, requests that have not yet started are cancelled
+        // Callbacks for requests that are in flight will still be called
+        void ReleaseRequest( IORequest*& pRequest );
+
+        // Number of requests waiting to be serviced
+        uint32 GetNumPendingRequests() const;
+
+    private:
+
+        IORequest* SubmitRequest( IORequest* pRequest );
+        void ProcessRequests();
+
+        // Remove the next batch of requests to service from the queues (expects the lock to be held)
+        void DequeueNextBatch( TInlineVector<IORequest*, s_maxBatchSize>& outBatch );
+
+        void ExecuteBatch( TInlineVector<IORequest*, s_maxBatchSize>& batch );
+        bool ReadRequestRange( IORequest const* pRequest, uint64 offset, uint64 size, Byte* pDestination ) const;
+        void CompleteRequest( IORequest* pRequest, bool wasSuccessful );
+
+    private:
+
+        TVector<std::thread>                    m_threads;
+        TVector<IORequest*>                     m_pendingRequests[(uint8) IOPriority::NumPriorities];
+        mutable Threading::Mutex                m_mutex;
+        Threading::ConditionVariable            m_wakeCondition;
+        uint64                                  m_nextSubmissionIdx = 0;
+        uint32                                  m_maxRequestsInFlight = s_defaultMaxRequestsInFlight;
+        uint32                                  m_numRequestsInFlight = 0; // Individual requests, coalesced requests each count towards the limit
+        bool                                    m_exitRequested = false;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#ifndef _WIN32
+#include "../FileSystem.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+//-------------------------------------------------------------------------
+
+namespace KRG::FileSystem
+{
+    bool ReadOnlyFile::Open( Path const& path )
+    {
+        KRG_ASSERT( path.IsFile() );
+        KRG_ASSERT( !IsOpen() );
+
+        int const fileDescriptor = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if ( fileDescriptor < 0 )
+        {
+            return false;
+        }
+
+        struct stat fileStats;
+        if ( fstat( fileDescriptor, &fileStats ) != 0 )
+        {
+            close( fileDescriptor );
+            return false;
+        }
+
+        m_path = path;
+        m_size = (uint64) fileStats.st_size;
+        m_fileHandle = (intptr_t) fileDescriptor;
+        return true;
+    }
+
+    void ReadOnlyFile::Close()
+    {
+        if ( IsOpen() )
+        {
+            close( (int) m_fileHandle );
+            m_fileHandle = s_invalidHandle;
+            m_size = 0;
+            m_path = Path();
+        }
+    }
+
+    bool ReadOnlyFile::ReadRange( uint64 offset, uint64 size, Byte* pDestination ) const
+    {
+        KRG_ASSERT( IsOpen() && pDestination != nullptr );
+
+        int const fileDescriptor = (int) m_fileHandle;
+
+        // pread may return less than requested so keep reading until the range is filled
+        bool result = true;
+        uint64 numBytesRead = 0;
+        while ( numBytesRead < size )
+        {
+            ssize_t const numBytesReadThisCall = pread( fileDescriptor, pDestination + numBytesRead, (size_t) ( size - numBytesRead ), (off_t) ( offset + numBytesRead ) );
+            if ( numBytesReadThisCall < 0 && errno == EINTR )
+            {
+                continue;
+            }
+
+            if ( numBytesReadThisCall <= 0 )
+            {
+                result = false;
+                break;
+            }
+
+            numBytesRead += (uint64) numBytesReadThisCall;
+        }
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool MappedFile::Open( Path const& path, AccessHint hint )
+    {
+        KRG_ASSERT( path.IsFile() );
+        KRG_ASSERT( !IsOpen() );
+
+        int const fileDescriptor = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if ( fileDescriptor < 0 )
+        {
+            return false;
+        }
+
+        struct stat fileStats;
+        if ( fstat( fileDescriptor, &fileStats ) != 0 || fileStats.st_size == 0 )
+        {
+            close( fileDescriptor );
+            return false;
+        }
+
+        size_t const fileSize = (size_t) fileStats.st_size;
+
+        #if defined( POSIX_FADV_SEQUENTIAL )
+        posix_fadvise( fileDescriptor, 0, 0, ( hint == AccessHint::Sequential ) ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM );
+        #endif
+
+        void* pView = mmap( nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+
+        // The mapping keeps its own reference to the file so we dont need the descriptor anymore
+        close( fileDescriptor );
+
+        if ( pView == MAP_FAILED )
+        {
+            return false;
+        }
+
+        // Sequential access will touch the whole file so ask the kernel to start reading it in immediately
+        if ( hint == AccessHint::Sequential )
+        {
+            madvise( pView, fileSize, MADV_SEQUENTIAL );
+            madvise( pView, fileSize, MADV_WILLNEED );
+        }
+        else
+        {
+            madvise( pView, fileSize, MADV_RANDOM );
+        }
+
+        m_pData = (Byte const*) pView;
+        m_size = fileSize;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if ( m_pData != nullptr )
+        {
+            munmap( const_cast<Byte*>( m_pData ), m_size );
+        }
+
+        m_pData = nullptr;
+        m_size = 0;
+        m_pFileHandle = nullptr;
+        m_pMappingHandle = nullptr;
+    }
+}
+#endif
\ No newline at end of file
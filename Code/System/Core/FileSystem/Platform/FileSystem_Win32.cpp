@@ -92,6 +92,140 @@ namespace KRG::FileSystem
         CloseHandle( hFile );
         return true;
     }
+
+    //-------------------------------------------------------------------------
+
+    bool ReadOnlyFile::Open( Path const& path )
+    {
+        KRG_ASSERT( path.IsFile() );
+        KRG_ASSERT( !IsOpen() );
+
+        HANDLE hFile = CreateFile( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr );
+        if ( hFile == INVALID_HANDLE_VALUE )
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSizeLI;
+        if ( !GetFileSizeEx( hFile, &fileSizeLI ) )
+        {
+            CloseHandle( hFile );
+            return false;
+        }
+
+        m_path = path;
+        m_size = (uint64) fileSizeLI.QuadPart;
+        m_fileHandle = (intptr_t) hFile;
+        return true;
+    }
+
+    void ReadOnlyFile::Close()
+    {
+        if ( IsOpen() )
+        {
+            CloseHandle( (HANDLE) m_fileHandle );
+            m_fileHandle = s_invalidHandle;
+            m_size = 0;
+            m_path = Path();
+        }
+    }
+
+    bool ReadOnlyFile::ReadRange( uint64 offset, uint64 size, Byte* pDestination ) const
+    {
+        KRG_ASSERT( IsOpen() && pDestination != nullptr );
+
+        // ReadFile is limited to 32bit sizes so large ranges need to be split
+        bool result = true;
+        uint64 numBytesRead = 0;
+        while ( numBytesRead < size )
+        {
+            uint64 const readOffset = offset + numBytesRead;
+
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = (DWORD) ( readOffset & 0xFFFFFFFF );
+            overlapped.OffsetHigh = (DWORD) ( readOffset >> 32 );
+
+            DWORD const numBytesToRead = (DWORD) Math::Min( size - numBytesRead, (uint64) 0x40000000 );
+            DWORD numBytesReadThisCall = 0;
+            if ( !::ReadFile( (HANDLE) m_fileHandle, pDestination + numBytesRead, numBytesToRead, &numBytesReadThisCall, &overlapped ) || numBytesReadThisCall == 0 )
+            {
+                result = false;
+                break;
+            }
+
+            numBytesRead += numBytesReadThisCall;
+        }
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool MappedFile::Open( Path const& path, AccessHint hint )
+    {
+        KRG_ASSERT( path.IsFile() );
+        KRG_ASSERT( !IsOpen() );
+
+        DWORD const flags = ( hint == AccessHint::Sequential ) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+        HANDLE hFile = CreateFile( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr );
+        if ( hFile == INVALID_HANDLE_VALUE )
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSizeLI;
+        if ( !GetFileSizeEx( hFile, &fileSizeLI ) || fileSizeLI.QuadPart == 0 )
+        {
+            CloseHandle( hFile );
+            return false;
+        }
+
+        HANDLE hMapping = CreateFileMapping( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( hMapping == nullptr )
+        {
+            CloseHandle( hFile );
+            return false;
+        }
+
+        void* pView = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( pView == nullptr )
+        {
+            CloseHandle( hMapping );
+            CloseHandle( hFile );
+            return false;
+        }
+
+        m_pData = (Byte const*) pView;
+        m_size = (size_t) fileSizeLI.QuadPart;
+        m_pFileHandle = hFile;
+        m_pMappingHandle = hMapping;
+
+        // Ask the OS to start paging in the whole file
+        if ( hint == AccessHint::Sequential )
+        {
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = pView;
+            range.NumberOfBytes = m_size;
+            PrefetchVirtualMemory( GetCurrentProcess(), 1, &range, 0 );
+        }
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if ( m_pData != nullptr )
+        {
+            UnmapViewOfFile( m_pData );
+            CloseHandle( m_pMappingHandle );
+            CloseHandle( m_pFileHandle );
+        }
+
+        m_pData = nullptr;
+        m_size = 0;
+        m_pFileHandle = nullptr;
+        m_pMappingHandle = nullptr;
+    }
 }
 
 #endif
\ No newline at end of file
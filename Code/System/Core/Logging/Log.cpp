@@ -2,7 +2,10 @@
 #include "System/Core/Threading/Threading.h"
 #include "System/Core/FileSystem/FileSystem.h"
 #include "System/Core/FileSystem/FileStreams.h"
+#include "System/Core/Types/StringID.h"
 #include <ctime>
+#include <cstdio>
+#include <thread>
 
 //-------------------------------------------------------------------------
 
@@ -12,8 +15,55 @@ namespace KRG::Log
     {
         static char const* const g_severityLabels[] = { "Message", "Warning", "Error", "Fatal Error" };
 
+        constexpr static uint32 const g_maxMessageLength = 1024;
+        constexpr static uint32 const g_maxChannelLength = 32;
+        constexpr static uint32 const g_processingIntervalMS = 10;
+
+        // Rate limiting
+        constexpr static uint32 const g_maxEntriesPerChannelPerSecond = 100;
+
+        //-------------------------------------------------------------------------
+
+        // The raw entry that is queued by the logging thread, needs to be trivially copyable so that queuing never allocates or locks
+        struct QueuedEntry
+        {
+            std::time_t                     m_time;
+            char const*                     m_pFilename;        // Always a __FILE__ literal so safe to store
+            int32                           m_lineNumber;
+            Severity                        m_severity;
+            char                            m_channel[g_maxChannelLength];
+            char                            m_message[g_maxMessageLength];
+        };
+
+        // Each channel has its own budget of entries per second
+        struct RateLimitBudget
+        {
+            int64                           m_window = 0;
+            uint32                          m_numEntries = 0;
+            uint32                          m_numSuppressed = 0;
+        };
+
         struct LogData
         {
+            // Producers - lock free, the queue internally keeps a sub-queue per producing thread
+            Threading::LockFreeQueue<QueuedEntry>   m_queue;
+            THashMap<StringID, RateLimitBudget> m_rateLimitBudgets;
+            Threading::Mutex                m_rateLimitMutex;
+
+            // Consumer
+            std::thread                     m_loggingThread;
+            Threading::SyncEvent            m_processEvent;
+            std::atomic<bool>               m_exitRequested = false;
+            Threading::Mutex                m_processingMutex;  // Serializes the logging thread and explicit flushes
+
+            // Output file
+            FileSystem::Path                m_outputFilePath;
+            FileSystem::OutputFileStream*   m_pOutputFile = nullptr;
+            size_t                          m_outputFileSize = 0;
+            size_t                          m_maxOutputFileSize = 0;
+            uint32                          m_maxRotatedFiles = 0;
+
+            // Processed entries
             TVector<LogEntry>               m_logEntries;
             TVector<LogEntry>               m_unhandledWarningsAndErrors;
             Threading::Mutex                m_mutex;
@@ -23,6 +73,234 @@ namespace KRG::Log
         };
 
         static LogData*                     g_pLog = nullptr;
+
+        //-------------------------------------------------------------------------
+        // Output File
+        //-------------------------------------------------------------------------
+
+        static String GetRotatedOutputFilePath( uint32 index )
+        {
+            KRG_ASSERT( g_pLog->m_outputFilePath.IsValid() );
+
+            if ( index == 0 )
+            {
+                return g_pLog->m_outputFilePath.GetFullPath();
+            }
+
+            char const* pExtension = g_pLog->m_outputFilePath.GetExtension();
+            String const parentDirectory = g_pLog->m_outputFilePath.GetParentDirectory().GetFullPath();
+            String const filename = g_pLog->m_outputFilePath.GetFileNameWithoutExtension();
+            return String( String::CtorSprintf(), "%s%s.%u.%s", parentDirectory.c_str(), filename.c_str(), index, ( pExtension != nullptr ) ? pExtension : "txt" );
+        }
+
+        static void CloseOutputFile()
+        {
+            if ( g_pLog->m_pOutputFile != nullptr )
+            {
+                if ( g_pLog->m_pOutputFile->IsValid() )
+                {
+                    g_pLog->m_pOutputFile->Close();
+                }
+
+                KRG::Delete( g_pLog->m_pOutputFile );
+            }
+        }
+
+        static void OpenOutputFile()
+        {
+            KRG_ASSERT( g_pLog->m_pOutputFile == nullptr );
+            g_pLog->m_pOutputFile = KRG::New<FileSystem::OutputFileStream>( g_pLog->m_outputFilePath );
+            g_pLog->m_outputFileSize = 0;
+        }
+
+        // Shift all existing files up by one (dropping the oldest) and start a new output file
+        static void RotateOutputFile()
+        {
+            CloseOutputFile();
+
+            std::remove( GetRotatedOutputFilePath( g_pLog->m_maxRotatedFiles ).c_str() );
+            for ( int32 i = (int32) g_pLog->m_maxRotatedFiles - 1; i >= 0; i-- )
+            {
+                std::rename( GetRotatedOutputFilePath( i ).c_str(), GetRotatedOutputFilePath( i + 1 ).c_str() );
+            }
+
+            OpenOutputFile();
+        }
+
+        static void WriteToOutputFile( char const* pLine, size_t length )
+        {
+            if ( g_pLog->m_pOutputFile == nullptr )
+            {
+                return;
+            }
+
+            if ( g_pLog->m_maxRotatedFiles > 0 && ( g_pLog->m_outputFileSize + length ) > g_pLog->m_maxOutputFileSize )
+            {
+                RotateOutputFile();
+            }
+
+            if ( g_pLog->m_pOutputFile->IsValid() )
+            {
+                g_pLog->m_pOutputFile->Write( (void*) pLine, length );
+                g_pLog->m_outputFileSize += length;
+            }
+        }
+
+        //-------------------------------------------------------------------------
+        // Processing
+        //-------------------------------------------------------------------------
+
+        static void ProcessEntry( QueuedEntry const& queuedEntry )
+        {
+            LogEntry entry;
+            entry.m_message = queuedEntry.m_message;
+            entry.m_channel = queuedEntry.m_channel;
+            entry.m_filename = queuedEntry.m_pFilename;
+            entry.m_lineNumber = queuedEntry.m_lineNumber;
+            entry.m_severity = queuedEntry.m_severity;
+            entry.m_timestamp.resize( 9 );
+
+            // Only ever called while holding the processing lock so the use of localtime is safe
+            strftime( entry.m_timestamp.data(), 9, "%H:%M:%S", std::localtime( &queuedEntry.m_time ) );
+
+            // Immediate display of log
+            //-------------------------------------------------------------------------
+            // This uses a less verbose format, if you want more info look at the saved log
+
+            char buffer[g_maxMessageLength + 256];
+            Printf( buffer, sizeof( buffer ), "[%s][%s][%s] %s", entry.m_timestamp.c_str(), g_severityLabels[(int32) entry.m_severity], entry.m_channel.c_str(), entry.m_message.c_str() );
+
+            // Print to debug trace
+            KRG_TRACE_MSG( buffer );
+
+            // Print to std out
+            printf( "%s\n", buffer );
+
+            // Write to output file
+            //-------------------------------------------------------------------------
+
+            int32 const lineLength = Printf( buffer, sizeof( buffer ), "[%s] %s >>> %s: %s, Source: %s, %i\r\n", entry.m_timestamp.c_str(), entry.m_channel.c_str(), g_severityLabels[(int32) entry.m_severity], entry.m_message.c_str(), entry.m_filename.c_str(), entry.m_lineNumber );
+            if ( lineLength > 0 )
+            {
+                size_t const numCharsWritten = ( (size_t) lineLength < sizeof( buffer ) ) ? (size_t) lineLength : sizeof( buffer ) - 1;
+                WriteToOutputFile( buffer, numCharsWritten );
+            }
+
+            // Store entry and track unhandled warnings and errors
+            //-------------------------------------------------------------------------
+
+            Threading::ScopeLock lock( g_pLog->m_mutex );
+
+            if ( entry.m_severity == Severity::FatalError )
+            {
+                g_pLog->m_fatalErrorIndex = (int32) g_pLog->m_logEntries.size();
+            }
+
+            if ( entry.m_severity > Severity::Message )
+            {
+                g_pLog->m_numWarnings += ( entry.m_severity == Severity::Warning ) ? 1 : 0;
+                g_pLog->m_numErrors += ( entry.m_severity == Severity::Error ) ? 1 : 0;
+                g_pLog->m_unhandledWarningsAndErrors.emplace_back( entry );
+            }
+
+            g_pLog->m_logEntries.emplace_back( eastl::move( entry ) );
+        }
+
+        // Needs to be called with the processing lock held
+        static void ProcessQueuedEntries()
+        {
+            QueuedEntry queuedEntry;
+            while ( g_pLog->m_queue.try_dequeue( queuedEntry ) )
+            {
+                ProcessEntry( queuedEntry );
+            }
+
+            if ( g_pLog->m_pOutputFile != nullptr && g_pLog->m_pOutputFile->IsValid() )
+            {
+                g_pLog->m_pOutputFile->GetStream().flush();
+            }
+        }
+
+        static void LoggingThreadMain()
+        {
+            Threading::SetCurrentThreadName( "Logging Thread" );
+
+            while ( !g_pLog->m_exitRequested )
+            {
+                g_pLog->m_processEvent.Wait( Milliseconds( (float) g_processingIntervalMS ) );
+                g_pLog->m_processEvent.Reset();
+
+                Threading::ScopeLock lock( g_pLog->m_processingMutex );
+                ProcessQueuedEntries();
+            }
+        }
+
+        //-------------------------------------------------------------------------
+        // Queuing
+        //-------------------------------------------------------------------------
+
+        static void EnqueueEntry( QueuedEntry const& entry )
+        {
+            g_pLog->m_queue.enqueue( entry );
+
+            // Fatal errors are always immediately processed since we are about to halt
+            if ( entry.m_severity == Severity::FatalError )
+            {
+                Flush();
+            }
+            else if ( entry.m_severity == Severity::Error )
+            {
+                g_pLog->m_processEvent.Signal();
+            }
+        }
+
+        // Returns true if this entry should be dropped due to exceeding the per-channel budget
+        // Errors are never dropped, and they dont count towards the budget
+        static bool ApplyRateLimit( QueuedEntry const& entry )
+        {
+            if ( entry.m_severity == Severity::Error || entry.m_severity == Severity::FatalError )
+            {
+                return false;
+            }
+
+            StringID const channelID( entry.m_channel );
+            uint32 numSuppressed = 0;
+            bool shouldDrop = false;
+
+            {
+                Threading::ScopeLock lock( g_pLog->m_rateLimitMutex );
+                RateLimitBudget& budget = g_pLog->m_rateLimitBudgets[channelID];
+
+                // Start a new window, report how many entries we dropped in the previous one
+                if ( budget.m_window != (int64) entry.m_time )
+                {
+                    budget.m_window = (int64) entry.m_time;
+                    budget.m_numEntries = 0;
+                    numSuppressed = budget.m_numSuppressed;
+                    budget.m_numSuppressed = 0;
+                }
+
+                if ( budget.m_numEntries >= g_maxEntriesPerChannelPerSecond )
+                {
+                    budget.m_numSuppressed++;
+                    shouldDrop = true;
+                }
+                else
+                {
+                    budget.m_numEntries++;
+                }
+            }
+
+            if ( numSuppressed > 0 )
+            {
+                QueuedEntry suppressionEntry = entry;
+                suppressionEntry.m_severity = Severity::Warning;
+                Printf( suppressionEntry.m_message, g_maxMessageLength, "Log rate limit exceeded - suppressed %u entries", numSuppressed );
+                EnqueueEntry( suppressionEntry );
+            }
+
+            return shouldDrop;
+        }
     }
 
     //-------------------------------------------------------------------------
@@ -31,11 +309,21 @@ namespace KRG::Log
     {
         KRG_ASSERT( g_pLog == nullptr );
         g_pLog = KRG::New<LogData>();
+        g_pLog->m_loggingThread = std::thread( LoggingThreadMain );
     }
 
     void Shutdown()
     {
         KRG_ASSERT( g_pLog != nullptr );
+
+        g_pLog->m_exitRequested = true;
+        g_pLog->m_processEvent.Signal();
+        g_pLog->m_loggingThread.join();
+
+        // Process anything queued after the logging thread exited
+        Flush();
+        CloseOutputFile();
+
         KRG::Delete( g_pLog );
     }
 
@@ -44,12 +332,34 @@ namespace KRG::Log
         return g_pLog != nullptr;
     }
 
+    void Flush()
+    {
+        KRG_ASSERT( IsInitialized() );
+        Threading::ScopeLock lock( g_pLog->m_processingMutex );
+        ProcessQueuedEntries();
+    }
+
     //-------------------------------------------------------------------------
 
-    TVector<KRG::Log::LogEntry> const& GetLogEntries()
+    int32 GetNumLogEntries()
     {
         KRG_ASSERT( IsInitialized() );
-        return g_pLog->m_logEntries;
+        Threading::ScopeLock lock( g_pLog->m_mutex );
+        return (int32) g_pLog->m_logEntries.size();
+    }
+
+    void GetLogEntries( int32 firstEntryIdx, int32 numEntries, TVector<LogEntry>& outEntries )
+    {
+        KRG_ASSERT( IsInitialized() );
+        KRG_ASSERT( firstEntryIdx >= 0 && numEntries >= 0 );
+
+        Threading::ScopeLock lock( g_pLog->m_mutex );
+        int32 const endIdx = eastl::min( firstEntryIdx + numEntries, (int32) g_pLog->m_logEntries.size() );
+        outEntries.clear();
+        if ( firstEntryIdx < endIdx )
+        {
+            outEntries.insert( outEntries.end(), g_pLog->m_logEntries.begin() + firstEntryIdx, g_pLog->m_logEntries.begin() + endIdx );
+        }
     }
 
     void AddEntry( Severity severity, char const* pChannel, char const* pFilename, int pLineNumber, char const* pMessageFormat, ... )
@@ -65,71 +375,57 @@ namespace KRG::Log
     {
         KRG_ASSERT( IsInitialized() && pFilename != nullptr );
 
-        char msgbuffer[1024];
-        VPrintf( msgbuffer, 1024, pMessageFormat, args );
-        va_end( args );
+        QueuedEntry entry;
+        entry.m_time = std::time( nullptr );
+        entry.m_pFilename = pFilename;
+        entry.m_lineNumber = pLineNumber;
+        entry.m_severity = severity;
+        Printf( entry.m_channel, g_maxChannelLength, "%s", pChannel );
 
+        if ( ApplyRateLimit( entry ) )
         {
-            std::lock_guard<std::mutex> lock( g_pLog->m_mutex );
-
-            if ( severity == Severity::FatalError )
-            {
-                g_pLog->m_fatalErrorIndex = (int32) g_pLog->m_logEntries.size();
-            }
-
-            auto& entry = g_pLog->m_logEntries.emplace_back( LogEntry() );
-
-            //-------------------------------------------------------------------------
-
-            entry.m_message = msgbuffer;
-            entry.m_channel = pChannel;
-            entry.m_filename = pFilename;
-            entry.m_lineNumber = pLineNumber;
-            entry.m_severity = severity;
-            entry.m_timestamp.resize( 9 );
-
-            auto t = std::time( nullptr );
-            strftime( entry.m_timestamp.data(), 9, "%H:%M:%S", std::localtime( &t ) );
+            va_end( args );
+            return;
+        }
 
-            // Immediate display of log
-            //-------------------------------------------------------------------------
-            // This uses a less verbose format, if you want more info look at the saved log
+        // The message needs to be formatted here since the arguments are not guaranteed to outlive this call
+        VPrintf( entry.m_message, g_maxMessageLength, pMessageFormat, args );
+        va_end( args );
 
-            Printf( msgbuffer, 1024, "[%s][%s][%s] %s", entry.m_timestamp.c_str(), g_severityLabels[(int32) entry.m_severity], entry.m_channel.c_str(), entry.m_message.c_str() );
+        EnqueueEntry( entry );
+    }
 
-            // Print to debug trace
-            KRG_TRACE_MSG( msgbuffer );
+    //-------------------------------------------------------------------------
 
-            // Print to std out
-            printf( "%s\n", msgbuffer );
+    void SetOutputFile( FileSystem::Path const& logFilePath, size_t maxFileSize, uint32 maxRotatedFiles )
+    {
+        KRG_ASSERT( IsInitialized() && logFilePath.IsValid() && logFilePath.IsFile() );
+        KRG_ASSERT( maxFileSize > 0 );
 
-            // Track unhandled warnings and errors
-            //-------------------------------------------------------------------------
+        Threading::ScopeLock lock( g_pLog->m_processingMutex );
 
-            if ( entry.m_severity > Severity::Message )
-            {
-                g_pLog->m_numWarnings += ( entry.m_severity == Severity::Warning ) ? 1 : 0;
-                g_pLog->m_numErrors += ( entry.m_severity == Severity::Error ) ? 1 : 0;
-                g_pLog->m_unhandledWarningsAndErrors.emplace_back( entry );
-            }
-        }
+        CloseOutputFile();
+        g_pLog->m_outputFilePath = logFilePath;
+        g_pLog->m_maxOutputFileSize = maxFileSize;
+        g_pLog->m_maxRotatedFiles = maxRotatedFiles;
+        OpenOutputFile();
     }
 
-    //-------------------------------------------------------------------------
-
     void SaveToFile( FileSystem::Path const& logFilePath )
     {
         KRG_ASSERT( IsInitialized() && logFilePath.IsValid() && logFilePath.IsFile() );
 
+        Flush();
+
         FileSystem::EnsurePathExists( logFilePath );
 
         String logData;
 
-        char buffer[1024];
-        std::lock_guard<std::mutex> lock( g_pLog->m_mutex );
+        char buffer[g_maxMessageLength + 256];
+        Threading::ScopeLock lock( g_pLog->m_mutex );
         for ( auto const& entry : g_pLog->m_logEntries )
         {
-            Printf( buffer, 1024, "[%s] %s >>> %s: %s, Source: %s, %i\r\n", entry.m_timestamp.c_str(), entry.m_channel.c_str(), g_severityLabels[(int32) entry.m_severity], entry.m_message.c_str(), entry.m_filename.c_str(), entry.m_lineNumber );
+            Printf( buffer, sizeof( buffer ), "[%s] %s >>> %s: %s, Source: %s, %i\r\n", entry.m_timestamp.c_str(), entry.m_channel.c_str(), g_severityLabels[(int32) entry.m_severity], entry.m_message.c_str(), entry.m_filename.c_str(), entry.m_lineNumber );
             logData.append( buffer );
         }
 
@@ -156,7 +452,7 @@ namespace KRG::Log
     TVector<Log::LogEntry> GetUnhandledWarningsAndErrors()
     {
         KRG_ASSERT( IsInitialized() );
-        std::lock_guard<std::mutex> lock( g_pLog->m_mutex );
+        Threading::ScopeLock lock( g_pLog->m_mutex );
 
         TVector<Log::LogEntry> outEntries = g_pLog->m_unhandledWarningsAndErrors;
         g_pLog->m_unhandledWarningsAndErrors.clear();
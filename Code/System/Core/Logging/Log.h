@@ -29,6 +29,8 @@ namespace KRG::Log
 
     // Lifetime
     //-------------------------------------------------------------------------
+    // Logging is asynchronous: entries are pushed into a lock-free queue (with a sub-queue per producing thread) and
+    // are timestamped, stored and written out by a dedicated logging thread
 
     KRG_SYSTEM_CORE_API void Initialize();
     KRG_SYSTEM_CORE_API void Shutdown();
@@ -39,13 +41,20 @@ namespace KRG::Log
 
     KRG_SYSTEM_CORE_API void AddEntry( Severity severity, char const* pChannel, char const* pFilename, int pLineNumber, char const* pMessageFormat, ... );
     KRG_SYSTEM_CORE_API void AddEntryVarArgs( Severity severity, char const* pChannel, char const* pFilename, int pLineNumber, char const* pMessageFormat, va_list args );
-    KRG_SYSTEM_CORE_API TVector<LogEntry> const& GetLogEntries();
+    KRG_SYSTEM_CORE_API int32 GetNumLogEntries();
+    KRG_SYSTEM_CORE_API void GetLogEntries( int32 firstEntryIdx, int32 numEntries, TVector<LogEntry>& outEntries ); // Copies a range of entries since entries are appended from the logging thread
     KRG_SYSTEM_CORE_API int32 GetNumWarnings();
     KRG_SYSTEM_CORE_API int32 GetNumErrors();
 
+    // Blocks until all queued entries have been processed and written to the output file - automatically called on fatal errors
+    KRG_SYSTEM_CORE_API void Flush();
+
     // Output
     //-------------------------------------------------------------------------
 
+    // Continuously write all log entries to the specified file, once the file exceeds the max size it is rotated (Log.txt -> Log.1.txt -> Log.2.txt...)
+    KRG_SYSTEM_CORE_API void SetOutputFile( FileSystem::Path const& logFilePath, size_t maxFileSize = 8 * 1024 * 1024, uint32 maxRotatedFiles = 3 );
+
     KRG_SYSTEM_CORE_API void SaveToFile( FileSystem::Path const& logFilePath );
 
     // Warnings and errors
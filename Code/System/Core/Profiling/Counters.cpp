@@ -0,0 +1,165 @@
+#include "Counters.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/FileSystem/FileStreams.h"
+#include "System/Core/Threading/Threading.h"
+#include "System/Core/Math/Math.h"
+#include <EASTL/sort.h>
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Profiling
+{
+    namespace
+    {
+        // Counters are allocated from the system heap since they are created from static initializers and can outlive the memory system
+        static std::atomic<Counter*>        g_pFirstCounter = nullptr;
+        static Threading::Mutex             g_registryMutex;
+        static std::atomic<uint32>          g_numThreadSlotsAssigned = 0;
+        static thread_local uint32          t_threadSlotIdx = InvalidIndex;
+
+        static char const* const            g_counterTypeNames[] = { "PerFrame", "Gauge" };
+    }
+
+    //-------------------------------------------------------------------------
+
+    Counter::Counter( char const* pName, Type type, Counter* pNext )
+        : m_pName( pName )
+        , m_type( type )
+        , m_pNext( pNext )
+    {
+        KRG_ASSERT( pName != nullptr );
+    }
+
+    uint32 Counter::GetCurrentThreadSlotIdx()
+    {
+        // Threads beyond the slot count will share slots, this is fine since the slots are atomic
+        if ( t_threadSlotIdx == InvalidIndex )
+        {
+            t_threadSlotIdx = g_numThreadSlotsAssigned.fetch_add( 1 ) % s_numThreadSlots;
+        }
+
+        return t_threadSlotIdx;
+    }
+
+    void Counter::UpdateHistory()
+    {
+        int64 frameValue = 0;
+        if ( m_type == Type::PerFrame )
+        {
+            for ( auto& threadSlot : m_threadSlots )
+            {
+                frameValue += threadSlot.m_value.exchange( 0, std::memory_order_relaxed );
+            }
+        }
+        else
+        {
+            frameValue = m_gaugeValue.load( std::memory_order_relaxed );
+        }
+
+        m_history[m_historyIdx] = frameValue;
+        m_historyIdx = ( m_historyIdx + 1 ) % s_historySize;
+        m_numHistoryFrames = Math::Min( m_numHistoryFrames + 1, s_historySize );
+        m_total += frameValue;
+    }
+
+    Counter::Stats Counter::GetStats() const
+    {
+        Stats stats;
+        stats.m_total = m_total;
+        stats.m_numFrames = m_numHistoryFrames;
+
+        if ( m_numHistoryFrames == 0 )
+        {
+            return stats;
+        }
+
+        stats.m_lastValue = m_history[( m_historyIdx + s_historySize - 1 ) % s_historySize];
+
+        // The history is unordered when not full, so the oldest valid entry is always at index 0
+        int64 sortedValues[s_historySize];
+        memcpy( sortedValues, m_history, sizeof( int64 ) * m_numHistoryFrames );
+        eastl::sort( sortedValues, sortedValues + m_numHistoryFrames );
+
+        int64 sum = 0;
+        for ( uint32 i = 0; i < m_numHistoryFrames; i++ )
+        {
+            sum += sortedValues[i];
+        }
+
+        auto GetPercentile = [&sortedValues, this] ( float percentile )
+        {
+            uint32 const idx = (uint32) ( percentile * ( m_numHistoryFrames - 1 ) + 0.5f );
+            return sortedValues[idx];
+        };
+
+        stats.m_minValue = sortedValues[0];
+        stats.m_maxValue = sortedValues[m_numHistoryFrames - 1];
+        stats.m_average = float( double( sum ) / m_numHistoryFrames );
+        stats.m_p50 = GetPercentile( 0.50f );
+        stats.m_p95 = GetPercentile( 0.95f );
+        stats.m_p99 = GetPercentile( 0.99f );
+        return stats;
+    }
+
+    //-------------------------------------------------------------------------
+
+    Counter* FindOrCreateCounter( char const* pName, Counter::Type type )
+    {
+        KRG_ASSERT( pName != nullptr );
+        Threading::ScopeLock lock( g_registryMutex );
+
+        Counter* pFirstCounter = g_pFirstCounter.load();
+        for ( Counter* pCounter = pFirstCounter; pCounter != nullptr; pCounter = const_cast<Counter*>( pCounter->GetNext() ) )
+        {
+            if ( strcmp( pCounter->GetName(), pName ) == 0 )
+            {
+                KRG_ASSERT( pCounter->GetType() == type );
+                return pCounter;
+            }
+        }
+
+        // New counters are added at the head so that the list can always be safely iterated without the lock
+        Counter* pNewCounter = new Counter( pName, type, pFirstCounter );
+        g_pFirstCounter.store( pNewCounter );
+        return pNewCounter;
+    }
+
+    Counter const* GetFirstCounter()
+    {
+        return g_pFirstCounter.load();
+    }
+
+    void UpdateCounters()
+    {
+        Threading::ScopeLock lock( g_registryMutex );
+        for ( Counter* pCounter = g_pFirstCounter.load(); pCounter != nullptr; pCounter = const_cast<Counter*>( pCounter->GetNext() ) )
+        {
+            pCounter->UpdateHistory();
+        }
+    }
+
+    bool ExportCountersToCSV( FileSystem::Path const& csvFilePath )
+    {
+        KRG_ASSERT( csvFilePath.IsValid() );
+
+        String csvData = "Counter,Type,Last,Average,Min,Max,P50,P95,P99,Total,Frames\n";
+
+        char buffer[512];
+        for ( Counter const* pCounter = GetFirstCounter(); pCounter != nullptr; pCounter = pCounter->GetNext() )
+        {
+            Counter::Stats const stats = pCounter->GetStats();
+            Printf( buffer, sizeof( buffer ), "\"%s\",%s,%lld,%.3f,%lld,%lld,%lld,%lld,%lld,%lld,%u\n", pCounter->GetName(), g_counterTypeNames[(uint8) pCounter->GetType()], (long long) stats.m_lastValue, stats.m_average, (long long) stats.m_minValue, (long long) stats.m_maxValue, (long long) stats.m_p50, (long long) stats.m_p95, (long long) stats.m_p99, (long long) stats.m_total, stats.m_numFrames );
+            csvData.append( buffer );
+        }
+
+        FileSystem::EnsurePathExists( csvFilePath );
+        FileSystem::OutputFileStream csvFile( csvFilePath );
+        if ( !csvFile.IsValid() )
+        {
+            return false;
+        }
+
+        csvFile.Write( (void*) csvData.data(), csvData.size() );
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "System/Core/_Module/API.h"
+#include "System/Core/Types/IntegralTypes.h"
+#include <atomic>
+
+//-------------------------------------------------------------------------
+// Telemetry Counters
+//-------------------------------------------------------------------------
+// Named numeric counters that are aggregated once per frame (in Profiling::EndFrame) and keep a rolling per-frame history
+// * PerFrame counters are incremented from any thread and reset every frame (e.g. draw calls, physics queries)
+// * Gauge counters are set to an absolute value and keep it until changed (e.g. number of resources loading)
+//
+// Increments go to a per-thread slot so that threads dont contend on the same cache line
+// Counters are always accessed via FindOrCreateCounter so that the same name maps to the same counter across modules
+
+namespace KRG
+{
+    namespace FileSystem { class Path; }
+
+    //-------------------------------------------------------------------------
+
+    namespace Profiling
+    {
+        class KRG_SYSTEM_CORE_API Counter
+        {
+        public:
+
+            enum class Type : uint8
+            {
+                PerFrame = 0,
+                Gauge,
+            };
+
+            constexpr static uint32 const s_numThreadSlots = 32;
+            constexpr static uint32 const s_historySize = 512;
+
+            struct Stats
+            {
+                int64                       m_lastValue = 0;
+                int64                       m_minValue = 0;
+                int64                       m_maxValue = 0;
+                int64                       m_p50 = 0;
+                int64                       m_p95 = 0;
+                int64                       m_p99 = 0;
+                int64                       m_total = 0;        // Sum of all recorded frames
+                float                       m_average = 0.0f;
+                uint32                      m_numFrames = 0;    // Number of frames in the history window
+            };
+
+        private:
+
+            struct alignas( 64 ) ThreadSlot
+            {
+                std::atomic<int64>          m_value = 0;
+            };
+
+        public:
+
+            Counter( char const* pName, Type type, Counter* pNext );
+
+            inline char const* GetName() const { return m_pName; }
+            inline Type GetType() const { return m_type; }
+            inline Counter const* GetNext() const { return m_pNext; }
+
+            inline void Increment( int64 value = 1 )
+            {
+                m_threadSlots[GetCurrentThreadSlotIdx()].m_value.fetch_add( value, std::memory_order_relaxed );
+            }
+
+            inline void Set( int64 value )
+            {
+                m_gaugeValue.store( value, std::memory_order_relaxed );
+            }
+
+            // Get the rolling stats for this counter (only safe to call from the main thread)
+            Stats GetStats() const;
+
+            // Collect all the thread slots into the history, called once per frame by UpdateCounters
+            void UpdateHistory();
+
+        private:
+
+            static uint32 GetCurrentThreadSlotIdx();
+
+        private:
+
+            ThreadSlot                      m_threadSlots[s_numThreadSlots];
+            std::atomic<int64>              m_gaugeValue = 0;
+            char const*                     m_pName = nullptr;
+            Type                            m_type = Type::PerFrame;
+            Counter*                        m_pNext = nullptr;
+
+            int64                           m_history[s_historySize] = { 0 };
+            uint32                          m_historyIdx = 0;
+            uint32                          m_numHistoryFrames = 0;
+            int64                           m_total = 0;
+        };
+
+        //-------------------------------------------------------------------------
+
+        // Get a counter by name (creating it if needed), the name must be a string literal
+        KRG_SYSTEM_CORE_API Counter* FindOrCreateCounter( char const* pName, Counter::Type type = Counter::Type::PerFrame );
+
+        // Get the first registered counter, all counters form an intrusive list (see Counter::GetNext)
+        KRG_SYSTEM_CORE_API Counter const* GetFirstCounter();
+
+        // Collect all per-thread values into the per-frame history (called by Profiling::EndFrame)
+        KRG_SYSTEM_CORE_API void UpdateCounters();
+
+        // Write the current stats for all counters to a CSV file
+        KRG_SYSTEM_CORE_API bool ExportCountersToCSV( FileSystem::Path const& csvFilePath );
+    }
+}
+
+//-------------------------------------------------------------------------
+
+#if KRG_DEVELOPMENT_TOOLS
+#define KRG_PROFILE_COUNTER_INCREMENT( name, value ) { static KRG::Profiling::Counter* const s_pProfileCounter = KRG::Profiling::FindOrCreateCounter( name, KRG::Profiling::Counter::Type::PerFrame ); s_pProfileCounter->Increment( value ); }
+#define KRG_PROFILE_COUNTER_SET( name, value ) { static KRG::Profiling::Counter* const s_pProfileCounter = KRG::Profiling::FindOrCreateCounter( name, KRG::Profiling::Counter::Type::Gauge ); s_pProfileCounter->Set( value ); }
+#else
+#define KRG_PROFILE_COUNTER_INCREMENT( name, value )
+#define KRG_PROFILE_COUNTER_SET( name, value )
+#endif
\ No newline at end of file
@@ -10,6 +10,240 @@
 #include <shellapi.h>
 #endif
 
+#if KRG_PROFILER_NATIVE && KRG_DEVELOPMENT_TOOLS
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/FileSystem/FileStreams.h"
+#include "System/Core/Time/Time.h"
+#include "System/Core/Math/Math.h"
+#include "System/Core/Types/String.h"
+#include <atomic>
+
+#if defined( _M_X64 ) || defined( __x86_64__ )
+    #if _MSC_VER
+    #include <intrin.h>
+    #else
+    #include <x86intrin.h>
+    #endif
+#endif
+#endif
+
+//-------------------------------------------------------------------------
+// Native Profiler
+//-------------------------------------------------------------------------
+// Each thread lazily creates a fixed size event ring buffer that only it ever writes to, so recording an event is just two
+// timestamp reads and a store. Events are only recorded while a capture is active, the buffers are read back when the capture
+// is stopped. Buffers are never freed since worker threads may still be writing to them (they use the system heap since they
+// can outlive the memory system).
+
+#if KRG_PROFILER_NATIVE && KRG_DEVELOPMENT_TOOLS
+namespace KRG::Profiling
+{
+    namespace
+    {
+        static char const* const g_categoryNames[] = { "None", "AI", "Animation", "Camera", "GameLogic", "IO", "Navigation", "Physics", "Rendering", "Scene", "Streaming", "Network", "Wait" };
+
+        constexpr static uint32 const g_maxThreads = 128;
+        constexpr static uint32 const g_maxThreadNameLength = 64;
+        constexpr static uint64 const g_eventBufferCapacity = 1 << 16;  // Needs to be a power of 2
+        constexpr static uint64 const g_eventBufferMask = g_eventBufferCapacity - 1;
+
+        struct RecordedEvent
+        {
+            EventDesc const*                        m_pDesc;
+            uint64                                  m_startTicks;
+            uint64                                  m_endTicks;
+        };
+
+        struct ThreadEventBuffer
+        {
+            RecordedEvent                           m_events[g_eventBufferCapacity];
+            std::atomic<uint64>                     m_writeIndex = 0;
+            std::atomic<uint64>                     m_captureStartIndex = 0;
+            uint32                                  m_threadIdx = 0;
+            char                                    m_name[g_maxThreadNameLength] = { 0 };
+        };
+
+        static std::atomic<ThreadEventBuffer*>      g_threadBuffers[g_maxThreads];
+        static std::atomic<uint32>                  g_numThreadBuffers = 0;
+        static std::atomic<bool>                    g_isCapturing = false;
+        static thread_local ThreadEventBuffer*      t_pThreadBuffer = nullptr;
+
+        // Capture time calibration
+        static uint64                               g_captureStartTicks = 0;
+        static Nanoseconds                          g_captureStartTime;
+        static uint64                               g_frameStartTicks = 0;
+
+        //-------------------------------------------------------------------------
+
+        KRG_FORCE_INLINE uint64 ReadTicks()
+        {
+            #if defined( _M_X64 ) || defined( __x86_64__ )
+            return __rdtsc();
+            #else
+            return (uint64) PlatformClock::GetTime();
+            #endif
+        }
+
+        static ThreadEventBuffer* GetOrCreateThreadBuffer()
+        {
+            if ( t_pThreadBuffer == nullptr )
+            {
+                uint32 const threadIdx = g_numThreadBuffers.fetch_add( 1 );
+                if ( threadIdx >= g_maxThreads )
+                {
+                    return nullptr;
+                }
+
+                t_pThreadBuffer = new ThreadEventBuffer;
+                t_pThreadBuffer->m_threadIdx = threadIdx;
+                g_threadBuffers[threadIdx].store( t_pThreadBuffer, std::memory_order_release );
+            }
+
+            return t_pThreadBuffer;
+        }
+
+        KRG_FORCE_INLINE void RecordEvent( EventDesc const* pDesc, uint64 startTicks, uint64 endTicks )
+        {
+            ThreadEventBuffer* pBuffer = GetOrCreateThreadBuffer();
+            if ( pBuffer == nullptr )
+            {
+                return;
+            }
+
+            uint64 const writeIdx = pBuffer->m_writeIndex.load( std::memory_order_relaxed );
+            pBuffer->m_events[writeIdx & g_eventBufferMask] = { pDesc, startTicks, endTicks };
+            pBuffer->m_writeIndex.store( writeIdx + 1, std::memory_order_release );
+        }
+
+        //-------------------------------------------------------------------------
+
+        static void AppendEscapedString( String& outString, char const* pString )
+        {
+            for ( char const* pChar = pString; *pChar != 0; pChar++ )
+            {
+                if ( *pChar == '"' || *pChar == '\\' )
+                {
+                    outString.push_back( '\\' );
+                }
+
+                outString.push_back( *pChar );
+            }
+        }
+
+        static void WriteChromeTrace( FileSystem::Path const& captureSavePath, uint64 captureEndTicks, Nanoseconds captureEndTime )
+        {
+            KRG_ASSERT( captureEndTicks > g_captureStartTicks );
+            double const captureDurationMicroseconds = double( captureEndTime - g_captureStartTime ) / 1000.0;
+            double const microsecondsPerTick = Math::Max( captureDurationMicroseconds, 1.0 ) / double( captureEndTicks - g_captureStartTicks );
+
+            String trace;
+            trace.reserve( 1024 * 1024 );
+            trace.append( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+
+            bool isFirstEvent = true;
+            char buffer[256];
+
+            uint32 const numThreadBuffers = Math::Min( g_numThreadBuffers.load(), g_maxThreads );
+            for ( uint32 i = 0; i < numThreadBuffers; i++ )
+            {
+                ThreadEventBuffer const* pBuffer = g_threadBuffers[i].load( std::memory_order_acquire );
+                if ( pBuffer == nullptr )
+                {
+                    continue;
+                }
+
+                // Thread name metadata
+                //-------------------------------------------------------------------------
+
+                trace.append( isFirstEvent ? "" : ",\n" );
+                isFirstEvent = false;
+
+                trace.append( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0," );
+                Printf( buffer, sizeof( buffer ), "\"tid\":%u,\"args\":{\"name\":\"", pBuffer->m_threadIdx );
+                trace.append( buffer );
+                if ( pBuffer->m_name[0] != 0 )
+                {
+                    AppendEscapedString( trace, pBuffer->m_name );
+                }
+                else
+                {
+                    Printf( buffer, sizeof( buffer ), "Thread %u", pBuffer->m_threadIdx );
+                    trace.append( buffer );
+                }
+                trace.append( "\"}}" );
+
+                // Events - the owning thread might still be finishing a scope, so anything it could have overwritten is skipped
+                //-------------------------------------------------------------------------
+
+                uint64 const endIdx = pBuffer->m_writeIndex.load( std::memory_order_acquire );
+                uint64 startIdx = pBuffer->m_captureStartIndex.load( std::memory_order_relaxed );
+                if ( endIdx - startIdx > g_eventBufferCapacity )
+                {
+                    startIdx = endIdx - g_eventBufferCapacity;
+                }
+
+                for ( uint64 eventIdx = startIdx; eventIdx < endIdx; eventIdx++ )
+                {
+                    RecordedEvent const event = pBuffer->m_events[eventIdx & g_eventBufferMask];
+                    uint64 const latestWriteIdx = pBuffer->m_writeIndex.load( std::memory_order_acquire );
+                    if ( latestWriteIdx - eventIdx > g_eventBufferCapacity || event.m_startTicks < g_captureStartTicks )
+                    {
+                        continue;
+                    }
+
+                    trace.append( ",\n{\"name\":\"" );
+                    AppendEscapedString( trace, event.m_pDesc->m_pName );
+                    double const startTime = double( event.m_startTicks - g_captureStartTicks ) * microsecondsPerTick;
+                    double const duration = double( event.m_endTicks - event.m_startTicks ) * microsecondsPerTick;
+                    Printf( buffer, sizeof( buffer ), "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", g_categoryNames[(uint8) event.m_pDesc->m_category], pBuffer->m_threadIdx, startTime, duration );
+                    trace.append( buffer );
+                }
+            }
+
+            trace.append( "\n]}\n" );
+
+            //-------------------------------------------------------------------------
+
+            FileSystem::EnsurePathExists( captureSavePath );
+            FileSystem::OutputFileStream traceFile( captureSavePath );
+            if ( traceFile.IsValid() )
+            {
+                traceFile.Write( (void*) trace.data(), trace.size() );
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    ScopedEvent::ScopedEvent( EventDesc const* pDesc )
+    {
+        if ( g_isCapturing.load( std::memory_order_relaxed ) )
+        {
+            m_pDesc = pDesc;
+            m_startTicks = ReadTicks();
+        }
+    }
+
+    ScopedEvent::~ScopedEvent()
+    {
+        if ( m_pDesc != nullptr )
+        {
+            RecordEvent( m_pDesc, m_startTicks, ReadTicks() );
+        }
+    }
+
+    void SetCurrentThreadName( char const* pName )
+    {
+        KRG_ASSERT( pName != nullptr );
+        ThreadEventBuffer* pBuffer = GetOrCreateThreadBuffer();
+        if ( pBuffer != nullptr )
+        {
+            Printf( pBuffer->m_name, g_maxThreadNameLength, "%s", pName );
+        }
+    }
+}
+#endif
+
 //-------------------------------------------------------------------------
 
 namespace KRG::Profiling
@@ -21,8 +255,12 @@ namespace KRG::Profiling
         #endif
 
         #if KRG_DEVELOPMENT_TOOLS
+        #if KRG_PROFILER_NATIVE
+        g_frameStartTicks = ReadTicks();
+        #else
         OPTICK_FRAME( "KRG Main" );
         #endif
+        #endif
     }
 
     void EndFrame()
@@ -30,11 +268,23 @@ namespace KRG::Profiling
         #if KRG_ENABLE_SUPERLUMINAL
         PerformanceAPI::EndEvent();
         #endif
+
+        #if KRG_DEVELOPMENT_TOOLS
+        UpdateCounters();
+        #endif
+
+        #if KRG_PROFILER_NATIVE && KRG_DEVELOPMENT_TOOLS
+        static constexpr EventDesc const s_frameEventDesc( "Frame" );
+        if ( g_isCapturing.load( std::memory_order_relaxed ) && g_frameStartTicks != 0 )
+        {
+            RecordEvent( &s_frameEventDesc, g_frameStartTicks, ReadTicks() );
+        }
+        #endif
     }
 
     void OpenProfiler()
     {
-        #if _WIN32
+        #if _WIN32 && !KRG_PROFILER_NATIVE
         FileSystem::Path const profilerPath = FileSystem::Path( Platform::Win32::GetCurrentModulePath() ) + "..\\..\\..\\..\\External\\Optick\\Optick.exe";
         ShellExecute( 0, 0, profilerPath.c_str(), 0, 0, SW_SHOW );
         #endif
@@ -43,15 +293,50 @@ namespace KRG::Profiling
     void StartCapture()
     {
         #if KRG_DEVELOPMENT_TOOLS
+        #if KRG_PROFILER_NATIVE
+        if ( g_isCapturing )
+        {
+            return;
+        }
+
+        // Discard everything recorded by previous captures
+        uint32 const numThreadBuffers = Math::Min( g_numThreadBuffers.load(), g_maxThreads );
+        for ( uint32 i = 0; i < numThreadBuffers; i++ )
+        {
+            ThreadEventBuffer* pBuffer = g_threadBuffers[i].load( std::memory_order_acquire );
+            if ( pBuffer != nullptr )
+            {
+                pBuffer->m_captureStartIndex = pBuffer->m_writeIndex.load( std::memory_order_acquire );
+            }
+        }
+
+        g_captureStartTime = PlatformClock::GetTime();
+        g_captureStartTicks = ReadTicks();
+        g_frameStartTicks = 0;
+        g_isCapturing = true;
+        #else
         OPTICK_START_CAPTURE();
         #endif
+        #endif
     }
 
     void StopCapture( FileSystem::Path const& captureSavePath )
     {
         #if KRG_DEVELOPMENT_TOOLS
+        #if KRG_PROFILER_NATIVE
+        if ( !g_isCapturing )
+        {
+            return;
+        }
+
+        g_isCapturing = false;
+        uint64 const captureEndTicks = ReadTicks();
+        Nanoseconds const captureEndTime = PlatformClock::GetTime();
+        WriteChromeTrace( captureSavePath, captureEndTicks, captureEndTime );
+        #else
         OPTICK_STOP_CAPTURE();
         OPTICK_SAVE_CAPTURE( captureSavePath.c_str() );
         #endif
+        #endif
     }
 }
\ No newline at end of file
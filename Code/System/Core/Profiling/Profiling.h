@@ -1,12 +1,29 @@
 #pragma once
 
 #include "System/Core/Algorithm/Hash.h"
+#include "Counters.h"
 
-#if !KRG_DEVELOPMENT_TOOLS
-#define USE_OPTICK 0
+//-------------------------------------------------------------------------
+// Profiler backend selection
+//-------------------------------------------------------------------------
+// Optick is only usable with its windows viewer so on other platforms we use the built-in native profiler
+// The native profiler records scoped events into per-thread ring buffers and exports captures as Chrome trace JSON (chrome://tracing or Perfetto)
+
+#ifndef KRG_PROFILER_NATIVE
+    #if _WIN32
+        #define KRG_PROFILER_NATIVE 0
+    #else
+        #define KRG_PROFILER_NATIVE 1
+    #endif
 #endif
 
-#include <optick.h>
+#if !KRG_PROFILER_NATIVE
+    #if !KRG_DEVELOPMENT_TOOLS
+    #define USE_OPTICK 0
+    #endif
+
+    #include <optick.h>
+#endif
 
 //-------------------------------------------------------------------------
 
@@ -29,11 +46,124 @@ namespace KRG
         // Capture management
         KRG_SYSTEM_CORE_API void StartCapture();
         KRG_SYSTEM_CORE_API void StopCapture( FileSystem::Path const& captureSavePath );
+
+        //-------------------------------------------------------------------------
+        // Native Profiler
+        //-------------------------------------------------------------------------
+
+        #if KRG_PROFILER_NATIVE && KRG_DEVELOPMENT_TOOLS
+        enum class Category : uint8
+        {
+            None = 0,
+            AI,
+            Animation,
+            Camera,
+            GameLogic,
+            IO,
+            Navigation,
+            Physics,
+            Rendering,
+            Scene,
+            Streaming,
+            Network,
+            Wait,
+        };
+
+        // Static description of a profiling scope, one is created per scope site so events only need to store a pointer
+        struct EventDesc
+        {
+            constexpr EventDesc( char const* pName, Category category = Category::None ) : m_pName( pName ), m_category( category ) {}
+
+            char const*         m_pName;
+            Category            m_category;
+        };
+
+        // Set the name for the calling thread in the exported captures
+        KRG_SYSTEM_CORE_API void SetCurrentThreadName( char const* pName );
+
+        // Records a complete event for the calling thread when the scope ends, only records while a capture is active
+        class KRG_SYSTEM_CORE_API ScopedEvent
+        {
+        public:
+
+            ScopedEvent( EventDesc const* pDesc );
+            ~ScopedEvent();
+
+        private:
+
+            EventDesc const*    m_pDesc = nullptr;
+            uint64              m_startTicks = 0;
+        };
+        #endif
     }
 }
 
 //-------------------------------------------------------------------------
 
+#if KRG_PROFILER_NATIVE
+
+#if KRG_DEVELOPMENT_TOOLS
+#define KRG_PROFILE_CONCAT_INTERNAL( a, b ) a##b
+#define KRG_PROFILE_CONCAT( a, b ) KRG_PROFILE_CONCAT_INTERNAL( a, b )
+#define KRG_PROFILE_EVENT_INTERNAL( name, category ) \
+    static constexpr KRG::Profiling::EventDesc const KRG_PROFILE_CONCAT( s_profileEventDesc, __LINE__ )( name, KRG::Profiling::Category::category ); \
+    KRG::Profiling::ScopedEvent const KRG_PROFILE_CONCAT( profileScopedEvent, __LINE__ )( &KRG_PROFILE_CONCAT( s_profileEventDesc, __LINE__ ) )
+
+#define KRG_PROFILE_THREAD_START( ThreadName ) KRG::Profiling::SetCurrentThreadName( ThreadName )
+#define KRG_PROFILE_THREAD_END()
+#else
+#define KRG_PROFILE_EVENT_INTERNAL( name, category )
+#define KRG_PROFILE_THREAD_START( ThreadName )
+#define KRG_PROFILE_THREAD_END()
+#endif
+
+// Generic scopes
+//-------------------------------------------------------------------------
+
+#define KRG_PROFILE_FUNCTION() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, None )
+#define KRG_PROFILE_SCOPE( name ) KRG_PROFILE_EVENT_INTERNAL( name, None )
+
+// Tags (not supported by the native profiler)
+//-------------------------------------------------------------------------
+
+#define KRG_PROFILE_TAG( name, value )
+
+// Waits
+//-------------------------------------------------------------------------
+
+#define KRG_PROFILE_WAIT( name ) KRG_PROFILE_EVENT_INTERNAL( name, Wait )
+
+// Category scopes
+//-------------------------------------------------------------------------
+
+#define KRG_PROFILE_FUNCTION_AI() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, AI )
+#define KRG_PROFILE_FUNCTION_ANIMATION() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Animation )
+#define KRG_PROFILE_FUNCTION_CAMERA() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Camera )
+#define KRG_PROFILE_FUNCTION_GAMEPLAY() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, GameLogic )
+#define KRG_PROFILE_FUNCTION_IO() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, IO )
+#define KRG_PROFILE_FUNCTION_NAVIGATION() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Navigation )
+#define KRG_PROFILE_FUNCTION_PHYSICS() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Physics )
+#define KRG_PROFILE_FUNCTION_RENDER() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Rendering )
+#define KRG_PROFILE_FUNCTION_SCENE() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Scene )
+#define KRG_PROFILE_FUNCTION_RESOURCE() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Streaming )
+#define KRG_PROFILE_FUNCTION_NETWORK() KRG_PROFILE_EVENT_INTERNAL( __FUNCTION__, Network )
+
+#define KRG_PROFILE_SCOPE_AI( name ) KRG_PROFILE_EVENT_INTERNAL( name, AI )
+#define KRG_PROFILE_SCOPE_ANIMATION( name ) KRG_PROFILE_EVENT_INTERNAL( name, Animation )
+#define KRG_PROFILE_SCOPE_CAMERA( name ) KRG_PROFILE_EVENT_INTERNAL( name, Camera )
+#define KRG_PROFILE_SCOPE_GAMEPLAY( name ) KRG_PROFILE_EVENT_INTERNAL( name, GameLogic )
+#define KRG_PROFILE_SCOPE_IO( name ) KRG_PROFILE_EVENT_INTERNAL( name, IO )
+#define KRG_PROFILE_SCOPE_NAVIGATION( name ) KRG_PROFILE_EVENT_INTERNAL( name, Navigation )
+#define KRG_PROFILE_SCOPE_PHYSICS( name ) KRG_PROFILE_EVENT_INTERNAL( name, Physics )
+#define KRG_PROFILE_SCOPE_RENDER( name ) KRG_PROFILE_EVENT_INTERNAL( name, Rendering )
+#define KRG_PROFILE_SCOPE_SCENE( name ) KRG_PROFILE_EVENT_INTERNAL( name, Scene )
+#define KRG_PROFILE_SCOPE_RESOURCE( name ) KRG_PROFILE_EVENT_INTERNAL( name, Streaming )
+#define KRG_PROFILE_SCOPE_NETWORK( name ) KRG_PROFILE_EVENT_INTERNAL( name, Network )
+
+//-------------------------------------------------------------------------
+
+#else
+
 #define KRG_PROFILE_THREAD_START( ThreadName ) OPTICK_START_THREAD( ThreadName )
 
 #define KRG_PROFILE_THREAD_END() OPTICK_STOP_THREAD()
@@ -79,4 +209,6 @@ namespace KRG
 #define KRG_PROFILE_SCOPE_RENDER( name ) OPTICK_EVENT( name, Optick::Category::Rendering )
 #define KRG_PROFILE_SCOPE_SCENE( name ) OPTICK_EVENT( name, Optick::Category::Scene )
 #define KRG_PROFILE_SCOPE_RESOURCE( name ) OPTICK_EVENT( name, Optick::Category::Streaming )
-#define KRG_PROFILE_SCOPE_NETWORK( name ) OPTICK_EVENT( name, Optick::Category::Network )
\ No newline at end of file
+#define KRG_PROFILE_SCOPE_NETWORK( name ) OPTICK_EVENT( name, Optick::Category::Network )
+
+#endif
\ No newline at end of file
@@ -89,14 +89,15 @@ namespace KRG
 
         BinaryMemoryArchive::BinaryMemoryArchive( Mode mode, TVector<Byte>& data )
             : m_mode( mode )
-            , m_stream( data )
         {
+            m_pStream = KRG::New<MemoryStream>( data );
+
             // Read
             if ( mode == Mode::Read )
             {
                 if ( IsValid() )
                 {
-                    m_pArchive = KRG::New<cereal::BinaryInputArchive>( m_stream );
+                    m_pArchive = KRG::New<cereal::BinaryInputArchive>( *m_pStream );
                 }
             }
             else // Write
@@ -105,11 +106,19 @@ namespace KRG
 
                 if ( IsValid() )
                 {
-                    m_pArchive = KRG::New<cereal::BinaryOutputArchive>( m_stream );
+                    m_pArchive = KRG::New<cereal::BinaryOutputArchive>( *m_pStream );
                 }
             }
         }
 
+        BinaryMemoryArchive::BinaryMemoryArchive( Byte const* pData, size_t dataSize )
+            : m_mode( Mode::Read )
+        {
+            KRG_ASSERT( pData != nullptr && dataSize > 0 );
+            m_pStreamView = KRG::New<MemoryStreamView>( pData, dataSize );
+            m_pArchive = KRG::New<cereal::BinaryInputArchive>( *m_pStreamView );
+        }
+
         BinaryMemoryArchive::~BinaryMemoryArchive()
         {
             if ( m_pArchive != nullptr )
@@ -125,6 +134,16 @@ namespace KRG
                     KRG::Delete( pOutputArchive );
                 }
             }
+
+            if ( m_pStream != nullptr )
+            {
+                KRG::Delete( m_pStream );
+            }
+
+            if ( m_pStreamView != nullptr )
+            {
+                KRG::Delete( m_pStreamView );
+            }
         }
     }
 }
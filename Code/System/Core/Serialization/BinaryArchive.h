@@ -97,6 +97,10 @@ namespace KRG::Serialization
     public:
 
         BinaryMemoryArchive( Mode mode, TVector<Byte>& data );
+
+        // Read-only archive over an existing block of memory (e.g. a memory mapped file), does not take ownership of the memory
+        BinaryMemoryArchive( Byte const* pData, size_t dataSize );
+
         ~BinaryMemoryArchive();
 
         inline Mode GetMode() const { return m_mode; }
@@ -129,7 +133,8 @@ namespace KRG::Serialization
     private:
 
         Mode                                            m_mode;
-        MemoryStream                                    m_stream;
+        MemoryStream*                                   m_pStream = nullptr;
+        MemoryStreamView*                               m_pStreamView = nullptr;
         void*                                           m_pArchive = nullptr;
     };
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "../_Module/API.h"
 #include "System/Core/Types/Containers.h"
 #include "System/Core/Systems/ISystem.h"
+#include "System/Core/Profiling/Counters.h"
 #include "System/Core/ThirdParty/EnkiTS/TaskScheduler.h"
 
 //-------------------------------------------------------------------------
@@ -46,6 +47,7 @@ namespace KRG
         inline void ScheduleTask( ITaskSet* pTask )
         {
             KRG_ASSERT( m_initialized );
+            KRG_PROFILE_COUNTER_INCREMENT( "Tasks Scheduled", 1 );
             m_taskScheduler.AddTaskSetToPipe( pTask );
         }
 
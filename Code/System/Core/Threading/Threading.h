@@ -4,6 +4,7 @@
 #include "System/Core/Time/Time.h"
 #include "System/Core/ThirdParty/concurrentqueue/concurrentqueue.h"
 #include <mutex>
+#include <condition_variable>
 #include <shared_mutex>
 
 //-------------------------------------------------------------------------
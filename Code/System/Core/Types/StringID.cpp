@@ -67,7 +67,8 @@ namespace KRG
     {
         if ( pStr != nullptr )
         {
-            m_ID = Hash::GetHash32( pStr );
+            // XXH3 is significantly faster for the short strings that make up the majority of IDs
+            m_ID = (uint32) Hash::XXH3::GetHash64( pStr );
 
             // Cache the string
             Threading::ScopeLock lock( g_stringCacheMutex );
@@ -1,4 +1,5 @@
 #include "RenderContext_DX11.h"
+#include "System/Core/Profiling/Profiling.h"
 
 //-------------------------------------------------------------------------
 
@@ -482,12 +483,14 @@ namespace KRG::Render
     void RenderContext::Draw( uint32 vertexCount, uint32 vertexStartIndex ) const
     {
         KRG_ASSERT( IsValid() );
+        KRG_PROFILE_COUNTER_INCREMENT( "Draw Calls", 1 );
         m_pDeviceContext->Draw( vertexCount, vertexStartIndex );
     }
 
     void RenderContext::DrawIndexed( uint32 vertexCount, uint32 indexStartIndex, uint32 vertexStartIndex ) const
     {
         KRG_ASSERT( IsValid() );
+        KRG_PROFILE_COUNTER_INCREMENT( "Draw Calls", 1 );
         m_pDeviceContext->DrawIndexed( vertexCount, indexStartIndex, vertexStartIndex );
     }
 
@@ -591,6 +591,10 @@ namespace KRG::Render
             DXGI_FORMAT_R32G32B32_FLOAT,
             DXGI_FORMAT_R32G32B32A32_FLOAT,
 
+            DXGI_FORMAT_R16G16B16A16_UNORM,
+
+            DXGI_FORMAT_R16G16_SNORM,
+
             DXGI_FORMAT_R32_TYPELESS
         };
 
@@ -647,7 +651,7 @@ namespace KRG::Render
                     D3D11_INPUT_ELEMENT_DESC elementDesc;
                     elementDesc.SemanticName = DX11::GetNameForSemantic( shaderVertexElementDesc.m_semantic );
                     elementDesc.SemanticIndex = shaderVertexElementDesc.m_semanticIndex;
-                    elementDesc.Format = DX11::GetDXGIFormat( shaderVertexElementDesc.m_format );
+                    elementDesc.Format = DX11::GetDXGIFormat( vertexElement.m_format ); // Use the buffer data format, normalized formats are expanded by the input assembler
                     elementDesc.InputSlot = 0;
                     elementDesc.AlignedByteOffset = vertexElement.m_offset;
                     elementDesc.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
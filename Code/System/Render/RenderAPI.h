@@ -50,6 +50,10 @@ namespace KRG::Render
         Float_R32G32B32,
         Float_R32G32B32A32,
 
+        UNorm_R16G16B16A16,
+
+        SNorm_R16G16,
+
         // Special case format that changes based on texture usage
         Float_X32,
 
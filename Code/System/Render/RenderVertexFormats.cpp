@@ -35,6 +35,10 @@ namespace KRG::Render
         12,
         16,
 
+        8,
+
+        4,
+
         4
     };
 
@@ -50,6 +54,132 @@ namespace KRG::Render
 
     //-------------------------------------------------------------------------
 
+    namespace VertexCompression
+    {
+        uint16 FloatToHalf( float value )
+        {
+            uint32 bits;
+            memcpy( &bits, &value, sizeof( float ) );
+
+            uint32 const sign = ( bits >> 16 ) & 0x8000;
+            uint32 const absBits = bits & 0x7FFFFFFF;
+            uint32 const exponent = absBits >> 23;
+
+            // Infinity and NaN (NaNs stay quiet NaNs)
+            if ( absBits >= 0x7F800000 )
+            {
+                return (uint16) ( sign | 0x7C00 | ( ( absBits > 0x7F800000 ) ? 0x0200 : 0 ) );
+            }
+
+            // Too large to be represented
+            if ( absBits >= 0x47800000 )
+            {
+                return (uint16) ( sign | 0x7C00 );
+            }
+
+            // Too small to be represented
+            if ( absBits < 0x33000000 )
+            {
+                return (uint16) sign;
+            }
+
+            // Denormalized half, the rounding may carry over into the smallest normalized value which is still correct
+            if ( absBits < 0x38800000 )
+            {
+                uint32 const mantissa = ( absBits & 0x007FFFFF ) | 0x00800000;
+                uint32 const shift = 126 - exponent;
+                uint32 half = mantissa >> shift;
+                uint32 const remainder = mantissa & ( ( 1u << shift ) - 1 );
+                uint32 const halfway = 1u << ( shift - 1 );
+                if ( remainder > halfway || ( remainder == halfway && ( half & 1 ) ) )
+                {
+                    half++;
+                }
+
+                return (uint16) ( sign | half );
+            }
+
+            // Normalized half, round to nearest even - rounding can carry over into the exponent (up to infinity) which is still correct
+            uint32 half = ( ( exponent - 112 ) << 10 ) | ( ( absBits >> 13 ) & 0x03FF );
+            uint32 const remainder = absBits & 0x1FFF;
+            if ( remainder > 0x1000 || ( remainder == 0x1000 && ( half & 1 ) ) )
+            {
+                half++;
+            }
+
+            return (uint16) ( sign | half );
+        }
+
+        float HalfToFloat( uint16 value )
+        {
+            uint32 const sign = uint32( value & 0x8000 ) << 16;
+            uint32 const exponent = ( value >> 10 ) & 0x1F;
+            uint32 const mantissa = value & 0x03FF;
+
+            // Denormalized half
+            if ( exponent == 0 )
+            {
+                float const result = mantissa / 16777216.0f;
+                return sign ? -result : result;
+            }
+
+            uint32 bits = 0;
+            if ( exponent == 0x1F )
+            {
+                bits = sign | 0x7F800000 | ( mantissa << 13 );
+            }
+            else
+            {
+                bits = sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+            }
+
+            float result;
+            memcpy( &result, &bits, sizeof( float ) );
+            return result;
+        }
+
+        //-------------------------------------------------------------------------
+
+        void EncodeOctahedralNormal( Vector const& normal, int16 encodedNormal[2] )
+        {
+            float const L1Norm = Math::Abs( normal.m_x ) + Math::Abs( normal.m_y ) + Math::Abs( normal.m_z );
+            if ( L1Norm <= 0.0f )
+            {
+                encodedNormal[0] = encodedNormal[1] = 0;
+                return;
+            }
+
+            // Project onto the octahedron, the lower hemisphere is folded over the diagonals
+            float x = normal.m_x / L1Norm;
+            float y = normal.m_y / L1Norm;
+            if ( normal.m_z < 0.0f )
+            {
+                float const foldedX = ( 1.0f - Math::Abs( y ) ) * ( ( x >= 0.0f ) ? 1.0f : -1.0f );
+                float const foldedY = ( 1.0f - Math::Abs( x ) ) * ( ( y >= 0.0f ) ? 1.0f : -1.0f );
+                x = foldedX;
+                y = foldedY;
+            }
+
+            encodedNormal[0] = (int16) Math::RoundToInt( Math::Clamp( x, -1.0f, 1.0f ) * 32767.0f );
+            encodedNormal[1] = (int16) Math::RoundToInt( Math::Clamp( y, -1.0f, 1.0f ) * 32767.0f );
+        }
+
+        Vector DecodeOctahedralNormal( int16 const encodedNormal[2] )
+        {
+            // Matches the GPU SNORM conversion
+            float const x = Math::Max( encodedNormal[0] / 32767.0f, -1.0f );
+            float const y = Math::Max( encodedNormal[1] / 32767.0f, -1.0f );
+
+            Vector normal( x, y, 1.0f - Math::Abs( x ) - Math::Abs( y ), 0.0f );
+            float const t = Math::Max( -normal.m_z, 0.0f );
+            normal.m_x += ( normal.m_x >= 0.0f ) ? -t : t;
+            normal.m_y += ( normal.m_y >= 0.0f ) ? -t : t;
+            return normal.GetNormalized3();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     void VertexLayoutDescriptor::CalculateByteSize()
     {
         m_byteSize = 0;
@@ -87,6 +217,24 @@ namespace KRG::Render
                 layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::BlendIndex, DataFormat::SInt_R32G32B32A32, 0, 48 ) );
                 layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::BlendWeight, DataFormat::Float_R32G32B32A32, 0, 64 ) );
             }
+            else if ( format == VertexFormat::StaticMeshCompact || format == VertexFormat::SkeletalMeshCompact || format == VertexFormat::SkeletalMeshCompactWeights16 )
+            {
+                layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::Position, DataFormat::UNorm_R16G16B16A16, 0, 0 ) );
+                layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::Normal, DataFormat::SNorm_R16G16, 0, 8 ) );
+                layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::TexCoord, DataFormat::Float_R16G16, 0, 12 ) );
+                layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::TexCoord, DataFormat::Float_R16G16, 1, 16 ) );
+
+                if ( format == VertexFormat::SkeletalMeshCompact )
+                {
+                    layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::BlendIndex, DataFormat::UInt_R8G8B8A8, 0, 20 ) );
+                    layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::BlendWeight, DataFormat::UNorm_R8G8B8A8, 0, 24 ) );
+                }
+                else if ( format == VertexFormat::SkeletalMeshCompactWeights16 )
+                {
+                    layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::BlendIndex, DataFormat::UInt_R8G8B8A8, 0, 20 ) );
+                    layoutDesc.m_elementDescriptors.push_back( VertexLayoutDescriptor::ElementDescriptor( DataSemantic::BlendWeight, DataFormat::UNorm_R16G16B16A16, 0, 24 ) );
+                }
+            }
 
             //-------------------------------------------------------------------------
 
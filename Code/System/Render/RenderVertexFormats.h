@@ -5,6 +5,7 @@
 #include "System/Core/Serialization/Serialization.h"
 #include "System/Core/Types/Containers.h"
 #include "System/Core/Math/Math.h"
+#include "System/Core/Math/Vector.h"
 
 //-------------------------------------------------------------------------
 
@@ -20,6 +21,9 @@ namespace KRG::Render
         None,
         StaticMesh,
         SkeletalMesh,
+        StaticMeshCompact,
+        SkeletalMeshCompact,
+        SkeletalMeshCompactWeights16,
     };
 
     // CPU format for the static mesh vertex - this is what the mesh compiler fills the vertex data array with
@@ -38,6 +42,57 @@ namespace KRG::Render
         Float4  m_boneWeights;
     };
 
+    //-------------------------------------------------------------------------
+    // Compact vertex formats
+    //-------------------------------------------------------------------------
+    // Positions are normalized to the mesh bounds and need to be dequantized using the mesh position offset and scale
+    // Normals are octahedral encoded, UVs are stored as half floats and bone weights are normalized integers
+
+    // CPU format for the compact static mesh vertex - 20 bytes instead of 48
+    struct StaticMeshCompactVertex
+    {
+        uint16  m_position[4];      // W is unused
+        int16   m_normal[2];
+        uint16  m_UV0[2];
+        uint16  m_UV1[2];
+    };
+
+    // CPU format for the compact skeletal mesh vertex - 28 bytes instead of 80
+    struct SkeletalMeshCompactVertex : public StaticMeshCompactVertex
+    {
+        uint8   m_boneIndices[4];   // Unused influences are set to the invalid compact bone index
+        uint8   m_boneWeights[4];
+    };
+
+    // CPU format for the compact skeletal mesh vertex with 16-bit weights - 32 bytes instead of 80
+    struct SkeletalMeshCompactWeights16Vertex : public StaticMeshCompactVertex
+    {
+        uint8   m_boneIndices[4];   // Unused influences are set to the invalid compact bone index
+        uint16  m_boneWeights[4];
+    };
+
+    static_assert( sizeof( StaticMeshCompactVertex ) == 20 && sizeof( SkeletalMeshCompactVertex ) == 28 && sizeof( SkeletalMeshCompactWeights16Vertex ) == 32, "Unexpected compact vertex padding" );
+
+    //-------------------------------------------------------------------------
+
+    namespace VertexCompression
+    {
+        // Compact skeletal meshes support up to 255 bones, this index is used for unused influences
+        static uint8 const InvalidCompactBoneIndex = 0xFF;
+
+        KRG_FORCE_INLINE bool IsCompactFormat( VertexFormat format ) { return format >= VertexFormat::StaticMeshCompact; }
+
+        KRG_FORCE_INLINE uint16 QuantizeUNorm16( float value ) { return (uint16) Math::RoundToInt( Math::Clamp( value, 0.0f, 1.0f ) * 65535.0f ); }
+        KRG_FORCE_INLINE float DequantizeUNorm16( uint16 value ) { return value / 65535.0f; }
+
+        KRG_SYSTEM_RENDER_API uint16 FloatToHalf( float value );
+        KRG_SYSTEM_RENDER_API float HalfToFloat( uint16 value );
+
+        // Octahedral normal encoding - maps the unit sphere onto the [-1,1] square, this has a fairly uniform error distribution
+        KRG_SYSTEM_RENDER_API void EncodeOctahedralNormal( Vector const& normal, int16 encodedNormal[2] );
+        KRG_SYSTEM_RENDER_API Vector DecodeOctahedralNormal( int16 const encodedNormal[2] );
+    }
+
     //-------------------------------------------------------------------------
 
     struct KRG_SYSTEM_RENDER_API VertexLayoutDescriptor
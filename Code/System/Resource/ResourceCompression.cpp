@@ -0,0 +1,244 @@
+#include "ResourceCompression.h"
+#include "System/Core/Algorithm/Compression.h"
+#include "System/Core/Algorithm/Hash.h"
+#include "System/Core/Threading/TaskSystem.h"
+#include "System/Core/Profiling/Profiling.h"
+#include "System/Core/Logging/Log.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource::ResourceCompression
+{
+    static bool DecompressChunk( Byte const* pChunkData, ChunkDesc const& chunk, Byte* pDestination )
+    {
+        // Uncompressible chunks are stored as is
+        if ( chunk.m_compressedSize == chunk.m_uncompressedSize )
+        {
+            memcpy( pDestination, pChunkData, chunk.m_uncompressedSize );
+        }
+        else if ( !Compression::LZ::DecompressBlock( pChunkData, chunk.m_compressedSize, pDestination, chunk.m_uncompressedSize ) )
+        {
+            return false;
+        }
+
+        return Hash::XXHash::GetHash32( pDestination, chunk.m_uncompressedSize ) == chunk.m_checksum;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool IsCompressed( Byte const* pData, size_t dataSize )
+    {
+        if ( pData == nullptr || dataSize < sizeof( Header ) )
+        {
+            return false;
+        }
+
+        uint32 magic;
+        memcpy( &magic, pData, sizeof( uint32 ) );
+        return magic == g_magic;
+    }
+
+    bool Compress( TVector<Byte> const& uncompressedData, TVector<Byte>& outCompressedData, uint32 chunkSize )
+    {
+        KRG_ASSERT( chunkSize > 0 );
+        KRG_ASSERT( uncompressedData.size() < UINT32_MAX );
+
+        uint32 const uncompressedSize = (uint32) uncompressedData.size();
+        uint32 const numChunks = ( uncompressedSize + chunkSize - 1 ) / chunkSize;
+        size_t const dataStartOffset = sizeof( Header ) + sizeof( ChunkDesc ) * numChunks;
+
+        Header header;
+        header.m_uncompressedSize = uncompressedSize;
+        header.m_chunkSize = chunkSize;
+        header.m_numChunks = numChunks;
+
+        TVector<ChunkDesc> chunks;
+        chunks.resize( numChunks );
+
+        // Compress all chunks
+        //-------------------------------------------------------------------------
+
+        outCompressedData.resize( dataStartOffset + Compression::LZ::GetMaxCompressedSize( uncompressedSize ) + numChunks * 16 );
+
+        size_t currentOffset = 0;
+        for ( uint32 i = 0; i < numChunks; i++ )
+        {
+            Byte const* pChunkSource = uncompressedData.data() + ( i * chunkSize );
+            Byte* pChunkDestination = outCompressedData.data() + dataStartOffset + currentOffset;
+
+            auto& chunk = chunks[i];
+            chunk.m_offset = (uint32) currentOffset;
+            chunk.m_uncompressedSize = Math::Min( chunkSize, uncompressedSize - ( i * chunkSize ) );
+            chunk.m_checksum = Hash::XXHash::GetHash32( pChunkSource, chunk.m_uncompressedSize );
+
+            size_t const destinationCapacity = outCompressedData.size() - dataStartOffset - currentOffset;
+            size_t const compressedSize = Compression::LZ::CompressBlock( pChunkSource, chunk.m_uncompressedSize, pChunkDestination, destinationCapacity );
+
+            // Store the chunk uncompressed if we didnt save anything
+            if ( compressedSize == 0 || compressedSize >= chunk.m_uncompressedSize )
+            {
+                memcpy( pChunkDestination, pChunkSource, chunk.m_uncompressedSize );
+                chunk.m_compressedSize = chunk.m_uncompressedSize;
+            }
+            else
+            {
+                chunk.m_compressedSize = (uint32) compressedSize;
+            }
+
+            currentOffset += chunk.m_compressedSize;
+        }
+
+        // Write header and chunk table
+        //-------------------------------------------------------------------------
+
+        outCompressedData.resize( dataStartOffset + currentOffset );
+        memcpy( outCompressedData.data(), &header, sizeof( Header ) );
+        if ( numChunks > 0 )
+        {
+            memcpy( outCompressedData.data() + sizeof( Header ), chunks.data(), sizeof( ChunkDesc ) * numChunks );
+        }
+
+        return outCompressedData.size() < uncompressedData.size();
+    }
+
+    bool Decompress( Byte const* pCompressedData, size_t compressedDataSize, TVector<Byte>& outUncompressedData, TaskSystem* pTaskSystem, DecompressionStats* pOutStats )
+    {
+        KRG_PROFILE_FUNCTION_RESOURCE();
+
+        if ( !IsCompressed( pCompressedData, compressedDataSize ) )
+        {
+            return false;
+        }
+
+        Nanoseconds const startTime = PlatformClock::GetTime();
+
+        // Read and validate header and chunk table
+        //-------------------------------------------------------------------------
+
+        Header header;
+        memcpy( &header, pCompressedData, sizeof( Header ) );
+        if ( header.m_version != g_version || header.m_chunkSize == 0 )
+        {
+            KRG_LOG_ERROR( "Resource", "Unsupported compressed resource version (%u)", header.m_version );
+            return false;
+        }
+
+        // Every chunk is decompressed to 'chunkIdx * chunkSize', so the chunk layout has to match exactly what Compress produces
+        size_t const expectedNumChunks = ( size_t( header.m_uncompressedSize ) + header.m_chunkSize - 1 ) / header.m_chunkSize;
+        if ( header.m_numChunks != expectedNumChunks )
+        {
+            return false;
+        }
+
+        size_t const dataStartOffset = sizeof( Header ) + sizeof( ChunkDesc ) * header.m_numChunks;
+        if ( dataStartOffset > compressedDataSize )
+        {
+            return false;
+        }
+
+        ChunkDesc const* pChunks = reinterpret_cast<ChunkDesc const*>( pCompressedData + sizeof( Header ) );
+        Byte const* pChunkData = pCompressedData + dataStartOffset;
+        size_t const chunkDataSize = compressedDataSize - dataStartOffset;
+
+        size_t totalUncompressedSize = 0;
+        for ( uint32 i = 0; i < header.m_numChunks; i++ )
+        {
+            ChunkDesc const& chunk = pChunks[i];
+            if ( size_t( chunk.m_offset ) + chunk.m_compressedSize > chunkDataSize )
+            {
+                return false;
+            }
+
+            // All chunks but the last one are full, and the last one holds the remainder
+            size_t const chunkStartOffset = size_t( i ) * header.m_chunkSize;
+            size_t const expectedUncompressedSize = Math::Min( size_t( header.m_chunkSize ), size_t( header.m_uncompressedSize ) - chunkStartOffset );
+            if ( chunk.m_uncompressedSize != expectedUncompressedSize )
+            {
+                return false;
+            }
+
+            totalUncompressedSize += chunk.m_uncompressedSize;
+        }
+
+        if ( totalUncompressedSize != header.m_uncompressedSize )
+        {
+            return false;
+        }
+
+        outUncompressedData.resize( header.m_uncompressedSize );
+
+        // Decompress chunks
+        //-------------------------------------------------------------------------
+
+        bool wasSuccessful = true;
+
+        if ( pTaskSystem == nullptr || header.m_numChunks <= 1 )
+        {
+            for ( uint32 i = 0; i < header.m_numChunks && wasSuccessful; i++ )
+            {
+                wasSuccessful = DecompressChunk( pChunkData + pChunks[i].m_offset, pChunks[i], outUncompressedData.data() + ( size_t( i ) * header.m_chunkSize ) );
+            }
+        }
+        else // Go wide and decompress all chunks in parallel
+        {
+            struct ChunkDecompressionTask : public ITaskSet
+            {
+                ChunkDecompressionTask( Header const& header, ChunkDesc const* pChunks, Byte const* pChunkData, Byte* pDestination )
+                    : m_header( header )
+                    , m_pChunks( pChunks )
+                    , m_pChunkData( pChunkData )
+                    , m_pDestination( pDestination )
+                {
+                    m_SetSize = header.m_numChunks;
+                    m_MinRange = 1;
+                }
+
+                virtual void ExecuteRange( TaskSetPartition range, uint32 threadnum ) override final
+                {
+                    KRG_PROFILE_SCOPE_RESOURCE( "Decompress Resource Chunks" );
+                    for ( uint64 i = range.start; i < range.end; ++i )
+                    {
+                        if ( !DecompressChunk( m_pChunkData + m_pChunks[i].m_offset, m_pChunks[i], m_pDestination + ( i * m_header.m_chunkSize ) ) )
+                        {
+                            m_failed = true;
+                        }
+                    }
+                }
+
+            public:
+
+                Header const&                   m_header;
+                ChunkDesc const*                m_pChunks = nullptr;
+                Byte const*                     m_pChunkData = nullptr;
+                Byte*                           m_pDestination = nullptr;
+                std::atomic<bool>               m_failed = false;
+            };
+
+            //-------------------------------------------------------------------------
+
+            ChunkDecompressionTask task( header, pChunks, pChunkData, outUncompressedData.data() );
+            pTaskSystem->ScheduleTask( &task );
+            pTaskSystem->WaitForTask( &task );
+            wasSuccessful = !task.m_failed;
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( !wasSuccessful )
+        {
+            KRG_LOG_ERROR( "Resource", "Compressed resource data is corrupt - checksum mismatch" );
+            outUncompressedData.clear();
+            return false;
+        }
+
+        if ( pOutStats != nullptr )
+        {
+            pOutStats->m_compressedSize = compressedDataSize;
+            pOutStats->m_uncompressedSize = outUncompressedData.size();
+            pOutStats->m_decompressionTime = ( PlatformClock::GetTime() - startTime ).ToMilliseconds();
+            pOutStats->m_numChunks = header.m_numChunks;
+        }
+
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "_Module/API.h"
+#include "System/Core/Types/Containers.h"
+#include "System/Core/Time/Time.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG { class TaskSystem; }
+
+//-------------------------------------------------------------------------
+// Compressed Resource Container
+//-------------------------------------------------------------------------
+// Optional wrapper around compiled resource data, applied by the resource compiler based on the per-type policy
+// The data is split into fixed size chunks that are LZ compressed independently so that we can decompress them in parallel
+//
+// Layout: [ Header ][ Chunk Table ][ Chunk Data... ]
+// Each chunk stores an XXHash of its uncompressed data that is validated on decompression
+// Chunks that dont compress are stored uncompressed (compressed size == uncompressed size)
+
+namespace KRG::Resource::ResourceCompression
+{
+    constexpr static uint32 const g_magic = ( uint32( 'K' ) << 24 ) | ( uint32( 'R' ) << 16 ) | ( uint32( 'G' ) << 8 ) | uint32( 'Z' ); // Built explicitly since multi-char literals are implementation defined
+    constexpr static uint32 const g_version = 1;
+    constexpr static uint32 const g_defaultChunkSize = 256 * 1024;
+
+    //-------------------------------------------------------------------------
+
+    struct Header
+    {
+        uint32              m_magic = g_magic;
+        uint32              m_version = g_version;
+        uint32              m_uncompressedSize = 0;
+        uint32              m_chunkSize = 0;
+        uint32              m_numChunks = 0;
+    };
+
+    struct ChunkDesc
+    {
+        uint32              m_offset = 0;               // Offset of the chunk data from the start of the data block
+        uint32              m_compressedSize = 0;
+        uint32              m_uncompressedSize = 0;
+        uint32              m_checksum = 0;             // Hash of the uncompressed chunk data
+    };
+
+    //-------------------------------------------------------------------------
+
+    struct DecompressionStats
+    {
+        inline bool WasCompressed() const { return m_compressedSize > 0; }
+
+        size_t              m_compressedSize = 0;
+        size_t              m_uncompressedSize = 0;
+        Milliseconds        m_decompressionTime = 0.0f;
+        uint32              m_numChunks = 0;
+    };
+
+    //-------------------------------------------------------------------------
+
+    // Does this data block start with a valid compressed resource header
+    KRG_SYSTEM_RESOURCE_API bool IsCompressed( Byte const* pData, size_t dataSize );
+    inline bool IsCompressed( TVector<Byte> const& data ) { return IsCompressed( data.data(), data.size() ); }
+
+    // Compress a compiled resource, returns false if the compressed data would be larger than the source data
+    KRG_SYSTEM_RESOURCE_API bool Compress( TVector<Byte> const& uncompressedData, TVector<Byte>& outCompressedData, uint32 chunkSize = g_defaultChunkSize );
+
+    // Decompress a compiled resource, if a task system is supplied, chunks will be decompressed in parallel
+    // Returns false if the data is malformed or fails the checksum validation
+    KRG_SYSTEM_RESOURCE_API bool Decompress( Byte const* pCompressedData, size_t compressedDataSize, TVector<Byte>& outUncompressedData, TaskSystem* pTaskSystem = nullptr, DecompressionStats* pOutStats = nullptr );
+
+    inline bool Decompress( TVector<Byte> const& compressedData, TVector<Byte>& outUncompressedData, TaskSystem* pTaskSystem = nullptr, DecompressionStats* pOutStats = nullptr )
+    {
+        return Decompress( compressedData.data(), compressedData.size(), outUncompressedData, pTaskSystem, pOutStats );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "System/Core/FileSystem/IOService.h"
+
+//-------------------------------------------------------------------------
+// Resource Load Priorities
+//-------------------------------------------------------------------------
+// Higher priority requests are processed first and have their file reads serviced first
+// A request's priority is inherited by its install dependencies and can be raised while it is still in flight
+
+namespace KRG::Resource
+{
+    enum class LoadPriority : uint8
+    {
+        Background = 0,     // Streaming/prefetching, can be starved by everything else
+        Normal,
+        High,
+        Critical,           // Needed for the current frame
+
+        NumPriorities
+    };
+
+    static_assert( (uint8) LoadPriority::NumPriorities == (uint8) FileSystem::IOPriority::NumPriorities, "Load priorities map 1:1 onto IO priorities" );
+
+    //-------------------------------------------------------------------------
+
+    inline FileSystem::IOPriority GetIOPriority( LoadPriority priority )
+    {
+        KRG_ASSERT( priority != LoadPriority::NumPriorities );
+        return (FileSystem::IOPriority) priority;
+    }
+
+    inline char const* GetLoadPriorityName( LoadPriority priority )
+    {
+        constexpr static char const* const names[] = { "Background", "Normal", "High", "Critical" };
+        KRG_ASSERT( priority != LoadPriority::NumPriorities );
+        return names[(uint8) priority];
+    }
+}
@@ -7,11 +7,33 @@
 
 namespace KRG::Resource
 {
-    bool ResourceLoader::Load( ResourceID const& resourceID, TVector<Byte>& rawData, ResourceRecord* pResourceRecord ) const
+    bool ResourceLoader::Load( ResourceID const& resourceID, Byte const* pRawData, size_t rawDataSize, ResourceRecord* pResourceRecord, TaskSystem* pTaskSystem, ResourceCompression::DecompressionStats* pOutDecompressionStats ) const
     {
-        Serialization::BinaryMemoryArchive archive( Serialization::Mode::Read, rawData );
+        KRG_ASSERT( pRawData != nullptr && rawDataSize > 0 );
+
+        // Decompress resource data
+        //-------------------------------------------------------------------------
+
+        TVector<Byte> decompressedData;
+        if ( ResourceCompression::IsCompressed( pRawData, rawDataSize ) )
+        {
+            if ( !ResourceCompression::Decompress( pRawData, rawDataSize, decompressedData, pTaskSystem, pOutDecompressionStats ) )
+            {
+                KRG_LOG_ERROR( "Resource", "Failed to decompress resource data (%s)", resourceID.c_str() );
+                return false;
+            }
+
+            pRawData = decompressedData.data();
+            rawDataSize = decompressedData.size();
+        }
+
+        //-------------------------------------------------------------------------
+
+        Serialization::BinaryMemoryArchive archive( pRawData, rawDataSize );
         if ( archive.IsValid() )
         {
+            pResourceRecord->m_dataSize = rawDataSize;
+
             // Read resource header
             Resource::ResourceHeader header;
             archive >> header;
@@ -64,6 +86,7 @@ namespace KRG::Resource
         KRG_ASSERT( pResourceRecord->IsUnloading() || pResourceRecord->HasLoadingFailed() );
         UnloadInternal( resourceID, pResourceRecord );
         pResourceRecord->m_installDependencyResourceIDs.clear();
+        pResourceRecord->m_dataSize = 0;
     }
 
     void ResourceLoader::UnloadInternal( ResourceID const& resourceID, ResourceRecord* pResourceRecord ) const
@@ -3,6 +3,7 @@
 #include "_Module/API.h"
 #include "ResourcePtr.h"
 #include "IResource.h"
+#include "ResourceCompression.h"
 
 //-------------------------------------------------------------------------
 
@@ -51,8 +52,13 @@ namespace KRG
 
             TVector<ResourceTypeID> const& GetLoadableTypes() const { return m_loadableTypes; }
 
+            // Can this loader's load/install/unload functions be called concurrently (for different resources) from multiple threads
+            inline bool IsThreadSafe() const { return m_isThreadSafe; }
+
             // This function loads is responsible to deserialize the compiled resource data, read the resource header for install dependencies and to create the new runtime resource object
-            bool Load( ResourceID const& resourceID, TVector<Byte>& rawData, ResourceRecord* pResourceRecord ) const;
+            // Compressed resource data will be transparently decompressed (in parallel if a task system is supplied)
+            // Uncompressed data is deserialized directly from the supplied memory (e.g. a memory mapped file) without any copies
+            bool Load( ResourceID const& resourceID, Byte const* pRawData, size_t rawDataSize, ResourceRecord* pResourceRecord, TaskSystem* pTaskSystem = nullptr, ResourceCompression::DecompressionStats* pOutDecompressionStats = nullptr ) const;
 
             // This function will destroy the created resource object
             void Unload( ResourceID const& resourceID, ResourceRecord* pResourceRecord ) const;
@@ -77,6 +83,7 @@ namespace KRG
         protected:
 
             TVector<ResourceTypeID>          m_loadableTypes;
+            bool                             m_isThreadSafe = false;     // Set in derived constructors if the loader doesnt touch any shared state
         };
     }
 }
\ No newline at end of file
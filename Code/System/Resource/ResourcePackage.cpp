@@ -0,0 +1,90 @@
+#include "ResourcePackage.h"
+#include "System/Core/Logging/Log.h"
+#include "System/Core/Profiling/Profiling.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource
+{
+    bool ResourcePackage::Open( FileSystem::Path const& packagePath )
+    {
+        KRG_PROFILE_FUNCTION_RESOURCE();
+        KRG_ASSERT( !IsOpen() );
+
+        if ( !m_file.Open( packagePath ) )
+        {
+            KRG_LOG_ERROR( "Resource", "Failed to open resource package: %s", packagePath.c_str() );
+            return false;
+        }
+
+        // Read and validate the header
+        //-------------------------------------------------------------------------
+
+        ResourcePackageFormat::Header header;
+        if ( m_file.GetSize() < sizeof( header ) || !m_file.ReadRange( 0, sizeof( header ), (Byte*) &header ) )
+        {
+            KRG_LOG_ERROR( "Resource", "Failed to read resource package header: %s", packagePath.c_str() );
+            Close();
+            return false;
+        }
+
+        if ( header.m_magic != ResourcePackageFormat::g_magic || header.m_version != ResourcePackageFormat::g_version )
+        {
+            KRG_LOG_ERROR( "Resource", "Invalid or outdated resource package: %s", packagePath.c_str() );
+            Close();
+            return false;
+        }
+
+        uint64 const indexSize = (uint64) header.m_numEntries * sizeof( IndexEntry );
+        if ( header.m_indexOffset < sizeof( header ) || header.m_indexOffset + indexSize != m_file.GetSize() )
+        {
+            KRG_LOG_ERROR( "Resource", "Corrupt resource package index: %s", packagePath.c_str() );
+            Close();
+            return false;
+        }
+
+        // Read the index
+        //-------------------------------------------------------------------------
+
+        m_index.resize( header.m_numEntries );
+        if ( header.m_numEntries > 0 && !m_file.ReadRange( header.m_indexOffset, indexSize, (Byte*) m_index.data() ) )
+        {
+            KRG_LOG_ERROR( "Resource", "Failed to read resource package index: %s", packagePath.c_str() );
+            Close();
+            return false;
+        }
+
+        for ( auto const& entry : m_index )
+        {
+            if ( entry.m_size == 0 || entry.m_offset < sizeof( header ) || entry.m_offset + entry.m_size > header.m_indexOffset )
+            {
+                KRG_LOG_ERROR( "Resource", "Corrupt resource package index: %s", packagePath.c_str() );
+                Close();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void ResourcePackage::Close()
+    {
+        m_index.clear();
+        m_file.Close();
+    }
+
+    ResourcePackage::IndexEntry const* ResourcePackage::FindEntry( ResourceID const& resourceID ) const
+    {
+        KRG_ASSERT( IsOpen() );
+
+        uint32 const resourcePathID = resourceID.GetID();
+        auto predicate = [] ( IndexEntry const& entry, uint32 ID ) { return entry.m_resourcePathID < ID; };
+        auto iter = eastl::lower_bound( m_index.begin(), m_index.end(), resourcePathID, predicate );
+        if ( iter != m_index.end() && iter->m_resourcePathID == resourcePathID )
+        {
+            return iter;
+        }
+
+        return nullptr;
+    }
+}
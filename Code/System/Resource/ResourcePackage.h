@@ -0,0 +1,88 @@
+#pragma once
+
+#include "_Module/API.h"
+#include "ResourceID.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/Types/Containers.h"
+
+//-------------------------------------------------------------------------
+// Resource Package
+//-------------------------------------------------------------------------
+// A single archive containing a set of compiled resources, built by the resource compiler ("-package")
+// Resources are stored back to back in locality order (e.g. a map followed by everything it needs) so loads turn into contiguous reads
+//
+// Layout: [ Header ][ Resource Data... ][ Index ]
+// The index is sorted by resource path ID so lookups are a binary search, the data for each resource is the unmodified compiled file
+// The package file is kept open for the lifetime of the package and read through positional reads, so it can be read from concurrently
+
+namespace KRG::Resource::ResourcePackageFormat
+{
+    constexpr static uint32 const g_magic = ( uint32( 'K' ) << 24 ) | ( uint32( 'R' ) << 16 ) | ( uint32( 'G' ) << 8 ) | uint32( 'P' ); // Built explicitly since multi-char literals are implementation defined
+    constexpr static uint32 const g_version = 1;
+    constexpr static uint32 const g_dataAlignment = 16;
+    constexpr static char const* const g_extension = ".krgpak";
+
+    //-------------------------------------------------------------------------
+
+    struct Header
+    {
+        uint32              m_magic = g_magic;
+        uint32              m_version = g_version;
+        uint32              m_numEntries = 0;
+        uint32              m_padding = 0;
+        uint64              m_indexOffset = 0;
+    };
+
+    struct IndexEntry
+    {
+        enum Flags : uint32
+        {
+            Compressed = 1 << 0,                        // The data is a compressed resource container
+        };
+
+        inline bool IsCompressed() const { return ( m_flags & Compressed ) != 0; }
+
+        uint32              m_resourcePathID = 0;
+        uint32              m_flags = 0;
+        uint64              m_offset = 0;
+        uint64              m_size = 0;
+    };
+
+    static_assert( sizeof( Header ) == 24, "The package header is read directly from disk, dont change its layout" );
+    static_assert( sizeof( IndexEntry ) == 24, "The package index is read directly from disk, dont change its layout" );
+}
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource
+{
+    class KRG_SYSTEM_RESOURCE_API ResourcePackage
+    {
+    public:
+
+        using IndexEntry = ResourcePackageFormat::IndexEntry;
+
+    public:
+
+        ResourcePackage() = default;
+        ResourcePackage( ResourcePackage const& ) = delete;
+        ResourcePackage& operator=( ResourcePackage const& ) = delete;
+
+        // Opens the package file and reads its index
+        bool Open( FileSystem::Path const& packagePath );
+        void Close();
+
+        inline bool IsOpen() const { return m_file.IsOpen(); }
+        inline FileSystem::Path const& GetPath() const { return m_file.GetPath(); }
+        inline FileSystem::ReadOnlyFile const* GetFile() const { return &m_file; }
+        inline uint32 GetNumEntries() const { return (uint32) m_index.size(); }
+
+        // Returns the index entry for the resource or nullptr if this package doesnt contain it
+        IndexEntry const* FindEntry( ResourceID const& resourceID ) const;
+
+    private:
+
+        FileSystem::ReadOnlyFile                m_file;
+        TVector<IndexEntry>                     m_index;
+    };
+}
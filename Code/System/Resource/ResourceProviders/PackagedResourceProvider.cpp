@@ -1,32 +1,82 @@
-#include "PackagedResourceProvider.h"
-#include "System/Resource/ResourceRequest.h"
-#include "System/Resource/ResourceSettings.h"
-
-//-------------------------------------------------------------------------
-
-namespace KRG::Resource
-{
-    PackagedResourceProvider::PackagedResourceProvider( Settings const* pSettings )
-        : ResourceProvider()
-        , m_compiledResourcesPath( pSettings->m_compiledResourcePath )
-    {
-        KRG_ASSERT( pSettings != nullptr );
-        KRG_ASSERT( m_compiledResourcesPath.IsValid() );
-    }
-
-    bool PackagedResourceProvider::IsReady() const
-    {
-        return true;
-    }
-
-    void PackagedResourceProvider::RequestRawResource( ResourceRequest* pRequest )
-    {
-        FileSystem::Path const resourceFilePath = pRequest->GetResourceID().GetResourcePath().ToFileSystemPath( m_compiledResourcesPath );
-        pRequest->OnRawResourceRequestComplete( resourceFilePath.c_str() );
-    }
-
-    void PackagedResourceProvider::CancelRequest( ResourceRequest* pRequest )
-    {
-         // Do Nothing
-    }
-}
\ No newline at end of file
+#include "PackagedResourceProvider.h"
+#include "System/Resource/ResourceRequest.h"
+#include "System/Resource/ResourceSettings.h"
+#include "System/Core/Logging/Log.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource
+{
+    PackagedResourceProvider::PackagedResourceProvider( Settings const* pSettings )
+        : ResourceProvider()
+        , m_compiledResourcesPath( pSettings->m_compiledResourcePath )
+    {
+        KRG_ASSERT( pSettings != nullptr );
+        KRG_ASSERT( m_compiledResourcesPath.IsValid() );
+    }
+
+    bool PackagedResourceProvider::IsReady() const
+    {
+        return true;
+    }
+
+    bool PackagedResourceProvider::Initialize()
+    {
+        KRG_ASSERT( m_packages.empty() );
+
+        TVector<FileSystem::Path> packagePaths;
+        FileSystem::GetDirectoryContents( m_compiledResourcesPath, packagePaths, FileSystem::DirectoryReaderOutput::OnlyFiles, FileSystem::DirectoryReaderMode::DontExpand, { ResourcePackageFormat::g_extension } );
+
+        auto comparator = [] ( FileSystem::Path const& a, FileSystem::Path const& b ) { return a.GetFullPath() > b.GetFullPath(); };
+        eastl::sort( packagePaths.begin(), packagePaths.end(), comparator );
+
+        // A package that fails to open is skipped, its resources will fall back to lower priority packages or loose files
+        for ( auto const& packagePath : packagePaths )
+        {
+            auto pPackage = KRG::New<ResourcePackage>();
+            if ( pPackage->Open( packagePath ) )
+            {
+                KRG_LOG_MESSAGE( "Resource", "Mounted resource package (%s) with %u resources", packagePath.c_str(), pPackage->GetNumEntries() );
+                m_packages.emplace_back( pPackage );
+            }
+            else
+            {
+                KRG::Delete( pPackage );
+            }
+        }
+
+        return true;
+    }
+
+    void PackagedResourceProvider::Shutdown()
+    {
+        for ( auto& pPackage : m_packages )
+        {
+            KRG::Delete( pPackage );
+        }
+
+        m_packages.clear();
+    }
+
+    void PackagedResourceProvider::RequestRawResource( ResourceRequest* pRequest )
+    {
+        ResourceID const& resourceID = pRequest->GetResourceID();
+
+        for ( auto pPackage : m_packages )
+        {
+            if ( auto pEntry = pPackage->FindEntry( resourceID ) )
+            {
+                pRequest->OnRawResourceRequestComplete( pPackage->GetFile(), pEntry->m_offset, pEntry->m_size );
+                return;
+            }
+        }
+
+        FileSystem::Path const resourceFilePath = resourceID.GetResourcePath().ToFileSystemPath( m_compiledResourcesPath );
+        pRequest->OnRawResourceRequestComplete( resourceFilePath.c_str() );
+    }
+
+    void PackagedResourceProvider::CancelRequest( ResourceRequest* pRequest )
+    {
+         // Do Nothing
+    }
+}
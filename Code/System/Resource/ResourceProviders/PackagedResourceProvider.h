@@ -1,33 +1,40 @@
-#pragma once
-
-#include "System/Resource/ResourceProvider.h"
-
-//-------------------------------------------------------------------------
-
-namespace KRG::Resource
-{
-    class Settings;
-
-    //-------------------------------------------------------------------------
-
-    class KRG_SYSTEM_RESOURCE_API PackagedResourceProvider final : public ResourceProvider
-    {
-
-    public:
-
-        PackagedResourceProvider( Settings const* pSettings );
-
-        virtual bool IsReady() const override final;
-
-    private:
-
-        PackagedResourceProvider() = delete;
-
-        virtual void RequestRawResource( ResourceRequest* pRequest ) override;
-        virtual void CancelRequest( ResourceRequest* pRequest ) override;
-
-    private:
-
-        FileSystem::Path const m_compiledResourcesPath;
-    };
-}
\ No newline at end of file
+#pragma once
+
+#include "System/Resource/ResourceProvider.h"
+#include "System/Resource/ResourcePackage.h"
+
+//-------------------------------------------------------------------------
+// Reads compiled resources from the resource packages in the compiled resource directory
+// Packages are searched in reverse name order so that later packages (e.g. patches) override earlier ones
+// Resources that are not in any package are read from the loose compiled files
+
+namespace KRG::Resource
+{
+    class Settings;
+
+    //-------------------------------------------------------------------------
+
+    class KRG_SYSTEM_RESOURCE_API PackagedResourceProvider final : public ResourceProvider
+    {
+
+    public:
+
+        PackagedResourceProvider( Settings const* pSettings );
+
+        virtual bool IsReady() const override final;
+        virtual bool Initialize() override final;
+        virtual void Shutdown() override final;
+
+    private:
+
+        PackagedResourceProvider() = delete;
+
+        virtual void RequestRawResource( ResourceRequest* pRequest ) override;
+        virtual void CancelRequest( ResourceRequest* pRequest ) override;
+
+    private:
+
+        FileSystem::Path const                  m_compiledResourcesPath;
+        TVector<ResourcePackage*>               m_packages;                 // In override order
+    };
+}
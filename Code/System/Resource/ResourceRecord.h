@@ -22,6 +22,7 @@ namespace KRG
             friend class ResourceRequest;
             friend class ResourceLoader;
             friend class ResourceDebugView;
+            friend class ResourceResidentCache;
 
         public:
 
@@ -68,6 +69,12 @@ namespace KRG
 
             inline TInlineVector<ResourceID, 4> const& GetInstallDependencies() const { return m_installDependencyResourceIDs; }
 
+            // Is this resource being kept resident even though it has no references
+            inline bool IsInResidentCache() const { return m_isInResidentCache; }
+
+            // The size of the (uncompressed) compiled data for this resource, this is used as an estimate for the resource's memory footprint
+            inline uint64 GetDataSize() const { return m_dataSize; }
+
         protected:
 
             ResourceID                              m_resourceID;                                   // The ID of the resource this record refers to
@@ -75,6 +82,8 @@ namespace KRG
             std::atomic<LoadingStatus>              m_loadingStatus = LoadingStatus::Unloaded;      // The state of this resource (atomic since it will be modify by resource requests which run across multiple frames)
             TVector<ResourceRequesterID>            m_references;                                   // The list of references to this resources
             TInlineVector<ResourceID, 4>            m_installDependencyResourceIDs;                 // The list of resources that need to be loaded and installed before we can install this resource
+            uint64                                  m_dataSize = 0;                                 // The size of the uncompressed compiled data
+            bool                                    m_isInResidentCache = false;                    // Is this unreferenced resource kept resident by the resource cache
         };
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "ResourceRequest.h"
 #include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/FileSystem/IOService.h"
 #include "System/Core/Profiling/Profiling.h"
 #include "System/Core/Threading/Threading.h"
 #include "System/Core/Logging/Log.h"
@@ -8,23 +9,49 @@
 
 namespace KRG::Resource
 {
-    ResourceRequest::ResourceRequest( ResourceRequesterID const& requesterID, Type type, ResourceRecord* pRecord, ResourceLoader* pResourceLoader )
+    #if KRG_DEVELOPMENT_TOOLS
+    char const* ResourceRequest::LoadTrace::GetStageName( Stage stage )
+    {
+        static char const* const stageNames[NumStages] = { "Queued", "Raw Request", "Raw Read", "Load", "Wait For Dependencies", "Install" };
+        KRG_ASSERT( stage < NumStages );
+        return stageNames[stage];
+    }
+    #endif
+
+    //-------------------------------------------------------------------------
+
+    ResourceRequest::ResourceRequest( ResourceRequesterID const& requesterID, Type type, ResourceRecord* pRecord, ResourceLoader* pResourceLoader, LoadPriority priority, Milliseconds deadline )
         : m_requesterID( requesterID )
         , m_pResourceRecord( pRecord )
         , m_pResourceLoader( pResourceLoader )
         , m_type( type )
+        , m_priority( priority )
+        , m_requestedPriority( priority )
+        , m_requestTime( PlatformClock::GetTimeInMilliseconds() )
     {
         KRG_ASSERT( Threading::IsMainThread() );
         KRG_ASSERT( m_pResourceRecord != nullptr && m_pResourceRecord->IsValid() );
         KRG_ASSERT( m_pResourceLoader != nullptr );
         KRG_ASSERT( m_type != Type::Invalid );
         KRG_ASSERT( !m_pResourceRecord->IsLoading() && !m_pResourceRecord->IsUnloading() );
+        KRG_ASSERT( m_priority != LoadPriority::NumPriorities && deadline >= 0.0f );
+
+        if ( deadline > 0.0f )
+        {
+            m_deadlineTime = m_requestTime + deadline;
+        }
 
         if ( m_type == Type::Load )
         {
             KRG_ASSERT( m_pResourceRecord->IsUnloaded() );
             m_stage = Stage::RequestRawResource;
             m_pResourceRecord->SetLoadingStatus( LoadingStatus::Loading );
+
+            #if KRG_DEVELOPMENT_TOOLS
+            m_loadTrace.m_resourceID = m_pResourceRecord->GetResourceID();
+            m_loadTrace.m_stageStartTimes[LoadTrace::Queued] = m_requestTime;
+            m_loadTrace.m_activeStage = LoadTrace::Queued;
+            #endif
         }
         else // Unload
         {
@@ -44,6 +71,95 @@ namespace KRG::Resource
         }
     }
 
+    ResourceRequest::~ResourceRequest()
+    {
+        ReleaseRawResourceRead();
+    }
+
+    void ResourceRequest::ReleaseRawResourceRead()
+    {
+        if ( m_pRawResourceReadRequest != nullptr )
+        {
+            KRG_ASSERT( m_pIOService != nullptr );
+            m_pIOService->ReleaseRequest( m_pRawResourceReadRequest );
+        }
+    }
+
+    #if KRG_DEVELOPMENT_TOOLS
+    void ResourceRequest::BeginLoadTraceStage( LoadTrace::Stage stage )
+    {
+        KRG_ASSERT( stage < LoadTrace::NumStages );
+
+        if ( !IsLoadRequest() )
+        {
+            return;
+        }
+
+        Milliseconds const currentTime = PlatformClock::GetTimeInMilliseconds();
+        if ( m_loadTrace.m_activeStage != LoadTrace::None )
+        {
+            m_loadTrace.m_stageEndTimes[m_loadTrace.m_activeStage] = currentTime;
+        }
+
+        m_loadTrace.m_stageStartTimes[stage] = currentTime;
+        m_loadTrace.m_activeStage = stage;
+    }
+    #endif
+
+    bool ResourceRequest::RaisePriority( LoadPriority priority, Milliseconds deadline )
+    {
+        KRG_ASSERT( priority != LoadPriority::NumPriorities && deadline >= 0.0f );
+
+        // Keep the earliest deadline
+        if ( deadline > 0.0f )
+        {
+            Milliseconds const deadlineTime = PlatformClock::GetTimeInMilliseconds() + deadline;
+            if ( !HasDeadline() || deadlineTime < m_deadlineTime )
+            {
+                m_deadlineTime = deadlineTime;
+            }
+        }
+
+        if ( priority <= m_priority )
+        {
+            return false;
+        }
+
+        m_priority = priority;
+
+        // Move any outstanding read ahead of lower priority reads, this is a no-op if the read has already started
+        if ( m_pRawResourceReadRequest != nullptr )
+        {
+            m_pIOService->SetPriority( m_pRawResourceReadRequest, GetIOPriority( m_priority ) );
+        }
+
+        return true;
+    }
+
+    bool ResourceRequest::UpdateDeadlinePriority( Milliseconds currentTime )
+    {
+        if ( !HasDeadline() || !IsLoadRequest() || m_priority == LoadPriority::Critical )
+        {
+            return false;
+        }
+
+        // Missed deadlines go straight to critical, otherwise bump up one priority class once we have used up half of the available time
+        if ( currentTime >= m_deadlineTime )
+        {
+            return RaisePriority( LoadPriority::Critical );
+        }
+
+        Milliseconds const halfTime = m_requestTime + ( ( m_deadlineTime - m_requestTime ) * 0.5f );
+        if ( currentTime >= halfTime && m_priority == m_requestedPriority )
+        {
+            return RaisePriority( (LoadPriority) ( (uint8) m_requestedPriority + 1 ) );
+        }
+
+        return false;
+    }
+
+    //-------------------------------------------------------------------------
+
     void ResourceRequest::OnRawResourceRequestComplete( String const& filePath )
     {
         // Raw resource failed to load
@@ -56,10 +172,22 @@ namespace KRG::Resource
         else // Continue the load operation
         {
             m_rawResourcePath = filePath;
-            m_stage = ResourceRequest::Stage::LoadResource;
+            m_pRawResourceFile = nullptr;
+            m_stage = ResourceRequest::Stage::ReadRawResource;
         }
     }
 
+    void ResourceRequest::OnRawResourceRequestComplete( FileSystem::ReadOnlyFile const* pFile, uint64 offset, uint64 size )
+    {
+        KRG_ASSERT( pFile != nullptr && pFile->IsOpen() && size > 0 );
+
+        m_rawResourcePath = pFile->GetPath();
+        m_pRawResourceFile = pFile;
+        m_rawResourceOffset = offset;
+        m_rawResourceSize = size;
+        m_stage = ResourceRequest::Stage::ReadRawResource;
+    }
+
     void ResourceRequest::SwitchToLoadTask()
     {
         KRG_ASSERT( m_type == Type::Unload );
@@ -75,6 +203,13 @@ namespace KRG::Resource
             case Stage::Complete:
             {
                 m_stage = Stage::RequestRawResource;
+
+                // This is a brand new load, so restart the trace
+                #if KRG_DEVELOPMENT_TOOLS
+                m_loadTrace = LoadTrace();
+                m_loadTrace.m_resourceID = m_pResourceRecord->GetResourceID();
+                BeginLoadTraceStage( LoadTrace::Queued );
+                #endif
             }
             break;
 
@@ -121,6 +256,16 @@ namespace KRG::Resource
             }
             break;
 
+            // Any in-flight read is cancelled (or its data discarded once it completes)
+            case Stage::ReadRawResource:
+            case Stage::WaitForRawResourceRead:
+            {
+                ReleaseRawResourceRead();
+                m_stage = Stage::Complete;
+                m_pResourceRecord->SetLoadingStatus( LoadingStatus::Unloaded );
+            }
+            break;
+
             case Stage::LoadResource:
             {
                 m_stage = Stage::Complete;
@@ -155,6 +300,36 @@ namespace KRG::Resource
 
     //-------------------------------------------------------------------------
 
+    bool ResourceRequest::CanBeProcessedInParallel() const
+    {
+        if ( !m_pResourceLoader->IsThreadSafe() )
+        {
+            return false;
+        }
+
+        switch ( m_stage )
+        {
+            case ResourceRequest::Stage::WaitForRawResourceRead:
+            {
+                // Only worth going wide if we are going to load the resource
+                return m_pRawResourceReadRequest->IsComplete();
+            }
+            break;
+
+            case ResourceRequest::Stage::LoadResource:
+            case ResourceRequest::Stage::InstallResource:
+            {
+                return true;
+            }
+            break;
+
+            default:
+            break;
+        }
+
+        return false;
+    }
+
     bool ResourceRequest::Update( RequestContext& requestContext )
     {
         // Update loading
@@ -175,6 +350,18 @@ namespace KRG::Resource
             }
             break;
 
+            case ResourceRequest::Stage::ReadRawResource:
+            {
+                ReadRawResource( requestContext );
+            }
+            break;
+
+            case ResourceRequest::Stage::WaitForRawResourceRead:
+            {
+                WaitForRawResourceRead( requestContext );
+            }
+            break;
+
             case ResourceRequest::Stage::LoadResource:
             {
                 LoadResource( requestContext );
@@ -250,6 +437,15 @@ namespace KRG::Resource
         if ( IsComplete() )
         {
             KRG_ASSERT( m_pResourceRecord->IsLoaded() || m_pResourceRecord->IsUnloaded() || m_pResourceRecord->HasLoadingFailed() );
+            m_completionTime = PlatformClock::GetTimeInMilliseconds();
+
+            if ( IsLoadRequest() && m_loadTrace.m_activeStage != LoadTrace::None )
+            {
+                m_loadTrace.m_stageEndTimes[m_loadTrace.m_activeStage] = m_completionTime;
+                m_loadTrace.m_endTime = m_completionTime;
+                m_loadTrace.m_activeStage = LoadTrace::None;
+                m_loadTrace.m_wasSuccessful = m_pResourceRecord->IsLoaded();
+            }
         }
         #endif
 
@@ -261,33 +457,83 @@ namespace KRG::Resource
     void ResourceRequest::RequestRawResource( RequestContext& requestContext )
     {
         KRG_PROFILE_FUNCTION_RESOURCE();
+
+        #if KRG_DEVELOPMENT_TOOLS
+        BeginLoadTraceStage( LoadTrace::RawRequest );
+        #endif
+
         m_stage = ResourceRequest::Stage::WaitForRawResourceRequest;
         requestContext.m_createRawRequestRequestFunction( this );
+
+        // Providers that can resolve the path immediately complete the request synchronously, so start the read right away
+        if ( m_stage == ResourceRequest::Stage::ReadRawResource )
+        {
+            ReadRawResource( requestContext );
+        }
     }
 
-    void ResourceRequest::LoadResource( RequestContext& requestContext )
+    void ResourceRequest::ReadRawResource( RequestContext& requestContext )
     {
         KRG_PROFILE_FUNCTION_RESOURCE();
-        KRG_ASSERT( m_stage == ResourceRequest::Stage::LoadResource );
-        KRG_ASSERT( m_rawResourcePath.IsValid() );
+        KRG_ASSERT( m_stage == ResourceRequest::Stage::ReadRawResource );
+        KRG_ASSERT( m_rawResourcePath.IsValid() && m_pRawResourceReadRequest == nullptr );
+        KRG_ASSERT( requestContext.m_pIOService != nullptr );
 
-        // Read file
-        //-------------------------------------------------------------------------
+        #if KRG_DEVELOPMENT_TOOLS
+        BeginLoadTraceStage( LoadTrace::RawRead );
+        #endif
 
+        // The file is mapped and paged in on an IO thread (or the range is read from the package), the request is then polled in subsequent updates
+        m_pIOService = requestContext.m_pIOService;
+        if ( m_pRawResourceFile != nullptr )
         {
-            KRG_PROFILE_SCOPE_IO( "Read File" );
-            KRG_PROFILE_TAG( "filename", m_rawResourcePath.GetFileName().c_str() );
+            m_pRawResourceReadRequest = m_pIOService->ReadRange( m_pRawResourceFile, m_rawResourceOffset, m_rawResourceSize, GetIOPriority( m_priority ) );
+        }
+        else
+        {
+            m_pRawResourceReadRequest = m_pIOService->MapFile( m_rawResourcePath, GetIOPriority( m_priority ) );
+        }
+        m_stage = ResourceRequest::Stage::WaitForRawResourceRead;
+    }
 
-            if ( !FileSystem::LoadFile( m_rawResourcePath, m_rawResourceData ) )
-            {
-                KRG_LOG_ERROR( "Resource", "Failed to load resource file (%s)", m_pResourceRecord->GetResourceID().c_str() );
-                m_stage = ResourceRequest::Stage::Complete;
-                m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
-                return;
-            }
+    void ResourceRequest::WaitForRawResourceRead( RequestContext& requestContext )
+    {
+        KRG_ASSERT( m_stage == ResourceRequest::Stage::WaitForRawResourceRead );
+        KRG_ASSERT( m_pRawResourceReadRequest != nullptr );
+
+        if ( !m_pRawResourceReadRequest->IsComplete() )
+        {
+            return;
         }
 
+        if ( !m_pRawResourceReadRequest->WasSuccessful() )
+        {
+            KRG_LOG_ERROR( "Resource", "Failed to load resource file (%s)", m_pResourceRecord->GetResourceID().c_str() );
+            ReleaseRawResourceRead();
+            m_stage = ResourceRequest::Stage::Complete;
+            m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
+            return;
+        }
+
+        // Immediately load the resource, no need to wait for another update
+        m_stage = ResourceRequest::Stage::LoadResource;
+        LoadResource( requestContext );
+    }
+
+    void ResourceRequest::LoadResource( RequestContext& requestContext )
+    {
+        KRG_PROFILE_FUNCTION_RESOURCE();
+        KRG_ASSERT( m_stage == ResourceRequest::Stage::LoadResource );
+        KRG_ASSERT( m_pRawResourceReadRequest != nullptr && m_pRawResourceReadRequest->WasSuccessful() );
+
+        #if KRG_DEVELOPMENT_TOOLS
+        BeginLoadTraceStage( LoadTrace::Load );
+        m_loadTrace.m_bytesRead = m_pRawResourceReadRequest->GetSize();
+        m_loadTrace.m_loadThreadID = Threading::GetCurrentThreadID();
+        #endif
+
         // Load resource
+        // The compiled data is deserialized straight from the mapped view (or read buffer) that was filled in by the IO service
         //-------------------------------------------------------------------------
 
         {
@@ -299,9 +545,19 @@ namespace KRG::Resource
             KRG_PROFILE_TAG( "Loader", resTypeID );
             #endif
 
+            #if KRG_DEVELOPMENT_TOOLS
+            ResourceCompression::DecompressionStats* pDecompressionStats = &m_decompressionStats;
+            #else
+            ResourceCompression::DecompressionStats* pDecompressionStats = nullptr;
+            #endif
+
             // Load the resource
-            KRG_ASSERT( !m_rawResourceData.empty() );
-            if ( !m_pResourceLoader->Load( GetResourceID(), m_rawResourceData, m_pResourceRecord ) )
+            bool const wasLoaded = m_pResourceLoader->Load( GetResourceID(), m_pRawResourceReadRequest->GetData(), m_pRawResourceReadRequest->GetSize(), m_pResourceRecord, requestContext.m_pTaskSystem, pDecompressionStats );
+
+            // Release the file mapping/read buffer
+            ReleaseRawResourceRead();
+
+            if ( !wasLoaded )
             {
                 KRG_LOG_ERROR( "Resource", "Failed to load compiled resource data (%s)", m_pResourceRecord->GetResourceID().c_str() );
                 m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
@@ -309,9 +565,6 @@ namespace KRG::Resource
                 m_stage = ResourceRequest::Stage::Complete;
                 return;
             }
-
-            // Release raw data
-            m_rawResourceData.clear();
         }
 
         // Load dependencies
@@ -327,9 +580,13 @@ namespace KRG::Resource
             // Do not use the requester ID for install dependencies! Since they are not explicitly loaded by a specific user!
             // Instead we create a ResourceRequesterID from the depending resource's resourceID
             m_pendingInstallDependencies[i] = ResourcePtr( m_pResourceRecord->m_installDependencyResourceIDs[i] );
-            requestContext.m_loadResourceFunction( installDependencyRequesterID, m_pendingInstallDependencies[i] );
+            requestContext.m_loadResourceFunction( installDependencyRequesterID, m_pendingInstallDependencies[i], m_priority );
         }
         m_stage = ResourceRequest::Stage::WaitForLoadDependencies;
+
+        #if KRG_DEVELOPMENT_TOOLS
+        BeginLoadTraceStage( LoadTrace::WaitForDependencies );
+        #endif
     }
 
     void ResourceRequest::WaitForLoadDependencies( RequestContext& requestContext )
@@ -410,6 +667,11 @@ namespace KRG::Resource
         KRG_ASSERT( m_stage == ResourceRequest::Stage::InstallResource );
         KRG_ASSERT( m_pendingInstallDependencies.empty() );
 
+        #if KRG_DEVELOPMENT_TOOLS
+        BeginLoadTraceStage( LoadTrace::Install );
+        m_loadTrace.m_installThreadID = Threading::GetCurrentThreadID();
+        #endif
+
         InstallResult const result = m_pResourceLoader->Install( GetResourceID(), m_pResourceRecord, m_installDependencies );
         switch ( result )
         {
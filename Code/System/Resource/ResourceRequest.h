@@ -2,7 +2,19 @@
 
 #include "ResourceRecord.h"
 #include "ResourceLoader.h"
+#include "ResourceLoadPriority.h"
 #include "System/Core/Types/Function.h"
+#include "System/Core/Time/Time.h"
+#include "System/Core/Threading/Threading.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::FileSystem
+{
+    class IOService;
+    class IORequest;
+    class ReadOnlyFile;
+}
 
 //-------------------------------------------------------------------------
 
@@ -19,6 +31,8 @@ namespace KRG::Resource
             // Load Stages
             RequestRawResource,
             WaitForRawResourceRequest,
+            ReadRawResource,
+            WaitForRawResourceRead,
             LoadResource,
             WaitForLoadDependencies,
             InstallResource,
@@ -55,14 +69,61 @@ namespace KRG::Resource
         {
             TFunction<void( ResourceRequest* )> m_createRawRequestRequestFunction;
             TFunction<void( ResourceRequest* )> m_cancelRawRequestRequestFunction;
-            TFunction<void( ResourceRequesterID const&, ResourcePtr& )> m_loadResourceFunction;
+            TFunction<void( ResourceRequesterID const&, ResourcePtr&, LoadPriority )> m_loadResourceFunction;
             TFunction<void( ResourceRequesterID const&, ResourcePtr& )> m_unloadResourceFunction;
+            TaskSystem*                                                 m_pTaskSystem = nullptr;
+            FileSystem::IOService*                                      m_pIOService = nullptr;
+        };
+
+        #if KRG_DEVELOPMENT_TOOLS
+        // Per-stage timings for a single load, all times are absolute platform times (0 = stage was never reached)
+        struct LoadTrace
+        {
+            enum Stage : uint8
+            {
+                Queued = 0,
+                RawRequest,
+                RawRead,
+                Load,
+                WaitForDependencies,
+                Install,
+
+                NumStages,
+                None = 0xFF,
+            };
+
+            static char const* GetStageName( Stage stage );
+
+        public:
+
+            inline bool WasStageReached( Stage stage ) const { return m_stageStartTimes[stage] > 0.0f; }
+            inline Milliseconds GetStageDuration( Stage stage ) const { return WasStageReached( stage ) ? m_stageEndTimes[stage] - m_stageStartTimes[stage] : Milliseconds( 0.0f ); }
+            inline Milliseconds GetStartTime() const { return m_stageStartTimes[Queued]; }
+            inline Milliseconds GetEndTime() const { return m_endTime; }
+
+        public:
+
+            ResourceID                          m_resourceID;
+            Milliseconds                        m_stageStartTimes[NumStages] = {};
+            Milliseconds                        m_stageEndTimes[NumStages] = {};
+            Milliseconds                        m_endTime = 0.0f;
+            uint64                              m_bytesRead = 0;
+            Threading::ThreadID                 m_loadThreadID = 0;
+            Threading::ThreadID                 m_installThreadID = 0;
+            Stage                               m_activeStage = None;
+            bool                                m_wasSuccessful = false;
         };
+        #endif
 
     public:
 
         ResourceRequest() = default;
-        ResourceRequest( ResourceRequesterID const& requesterID, Type type, ResourceRecord* pRecord, ResourceLoader* pResourceLoader );
+        ResourceRequest( ResourceRequesterID const& requesterID, Type type, ResourceRecord* pRecord, ResourceLoader* pResourceLoader, LoadPriority priority = LoadPriority::Normal, Milliseconds deadline = 0.0f );
+        ~ResourceRequest();
+
+        // The destructor releases the IO request, so requests cannot be copied
+        ResourceRequest( ResourceRequest const& ) = delete;
+        ResourceRequest& operator=( ResourceRequest const& ) = delete;
 
         inline bool IsValid() const { return m_pResourceRecord != nullptr; }
         inline bool IsActive() const { return m_stage != Stage::Complete; }
@@ -77,6 +138,40 @@ namespace KRG::Resource
         inline ResourceTypeID GetResourceTypeID() const { return m_pResourceRecord->GetResourceTypeID(); }
         inline LoadingStatus GetLoadingStatus() const { return m_pResourceRecord->GetLoadingStatus(); }
 
+        // Priority
+        //-------------------------------------------------------------------------
+
+        inline LoadPriority GetPriority() const { return m_priority; }
+        inline LoadPriority GetRequestedPriority() const { return m_requestedPriority; }
+        inline InstallDependencyList const& GetPendingInstallDependencies() const { return m_pendingInstallDependencies; }
+
+        // Raise the priority of this request (lower priorities are ignored), an optional deadline (relative to now) can also be supplied
+        // This will re-prioritize any outstanding file read, returns true if the priority was changed
+        bool RaisePriority( LoadPriority priority, Milliseconds deadline = 0.0f );
+
+        // Escalate the priority of requests that are approaching (or have missed) their deadline, returns true if the priority was changed
+        bool UpdateDeadlinePriority( Milliseconds currentTime );
+
+        inline bool HasDeadline() const { return m_deadlineTime > 0.0f; }
+        inline bool HasMissedDeadline( Milliseconds currentTime ) const { return HasDeadline() && currentTime > m_deadlineTime; }
+        inline Milliseconds GetRequestTime() const { return m_requestTime; }
+
+        // Can the next update of this request be run concurrently with the updates of other requests
+        // Only the load and install stages of requests with thread-safe loaders qualify, every other stage touches shared state
+        bool CanBeProcessedInParallel() const;
+
+        #if KRG_DEVELOPMENT_TOOLS
+        inline ResourceCompression::DecompressionStats const& GetDecompressionStats() const { return m_decompressionStats; }
+
+        // Time from the creation of the request to its completion
+        inline Milliseconds GetTimeToReady() const { KRG_ASSERT( IsComplete() ); return m_completionTime - m_requestTime; }
+        inline bool WasCompletedAfterDeadline() const { KRG_ASSERT( IsComplete() ); return HasMissedDeadline( m_completionTime ); }
+        inline Milliseconds GetDeadlineOverrun() const { KRG_ASSERT( WasCompletedAfterDeadline() ); return m_completionTime - m_deadlineTime; }
+
+        // Stage timings for the load operation, only valid for completed load requests
+        inline LoadTrace const& GetLoadTrace() const { KRG_ASSERT( IsComplete() && IsLoadRequest() ); return m_loadTrace; }
+        #endif
+
         inline bool operator==( ResourceRequest const& other ) const { return GetResourceID() == other.GetResourceID(); }
         inline bool operator!=( ResourceRequest const& other ) const { return GetResourceID() != other.GetResourceID(); }
 
@@ -88,6 +183,9 @@ namespace KRG::Resource
         // Called by the resource provider once the request operation completes and provides the raw resource data
         void OnRawResourceRequestComplete( String const& filePath );
 
+        // Called by the resource provider once the request completes and the raw resource data is a range of an open package file
+        void OnRawResourceRequestComplete( FileSystem::ReadOnlyFile const* pFile, uint64 offset, uint64 size );
+
         // This will interrupt a load task and convert it into an unload task
         void SwitchToLoadTask();
 
@@ -97,6 +195,8 @@ namespace KRG::Resource
         //-------------------------------------------------------------------------
 
         void RequestRawResource( RequestContext& requestContext );
+        void ReadRawResource( RequestContext& requestContext );
+        void WaitForRawResourceRead( RequestContext& requestContext );
         void LoadResource( RequestContext& requestContext );
         void WaitForLoadDependencies( RequestContext& requestContext );
         void InstallResource( RequestContext& requestContext );
@@ -106,17 +206,40 @@ namespace KRG::Resource
         void UnloadFailedResource( RequestContext& requestContext );
         void CancelRawRequestRequest( RequestContext& requestContext );
 
+    private:
+
+        void ReleaseRawResourceRead();
+
+        #if KRG_DEVELOPMENT_TOOLS
+        // Close the active trace stage (if any) and start the specified one
+        void BeginLoadTraceStage( LoadTrace::Stage stage );
+        #endif
+
     private:
 
         ResourceRequesterID                     m_requesterID;
         ResourceRecord*                         m_pResourceRecord = nullptr;
         ResourceLoader*                         m_pResourceLoader = nullptr;
         FileSystem::Path                        m_rawResourcePath;
-        TVector<Byte>                           m_rawResourceData;
+        FileSystem::ReadOnlyFile const*         m_pRawResourceFile = nullptr;
+        uint64                                  m_rawResourceOffset = 0;
+        uint64                                  m_rawResourceSize = 0;
+        FileSystem::IOService*                  m_pIOService = nullptr;
+        FileSystem::IORequest*                  m_pRawResourceReadRequest = nullptr;
         InstallDependencyList                   m_pendingInstallDependencies;
         InstallDependencyList                   m_installDependencies;
         Type                                    m_type = Type::Invalid;
         Stage                                   m_stage = Stage::None;
+        LoadPriority                            m_priority = LoadPriority::Normal;
+        LoadPriority                            m_requestedPriority = LoadPriority::Normal;
+        Milliseconds                            m_requestTime = 0.0f;
+        Milliseconds                            m_deadlineTime = 0.0f;         // Absolute platform time by which we want the resource to be ready (0 = no deadline)
         bool                                    m_isReloadRequest = false;
+
+        #if KRG_DEVELOPMENT_TOOLS
+        ResourceCompression::DecompressionStats m_decompressionStats;
+        Milliseconds                            m_completionTime = 0.0f;
+        LoadTrace                               m_loadTrace;
+        #endif
     };
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "ResourceResidentCache.h"
+#include "ResourceRecord.h"
+#include "System/Core/Profiling/Profiling.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource
+{
+    ResourceResidentCache::~ResourceResidentCache()
+    {
+        for ( auto const& typeCachePair : m_typeCaches )
+        {
+            KRG_ASSERT( typeCachePair.second.m_records.empty() );
+        }
+    }
+
+    void ResourceResidentCache::SetBudget( ResourceTypeID typeID, uint64 budget, TVector<ResourceRecord*>& outEvictedRecords )
+    {
+        KRG_ASSERT( typeID.IsValid() );
+
+        auto& typeCache = m_typeCaches[typeID];
+        typeCache.m_budget = budget;
+        EvictOverBudgetRecords( typeCache, outEvictedRecords );
+    }
+
+    uint64 ResourceResidentCache::GetBudget( ResourceTypeID typeID ) const
+    {
+        auto const iter = m_typeCaches.find( typeID );
+        return ( iter != m_typeCaches.end() ) ? iter->second.m_budget : 0;
+    }
+
+    bool ResourceResidentCache::TryAdd( ResourceRecord* pRecord, TVector<ResourceRecord*>& outEvictedRecords )
+    {
+        KRG_ASSERT( pRecord != nullptr && pRecord->IsLoaded() && !pRecord->HasReferences() );
+        KRG_ASSERT( !pRecord->m_isInResidentCache );
+
+        auto const iter = m_typeCaches.find( pRecord->GetResourceTypeID() );
+        if ( iter == m_typeCaches.end() || iter->second.m_budget == 0 )
+        {
+            return false;
+        }
+
+        auto& typeCache = iter->second;
+        typeCache.m_records.emplace_back( pRecord );
+        typeCache.m_usedMemory += pRecord->m_dataSize;
+        pRecord->m_isInResidentCache = true;
+
+        EvictOverBudgetRecords( typeCache, outEvictedRecords );
+        return true;
+    }
+
+    bool ResourceResidentCache::TryAcquire( ResourceRecord* pRecord )
+    {
+        KRG_ASSERT( pRecord != nullptr );
+
+        auto const iter = m_typeCaches.find( pRecord->GetResourceTypeID() );
+        if ( iter == m_typeCaches.end() || iter->second.m_budget == 0 )
+        {
+            return false;
+        }
+
+        auto& typeCache = iter->second;
+        if ( TryRemove( pRecord ) )
+        {
+            typeCache.m_numHits++;
+            KRG_PROFILE_COUNTER_INCREMENT( "Resource Cache Hits", 1 );
+            return true;
+        }
+
+        typeCache.m_numMisses++;
+        return false;
+    }
+
+    bool ResourceResidentCache::TryRemove( ResourceRecord* pRecord )
+    {
+        KRG_ASSERT( pRecord != nullptr );
+
+        if ( !pRecord->m_isInResidentCache )
+        {
+            return false;
+        }
+
+        auto const iter = m_typeCaches.find( pRecord->GetResourceTypeID() );
+        KRG_ASSERT( iter != m_typeCaches.end() );
+
+        auto& typeCache = iter->second;
+        auto recordIter = eastl::find( typeCache.m_records.begin(), typeCache.m_records.end(), pRecord );
+        KRG_ASSERT( recordIter != typeCache.m_records.end() );
+
+        // Keep the LRU order
+        typeCache.m_records.erase( recordIter );
+        typeCache.m_usedMemory -= pRecord->m_dataSize;
+        pRecord->m_isInResidentCache = false;
+        return true;
+    }
+
+    void ResourceResidentCache::Clear( TVector<ResourceRecord*>& outEvictedRecords )
+    {
+        for ( auto& typeCachePair : m_typeCaches )
+        {
+            auto& typeCache = typeCachePair.second;
+            for ( auto pRecord : typeCache.m_records )
+            {
+                pRecord->m_isInResidentCache = false;
+                outEvictedRecords.emplace_back( pRecord );
+            }
+
+            typeCache.m_records.clear();
+            typeCache.m_usedMemory = 0;
+        }
+    }
+
+    void ResourceResidentCache::EvictOverBudgetRecords( TypeCache& typeCache, TVector<ResourceRecord*>& outEvictedRecords )
+    {
+        int32 numRecordsToEvict = 0;
+        while ( typeCache.m_usedMemory > typeCache.m_budget )
+        {
+            ResourceRecord* pRecord = typeCache.m_records[numRecordsToEvict];
+            typeCache.m_usedMemory -= pRecord->m_dataSize;
+            pRecord->m_isInResidentCache = false;
+            outEvictedRecords.emplace_back( pRecord );
+            numRecordsToEvict++;
+        }
+
+        if ( numRecordsToEvict > 0 )
+        {
+            typeCache.m_records.erase( typeCache.m_records.begin(), typeCache.m_records.begin() + numRecordsToEvict );
+            typeCache.m_numEvictions += numRecordsToEvict;
+            KRG_PROFILE_COUNTER_INCREMENT( "Resource Cache Evictions", numRecordsToEvict );
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "_Module/API.h"
+#include "ResourceTypeID.h"
+#include "System/Core/Types/Containers.h"
+
+//-------------------------------------------------------------------------
+// Resident Resource Cache
+//-------------------------------------------------------------------------
+// Keeps loaded resources that no longer have any references resident so that re-requesting them is instant
+// Each resource type has its own memory budget, cached resources are evicted in LRU order once a type exceeds its budget
+// Resource types without a budget are never cached
+//
+// This is not thread-safe, the resource system guards all access with its access lock
+
+namespace KRG::Resource
+{
+    class ResourceRecord;
+
+    //-------------------------------------------------------------------------
+
+    class KRG_SYSTEM_RESOURCE_API ResourceResidentCache
+    {
+    public:
+
+        struct TypeCache
+        {
+            inline float GetHitRate() const
+            {
+                uint32 const numRequests = m_numHits + m_numMisses;
+                return ( numRequests > 0 ) ? float( m_numHits ) / numRequests : 0.0f;
+            }
+
+            TVector<ResourceRecord*>            m_records;                  // Least recently used first
+            uint64                              m_budget = 0;
+            uint64                              m_usedMemory = 0;
+            uint32                              m_numHits = 0;
+            uint32                              m_numMisses = 0;
+            uint32                              m_numEvictions = 0;
+        };
+
+    public:
+
+        ~ResourceResidentCache();
+
+        // Set the memory budget for a resource type (0 disables caching for that type), any records that no longer fit are returned for eviction
+        void SetBudget( ResourceTypeID typeID, uint64 budget, TVector<ResourceRecord*>& outEvictedRecords );
+        uint64 GetBudget( ResourceTypeID typeID ) const;
+
+        // Try to cache a loaded record that has no more references, returns false if the resource type isnt cached
+        // Any records that need to be evicted to keep the type within its budget are returned (this can include the added record)
+        bool TryAdd( ResourceRecord* pRecord, TVector<ResourceRecord*>& outEvictedRecords );
+
+        // Take a record out of the cache since it has been requested again, returns true if the record was cached
+        // This also updates the hit/miss stats for the record's resource type
+        bool TryAcquire( ResourceRecord* pRecord );
+
+        // Remove a record from the cache without affecting the stats (e.g. the resource needs to be reloaded)
+        bool TryRemove( ResourceRecord* pRecord );
+
+        // Remove all cached records, all of them are returned for eviction
+        void Clear( TVector<ResourceRecord*>& outEvictedRecords );
+
+        inline THashMap<ResourceTypeID, TypeCache> const& GetTypeCaches() const { return m_typeCaches; }
+
+    private:
+
+        void EvictOverBudgetRecords( TypeCache& typeCache, TVector<ResourceRecord*>& outEvictedRecords );
+
+    private:
+
+        THashMap<ResourceTypeID, TypeCache>     m_typeCaches;
+    };
+}
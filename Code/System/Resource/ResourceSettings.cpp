@@ -32,6 +32,31 @@ namespace KRG::Resource
             }
         }
 
+        // Resident cache budgets
+        //-------------------------------------------------------------------------
+
+        m_residentCacheBudgets.clear();
+
+        if ( ini.TryGetString( "Resource:ResidentCacheBudgets", s ) )
+        {
+            TVector<String> budgetStrings;
+            StringUtils::Split( StringUtils::StripWhitespace( s ), budgetStrings, "," );
+
+            for ( auto const& budgetString : budgetStrings )
+            {
+                size_t const separatorIdx = budgetString.find( ':' );
+                if ( separatorIdx == String::npos || separatorIdx == 0 || separatorIdx > 4 )
+                {
+                    KRG_LOG_ERROR( "Engine", "Invalid resident cache budget entry: %s", budgetString.c_str() );
+                    return false;
+                }
+
+                ResourceTypeID const typeID( budgetString.substr( 0, separatorIdx ) );
+                uint32 const budgetInMB = (uint32) strtoul( budgetString.c_str() + separatorIdx + 1, nullptr, 10 );
+                m_residentCacheBudgets[typeID] = uint64( budgetInMB ) * 1024 * 1024;
+            }
+        }
+
         // Development only settings
         //-------------------------------------------------------------------------
 
@@ -87,6 +112,30 @@ namespace KRG::Resource
                 return false;
             }
 
+            // Compilation Cache
+            //-------------------------------------------------------------------------
+
+            m_compilationCachePath = FileSystem::Path();
+            m_compilationCacheMaxSize = 0;
+
+            if ( ini.TryGetString( "Resource:CompilationCachePath", s ) && !s.empty() )
+            {
+                // Absolute paths are allowed so that the cache can be shared between machines
+                bool const isAbsolutePath = ( s.length() > 1 && s[1] == ':' ) || s[0] == '/' || s[0] == '\\';
+                m_compilationCachePath = isAbsolutePath ? FileSystem::Path( s ) : m_workingDirectoryPath + s;
+                if ( !m_compilationCachePath.IsValid() )
+                {
+                    KRG_LOG_ERROR( "Engine", "Invalid compilation cache path: %s", s.c_str() );
+                    return false;
+                }
+
+                m_compilationCachePath.MakeDirectory();
+
+                uint32 cacheSizeInMB = 10240;
+                ini.TryGetUInt( "Resource:CompilationCacheSizeMB", cacheSizeInMB );
+                m_compilationCacheMaxSize = uint64( cacheSizeInMB ) * 1024 * 1024;
+            }
+
             // Resource Server
             //-------------------------------------------------------------------------
 
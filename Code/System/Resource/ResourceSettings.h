@@ -4,6 +4,7 @@
 #include "System/Core/Settings/ISettings.h"
 #include "System/Core/Math/Math.h"
 #include "System/Core/FileSystem/FileSystemPath.h"
+#include "ResourceTypeID.h"
 
 //-------------------------------------------------------------------------
 
@@ -24,6 +25,10 @@ namespace KRG::Resource
         FileSystem::Path        m_workingDirectoryPath;
         FileSystem::Path        m_compiledResourcePath;
 
+        // Optional memory budgets (in bytes) for keeping unreferenced resources resident, per resource type
+        // Specified as "Resource:ResidentCacheBudgets = TXTR:128, MSH:64" where the budgets are in MB
+        THashMap<ResourceTypeID, uint64>    m_residentCacheBudgets;
+
         #if KRG_DEVELOPMENT_TOOLS
         String                  m_resourceServerNetworkAddress;
         uint16                  m_resourceServerPort;
@@ -31,6 +36,11 @@ namespace KRG::Resource
         FileSystem::Path        m_compiledResourceDatabasePath;
         FileSystem::Path        m_resourceServerExecutablePath;
         FileSystem::Path        m_resourceCompilerExecutablePath;
+
+        // Optional content-addressed cache for compiled resources, can be an absolute path to a shared location
+        // The cache is disabled if no path is specified, the size is specified in MB
+        FileSystem::Path        m_compilationCachePath;
+        uint64                  m_compilationCacheMaxSize = 0;
         #endif
     };
 }
\ No newline at end of file
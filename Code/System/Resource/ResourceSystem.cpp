@@ -2,6 +2,10 @@
 #include "ResourceProvider.h"
 #include "ResourceRequest.h"
 #include "System/Core/Profiling/Profiling.h"
+#include "System/Core/Logging/Log.h"
+#include "System/Core/Math/Math.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/FileSystem/FileStreams.h"
 
 //-------------------------------------------------------------------------
 
@@ -21,11 +25,14 @@ namespace KRG::Resource
     {
         KRG_ASSERT( pResourceProvider != nullptr && pResourceProvider->IsReady() );
         m_pResourceProvider = pResourceProvider;
+        m_ioService.Initialize();
     }
 
     void ResourceSystem::Shutdown()
     {
+        ClearResidentCache();
         WaitForAllRequestsToComplete();
+        m_ioService.Shutdown();
         m_pResourceProvider = nullptr;
     }
 
@@ -141,8 +148,9 @@ namespace KRG::Resource
         return recordIter->second;
     }
 
-    void ResourceSystem::LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID )
+    void ResourceSystem::LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID, LoadPriority priority, Milliseconds deadline )
     {
+        KRG_ASSERT( priority != LoadPriority::NumPriorities && deadline >= 0.0f );
         Threading::RecursiveScopeLock lock( m_accessLock );
 
         // Immediately update the resource ptr
@@ -153,7 +161,30 @@ namespace KRG::Resource
 
         if ( !pRecord->HasReferences() )
         {
-            AddPendingRequest( PendingRequest( PendingRequest::Type::Load, pRecord, requesterID ) );
+            // Resident resources are immediately available
+            if ( !m_residentCache.TryAcquire( pRecord ) )
+            {
+                AddPendingRequest( PendingRequest( PendingRequest::Type::Load, pRecord, requesterID, priority, deadline ) );
+            }
+        }
+        else if ( !pRecord->IsLoaded() && ( priority != LoadPriority::Background || deadline > 0.0f ) )
+        {
+            // Raise the priority of the pending load directly, otherwise defer the raise to the next update since the active requests belong to the async task
+            auto predicate = [] ( PendingRequest const& request, ResourceRecord const* pRecord ) { return request.m_pRecord == pRecord; };
+            int32 const foundIdx = VectorFindIndex( m_pendingRequests, pRecord, predicate );
+            if ( foundIdx != InvalidIndex && m_pendingRequests[foundIdx].m_type == PendingRequest::Type::Load )
+            {
+                auto& pendingRequest = m_pendingRequests[foundIdx];
+                pendingRequest.m_priority = Math::Max( pendingRequest.m_priority, priority );
+                if ( deadline > 0.0f && ( pendingRequest.m_deadline <= 0.0f || deadline < pendingRequest.m_deadline ) )
+                {
+                    pendingRequest.m_deadline = deadline;
+                }
+            }
+            else
+            {
+                m_pendingPriorityChanges.push_back( { pRecord, deadline, priority } );
+            }
         }
 
         pRecord->AddReference( requesterID );
@@ -173,7 +204,47 @@ namespace KRG::Resource
 
         if ( !pRecord->HasReferences() )
         {
-            AddPendingRequest( PendingRequest( PendingRequest::Type::Unload, pRecord, requesterID ) );
+            // Try to keep fully loaded resources resident, resources that are still in flight are always unloaded
+            TVector<ResourceRecord*> evictedRecords;
+            if ( pRecord->IsLoaded() && m_residentCache.TryAdd( pRecord, evictedRecords ) )
+            {
+                UnloadEvictedRecords( evictedRecords );
+            }
+            else
+            {
+                AddPendingRequest( PendingRequest( PendingRequest::Type::Unload, pRecord, requesterID ) );
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceSystem::SetResidentCacheBudget( ResourceTypeID typeID, uint64 budgetInBytes )
+    {
+        Threading::RecursiveScopeLock lock( m_accessLock );
+
+        TVector<ResourceRecord*> evictedRecords;
+        m_residentCache.SetBudget( typeID, budgetInBytes, evictedRecords );
+        UnloadEvictedRecords( evictedRecords );
+    }
+
+    void ResourceSystem::ClearResidentCache()
+    {
+        Threading::RecursiveScopeLock lock( m_accessLock );
+
+        TVector<ResourceRecord*> evictedRecords;
+        m_residentCache.Clear( evictedRecords );
+        UnloadEvictedRecords( evictedRecords );
+    }
+
+    void ResourceSystem::UnloadEvictedRecords( TVector<ResourceRecord*> const& evictedRecords )
+    {
+        Threading::RecursiveScopeLock lock( m_accessLock );
+
+        for ( auto pEvictedRecord : evictedRecords )
+        {
+            KRG_ASSERT( !pEvictedRecord->HasReferences() );
+            AddPendingRequest( PendingRequest( PendingRequest::Type::Unload, pEvictedRecord, ResourceRequesterID() ) );
         }
     }
 
@@ -213,6 +284,77 @@ namespace KRG::Resource
         return nullptr;
     }
 
+    void ResourceSystem::UpdateRequestPriorities()
+    {
+        KRG_ASSERT( !m_isAsyncTaskRunning );
+        Threading::RecursiveScopeLock lock( m_accessLock );
+
+        for ( auto const& priorityChange : m_pendingPriorityChanges )
+        {
+            RaiseActiveRequestPriority( priorityChange.m_pRecord, priorityChange.m_priority, priorityChange.m_deadline );
+        }
+        m_pendingPriorityChanges.clear();
+
+        //-------------------------------------------------------------------------
+
+        Milliseconds const currentTime = PlatformClock::GetTimeInMilliseconds();
+        for ( auto pRequest : m_activeRequests )
+        {
+            if ( pRequest->UpdateDeadlinePriority( currentTime ) )
+            {
+                for ( auto const& dependency : pRequest->GetPendingInstallDependencies() )
+                {
+                    RaiseActiveRequestPriority( dependency.m_pResource, pRequest->GetPriority(), 0.0f );
+                }
+            }
+        }
+    }
+
+    void ResourceSystem::RaiseActiveRequestPriority( ResourceRecord const* pResourceRecord, LoadPriority priority, Milliseconds deadline )
+    {
+        KRG_ASSERT( pResourceRecord != nullptr );
+
+        // Install dependencies can still be in the pending list
+        auto predicate = [] ( PendingRequest const& request, ResourceRecord const* pRecord ) { return request.m_pRecord == pRecord; };
+        int32 const foundIdx = VectorFindIndex( m_pendingRequests, pResourceRecord, predicate );
+        if ( foundIdx != InvalidIndex )
+        {
+            auto& pendingRequest = m_pendingRequests[foundIdx];
+            if ( pendingRequest.m_type == PendingRequest::Type::Load )
+            {
+                pendingRequest.m_priority = Math::Max( pendingRequest.m_priority, priority );
+            }
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        ResourceRequest* pRequest = TryFindActiveRequest( pResourceRecord );
+        if ( pRequest != nullptr )
+        {
+            RaiseRequestPriority( pRequest, priority, deadline );
+        }
+    }
+
+    void ResourceSystem::RaiseRequestPriority( ResourceRequest* pRequest, LoadPriority priority, Milliseconds deadline )
+    {
+        KRG_ASSERT( pRequest != nullptr );
+
+        if ( !pRequest->IsLoadRequest() )
+        {
+            return;
+        }
+
+        // Propagate the raise to all dependencies we are still waiting on
+        if ( pRequest->RaisePriority( priority, deadline ) )
+        {
+            for ( auto const& dependency : pRequest->GetPendingInstallDependencies() )
+            {
+                RaiseActiveRequestPriority( dependency.m_pResource, pRequest->GetPriority(), deadline );
+            }
+        }
+    }
+
     //-------------------------------------------------------------------------
 
     void ResourceSystem::UpdateResourceProvider()
@@ -232,8 +374,30 @@ namespace KRG::Resource
                 return;
             }
 
-            // Generate a list of users for this resource
+            // Resident resources have no users that would reload them, so evict them (and any resident resources that directly depend on them)
             ResourceRecord* pRecord = recordIter->second;
+
+            TVector<ResourceRecord*> staleRecords;
+            if ( m_residentCache.TryRemove( pRecord ) )
+            {
+                staleRecords.emplace_back( pRecord );
+            }
+
+            for ( auto const& requesterID : pRecord->m_references )
+            {
+                if ( requesterID.IsInstallDependencyRequest() )
+                {
+                    auto const dependentRecordIter = m_resourceRecords.find_as( requesterID.GetInstallDependencyResourcePathID() );
+                    if ( dependentRecordIter != m_resourceRecords.end() && m_residentCache.TryRemove( dependentRecordIter->second ) )
+                    {
+                        staleRecords.emplace_back( dependentRecordIter->second );
+                    }
+                }
+            }
+
+            UnloadEvictedRecords( staleRecords );
+
+            // Generate a list of users for this resource
             GetUsersForResource( pRecord, m_usersThatRequireReload );
 
             // Add to list of resources to be reloaded
@@ -276,6 +440,12 @@ namespace KRG::Resource
         {
             Threading::RecursiveScopeLock lock( m_accessLock );
 
+            UpdateRequestPriorities();
+
+            // Create requests in priority order
+            auto pendingSortPredicate = [] ( PendingRequest const& a, PendingRequest const& b ) { return a.m_priority > b.m_priority; };
+            eastl::stable_sort( m_pendingRequests.begin(), m_pendingRequests.end(), pendingSortPredicate );
+
             for ( auto& pendingRequest : m_pendingRequests )
             {
                 // Get existing active request
@@ -290,6 +460,9 @@ namespace KRG::Resource
                         {
                             pActiveRequest->SwitchToLoadTask();
                         }
+
+                        // The record is still in the pending list, so we raise the active request directly
+                        RaiseRequestPriority( pActiveRequest, pendingRequest.m_priority, pendingRequest.m_deadline );
                     }
                     else if ( pendingRequest.m_pRecord->IsLoaded() ) // Can occur due to multiple requests for the same resource in the same frame
                     {
@@ -299,7 +472,7 @@ namespace KRG::Resource
                     {
                         auto loaderIter = m_resourceLoaders.find( pendingRequest.m_pRecord->GetResourceTypeID() );
                         KRG_ASSERT( loaderIter != m_resourceLoaders.end() );
-                        m_activeRequests.emplace_back( KRG::New<ResourceRequest>( pendingRequest.m_requesterID, ResourceRequest::Type::Load, pendingRequest.m_pRecord, loaderIter->second ) );
+                        m_activeRequests.emplace_back( KRG::New<ResourceRequest>( pendingRequest.m_requesterID, ResourceRequest::Type::Load, pendingRequest.m_pRecord, loaderIter->second, pendingRequest.m_priority, pendingRequest.m_deadline ) );
                     }
                 }
                 else // Unload request
@@ -344,6 +517,43 @@ namespace KRG::Resource
 
                 #if KRG_DEVELOPMENT_TOOLS
                 m_history.emplace_back( CompletedRequestLog( pCompletedRequest->IsLoadRequest() ? PendingRequest::Type::Load : PendingRequest::Type::Unload, resourceID ) );
+
+                auto const& decompressionStats = pCompletedRequest->GetDecompressionStats();
+                if ( decompressionStats.WasCompressed() )
+                {
+                    auto& typeStats = m_compressionStats[pCompletedRequest->GetResourceTypeID()];
+                    typeStats.m_numResources++;
+                    typeStats.m_compressedSize += decompressionStats.m_compressedSize;
+                    typeStats.m_uncompressedSize += decompressionStats.m_uncompressedSize;
+                    typeStats.m_decompressionTime += decompressionStats.m_decompressionTime;
+                }
+
+                if ( pCompletedRequest->IsLoadRequest() )
+                {
+                    Milliseconds const timeToReady = pCompletedRequest->GetTimeToReady();
+                    auto& loadTimeStats = m_loadTimeStats[(uint8) pCompletedRequest->GetRequestedPriority()];
+                    loadTimeStats.m_numLoads++;
+                    loadTimeStats.m_totalTimeToReady += timeToReady;
+                    loadTimeStats.m_maxTimeToReady = Math::Max( loadTimeStats.m_maxTimeToReady.ToFloat(), timeToReady.ToFloat() );
+
+                    if ( pCompletedRequest->WasCompletedAfterDeadline() )
+                    {
+                        loadTimeStats.m_numMissedDeadlines++;
+                        KRG_LOG_WARNING( "Resource", "Resource missed its load deadline by %.2fms (%s)", pCompletedRequest->GetDeadlineOverrun().ToFloat(), resourceID.c_str() );
+                    }
+
+                    // Drop the oldest quarter of the traces when full, so we dont shift the whole list on every completed load
+                    auto const& loadTrace = pCompletedRequest->GetLoadTrace();
+                    if ( loadTrace.WasStageReached( ResourceRequest::LoadTrace::Queued ) )
+                    {
+                        if ( m_loadTraces.size() >= s_maxLoadTraces )
+                        {
+                            m_loadTraces.erase( m_loadTraces.begin(), m_loadTraces.begin() + ( s_maxLoadTraces / 4 ) );
+                        }
+
+                        m_loadTraces.emplace_back( loadTrace );
+                    }
+                }
                 #endif
 
                 if ( pCompletedRequest->IsUnloadRequest() )
@@ -367,6 +577,20 @@ namespace KRG::Resource
             m_completedRequests.clear();
         }
 
+        KRG_PROFILE_COUNTER_SET( "Resource Requests Active", (int64) m_activeRequests.size() );
+
+        // Requests are processed back to front, so sort them so that the highest priority (and oldest within a priority) requests are updated first
+        auto activeSortPredicate = [] ( ResourceRequest const* pA, ResourceRequest const* pB )
+        {
+            if ( pA->GetPriority() != pB->GetPriority() )
+            {
+                return pA->GetPriority() < pB->GetPriority();
+            }
+
+            return pA->GetRequestTime() > pB->GetRequestTime();
+        };
+        eastl::stable_sort( m_activeRequests.begin(), m_activeRequests.end(), activeSortPredicate );
+
         // Kick off new async task
         //-------------------------------------------------------------------------
 
@@ -389,34 +613,90 @@ namespace KRG::Resource
     {
         KRG_PROFILE_FUNCTION_RESOURCE();
 
-        //-------------------------------------------------------------------------
+        // The context is only read by the requests so it is safe to share it between threads
+        ResourceRequest::RequestContext context;
+        context.m_createRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->RequestRawResource( pRequest ); };
+        context.m_cancelRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->CancelRequest( pRequest ); };
+        context.m_loadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr, LoadPriority priority ) { LoadResource( resourcePtr, requesterID, priority ); };
+        context.m_unloadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { UnloadResource( resourcePtr, requesterID ); };
+        context.m_pTaskSystem = &m_taskSystem;
+        context.m_pIOService = &m_ioService;
 
+        // Update all requests that need to be processed serially and collect the ones that can be processed in parallel
+        //-------------------------------------------------------------------------
         // We dont have to worry about this loop even if the m_activeRequests array is modified from another thread since we only access the array in 2 places and both use locks
-        for ( int32 i = (int32) m_activeRequests.size() - 1; i >= 0; i-- )
-        {
-            ResourceRequest::RequestContext context;
-            context.m_createRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->RequestRawResource( pRequest ); };
-            context.m_cancelRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->CancelRequest( pRequest ); };
-            context.m_loadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { LoadResource( resourcePtr, requesterID ); };
-            context.m_unloadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { UnloadResource( resourcePtr, requesterID ); };
-
-            //-------------------------------------------------------------------------
+        // Serial stages read the loading status of other resources (i.e. install dependencies), so they are all run before any of the parallel work is started
 
-            bool isRequestComplete = false;
+        m_parallelRequests.clear();
 
+        for ( int32 i = (int32) m_activeRequests.size() - 1; i >= 0; i-- )
+        {
             ResourceRequest* pRequest = m_activeRequests[i];
-            if ( pRequest->IsActive() )
+            if ( !pRequest->IsActive() )
             {
-                isRequestComplete = pRequest->Update( context );
+                continue;
+            }
+
+            if ( pRequest->CanBeProcessedInParallel() )
+            {
+                m_parallelRequests.emplace_back( pRequest );
             }
             else
             {
-                isRequestComplete = true;
+                pRequest->Update( context );
             }
+        }
+
+        // Load and install all thread-safe requests across the task system workers
+        //-------------------------------------------------------------------------
+
+        KRG_PROFILE_COUNTER_SET( "Resource Requests Processed In Parallel", (int64) m_parallelRequests.size() );
+
+        if ( m_parallelRequests.size() == 1 )
+        {
+            m_parallelRequests[0]->Update( context );
+        }
+        else if ( m_parallelRequests.size() > 1 )
+        {
+            struct ParallelRequestTask : public ITaskSet
+            {
+                ParallelRequestTask( TVector<ResourceRequest*> const& requests, ResourceRequest::RequestContext& context )
+                    : m_requests( requests )
+                    , m_context( context )
+                {
+                    m_SetSize = (uint32) requests.size();
+                    m_MinRange = 1;
+                }
+
+                virtual void ExecuteRange( TaskSetPartition range, uint32 threadnum ) override final
+                {
+                    KRG_PROFILE_SCOPE_RESOURCE( "Process Resource Requests" );
+                    for ( uint64 i = range.start; i < range.end; ++i )
+                    {
+                        m_requests[i]->Update( m_context );
+                    }
+                }
+
+            public:
+
+                TVector<ResourceRequest*> const&            m_requests;
+                ResourceRequest::RequestContext&            m_context;
+            };
 
             //-------------------------------------------------------------------------
 
-            if ( isRequestComplete )
+            ParallelRequestTask task( m_parallelRequests, context );
+            m_taskSystem.ScheduleTask( &task );
+            m_taskSystem.WaitForTask( &task );
+        }
+
+        // Retire completed requests
+        //-------------------------------------------------------------------------
+
+        for ( int32 i = (int32) m_activeRequests.size() - 1; i >= 0; i-- )
+        {
+            ResourceRequest* pRequest = m_activeRequests[i];
+            if ( pRequest->IsComplete() )
             {
                 // We need to process and remove completed requests at the next update stage since unload task may have queued unload requests which refer to the request's allocated memory
                 m_completedRequests.emplace_back( pRequest );
@@ -434,5 +714,102 @@ namespace KRG::Resource
         m_usersThatRequireReload.clear(); 
         m_externallyUpdatedResources.clear();
     }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceSystem::ClearLoadTraces()
+    {
+        Threading::RecursiveScopeLock lock( m_accessLock );
+        m_loadTraces.clear();
+    }
+
+    bool ResourceSystem::ExportLoadTraces( FileSystem::Path const& exportPath ) const
+    {
+        KRG_ASSERT( exportPath.IsFile() );
+        Threading::RecursiveScopeLock lock( m_accessLock );
+
+        if ( m_loadTraces.empty() )
+        {
+            return false;
+        }
+
+        // Traces are packed into as few lanes as possible, each lane is exported as a separate thread
+        //-------------------------------------------------------------------------
+
+        TVector<ResourceRequest::LoadTrace const*> sortedTraces;
+        sortedTraces.reserve( m_loadTraces.size() );
+        for ( auto const& loadTrace : m_loadTraces )
+        {
+            sortedTraces.emplace_back( &loadTrace );
+        }
+
+        auto SortPredicate = [] ( ResourceRequest::LoadTrace const* pTraceA, ResourceRequest::LoadTrace const* pTraceB ) { return pTraceA->GetStartTime() < pTraceB->GetStartTime(); };
+        eastl::sort( sortedTraces.begin(), sortedTraces.end(), SortPredicate );
+
+        Milliseconds const captureStartTime = sortedTraces.front()->GetStartTime();
+        TVector<Milliseconds> laneEndTimes;
+
+        String trace;
+        trace.reserve( sortedTraces.size() * 1024 );
+        trace.append( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+        trace.append( "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Resource Loads\"}}" );
+
+        char buffer[512];
+        for ( auto pLoadTrace : sortedTraces )
+        {
+            uint32 laneIdx = 0;
+            while ( laneIdx < laneEndTimes.size() && laneEndTimes[laneIdx] > pLoadTrace->GetStartTime() )
+            {
+                laneIdx++;
+            }
+
+            if ( laneIdx == laneEndTimes.size() )
+            {
+                laneEndTimes.emplace_back( 0.0f );
+                Printf( buffer, sizeof( buffer ), ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Load Lane %u\"}}", laneIdx, laneIdx );
+                trace.append( buffer );
+            }
+
+            laneEndTimes[laneIdx] = pLoadTrace->GetEndTime();
+
+            //-------------------------------------------------------------------------
+
+            // The whole load is emitted as the parent event, with the individual stages nested inside it
+            double const loadStartTime = double( ( pLoadTrace->GetStartTime() - captureStartTime ).ToFloat() ) * 1000.0;
+            double const loadDuration = double( ( pLoadTrace->GetEndTime() - pLoadTrace->GetStartTime() ).ToFloat() ) * 1000.0;
+            Printf( buffer, sizeof( buffer ), ",\n{\"name\":\"%s\",\"cat\":\"Resource\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"bytesRead\":%llu,\"loadThread\":%u,\"installThread\":%u,\"succeeded\":%s}}",
+                pLoadTrace->m_resourceID.c_str(), laneIdx, loadStartTime, loadDuration, (unsigned long long) pLoadTrace->m_bytesRead, pLoadTrace->m_loadThreadID, pLoadTrace->m_installThreadID, pLoadTrace->m_wasSuccessful ? "true" : "false" );
+            trace.append( buffer );
+
+            for ( uint8 i = 0; i < ResourceRequest::LoadTrace::NumStages; i++ )
+            {
+                auto const stage = (ResourceRequest::LoadTrace::Stage) i;
+                if ( !pLoadTrace->WasStageReached( stage ) )
+                {
+                    continue;
+                }
+
+                double const stageStartTime = double( ( pLoadTrace->m_stageStartTimes[i] - captureStartTime ).ToFloat() ) * 1000.0;
+                double const stageDuration = double( pLoadTrace->GetStageDuration( stage ).ToFloat() ) * 1000.0;
+                Printf( buffer, sizeof( buffer ), ",\n{\"name\":\"%s\",\"cat\":\"Resource\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", ResourceRequest::LoadTrace::GetStageName( stage ), laneIdx, stageStartTime, stageDuration );
+                trace.append( buffer );
+            }
+        }
+
+        trace.append( "\n]}\n" );
+
+        //-------------------------------------------------------------------------
+
+        FileSystem::EnsurePathExists( exportPath );
+        FileSystem::OutputFileStream traceFile( exportPath );
+        if ( !traceFile.IsValid() )
+        {
+            KRG_LOG_ERROR( "Resource", "Failed to export resource load traces (%s)", exportPath.c_str() );
+            return false;
+        }
+
+        traceFile.Write( (void*) trace.data(), trace.size() );
+        return true;
+    }
     #endif
 }
\ No newline at end of file
@@ -2,8 +2,12 @@
 
 #include "_Module/API.h"
 #include "ResourcePtr.h"
+#include "ResourceLoadPriority.h"
+#include "ResourceResidentCache.h"
+#include "ResourceRequest.h"
 #include "System/Core/Threading/Threading.h"
 #include "System/Core/Threading/TaskSystem.h"
+#include "System/Core/FileSystem/IOService.h"
 #include "System/Core/Systems/ISystem.h"
 #include "System/Core/Types/Event.h"
 #include "System/Core/Time/TimeStamp.h"
@@ -19,7 +23,6 @@ namespace KRG::Resource
 {
     class ResourceProvider;
     class ResourceLoader;
-    class ResourceRequest;
 
     //-------------------------------------------------------------------------
 
@@ -35,20 +38,34 @@ namespace KRG::Resource
 
             PendingRequest() = default;
 
-            PendingRequest( Type type, ResourceRecord* pRecord, ResourceRequesterID const& requesterID )
+            PendingRequest( Type type, ResourceRecord* pRecord, ResourceRequesterID const& requesterID, LoadPriority priority = LoadPriority::Normal, Milliseconds deadline = 0.0f )
                 : m_pRecord( pRecord )
                 , m_requesterID( requesterID )
+                , m_deadline( deadline )
                 , m_type( type )
+                , m_priority( priority )
             {
                 KRG_ASSERT( m_pRecord != nullptr );
             }
 
             ResourceRecord*         m_pRecord = nullptr;
             ResourceRequesterID     m_requesterID;
+            Milliseconds            m_deadline = 0.0f;
             Type                    m_type = Type::Load;
+            LoadPriority            m_priority = LoadPriority::Normal;
+        };
+
+        // Priority raise for a resource that is already in flight, these are applied on the main thread since active requests are owned by the async task
+        struct PendingPriorityChange
+        {
+            ResourceRecord*         m_pRecord = nullptr;
+            Milliseconds            m_deadline = 0.0f;
+            LoadPriority            m_priority = LoadPriority::Normal;
         };
 
         #if KRG_DEVELOPMENT_TOOLS
+        constexpr static uint32 const s_maxLoadTraces = 2048;
+
         struct CompletedRequestLog
         {
             CompletedRequestLog( PendingRequest::Type type, ResourceID ID ) : m_type( type ), m_ID( ID ) {}
@@ -57,6 +74,29 @@ namespace KRG::Resource
             ResourceID              m_ID;
             TimeStamp               m_time;
         };
+
+        // Accumulated decompression stats per resource type
+        struct CompressionStats
+        {
+            inline float GetCompressionRatio() const { return ( m_compressedSize > 0 ) ? float( m_uncompressedSize ) / m_compressedSize : 1.0f; }
+            inline float GetDecodeThroughput() const { return ( m_decompressionTime.ToFloat() > 0.0f ) ? float( m_uncompressedSize / ( 1024.0 * 1024.0 ) ) / m_decompressionTime.ToSeconds().ToFloat() : 0.0f; } // MB/s
+
+            uint32                  m_numResources = 0;
+            uint64                  m_compressedSize = 0;
+            uint64                  m_uncompressedSize = 0;
+            Milliseconds            m_decompressionTime = 0.0f;
+        };
+
+        // Accumulated time-to-ready stats per requested priority class
+        struct LoadTimeStats
+        {
+            inline Milliseconds GetAverageTimeToReady() const { return ( m_numLoads > 0 ) ? Milliseconds( m_totalTimeToReady.ToFloat() / m_numLoads ) : Milliseconds( 0.0f ); }
+
+            uint32                  m_numLoads = 0;
+            uint32                  m_numMissedDeadlines = 0;
+            Milliseconds            m_totalTimeToReady = 0.0f;
+            Milliseconds            m_maxTimeToReady = 0.0f;
+        };
         #endif
 
     public:
@@ -91,17 +131,28 @@ namespace KRG::Resource
         //-------------------------------------------------------------------------
 
         // Request a load of a resource, can optionally provide a ResourceRequesterID for identification of the request source
-        void LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() );
+        // An optional deadline (time from now) will escalate the request's priority as it approaches
+        // Requesting an already loading resource with a higher priority will raise the priority of the in-flight request
+        void LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID(), LoadPriority priority = LoadPriority::Normal, Milliseconds deadline = 0.0f );
 
         // Request an unload of a resource, can optionally provide a ResourceRequesterID for identification of the request source
         void UnloadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() );
 
         template<typename T>
-        inline void LoadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() ) { LoadResource( (ResourcePtr&) resourcePtr, requesterID ); }
+        inline void LoadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID(), LoadPriority priority = LoadPriority::Normal, Milliseconds deadline = 0.0f ) { LoadResource( (ResourcePtr&) resourcePtr, requesterID, priority, deadline ); }
 
         template<typename T>
         inline void UnloadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() ) { UnloadResource( (ResourcePtr&) resourcePtr, requesterID ); }
 
+        // Resident Cache
+        //-------------------------------------------------------------------------
+
+        // Keep unreferenced resources of this type loaded up to the specified memory budget (0 disables caching for the type)
+        void SetResidentCacheBudget( ResourceTypeID typeID, uint64 budgetInBytes );
+
+        // Unload all unreferenced resources that are being kept resident
+        void ClearResidentCache();
+
         // Hot Reload
         //-------------------------------------------------------------------------
 
@@ -112,6 +163,18 @@ namespace KRG::Resource
         void ClearHotReloadRequests();
         #endif
 
+        // Load Tracing
+        //-------------------------------------------------------------------------
+
+        #if KRG_DEVELOPMENT_TOOLS
+        // The stage timings of the most recently completed loads, ordered by completion
+        inline TVector<ResourceRequest::LoadTrace> const& GetLoadTraces() const { return m_loadTraces; }
+        void ClearLoadTraces();
+
+        // Write the recorded load traces to a file in the same (chrome trace) format as the profiler captures
+        bool ExportLoadTraces( FileSystem::Path const& exportPath ) const;
+        #endif
+
     private:
 
         void UpdateResourceProvider();
@@ -131,6 +194,18 @@ namespace KRG::Resource
         // Returns a list of all unique external references for the given resource
         void GetUsersForResource( ResourceRecord const* pResourceRecord, TVector<ResourceRequesterID>& requesterIDs ) const;
 
+        // Request the unload of records that were evicted from the resident cache
+        void UnloadEvictedRecords( TVector<ResourceRecord*> const& evictedRecords );
+
+        // Apply all queued priority raises to the active requests and escalate requests that are approaching their deadlines
+        void UpdateRequestPriorities();
+
+        // Raise the priority of a resource's active request as well as the requests for its pending install dependencies
+        void RaiseActiveRequestPriority( ResourceRecord const* pResourceRecord, LoadPriority priority, Milliseconds deadline );
+
+        // Raise the priority of an active load request and propagate it to the requests for its pending install dependencies
+        void RaiseRequestPriority( ResourceRequest* pRequest, LoadPriority priority, Milliseconds deadline );
+
         // Process all queued resource requests
         void ProcessResourceRequests();
 
@@ -138,14 +213,18 @@ namespace KRG::Resource
 
         TaskSystem&                                             m_taskSystem;
         ResourceProvider*                                       m_pResourceProvider = nullptr;
+        FileSystem::IOService                                   m_ioService;
         THashMap<ResourceTypeID, ResourceLoader*>               m_resourceLoaders;
         THashMap<ResourceID, ResourceRecord*>                   m_resourceRecords;
         mutable Threading::RecursiveMutex                       m_accessLock;
+        ResourceResidentCache                                   m_residentCache;
 
         // Requests
         TVector<PendingRequest>                                 m_pendingRequests;
+        TVector<PendingPriorityChange>                          m_pendingPriorityChanges;
         TVector<ResourceRequest*>                               m_activeRequests;
         TVector<ResourceRequest*>                               m_completedRequests;
+        TVector<ResourceRequest*>                               m_parallelRequests;     // Scratch list for the async processing task
 
         // ASync
         AsyncTask                                               m_asyncProcessingTask;
@@ -155,6 +234,9 @@ namespace KRG::Resource
         TVector<ResourceRequesterID>                            m_usersThatRequireReload;
         TVector<ResourceID>                                     m_externallyUpdatedResources;
         TVector<CompletedRequestLog>                            m_history;
+        THashMap<ResourceTypeID, CompressionStats>              m_compressionStats;
+        LoadTimeStats                                           m_loadTimeStats[(uint8) LoadPriority::NumPriorities];
+        TVector<ResourceRequest::LoadTrace>                     m_loadTraces;
         #endif
     };
 }
\ No newline at end of file
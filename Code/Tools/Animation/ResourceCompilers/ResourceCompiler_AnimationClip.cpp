@@ -13,10 +13,368 @@
 
 namespace KRG::Animation
 {
+    namespace
+    {
+        // The minimum distance of the virtual vertices from their bone (in meters)
+        static constexpr float const s_minVirtualVertexDistance = 0.03f;
+
+        // How many rates above the lowest valid rate we try when reducing keys, higher rates leave more of the error budget for removing keys
+        static constexpr uint32 const s_maxKeyReductionRateIncrease = 2;
+
+        //-------------------------------------------------------------------------
+
+        class BitStreamWriter
+        {
+        public:
+
+            BitStreamWriter() { Reset(); }
+
+            inline void Reset()
+            {
+                m_data.clear();
+                m_data.resize( 2, 0 );
+                m_numBits = 0;
+            }
+
+            inline uint32 GetNumBits() const { return m_numBits; }
+
+            // The data is always padded with two extra words, as required by the decoder
+            inline TVector<uint32> const& GetData() const { return m_data; }
+
+            void Write( uint32 value, uint32 numBits )
+            {
+                KRG_ASSERT( numBits <= 32 && uint64( value ) < ( uint64( 1 ) << numBits ) );
+
+                uint32 const wordIdx = m_numBits >> 5;
+                m_numBits += numBits;
+                m_data.resize( ( m_numBits >> 5 ) + 2, 0 );
+
+                uint64 const shiftedValue = uint64( value ) << ( ( m_numBits - numBits ) & 31 );
+                m_data[wordIdx] |= uint32( shiftedValue );
+                m_data[wordIdx + 1] |= uint32( shiftedValue >> 32 );
+            }
+
+            void Append( BitStreamWriter const& other )
+            {
+                uint32 const numWholeWords = other.m_numBits >> 5;
+                for ( uint32 i = 0; i < numWholeWords; i++ )
+                {
+                    Write( other.m_data[i], 32 );
+                }
+
+                uint32 const numRemainingBits = other.m_numBits & 31;
+                Write( other.m_data[numWholeWords] & ( ( 1u << numRemainingBits ) - 1 ), numRemainingBits );
+            }
+
+        private:
+
+            TVector<uint32>                     m_data;
+            uint32                              m_numBits = 0;
+        };
+
+        //-------------------------------------------------------------------------
+
+        enum Channel
+        {
+            Rotation = 0,
+            Translation,
+            Scale,
+
+            NumChannels
+        };
+
+        // Get the stored rotation components, the quaternion is negated if needed so that the dropped component is positive
+        static Vector GetStoredRotationComponents( Quaternion const& rotation, uint32 droppedComponentIdx )
+        {
+            float const components[4] = { rotation.m_x, rotation.m_y, rotation.m_z, rotation.m_w };
+            float const sign = ( components[droppedComponentIdx] < 0 ) ? -1.0f : 1.0f;
+
+            uint32 const* pStoredComponents = TrackCompression::s_storedRotationComponents[droppedComponentIdx];
+            return Vector( components[pStoredComponents[0]] * sign, components[pStoredComponents[1]] * sign, components[pStoredComponents[2]] * sign, 0.0f );
+        }
+
+        static Vector GetChannelValue( Transform const& transform, int32 channelIdx, uint32 droppedRotationComponentIdx )
+        {
+            if ( channelIdx == Rotation )
+            {
+                return GetStoredRotationComponents( transform.GetRotation(), droppedRotationComponentIdx );
+            }
+
+            return ( channelIdx == Translation ) ? transform.GetTranslation() : transform.GetScale();
+        }
+
+        // Drop the component that is furthest from zero over the segment, the precision of the reconstructed component degrades as it approaches zero
+        static uint32 SelectDroppedRotationComponent( TVector<Transform> const& transforms, uint32 segmentStartFrame, uint32 numSegmentFrames )
+        {
+            float minAbsComponents[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            for ( uint32 i = 0; i < numSegmentFrames; i++ )
+            {
+                Quaternion const& rotation = transforms[segmentStartFrame + i].GetRotation();
+                minAbsComponents[0] = Math::Min( minAbsComponents[0], Math::Abs( rotation.m_x ) );
+                minAbsComponents[1] = Math::Min( minAbsComponents[1], Math::Abs( rotation.m_y ) );
+                minAbsComponents[2] = Math::Min( minAbsComponents[2], Math::Abs( rotation.m_z ) );
+                minAbsComponents[3] = Math::Min( minAbsComponents[3], Math::Abs( rotation.m_w ) );
+            }
+
+            uint32 droppedComponentIdx = 3;
+            for ( uint32 componentIdx = 0; componentIdx < 3; componentIdx++ )
+            {
+                if ( minAbsComponents[componentIdx] > minAbsComponents[droppedComponentIdx] )
+                {
+                    droppedComponentIdx = componentIdx;
+                }
+            }
+
+            return droppedComponentIdx;
+        }
+
+        // Calculate the clip ranges for the rotation components, using the dropped component of each segment. Returns true if the rotation is static
+        static bool CalculateRotationClipRanges( TVector<Transform> const& transforms, uint8 const* pDroppedComponentIndices, QuantizationRange outRanges[4] )
+        {
+            uint32 const numFrames = (uint32) transforms.size();
+            uint32 const numSegments = TrackCompression::GetNumSegments( numFrames );
+
+            float minValues[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            float maxValues[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+
+            for ( uint32 segmentIdx = 0; segmentIdx < numSegments; segmentIdx++ )
+            {
+                uint32 const segmentStartFrame = segmentIdx * TrackCompression::s_numFramesPerSegment;
+                uint32 const numSegmentFrames = TrackCompression::GetNumSegmentFrames( numFrames, segmentIdx );
+                uint32 const* pStoredComponents = TrackCompression::s_storedRotationComponents[pDroppedComponentIndices[segmentIdx]];
+
+                for ( uint32 i = 0; i < numSegmentFrames; i++ )
+                {
+                    Vector const value = GetStoredRotationComponents( transforms[segmentStartFrame + i].GetRotation(), pDroppedComponentIndices[segmentIdx] );
+                    for ( uint32 k = 0; k < 3; k++ )
+                    {
+                        minValues[pStoredComponents[k]] = Math::Min( minValues[pStoredComponents[k]], value[k] );
+                        maxValues[pStoredComponents[k]] = Math::Max( maxValues[pStoredComponents[k]], value[k] );
+                    }
+                }
+            }
+
+            bool isStatic = true;
+            for ( uint32 componentIdx = 0; componentIdx < 4; componentIdx++ )
+            {
+                // This component is dropped in every segment
+                if ( minValues[componentIdx] > maxValues[componentIdx] )
+                {
+                    outRanges[componentIdx] = { 0.0f, 0.0f };
+                    continue;
+                }
+
+                float const rangeLength = maxValues[componentIdx] - minValues[componentIdx];
+                bool const isConstant = Math::IsNearZero( rangeLength );
+                outRanges[componentIdx] = { minValues[componentIdx], isConstant ? 0.0f : rangeLength };
+                isStatic &= isConstant;
+            }
+
+            return isStatic;
+        }
+
+        // Calculate the clip ranges for a translation or scale channel's components, returns true if the channel is static
+        static bool CalculateChannelClipRanges( TVector<Transform> const& transforms, int32 channelIdx, QuantizationRange& outRangeX, QuantizationRange& outRangeY, QuantizationRange& outRangeZ )
+        {
+            KRG_ASSERT( channelIdx != Rotation );
+
+            Vector const firstValue = GetChannelValue( transforms[0], channelIdx, 0 );
+            Vector minValue = firstValue;
+            Vector maxValue = firstValue;
+
+            for ( auto const& transform : transforms )
+            {
+                Vector const value = GetChannelValue( transform, channelIdx, 0 );
+                minValue = Vector::Min( minValue, value );
+                maxValue = Vector::Max( maxValue, value );
+            }
+
+            Vector const rangeLength = maxValue - minValue;
+            bool const isStatic = Math::IsNearZero( rangeLength.m_x ) && Math::IsNearZero( rangeLength.m_y ) && Math::IsNearZero( rangeLength.m_z );
+
+            // Static channels and components that don't change use a zero length range, so they always decode to the range start
+            if ( isStatic )
+            {
+                outRangeX = { firstValue.m_x, 0.0f };
+                outRangeY = { firstValue.m_y, 0.0f };
+                outRangeZ = { firstValue.m_z, 0.0f };
+            }
+            else
+            {
+                outRangeX = { minValue.m_x, Math::IsNearZero( rangeLength.m_x ) ? 0.0f : rangeLength.m_x };
+                outRangeY = { minValue.m_y, Math::IsNearZero( rangeLength.m_y ) ? 0.0f : rangeLength.m_y };
+                outRangeZ = { minValue.m_z, Math::IsNearZero( rangeLength.m_z ) ? 0.0f : rangeLength.m_z };
+            }
+
+            return isStatic;
+        }
+
+        // The encoding choices for a track's segment block
+        struct TrackSegmentFormat
+        {
+            uint32                              m_rates[NumChannels];
+            uint32                              m_keyMasks[NumChannels]; // Bit N is set if frame N of the segment is a key
+            bool                                m_useSplines[NumChannels];
+            uint32                              m_droppedRotationComponentIdx;
+        };
+
+        // Encode a track's block for a segment, see AnimationClipCompression.h for the layout
+        static void EncodeTrackSegment( TVector<Transform> const& transforms, TrackCompressionSettings const& settings, uint32 segmentStartFrame, uint32 numSegmentFrames, TrackSegmentFormat const& format, BitStreamWriter& writer )
+        {
+            using namespace TrackCompression;
+
+            uint32 const droppedRotationComponentIdx = format.m_droppedRotationComponentIdx;
+            uint32 const* pStoredRotationComponents = s_storedRotationComponents[droppedRotationComponentIdx];
+            QuantizationRange const* clipRanges[NumChannels][3] =
+            {
+                { &settings.m_rotationRanges[pStoredRotationComponents[0]], &settings.m_rotationRanges[pStoredRotationComponents[1]], &settings.m_rotationRanges[pStoredRotationComponents[2]] },
+                { &settings.m_translationRangeX, &settings.m_translationRangeY, &settings.m_translationRangeZ },
+                { &settings.m_scaleRangeX, &settings.m_scaleRangeY, &settings.m_scaleRangeZ },
+            };
+
+            // Static channels always have a single key and no flags
+            uint32 const allKeysMask = ( 1u << numSegmentFrames ) - 1;
+            uint32 keyMasks[NumChannels];
+            uint32 channelFlags[NumChannels];
+            for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+            {
+                bool const isStatic = ( format.m_rates[channelIdx] == s_staticRate );
+                keyMasks[channelIdx] = isStatic ? 1 : format.m_keyMasks[channelIdx];
+                KRG_ASSERT( isStatic || ( ( keyMasks[channelIdx] & 1 ) && ( keyMasks[channelIdx] >> ( numSegmentFrames - 1 ) ) == 1 ) );
+
+                channelFlags[channelIdx] = 0;
+                if ( !isStatic && keyMasks[channelIdx] != allKeysMask )
+                {
+                    channelFlags[channelIdx] |= s_channelFlagHasKeyMask;
+                }
+
+                if ( !isStatic && format.m_useSplines[channelIdx] )
+                {
+                    channelFlags[channelIdx] |= s_channelFlagSpline;
+                }
+            }
+
+            uint32 header = format.m_rates[Rotation] | ( format.m_rates[Translation] << s_numBitsPerRateIndex ) | ( format.m_rates[Scale] << ( 2 * s_numBitsPerRateIndex ) ) | ( droppedRotationComponentIdx << ( 3 * s_numBitsPerRateIndex ) );
+            for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+            {
+                header |= channelFlags[channelIdx] << ( 3 * s_numBitsPerRateIndex + s_numBitsPerDroppedComponentIdx + channelIdx * s_numBitsPerChannelFlags );
+            }
+
+            writer.Write( header, s_numBitsPerTrackSegmentHeader );
+
+            // Key masks and segment ranges, the ranges only need to contain the key values
+            //-------------------------------------------------------------------------
+
+            float segmentRangeStart[NumChannels][3];
+            float segmentRangeLength[NumChannels][3];
+
+            for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+            {
+                if ( format.m_rates[channelIdx] == s_staticRate )
+                {
+                    continue;
+                }
+
+                if ( channelFlags[channelIdx] & s_channelFlagHasKeyMask )
+                {
+                    writer.Write( keyMasks[channelIdx], numSegmentFrames );
+                }
+
+                Vector minValue = GetChannelValue( transforms[segmentStartFrame], channelIdx, droppedRotationComponentIdx );
+                Vector maxValue = minValue;
+                for ( uint32 i = 1; i < numSegmentFrames; i++ )
+                {
+                    if ( keyMasks[channelIdx] & ( 1u << i ) )
+                    {
+                        Vector const value = GetChannelValue( transforms[segmentStartFrame + i], channelIdx, droppedRotationComponentIdx );
+                        minValue = Vector::Min( minValue, value );
+                        maxValue = Vector::Max( maxValue, value );
+                    }
+                }
+
+                for ( int32 componentIdx = 0; componentIdx < 3; componentIdx++ )
+                {
+                    QuantizationRange const& clipRange = *clipRanges[channelIdx][componentIdx];
+
+                    // The segment range is quantized relative to the clip range, and is rounded outwards so that it still contains all the values
+                    int32 encodedStart = 0;
+                    int32 encodedLength = 0;
+                    if ( clipRange.m_rangeLength > 0 )
+                    {
+                        float const normalizedMin = ( minValue[componentIdx] - clipRange.m_rangeStart ) / clipRange.m_rangeLength;
+                        float const normalizedMax = ( maxValue[componentIdx] - clipRange.m_rangeStart ) / clipRange.m_rangeLength;
+                        encodedStart = Math::Clamp( Math::FloorToInt( normalizedMin * s_maxSegmentRangeValue ), 0, (int32) s_maxSegmentRangeValue - 1 );
+                        int32 const encodedEnd = Math::Clamp( Math::CeilingToInt( normalizedMax * s_maxSegmentRangeValue ), encodedStart + 1, (int32) s_maxSegmentRangeValue );
+                        encodedLength = encodedEnd - encodedStart;
+                    }
+
+                    writer.Write( encodedStart, s_numBitsPerSegmentRangeValue );
+                    writer.Write( encodedLength, s_numBitsPerSegmentRangeValue );
+
+                    float const clipRangeStep = clipRange.m_rangeLength / s_maxSegmentRangeValue;
+                    segmentRangeStart[channelIdx][componentIdx] = clipRange.m_rangeStart + encodedStart * clipRangeStep;
+                    segmentRangeLength[channelIdx][componentIdx] = encodedLength * clipRangeStep;
+                }
+            }
+
+            // Key samples
+            //-------------------------------------------------------------------------
+
+            for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+            {
+                if ( format.m_rates[channelIdx] == s_staticRate )
+                {
+                    continue;
+                }
+
+                uint32 const numBits = s_numBitsPerRate[format.m_rates[channelIdx]];
+                int32 const maxEncodedValue = ( 1 << numBits ) - 1;
+
+                for ( uint32 i = 0; i < numSegmentFrames; i++ )
+                {
+                    if ( ( keyMasks[channelIdx] & ( 1u << i ) ) == 0 )
+                    {
+                        continue;
+                    }
+
+                    Vector const value = GetChannelValue( transforms[segmentStartFrame + i], channelIdx, droppedRotationComponentIdx );
+                    for ( int32 componentIdx = 0; componentIdx < 3; componentIdx++ )
+                    {
+                        int32 encodedValue = 0;
+                        if ( segmentRangeLength[channelIdx][componentIdx] > 0 )
+                        {
+                            float const normalizedValue = ( value[componentIdx] - segmentRangeStart[channelIdx][componentIdx] ) / segmentRangeLength[channelIdx][componentIdx];
+                            encodedValue = Math::Clamp( Math::RoundToInt( normalizedValue * maxEncodedValue ), 0, maxEncodedValue );
+                        }
+
+                        writer.Write( encodedValue, numBits );
+                    }
+                }
+            }
+        }
+
+        // The error is the largest distance between the raw and the compressed positions of the bone's virtual vertices
+        static float CalculateVirtualVertexError( Transform const& rawTransform, Transform const& compressedTransform, float virtualVertexDistance )
+        {
+            Vector const virtualVertices[3] = { Vector( virtualVertexDistance, 0, 0 ), Vector( 0, virtualVertexDistance, 0 ), Vector( 0, 0, virtualVertexDistance ) };
+
+            float error = 0.0f;
+            for ( auto const& virtualVertex : virtualVertices )
+            {
+                error = Math::Max( error, rawTransform.TransformPoint( virtualVertex ).GetDistance3( compressedTransform.TransformPoint( virtualVertex ) ) );
+            }
+
+            return error;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     AnimationClipCompiler::AnimationClipCompiler()
         : Resource::Compiler( "AnimationCompiler", s_version )
     {
         m_outputTypes.push_back( AnimationClip::GetStaticResourceTypeID() );
+        m_compressedOutputTypes.push_back( AnimationClip::GetStaticResourceTypeID() );
     }
 
     Resource::CompilationResult AnimationClipCompiler::Compile( Resource::CompileContext const& ctx ) const
@@ -99,7 +457,7 @@ namespace KRG::Animation
 
         AnimationClip animData;
         animData.m_pSkeleton = resourceDescriptor.m_pSkeleton;
-        TransferAndCompressAnimationData( *pRawAnimation, animData );
+        TransferAndCompressAnimationData( *pRawAnimation, animData, resourceDescriptor.m_compressionErrorThreshold, resourceDescriptor.m_reduceKeyFrames );
 
         // Handle events
         //-------------------------------------------------------------------------
@@ -142,7 +500,7 @@ namespace KRG::Animation
 
     //-------------------------------------------------------------------------
 
-    void AnimationClipCompiler::TransferAndCompressAnimationData( RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip ) const
+    void AnimationClipCompiler::TransferAndCompressAnimationData( RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip, float errorThreshold, bool reduceKeyFrames ) const
     {
         auto const& rawTrackData = rawAnimData.GetTrackData();
         int32 const numBones = rawAnimData.GetNumBones();
@@ -179,162 +537,257 @@ namespace KRG::Animation
         animClip.m_averageLinearVelocity = totalDistance / animClip.GetDuration();
         animClip.m_averageAngularVelocity = totalRotation / animClip.GetDuration();
 
-        // Compress raw data
+        // Calculate clip ranges
         //-------------------------------------------------------------------------
 
-        static constexpr float const defaultQuantizationRangeLength = 0.1f;
+        using namespace TrackCompression;
 
-        for ( int32 boneIdx = 0; boneIdx < numBones; boneIdx++ )
-        {
-            TrackCompressionSettings trackSettings;
+        uint32 const numFrames = animClip.m_numFrames;
+        uint32 const numSegments = GetNumSegments( numFrames );
 
-            // Record offset into data for this track
-            trackSettings.m_trackStartIndex = (uint32) animClip.m_compressedPoseData.size();
+        TVector<uint8> droppedRotationComponents( numBones * numSegments );
+        animClip.m_trackCompressionSettings.resize( numBones );
 
-            //-------------------------------------------------------------------------
-            // Rotation
-            //-------------------------------------------------------------------------
+        for ( int32 boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            TrackCompressionSettings& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+            TVector<Transform> const& rawTransforms = rawTrackData[boneIdx].m_transforms;
 
-            for ( uint32 frameIdx = 0; frameIdx < animClip.m_numFrames; frameIdx++ )
+            uint8* pDroppedRotationComponents = &droppedRotationComponents[boneIdx * numSegments];
+            for ( uint32 segmentIdx = 0; segmentIdx < numSegments; segmentIdx++ )
             {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[frameIdx];
-                Quaternion const rotation = rawBoneTransform.GetRotation();
-
-                Quantization::EncodedQuaternion const encodedQuat( rotation );
-                animClip.m_compressedPoseData.push_back( encodedQuat.GetData0() );
-                animClip.m_compressedPoseData.push_back( encodedQuat.GetData1() );
-                animClip.m_compressedPoseData.push_back( encodedQuat.GetData2() );
+                pDroppedRotationComponents[segmentIdx] = (uint8) SelectDroppedRotationComponent( rawTransforms, segmentIdx * s_numFramesPerSegment, GetNumSegmentFrames( numFrames, segmentIdx ) );
             }
 
-            //-------------------------------------------------------------------------
-            // Translation
-            //-------------------------------------------------------------------------
+            trackSettings.m_isRotationStatic = CalculateRotationClipRanges( rawTransforms, pDroppedRotationComponents, trackSettings.m_rotationRanges );
+            trackSettings.m_isTranslationStatic = CalculateChannelClipRanges( rawTransforms, Translation, trackSettings.m_translationRangeX, trackSettings.m_translationRangeY, trackSettings.m_translationRangeZ );
+            trackSettings.m_isScaleStatic = CalculateChannelClipRanges( rawTransforms, Scale, trackSettings.m_scaleRangeX, trackSettings.m_scaleRangeY, trackSettings.m_scaleRangeZ );
+        }
 
-            auto const& rawTranslationValueRangeX = rawTrackData[boneIdx].m_translationValueRangeX;
-            auto const& rawTranslationValueRangeY = rawTrackData[boneIdx].m_translationValueRangeY;
-            auto const& rawTranslationValueRangeZ = rawTrackData[boneIdx].m_translationValueRangeZ;
+        // Calculate the virtual vertex distances and the raw object space transforms
+        //-------------------------------------------------------------------------
 
-            float const& rawTranslationValueRangeLengthX = rawTranslationValueRangeX.GetLength();
-            float const& rawTranslationValueRangeLengthY = rawTranslationValueRangeY.GetLength();
-            float const& rawTranslationValueRangeLengthZ = rawTranslationValueRangeZ.GetLength();
+        // Each bone's virtual vertices are placed at the distance of its furthest descendant, so that errors that propagate down the hierarchy are accounted for
+        RawAssets::RawSkeleton const& rawSkeleton = rawAnimData.GetSkeleton();
+        TVector<float> virtualVertexDistances( numBones, s_minVirtualVertexDistance );
 
-            // We could arguably compress more by saving each component individually at the cost of sampling performance. If we absolutely need more compression, we can do it here
-            bool const isTranslationConstant = Math::IsNearZero( rawTranslationValueRangeLengthX ) && Math::IsNearZero( rawTranslationValueRangeLengthY ) && Math::IsNearZero( rawTranslationValueRangeLengthZ );
-            if ( isTranslationConstant )
-            {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[0];
-                Vector const& translation = rawBoneTransform.GetTranslation();
+        for ( int32 boneIdx = 1; boneIdx < numBones; boneIdx++ )
+        {
+            Vector const bonePosition = rawSkeleton.GetGlobalTransform( boneIdx ).GetTranslation();
 
-                trackSettings.m_translationRangeX = { translation.m_x, defaultQuantizationRangeLength };
-                trackSettings.m_translationRangeY = { translation.m_y, defaultQuantizationRangeLength };
-                trackSettings.m_translationRangeZ = { translation.m_z, defaultQuantizationRangeLength };
-                trackSettings.m_isTranslationStatic = true;
-            }
-            else
+            int32 parentBoneIdx = rawSkeleton.GetParentBoneIndex( boneIdx );
+            while ( parentBoneIdx != InvalidIndex )
             {
-                trackSettings.m_translationRangeX = { rawTranslationValueRangeX.m_start, Math::IsNearZero( rawTranslationValueRangeLengthX ) ? defaultQuantizationRangeLength : rawTranslationValueRangeLengthX };
-                trackSettings.m_translationRangeY = { rawTranslationValueRangeY.m_start, Math::IsNearZero( rawTranslationValueRangeLengthY ) ? defaultQuantizationRangeLength : rawTranslationValueRangeLengthY };
-                trackSettings.m_translationRangeZ = { rawTranslationValueRangeZ.m_start, Math::IsNearZero( rawTranslationValueRangeLengthZ ) ? defaultQuantizationRangeLength : rawTranslationValueRangeLengthZ };
+                float const distance = bonePosition.GetDistance3( rawSkeleton.GetGlobalTransform( parentBoneIdx ).GetTranslation() );
+                virtualVertexDistances[parentBoneIdx] = Math::Max( virtualVertexDistances[parentBoneIdx], distance );
+                parentBoneIdx = rawSkeleton.GetParentBoneIndex( parentBoneIdx );
             }
+        }
 
-            //-------------------------------------------------------------------------
+        TVector<Transform> rawObjectSpaceTransforms( numFrames * numBones );
 
-            if ( trackSettings.IsTranslationTrackStatic() )
+        for ( uint32 frameIdx = 0; frameIdx < numFrames; frameIdx++ )
+        {
+            Transform* pFrameTransforms = &rawObjectSpaceTransforms[frameIdx * numBones];
+            for ( int32 boneIdx = 0; boneIdx < numBones; boneIdx++ )
             {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[0];
-                Vector const& translation = rawBoneTransform.GetTranslation();
-
-                uint16 const m_x = Quantization::EncodeFloat( translation.m_x, trackSettings.m_translationRangeX.m_rangeStart, trackSettings.m_translationRangeX.m_rangeLength );
-                uint16 const m_y = Quantization::EncodeFloat( translation.m_y, trackSettings.m_translationRangeY.m_rangeStart, trackSettings.m_translationRangeY.m_rangeLength );
-                uint16 const m_z = Quantization::EncodeFloat( translation.m_z, trackSettings.m_translationRangeZ.m_rangeStart, trackSettings.m_translationRangeZ.m_rangeLength );
+                int32 const parentBoneIdx = rawSkeleton.GetParentBoneIndex( boneIdx );
+                KRG_ASSERT( parentBoneIdx < boneIdx );
 
-                animClip.m_compressedPoseData.push_back( m_x );
-                animClip.m_compressedPoseData.push_back( m_y );
-                animClip.m_compressedPoseData.push_back( m_z );
+                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[frameIdx];
+                pFrameTransforms[boneIdx] = ( parentBoneIdx == InvalidIndex ) ? rawBoneTransform : rawBoneTransform * pFrameTransforms[parentBoneIdx];
             }
-            else // Store all frames
+        }
+
+        // Compress raw data
+        //-------------------------------------------------------------------------
+        // For each segment, we process the bones from the root down and pick the lowest rate for each channel that keeps the object space error
+        // of the bone's virtual vertices below the threshold. The error includes the error of the already compressed parent bones.
+        // With key reduction, we then greedily remove the keys of each channel that can be interpolated (linearly or with a spline) within the
+        // threshold. Since removing keys needs some of the error budget, we also try slightly higher rates and keep the smallest encoding.
+
+        animClip.m_trackSegmentOffsets.reserve( numSegments * numBones );
+
+        BitStreamWriter clipWriter;
+        BitStreamWriter trackWriter;
+        TVector<Transform> compressedObjectSpaceTransforms( ( s_numFramesPerSegment + 1 ) * numBones );
+        uint32 rateHistogram[s_numRates] = { 0 };
+        uint64 numAnimatedChannelFrames = 0;
+        uint64 numAnimatedChannelKeys = 0;
+        float maxError = 0.0f;
+
+        for ( uint32 segmentIdx = 0; segmentIdx < numSegments; segmentIdx++ )
+        {
+            uint32 const segmentStartFrame = segmentIdx * s_numFramesPerSegment;
+            uint32 const numSegmentFrames = GetNumSegmentFrames( numFrames, segmentIdx );
+            uint32 const allKeysMask = ( 1u << numSegmentFrames ) - 1;
+
+            for ( int32 boneIdx = 0; boneIdx < numBones; boneIdx++ )
             {
-                for ( uint32 frameIdx = 0; frameIdx < animClip.m_numFrames; frameIdx++ )
-                {
-                    Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[frameIdx];
-                    Vector const& translation = rawBoneTransform.GetTranslation();
+                TrackCompressionSettings const& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+                int32 const parentBoneIdx = rawSkeleton.GetParentBoneIndex( boneIdx );
 
-                    uint16 const m_x = Quantization::EncodeFloat( translation.m_x, trackSettings.m_translationRangeX.m_rangeStart, trackSettings.m_translationRangeX.m_rangeLength );
-                    uint16 const m_y = Quantization::EncodeFloat( translation.m_y, trackSettings.m_translationRangeY.m_rangeStart, trackSettings.m_translationRangeY.m_rangeLength );
-                    uint16 const m_z = Quantization::EncodeFloat( translation.m_z, trackSettings.m_translationRangeZ.m_rangeStart, trackSettings.m_translationRangeZ.m_rangeLength );
+                TrackSegmentFormat format;
+                format.m_droppedRotationComponentIdx = droppedRotationComponents[boneIdx * numSegments + segmentIdx];
+                format.m_rates[Rotation] = trackSettings.IsRotationTrackStatic() ? s_staticRate : s_highestRate;
+                format.m_rates[Translation] = trackSettings.IsTranslationTrackStatic() ? s_staticRate : s_highestRate;
+                format.m_rates[Scale] = trackSettings.IsScaleTrackStatic() ? s_staticRate : s_highestRate;
 
-                    animClip.m_compressedPoseData.push_back( m_x );
-                    animClip.m_compressedPoseData.push_back( m_y );
-                    animClip.m_compressedPoseData.push_back( m_z );
+                for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+                {
+                    format.m_keyMasks[channelIdx] = allKeysMask;
+                    format.m_useSplines[channelIdx] = false;
                 }
-            }
-
-            //-------------------------------------------------------------------------
-            // Scale
-            //-------------------------------------------------------------------------
 
-            auto const& rawScaleValueRangeX = rawTrackData[boneIdx].m_scaleValueRangeX;
-            auto const& rawScaleValueRangeY = rawTrackData[boneIdx].m_scaleValueRangeY;
-            auto const& rawScaleValueRangeZ = rawTrackData[boneIdx].m_scaleValueRangeZ;
+                // Encode the track with the current format and return the max error over the segment, this also updates the compressed object space transforms
+                auto EncodeAndCalculateError = [&] ()
+                {
+                    trackWriter.Reset();
+                    EncodeTrackSegment( rawTrackData[boneIdx].m_transforms, trackSettings, segmentStartFrame, numSegmentFrames, format, trackWriter );
+
+                    // Decode through a cursor like the runtime does
+                    TrackCursor cursor;
+                    DecodeTrackSegment( trackWriter.GetData().data(), 0, trackSettings, segmentIdx, numSegmentFrames, cursor );
+
+                    float error = 0.0f;
+                    for ( uint32 i = 0; i < numSegmentFrames; i++ )
+                    {
+                        Transform compressedTransform;
+                        DecodeTrackSegmentFrame( trackWriter.GetData().data(), cursor, i, compressedTransform );
+                        if ( parentBoneIdx != InvalidIndex )
+                        {
+                            compressedTransform = compressedTransform * compressedObjectSpaceTransforms[i * numBones + parentBoneIdx];
+                        }
+
+                        compressedObjectSpaceTransforms[i * numBones + boneIdx] = compressedTransform;
+                        error = Math::Max( error, CalculateVirtualVertexError( rawObjectSpaceTransforms[( segmentStartFrame + i ) * numBones + boneIdx], compressedTransform, virtualVertexDistances[boneIdx] ) );
+                    }
+
+                    return error;
+                };
+
+                // Lower each channel's rate in turn, if no rate is below the threshold (due to the parent's error) we keep the highest rate
+                for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+                {
+                    if ( format.m_rates[channelIdx] == s_staticRate )
+                    {
+                        continue;
+                    }
+
+                    uint32 rate = s_lowestRate;
+                    for ( ; rate < s_highestRate; rate++ )
+                    {
+                        format.m_rates[channelIdx] = rate;
+                        if ( EncodeAndCalculateError() <= errorThreshold )
+                        {
+                            break;
+                        }
+                    }
+
+                    format.m_rates[channelIdx] = rate;
+                }
 
-            float const& rawScaleValueRangeLengthX = rawScaleValueRangeX.GetLength();
-            float const& rawScaleValueRangeLengthY = rawScaleValueRangeY.GetLength();
-            float const& rawScaleValueRangeLengthZ = rawScaleValueRangeZ.GetLength();
+                // Remove the keys that can be interpolated, the first and last frames of a segment are always keys
+                if ( reduceKeyFrames && numSegmentFrames > 2 )
+                {
+                    for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+                    {
+                        uint32 const minRate = format.m_rates[channelIdx];
+                        if ( minRate == s_staticRate )
+                        {
+                            continue;
+                        }
+
+                        uint32 bestRate = minRate;
+                        uint32 bestKeyMask = allKeysMask;
+                        bool bestUseSpline = false;
+                        uint32 bestNumBits = numSegmentFrames * 3 * s_numBitsPerRate[minRate];
+
+                        uint32 const maxRate = Math::Min( minRate + s_maxKeyReductionRateIncrease, s_highestRate );
+                        for ( uint32 rate = minRate; rate <= maxRate; rate++ )
+                        {
+                            for ( bool useSpline : { false, true } )
+                            {
+                                format.m_rates[channelIdx] = rate;
+                                format.m_useSplines[channelIdx] = useSpline;
+                                format.m_keyMasks[channelIdx] = allKeysMask;
+
+                                for ( uint32 i = 1; i < numSegmentFrames - 1; i++ )
+                                {
+                                    format.m_keyMasks[channelIdx] &= ~( 1u << i );
+                                    if ( EncodeAndCalculateError() > errorThreshold )
+                                    {
+                                        format.m_keyMasks[channelIdx] |= ( 1u << i );
+                                    }
+                                }
+
+                                // The key mask is only stored if keys were removed
+                                uint32 const keyMaskNumBits = ( format.m_keyMasks[channelIdx] != allKeysMask ) ? numSegmentFrames : 0;
+                                uint32 const numBits = keyMaskNumBits + CountSetBits( format.m_keyMasks[channelIdx] ) * 3 * s_numBitsPerRate[rate];
+                                if ( numBits < bestNumBits )
+                                {
+                                    bestRate = rate;
+                                    bestKeyMask = format.m_keyMasks[channelIdx];
+                                    bestUseSpline = useSpline;
+                                    bestNumBits = numBits;
+                                }
+                            }
+                        }
+
+                        format.m_rates[channelIdx] = bestRate;
+                        format.m_keyMasks[channelIdx] = bestKeyMask;
+                        format.m_useSplines[channelIdx] = bestUseSpline;
+                    }
+                }
 
-            // We could arguably compress more by saving each component individually at the cost of sampling performance. If we absolutely need more compression, we can do it here
-            bool const isScaleConstant = Math::IsNearZero( rawScaleValueRangeLengthX ) && Math::IsNearZero( rawScaleValueRangeLengthY ) && Math::IsNearZero( rawScaleValueRangeLengthZ );
-            if ( isScaleConstant )
-            {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[0];
-                Vector const& scale = rawBoneTransform.GetScale();
+                for ( int32 channelIdx = 0; channelIdx < NumChannels; channelIdx++ )
+                {
+                    if ( format.m_rates[channelIdx] != s_staticRate )
+                    {
+                        rateHistogram[format.m_rates[channelIdx]]++;
+                        numAnimatedChannelFrames += numSegmentFrames;
+                        numAnimatedChannelKeys += CountSetBits( format.m_keyMasks[channelIdx] );
+                    }
+                }
 
-                trackSettings.m_scaleRangeX = { scale.m_x, defaultQuantizationRangeLength };
-                trackSettings.m_scaleRangeY = { scale.m_y, defaultQuantizationRangeLength };
-                trackSettings.m_scaleRangeZ = { scale.m_z, defaultQuantizationRangeLength };
-                trackSettings.m_isScaleStatic = true;
+                // Encode the final format and write the track's block
+                maxError = Math::Max( maxError, EncodeAndCalculateError() );
+                animClip.m_trackSegmentOffsets.emplace_back( clipWriter.GetNumBits() );
+                clipWriter.Append( trackWriter );
             }
-            else
-            {
-                trackSettings.m_scaleRangeX = { rawScaleValueRangeX.m_start, Math::IsNearZero( rawScaleValueRangeLengthX ) ? defaultQuantizationRangeLength : rawScaleValueRangeLengthX };
-                trackSettings.m_scaleRangeY = { rawScaleValueRangeY.m_start, Math::IsNearZero( rawScaleValueRangeLengthY ) ? defaultQuantizationRangeLength : rawScaleValueRangeLengthY };
-                trackSettings.m_scaleRangeZ = { rawScaleValueRangeZ.m_start, Math::IsNearZero( rawScaleValueRangeLengthZ ) ? defaultQuantizationRangeLength : rawScaleValueRangeLengthZ };
-            }
-
-            //-------------------------------------------------------------------------
+        }
 
-            if ( trackSettings.IsScaleTrackStatic() )
-            {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[0];
-                Vector const& scale = rawBoneTransform.GetScale();
+        animClip.m_compressedPoseData = clipWriter.GetData();
 
-                uint16 const m_x = Quantization::EncodeFloat( scale.m_x, trackSettings.m_scaleRangeX.m_rangeStart, trackSettings.m_scaleRangeX.m_rangeLength );
-                uint16 const m_y = Quantization::EncodeFloat( scale.m_y, trackSettings.m_scaleRangeY.m_rangeStart, trackSettings.m_scaleRangeY.m_rangeLength );
-                uint16 const m_z = Quantization::EncodeFloat( scale.m_z, trackSettings.m_scaleRangeZ.m_rangeStart, trackSettings.m_scaleRangeZ.m_rangeLength );
+        // Report
+        //-------------------------------------------------------------------------
 
-                animClip.m_compressedPoseData.push_back( m_x );
-                animClip.m_compressedPoseData.push_back( m_y );
-                animClip.m_compressedPoseData.push_back( m_z );
-            }
-            else // Store all frames
-            {
-                for ( uint32 frameIdx = 0; frameIdx < animClip.m_numFrames; frameIdx++ )
-                {
-                    Transform const& rawBoneTransform = rawTrackData[boneIdx].m_transforms[frameIdx];
-                    Vector const& scale = rawBoneTransform.GetScale();
+        // The size of the previous fixed rate format: 48 bits per rotation, translation and scale sample with static translation and scale stored once
+        size_t fixedRateDataSize = 0;
+        for ( auto const& trackSettings : animClip.m_trackCompressionSettings )
+        {
+            fixedRateDataSize += numFrames * 6;
+            fixedRateDataSize += trackSettings.IsTranslationTrackStatic() ? 6 : numFrames * 6;
+            fixedRateDataSize += trackSettings.IsScaleTrackStatic() ? 6 : numFrames * 6;
+        }
 
-                    uint16 const m_x = Quantization::EncodeFloat( scale.m_x, trackSettings.m_scaleRangeX.m_rangeStart, trackSettings.m_scaleRangeX.m_rangeLength );
-                    uint16 const m_y = Quantization::EncodeFloat( scale.m_y, trackSettings.m_scaleRangeY.m_rangeStart, trackSettings.m_scaleRangeY.m_rangeLength );
-                    uint16 const m_z = Quantization::EncodeFloat( scale.m_z, trackSettings.m_scaleRangeZ.m_rangeStart, trackSettings.m_scaleRangeZ.m_rangeLength );
+        size_t const compressedDataSize = ( animClip.m_compressedPoseData.size() + animClip.m_trackSegmentOffsets.size() ) * sizeof( uint32 );
 
-                    animClip.m_compressedPoseData.push_back( m_x );
-                    animClip.m_compressedPoseData.push_back( m_y );
-                    animClip.m_compressedPoseData.push_back( m_z );
-                }
-            }
+        uint32 numAnimatedChannels = 0;
+        uint32 totalBits = 0;
+        for ( uint32 rate = s_lowestRate; rate < s_numRates; rate++ )
+        {
+            numAnimatedChannels += rateHistogram[rate];
+            totalBits += rateHistogram[rate] * s_numBitsPerRate[rate];
+        }
 
-            //-------------------------------------------------------------------------
+        float const averageBitsPerComponent = ( numAnimatedChannels > 0 ) ? float( totalBits ) / numAnimatedChannels : 0.0f;
+        float const keptKeysPercentage = ( numAnimatedChannelFrames > 0 ) ? 100.0f * numAnimatedChannelKeys / numAnimatedChannelFrames : 100.0f;
+        Message( "Compressed %u frames (%u segments): %llu bytes (fixed rate: %llu bytes, %.2fx smaller), average bits per component: %.2f, keys kept: %.1f%%, max error: %.6fm (threshold: %.6fm)", numFrames, numSegments, (uint64) compressedDataSize, (uint64) fixedRateDataSize, float( fixedRateDataSize ) / compressedDataSize, averageBitsPerComponent, keptKeysPercentage, maxError, errorThreshold );
 
-            animClip.m_trackCompressionSettings.emplace_back( trackSettings );
+        if ( maxError > errorThreshold )
+        {
+            Warning( "Compression error (%.6fm) exceeds the error threshold (%.6fm), even at the highest rate", maxError, errorThreshold );
         }
     }
 
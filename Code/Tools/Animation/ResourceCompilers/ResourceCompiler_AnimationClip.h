@@ -19,7 +19,7 @@ namespace KRG::Animation
 
     class AnimationClipCompiler : public Resource::Compiler
     {
-        static const int32 s_version = 21;
+        static const int32 s_version = 24;
 
         struct AnimationEventData
         {
@@ -35,7 +35,7 @@ namespace KRG::Animation
 
         virtual Resource::CompilationResult Compile( Resource::CompileContext const& ctx ) const final;
 
-        void TransferAndCompressAnimationData( RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip ) const;
+        void TransferAndCompressAnimationData( RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip, float errorThreshold, bool reduceKeyFrames ) const;
 
         bool ReadEventsData( Resource::CompileContext const& ctx, rapidjson::Document const& document, RawAssets::RawAnimation const& rawAnimData, AnimationEventData& outEventData ) const;
     };
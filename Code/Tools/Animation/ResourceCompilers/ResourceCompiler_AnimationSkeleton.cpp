@@ -14,6 +14,7 @@ namespace KRG::Animation
         : Resource::Compiler( "SkeletonCompiler", s_version )
     {
         m_outputTypes.push_back( Skeleton::GetStaticResourceTypeID() );
+        m_compressedOutputTypes.push_back( Skeleton::GetStaticResourceTypeID() );
     }
 
     Resource::CompilationResult SkeletonCompiler::Compile( Resource::CompileContext const& ctx ) const
@@ -21,5 +21,11 @@ namespace KRG::Animation
         KRG_EXPOSE ResourcePath                m_animationPath;
         KRG_EXPOSE TResourcePtr<Skeleton>      m_pSkeleton = nullptr;
         KRG_EXPOSE String                      m_animationName; // Optional: if not set, will use the first animation in the file
+
+        // The maximum allowed compression error (in meters), measured in object space at virtual vertices around each bone
+        KRG_EXPOSE float                       m_compressionErrorThreshold = 0.0001f;
+
+        // Remove the key-frames that can be interpolated within the error threshold, this is slower to compile and mostly useful for long clips
+        KRG_EXPOSE bool                        m_reduceKeyFrames = false;
     };
 }
\ No newline at end of file
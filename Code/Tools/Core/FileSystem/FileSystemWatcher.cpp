@@ -1,17 +1,22 @@
 #include "FileSystemWatcher.h"
 #include "System/Core/FileSystem/FileSystem.h"
 #include "System/Core/Logging/Log.h"
+#if _WIN32
 #include "System/Core/Platform/PlatformHelpers_Win32.h"
+#endif
 
 //-------------------------------------------------------------------------
 
-#if _WIN32
 namespace KRG::FileSystem
 {
     FileSystemWatcher::~FileSystemWatcher()
     {
         KRG_ASSERT( m_changeListeners.empty() );
-        StopWatching();
+
+        if ( IsWatching() )
+        {
+            StopWatching();
+        }
     }
 
     void FileSystemWatcher::RegisterChangeListener( IFileSystemChangeListener* pListener )
@@ -26,6 +31,122 @@ namespace KRG::FileSystem
         m_changeListeners.erase_first_unsorted( pListener );
     }
 
+    //-------------------------------------------------------------------------
+
+    void FileSystemWatcher::NotifyCreated( Path const& path )
+    {
+        if ( path.IsDirectory() )
+        {
+            for ( auto pChangeHandler : m_changeListeners )
+            {
+                pChangeHandler->OnDirectoryCreated( path );
+            }
+        }
+        else
+        {
+            for ( auto pChangeHandler : m_changeListeners )
+            {
+                pChangeHandler->OnFileCreated( path );
+            }
+        }
+    }
+
+    void FileSystemWatcher::NotifyDeleted( Path const& path )
+    {
+        if ( path.IsDirectory() )
+        {
+            for ( auto pChangeHandler : m_changeListeners )
+            {
+                pChangeHandler->OnDirectoryDeleted( path );
+            }
+        }
+        else
+        {
+            // No point in notifying about modifications to a deleted file
+            RemovePendingModificationEvent( path );
+
+            for ( auto pChangeHandler : m_changeListeners )
+            {
+                pChangeHandler->OnFileDeleted( path );
+            }
+        }
+    }
+
+    void FileSystemWatcher::NotifyRenamed( Path const& oldPath, Path const& newPath )
+    {
+        if ( newPath.IsDirectory() )
+        {
+            for ( auto pChangeHandler : m_changeListeners )
+            {
+                pChangeHandler->OnDirectoryRenamed( oldPath, newPath );
+            }
+        }
+        else
+        {
+            for ( auto pChangeHandler : m_changeListeners )
+            {
+                pChangeHandler->OnFileRenamed( oldPath, newPath );
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void FileSystemWatcher::AddPendingModificationEvent( Path const& path )
+    {
+        KRG_ASSERT( path.IsFile() );
+
+        // Each new modification restarts the timeout so that bursts of writes only generate a single notification
+        for ( auto& pendingEvent : m_pendingFileModificationEvents )
+        {
+            if ( pendingEvent.m_path == path )
+            {
+                pendingEvent.m_lastModificationTime = PlatformClock::GetTimeInMilliseconds();
+                return;
+            }
+        }
+
+        m_pendingFileModificationEvents.emplace_back( FileModificationEvent( path ) );
+    }
+
+    void FileSystemWatcher::RemovePendingModificationEvent( Path const& path )
+    {
+        for ( int32 i = (int32) m_pendingFileModificationEvents.size() - 1; i >= 0; i-- )
+        {
+            if ( m_pendingFileModificationEvents[i].m_path == path )
+            {
+                m_pendingFileModificationEvents.erase_unsorted( m_pendingFileModificationEvents.begin() + i );
+            }
+        }
+    }
+
+    void FileSystemWatcher::ProcessPendingModificationEvents()
+    {
+        for ( int32 i = (int32) m_pendingFileModificationEvents.size() - 1; i >= 0; i-- )
+        {
+            auto& pendingEvent = m_pendingFileModificationEvents[i];
+
+            Milliseconds const elapsedTime = PlatformClock::GetTimeInMilliseconds() - pendingEvent.m_lastModificationTime;
+            if ( elapsedTime > FileModificationBatchTimeout )
+            {
+                for ( auto pChangeHandler : m_changeListeners )
+                {
+                    pChangeHandler->OnFileModified( pendingEvent.m_path );
+                }
+
+                m_pendingFileModificationEvents.erase_unsorted( m_pendingFileModificationEvents.begin() + i );
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+// Win32
+//-------------------------------------------------------------------------
+
+#if _WIN32
+namespace KRG::FileSystem
+{
     bool FileSystemWatcher::StartWatching( Path const& directoryToWatch )
     {
         KRG_ASSERT( !IsWatching() );
@@ -180,42 +301,14 @@ namespace KRG::FileSystem
                 case FILE_ACTION_ADDED:
                 {
                     path = GetFileSystemPath( m_directoryToWatch, pNotify );
-
-                    if ( path.IsDirectory() )
-                    {
-                        for ( auto pChangeHandler : m_changeListeners )
-                        {
-                            pChangeHandler->OnDirectoryCreated( path );
-                        }
-                    }
-                    else
-                    {
-                        for ( auto pChangeHandler : m_changeListeners )
-                        {
-                            pChangeHandler->OnFileCreated( path );
-                        }
-                    }
+                    NotifyCreated( path );
                 }
                 break;
 
                 case FILE_ACTION_REMOVED:
                 {
                     path = GetFileSystemPath( m_directoryToWatch, pNotify );
-
-                    if ( path.IsDirectory() )
-                    {
-                        for ( auto pChangeHandler : m_changeListeners )
-                        {
-                            pChangeHandler->OnDirectoryDeleted( path );
-                        }
-                    }
-                    else
-                    {
-                        for ( auto pChangeHandler : m_changeListeners )
-                        {
-                            pChangeHandler->OnFileDeleted( path );
-                        }
-                    }
+                    NotifyDeleted( path );
                 }
                 break;
 
@@ -225,15 +318,7 @@ namespace KRG::FileSystem
 
                     if ( path.IsFile() )
                     {
-                        auto predicate = [] ( FileModificationEvent const& event, Path const& path )
-                        {
-                            return event.m_path == path;
-                        };
-
-                        if ( !VectorContains( m_pendingFileModificationEvents, path, predicate ) )
-                        {
-                            m_pendingFileModificationEvents.emplace_back( FileModificationEvent( path ) );
-                        }
+                        AddPendingModificationEvent( path );
                     }
                 }
                 break;
@@ -251,22 +336,7 @@ namespace KRG::FileSystem
 
                     secondPath = GetFileSystemPath( m_directoryToWatch, pNotify );
 
-                    //-------------------------------------------------------------------------
-
-                    if ( secondPath.IsDirectory() )
-                    {
-                        for ( auto pChangeHandler : m_changeListeners )
-                        {
-                            pChangeHandler->OnDirectoryRenamed( path, secondPath );
-                        }
-                    }
-                    else
-                    {
-                        for ( auto pChangeHandler : m_changeListeners )
-                        {
-                            pChangeHandler->OnFileRenamed( path, secondPath );
-                        }
-                    }
+                    NotifyRenamed( path, secondPath );
                 }
                 break;
             }
@@ -278,24 +348,5 @@ namespace KRG::FileSystem
         // Clear the result buffer
         Memory::MemsetZero( m_resultBuffer, ResultBufferSize );
     }
-
-    void FileSystemWatcher::ProcessPendingModificationEvents()
-    {
-        for ( int32 i = (int32) m_pendingFileModificationEvents.size() - 1; i >= 0; i-- )
-        {
-            auto& pendingEvent = m_pendingFileModificationEvents[i];
-
-            Milliseconds const elapsedTime = PlatformClock::GetTimeInMilliseconds() - pendingEvent.m_startTime;
-            if ( elapsedTime > FileModificationBatchTimeout )
-            {
-                for ( auto pChangeHandler : m_changeListeners )
-                {
-                    pChangeHandler->OnFileModified( pendingEvent.m_path );
-                }
-
-                m_pendingFileModificationEvents.erase_unsorted( m_pendingFileModificationEvents.begin() + i );
-            }
-        }
-    }
 }
 #endif
\ No newline at end of file
@@ -3,15 +3,19 @@
 #include "Tools/Core/_Module/API.h"
 #include "System/Core/FileSystem/FileSystemPath.h"
 #include "System/Core/Time/Time.h"
+#include "System/Core/Types/Containers.h"
 
 //-------------------------------------------------------------------------
-// Basic Win32 File System Watcher
+// Basic File System Watcher
 //-------------------------------------------------------------------------
 // Implementation will try to batch file modification notification to prevent sending multiple events for the same operation
-// The OS level function (ReadDirectoryChangesW) will trigger a modification event for multiple operations that are part of a logical operation
+// The OS level functions (ReadDirectoryChangesW/inotify) will trigger a modification event for multiple operations that are part of a logical operation
+// Modification events are debounced per file, listeners are only notified once a file hasnt been modified for the batch timeout
+//
+// Win32: ReadDirectoryChangesExW on the root directory
+// Linux: inotify, with a watch per directory that is added/removed incrementally as directories are created/deleted/moved
 //-------------------------------------------------------------------------
 
-#if _WIN32
 namespace KRG::FileSystem
 {
     class KRG_TOOLS_CORE_API IFileSystemChangeListener
@@ -34,16 +38,25 @@ namespace KRG::FileSystem
     class KRG_TOOLS_CORE_API FileSystemWatcher final
     {
         static constexpr uint32 const ResultBufferSize = 16384;
-        static constexpr float const FileModificationBatchTimeout = 250; // How long to wait between the start of the first modification event and notifying the event listeners
+        static constexpr float const FileModificationBatchTimeout = 250; // How long a file needs to remain unmodified before we notify the event listeners
 
         struct FileModificationEvent
         {
             FileModificationEvent( FileSystem::Path const& path ) : m_path( path ) { KRG_ASSERT( path.IsValid() && path.IsFile() ); }
 
             FileSystem::Path                            m_path;
-            Milliseconds                                m_startTime = PlatformClock::GetTimeInMilliseconds();
+            Milliseconds                                m_lastModificationTime = PlatformClock::GetTimeInMilliseconds();
         };
 
+        #if !_WIN32
+        // inotify reports renames as a pair of moved from/to events linked by a cookie
+        struct PendingMoveEvent
+        {
+            FileSystem::Path                            m_path;
+            uint32                                      m_cookie = 0;
+        };
+        #endif
+
     public:
 
         ~FileSystemWatcher();
@@ -52,7 +65,11 @@ namespace KRG::FileSystem
         void UnregisterChangeListener( IFileSystemChangeListener* pListener );
 
         bool StartWatching( FileSystem::Path const& directoryToWatch );
+        #if _WIN32
         bool IsWatching() const { return m_pDirectoryHandle != nullptr; }
+        #else
+        bool IsWatching() const { return m_inotifyFileDescriptor >= 0; }
+        #endif
         void StopWatching();
 
         // Returns true if any filesystem changes detected!
@@ -61,24 +78,47 @@ namespace KRG::FileSystem
     private:
 
         void ProcessResults();
+
+        // Add or refresh the pending modification event for a file
+        void AddPendingModificationEvent( FileSystem::Path const& path );
+        void RemovePendingModificationEvent( FileSystem::Path const& path );
         void ProcessPendingModificationEvents();
 
+        // Listener notification helpers
+        void NotifyCreated( FileSystem::Path const& path );
+        void NotifyDeleted( FileSystem::Path const& path );
+        void NotifyRenamed( FileSystem::Path const& oldPath, FileSystem::Path const& newPath );
+
+        #if !_WIN32
+        void AddWatchRecursive( FileSystem::Path const& directoryPath );
+        void UpdateWatchedDirectoryPaths( FileSystem::Path const& oldPath, FileSystem::Path const& newPath );
+        void ProcessUnmatchedMoveEvents();
+        #endif
+
     private:
 
         FileSystem::Path                                m_directoryToWatch;
-        void*                                           m_pDirectoryHandle = nullptr;
 
         // Listeners
         TInlineVector<IFileSystemChangeListener*, 5>    m_changeListeners;
 
+        #if _WIN32
+        void*                                           m_pDirectoryHandle = nullptr;
+
         // Request Data
         OVERLAPPED                                      m_overlappedEvent = { 0 };
         Byte                                            m_resultBuffer[ResultBufferSize] = { 0 };
         DWORD                                           m_numBytesReturned = 0;
         bool                                            m_requestPending = false;
+        #else
+        int32                                           m_inotifyFileDescriptor = -1;
+        THashMap<int32, FileSystem::Path>               m_watchedDirectories;   // Watch descriptor -> directory path
+        alignas( 8 ) Byte                               m_resultBuffer[ResultBufferSize] = { 0 };
+        uint32                                          m_numBytesReturned = 0;
+        TVector<PendingMoveEvent>                       m_pendingMoveEvents;
+        #endif
 
         // File Modification buffers
         TVector<FileModificationEvent>                  m_pendingFileModificationEvents;
     };
-}
-#endif
\ No newline at end of file
+}
\ No newline at end of file
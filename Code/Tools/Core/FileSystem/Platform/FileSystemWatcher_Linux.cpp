@@ -0,0 +1,295 @@
+#if __linux__
+#include "../FileSystemWatcher.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/Logging/Log.h"
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------
+
+namespace KRG::FileSystem
+{
+    static uint32 const g_watchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+    //-------------------------------------------------------------------------
+
+    bool FileSystemWatcher::StartWatching( Path const& directoryToWatch )
+    {
+        KRG_ASSERT( !IsWatching() );
+        KRG_ASSERT( directoryToWatch.IsValid() && directoryToWatch.IsDirectory() );
+
+        m_inotifyFileDescriptor = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+        if ( m_inotifyFileDescriptor < 0 )
+        {
+            KRG_LOG_ERROR( "FileSystem", "Failed to create inotify instance: %s", strerror( errno ) );
+            return false;
+        }
+
+        m_directoryToWatch = directoryToWatch;
+        AddWatchRecursive( m_directoryToWatch );
+
+        if ( m_watchedDirectories.empty() )
+        {
+            KRG_LOG_ERROR( "FileSystem", "Failed to watch directory (%s)", m_directoryToWatch.c_str() );
+            StopWatching();
+            return false;
+        }
+
+        return true;
+    }
+
+    void FileSystemWatcher::StopWatching()
+    {
+        // Send all pending notifications
+        for ( auto& event : m_pendingFileModificationEvents )
+        {
+            for ( auto pChangeHandler : m_changeListeners )
+            {
+                pChangeHandler->OnFileModified( event.m_path );
+            }
+        }
+
+        m_pendingFileModificationEvents.clear();
+        m_pendingMoveEvents.clear();
+
+        //-------------------------------------------------------------------------
+
+        // Closing the inotify instance releases all its watches
+        if ( m_inotifyFileDescriptor >= 0 )
+        {
+            close( m_inotifyFileDescriptor );
+        }
+
+        m_watchedDirectories.clear();
+        m_directoryToWatch = Path();
+        m_inotifyFileDescriptor = -1;
+    }
+
+    bool FileSystemWatcher::Update()
+    {
+        KRG_ASSERT( IsWatching() );
+
+        bool changeDetected = false;
+
+        // Drain all queued events
+        while ( true )
+        {
+            ssize_t const numBytesRead = read( m_inotifyFileDescriptor, m_resultBuffer, ResultBufferSize );
+            if ( numBytesRead < 0 )
+            {
+                if ( errno == EINTR )
+                {
+                    continue;
+                }
+
+                if ( errno != EAGAIN )
+                {
+                    KRG_LOG_FATAL_ERROR( "FileSystem", "FileSystemWatcher failed to read inotify events: %s", strerror( errno ) );
+                }
+
+                break;
+            }
+
+            if ( numBytesRead == 0 )
+            {
+                break;
+            }
+
+            m_numBytesReturned = (uint32) numBytesRead;
+            ProcessResults();
+            changeDetected = true;
+        }
+
+        // Any moves that didnt get a matching destination moved out of the watched tree
+        ProcessUnmatchedMoveEvents();
+
+        //-------------------------------------------------------------------------
+
+        ProcessPendingModificationEvents();
+        return changeDetected;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void FileSystemWatcher::AddWatchRecursive( Path const& directoryPath )
+    {
+        KRG_ASSERT( directoryPath.IsDirectory() );
+
+        int32 const watchDescriptor = inotify_add_watch( m_inotifyFileDescriptor, directoryPath.c_str(), g_watchMask );
+        if ( watchDescriptor < 0 )
+        {
+            KRG_LOG_WARNING( "FileSystem", "Failed to add inotify watch for directory (%s): %s", directoryPath.c_str(), strerror( errno ) );
+            return;
+        }
+
+        m_watchedDirectories[watchDescriptor] = directoryPath;
+
+        //-------------------------------------------------------------------------
+
+        TVector<Path> subdirectories;
+        GetDirectoryContents( directoryPath, subdirectories, DirectoryReaderOutput::OnlyDirectories, DirectoryReaderMode::DontExpand );
+        for ( auto& subdirectoryPath : subdirectories )
+        {
+            subdirectoryPath.MakeDirectory();
+            AddWatchRecursive( subdirectoryPath );
+        }
+    }
+
+    void FileSystemWatcher::UpdateWatchedDirectoryPaths( Path const& oldPath, Path const& newPath )
+    {
+        KRG_ASSERT( oldPath.IsDirectory() && newPath.IsDirectory() );
+
+        // Watches follow the directory inode so we only need to update our path mapping for the moved subtree
+        String const& oldPathString = oldPath.GetFullPath();
+        for ( auto& watchedDirectory : m_watchedDirectories )
+        {
+            String const& watchedPathString = watchedDirectory.second.GetFullPath();
+            if ( watchedPathString.compare( 0, oldPathString.length(), oldPathString ) == 0 )
+            {
+                String updatedPathString = newPath.GetFullPath();
+                updatedPathString.append( watchedPathString.c_str() + oldPathString.length() );
+                watchedDirectory.second = Path( updatedPathString );
+            }
+        }
+    }
+
+    void FileSystemWatcher::ProcessUnmatchedMoveEvents()
+    {
+        for ( auto const& moveEvent : m_pendingMoveEvents )
+        {
+            // inotify keeps watching directories that are moved out of the tree so we need to explicitly remove their watches
+            if ( moveEvent.m_path.IsDirectory() )
+            {
+                String const& movedPathString = moveEvent.m_path.GetFullPath();
+                for ( auto iter = m_watchedDirectories.begin(); iter != m_watchedDirectories.end(); )
+                {
+                    if ( iter->second.GetFullPath().compare( 0, movedPathString.length(), movedPathString ) == 0 )
+                    {
+                        inotify_rm_watch( m_inotifyFileDescriptor, iter->first );
+                        iter = m_watchedDirectories.erase( iter );
+                    }
+                    else
+                    {
+                        ++iter;
+                    }
+                }
+            }
+
+            NotifyDeleted( moveEvent.m_path );
+        }
+
+        m_pendingMoveEvents.clear();
+    }
+
+    void FileSystemWatcher::ProcessResults()
+    {
+        size_t offset = 0;
+        while ( offset < m_numBytesReturned )
+        {
+            auto pEvent = reinterpret_cast<inotify_event const*>( m_resultBuffer + offset );
+            offset += sizeof( inotify_event ) + pEvent->len;
+
+            // Queue overflowed, events have been lost
+            //-------------------------------------------------------------------------
+
+            if ( pEvent->mask & IN_Q_OVERFLOW )
+            {
+                KRG_LOG_WARNING( "FileSystem", "FileSystemWatcher event queue overflowed, some file system changes were missed" );
+                continue;
+            }
+
+            // Watch was removed (directory deleted or moved out of the tree)
+            //-------------------------------------------------------------------------
+
+            if ( pEvent->mask & IN_IGNORED )
+            {
+                m_watchedDirectories.erase( pEvent->wd );
+                continue;
+            }
+
+            auto watchIter = m_watchedDirectories.find( pEvent->wd );
+            if ( watchIter == m_watchedDirectories.end() || pEvent->len == 0 )
+            {
+                continue;
+            }
+
+            // Build the path for the event
+            //-------------------------------------------------------------------------
+
+            bool const isDirectory = ( pEvent->mask & IN_ISDIR ) != 0;
+
+            Path path = watchIter->second;
+            path.Append( pEvent->name );
+            if ( isDirectory )
+            {
+                path.MakeDirectory();
+            }
+
+            //-------------------------------------------------------------------------
+
+            if ( pEvent->mask & IN_CREATE )
+            {
+                // Watch the new directory before notifying, so that listeners that scan its contents dont miss any events
+                if ( isDirectory )
+                {
+                    AddWatchRecursive( path );
+                }
+
+                NotifyCreated( path );
+            }
+            else if ( pEvent->mask & IN_DELETE )
+            {
+                NotifyDeleted( path );
+            }
+            else if ( pEvent->mask & ( IN_MODIFY | IN_CLOSE_WRITE ) )
+            {
+                if ( !isDirectory )
+                {
+                    AddPendingModificationEvent( path );
+                }
+            }
+            else if ( pEvent->mask & IN_MOVED_FROM )
+            {
+                m_pendingMoveEvents.push_back( { path, pEvent->cookie } );
+            }
+            else if ( pEvent->mask & IN_MOVED_TO )
+            {
+                auto predicate = [pEvent] ( PendingMoveEvent const& moveEvent ) { return moveEvent.m_cookie == pEvent->cookie; };
+                auto moveIter = eastl::find_if( m_pendingMoveEvents.begin(), m_pendingMoveEvents.end(), predicate );
+
+                // Renamed within the watched tree
+                if ( moveIter != m_pendingMoveEvents.end() )
+                {
+                    Path const oldPath = moveIter->m_path;
+                    m_pendingMoveEvents.erase( moveIter );
+
+                    if ( isDirectory )
+                    {
+                        UpdateWatchedDirectoryPaths( oldPath, path );
+                    }
+                    else
+                    {
+                        RemovePendingModificationEvent( oldPath );
+                    }
+
+                    NotifyRenamed( oldPath, path );
+                }
+                else // Moved into the watched tree
+                {
+                    if ( isDirectory )
+                    {
+                        AddWatchRecursive( path );
+                    }
+
+                    NotifyCreated( path );
+                }
+            }
+        }
+
+        // Clear the result buffer
+        Memory::MemsetZero( m_resultBuffer, ResultBufferSize );
+    }
+}
+#endif
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "ResourceCompiler.h"
+#include "System/Resource/ResourceCompression.h"
 #include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/FileSystem/FileStreams.h"
 
 //-------------------------------------------------------------------------
 
@@ -73,4 +75,36 @@ namespace KRG::Resource
     {
         return Error( "Failed to compile resource: '%s'", (char const*) ctx.m_outputFilePath );
     }
+
+    //-------------------------------------------------------------------------
+
+    bool Compiler::CompressOutput( CompileContext const& ctx ) const
+    {
+        TVector<Byte> uncompressedData;
+        if ( !FileSystem::LoadFile( ctx.m_outputFilePath, uncompressedData ) )
+        {
+            Error( "Failed to read compiled resource for compression: '%s'", (char const*) ctx.m_outputFilePath );
+            return false;
+        }
+
+        TVector<Byte> compressedData;
+        if ( !ResourceCompression::Compress( uncompressedData, compressedData ) )
+        {
+            Message( "Compiled resource is not compressible, storing uncompressed" );
+            return true;
+        }
+
+        FileSystem::OutputFileStream outputFile( ctx.m_outputFilePath );
+        if ( !outputFile.IsValid() )
+        {
+            Error( "Failed to write compressed resource: '%s'", (char const*) ctx.m_outputFilePath );
+            return false;
+        }
+
+        outputFile.Write( compressedData.data(), compressedData.size() );
+        outputFile.Close();
+
+        Message( "Compressed resource: %.2fKB -> %.2fKB (ratio: %.2f)", uncompressedData.size() / 1024.0f, compressedData.size() / 1024.0f, float( uncompressedData.size() ) / compressedData.size() );
+        return true;
+    }
 }
\ No newline at end of file
@@ -8,6 +8,10 @@
 
 //-------------------------------------------------------------------------
 
+namespace KRG { class TaskSystem; }
+
+//-------------------------------------------------------------------------
+
 namespace KRG::Resource
 {
     enum class CompilationResult
@@ -17,6 +21,16 @@ namespace KRG::Resource
         SuccessWithWarnings = 1,
     };
 
+    // Persistent compiler workers
+    //-------------------------------------------------------------------------
+    // Compiler processes started with '-worker' stay alive and compile one resource per line (the resource path) received on stdin
+    // The compilation output is written to stdout, followed by a line containing the result prefix and the integer compilation result
+
+    namespace CompilerWorker
+    {
+        constexpr static char const* const s_resultPrefix = "#KRG_COMPILER_WORKER_RESULT:";
+    }
+
     //-------------------------------------------------------------------------
 
     struct KRG_TOOLS_CORE_API CompileContext
@@ -55,6 +69,9 @@ namespace KRG::Resource
         ResourceID const                                m_resourceID;
         FileSystem::Path const                          m_inputFilePath;
         FileSystem::Path const                          m_outputFilePath;
+
+        // Optional, compilers can use this to parallelize expensive work (the task system is shared by all compilations in the process)
+        TaskSystem*                                     m_pTaskSystem = nullptr;
     };
 
     //-------------------------------------------------------------------------
@@ -77,6 +94,12 @@ namespace KRG::Resource
         // The list of virtual resources we produce as part of the compilation process
         virtual TVector<ResourceTypeID> const& GetVirtualTypes() const { return m_virtualTypes; }
 
+        // Compression policy - should the compiled output for this resource type be compressed
+        inline bool ShouldCompressOutput( ResourceTypeID resourceTypeID ) const { return VectorContains( m_compressedOutputTypes, resourceTypeID ); }
+
+        // Compresses the compiled output file in place, uncompressible files are left as is
+        bool CompressOutput( CompileContext const& ctx ) const;
+
     protected:
 
         Compiler& operator=( Compiler const& ) = delete;
@@ -95,5 +118,6 @@ namespace KRG::Resource
         String                                          m_name;
         TVector<ResourceTypeID>                         m_outputTypes;
         TVector<ResourceTypeID>                         m_virtualTypes;
+        TVector<ResourceTypeID>                         m_compressedOutputTypes;
     };
 }
\ No newline at end of file
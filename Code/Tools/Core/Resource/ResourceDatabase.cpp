@@ -1,6 +1,8 @@
 #include "ResourceDatabase.h"
 #include "System/Core/FileSystem/FileSystem.h"
 #include "System/TypeSystem/TypeRegistry.h"
+#include "System/Core/Time/Timers.h"
+#include "System/Core/Logging/Log.h"
 
 //-------------------------------------------------------------------------
 
@@ -60,7 +62,7 @@ namespace KRG::Resource
 
     //-------------------------------------------------------------------------
 
-    void ResourceDatabase::Initialize( TypeSystem::TypeRegistry const* pTypeRegistry, FileSystem::Path const& rawResourceDirPath, FileSystem::Path const& compiledResourceDirPath )
+    void ResourceDatabase::Initialize( TypeSystem::TypeRegistry const* pTypeRegistry, FileSystem::Path const& rawResourceDirPath, FileSystem::Path const& compiledResourceDirPath, TaskSystem* pTaskSystem )
     {
         KRG_ASSERT( m_pTypeRegistry == nullptr );
         KRG_ASSERT( pTypeRegistry != nullptr );
@@ -71,6 +73,7 @@ namespace KRG::Resource
         m_compiledResourceDirPath = compiledResourceDirPath;
         m_dataDirectoryPathDepth = m_rawResourceDirPath.GetDirectoryDepth();
         m_pTypeRegistry = pTypeRegistry;
+        m_pTaskSystem = pTaskSystem;
 
         //-------------------------------------------------------------------------
 
@@ -98,7 +101,9 @@ namespace KRG::Resource
         //-------------------------------------------------------------------------
 
         m_rawResourceDirPath.Clear();
+        m_directoryScanCache.Clear();
         m_pTypeRegistry = nullptr;
+        m_pTaskSystem = nullptr;
     }
 
     bool ResourceDatabase::Update()
@@ -128,7 +133,6 @@ namespace KRG::Resource
         }
     }
 
-    // TODO: Make this async!
     void ResourceDatabase::RebuildDatabase()
     {
         m_resourcesPerType.clear();
@@ -141,17 +145,33 @@ namespace KRG::Resource
 
         //-------------------------------------------------------------------------
 
-        TVector<FileSystem::Path> foundPaths;
-        if ( !FileSystem::GetDirectoryContents( m_rawResourceDirPath, foundPaths, FileSystem::DirectoryReaderOutput::OnlyFiles, FileSystem::DirectoryReaderMode::Expand ) )
+        // Directories that havent changed since the last scan are read from the cache
+        FileSystem::Path const scanCachePath = m_compiledResourceDirPath + s_directoryScanCacheFilename;
+        m_directoryScanCache.Load( scanCachePath );
+
+        TVector<FileSystem::ScannedFile> foundFiles;
+
+        Milliseconds scanTime = 0;
         {
-            KRG_HALT();
+            ScopedTimer<PlatformClock> timer( scanTime );
+            if ( !FileSystem::ScanDirectory( m_rawResourceDirPath, foundFiles, TVector<String>(), m_pTaskSystem, &m_directoryScanCache ) )
+            {
+                KRG_HALT();
+            }
+        }
+
+        KRG_LOG_MESSAGE( "Resource", "Scanned raw resource directory in %.2fms (%u directories read, %u unchanged)", (float) scanTime, m_directoryScanCache.GetNumDirectoriesScanned(), m_directoryScanCache.GetNumDirectoriesReused() );
+
+        if ( !m_directoryScanCache.Save( scanCachePath ) )
+        {
+            KRG_LOG_WARNING( "Resource", "Failed to save directory scan cache: %s", scanCachePath.c_str() );
         }
 
         //-------------------------------------------------------------------------
 
-        for ( auto const& filePath : foundPaths )
+        for ( auto const& scannedFile : foundFiles )
         {
-            AddFileRecord( filePath );
+            AddFileRecord( scannedFile.m_path );
         }
 
         //-------------------------------------------------------------------------
@@ -329,15 +349,15 @@ namespace KRG::Resource
 
     void ResourceDatabase::OnDirectoryCreated( FileSystem::Path const& newDirectoryPath )
     {
-        TVector<FileSystem::Path> foundPaths;
-        if ( !FileSystem::GetDirectoryContents( newDirectoryPath, foundPaths, FileSystem::DirectoryReaderOutput::OnlyFiles, FileSystem::DirectoryReaderMode::Expand ) )
+        TVector<FileSystem::ScannedFile> foundFiles;
+        if ( !FileSystem::ScanDirectory( newDirectoryPath, foundFiles, TVector<String>(), m_pTaskSystem ) )
         {
             KRG_HALT();
         }
 
-        for ( auto const& filePath : foundPaths )
+        for ( auto const& scannedFile : foundFiles )
         {
-            AddFileRecord( filePath );
+            AddFileRecord( scannedFile.m_path );
         }
     }
 
@@ -1,11 +1,13 @@
 #pragma once
 #include "Tools/Core/FileSystem/FileSystemWatcher.h"
+#include "System/Core/FileSystem/DirectoryScanner.h"
 #include "System/Resource/ResourceID.h"
 #include "System/Core/Types/StringID.h"
 #include "System/Core/Types/Event.h"
 
 //-------------------------------------------------------------------------
 
+namespace KRG { class TaskSystem; }
 namespace KRG::TypeSystem { class TypeRegistry; }
 
 //-------------------------------------------------------------------------
@@ -14,6 +16,8 @@ namespace KRG::Resource
 {
     class KRG_TOOLS_CORE_API ResourceDatabase : public FileSystem::IFileSystemChangeListener
     {
+        constexpr static char const* const s_directoryScanCacheFilename = "RawResourceScanCache.bin";
+
         struct ResourceEntry
         {
             ResourceID                                              m_resourceID;
@@ -41,7 +45,8 @@ namespace KRG::Resource
         ~ResourceDatabase();
 
         inline bool IsInitialized() const { return m_pTypeRegistry != nullptr; }
-        void Initialize( TypeSystem::TypeRegistry const* pTypeRegistry, FileSystem::Path const& rawResourceDirPath, FileSystem::Path const& compiledResourceDirPath );
+        // The task system is optional, if supplied the raw resource directory will be scanned in parallel
+        void Initialize( TypeSystem::TypeRegistry const* pTypeRegistry, FileSystem::Path const& rawResourceDirPath, FileSystem::Path const& compiledResourceDirPath, TaskSystem* pTaskSystem = nullptr );
         void Shutdown();
 
         inline FileSystem::Path const& GetRawResourceDirectoryPath() const { return m_rawResourceDirPath; }
@@ -88,10 +93,12 @@ namespace KRG::Resource
     private:
 
         TypeSystem::TypeRegistry const*                             m_pTypeRegistry;
+        TaskSystem*                                                 m_pTaskSystem = nullptr;
         FileSystem::Path                                            m_rawResourceDirPath;
         FileSystem::Path                                            m_compiledResourceDirPath;
         int32                                                       m_dataDirectoryPathDepth;
         FileSystem::FileSystemWatcher                               m_fileSystemWatcher;
+        FileSystem::DirectoryScanCache                              m_directoryScanCache;
 
         Directory                                                   m_rootDir;
         THashMap<ResourceTypeID, TVector<ResourceEntry*>>           m_resourcesPerType;
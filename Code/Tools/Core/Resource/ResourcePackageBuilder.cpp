@@ -0,0 +1,264 @@
+#include "ResourcePackageBuilder.h"
+#include "Compilers/ResourceCompilerRegistry.h"
+#include "System/Resource/ResourcePackage.h"
+#include "System/Resource/ResourceHeader.h"
+#include "System/Resource/ResourceCompression.h"
+#include "System/Core/FileSystem/DirectoryScanner.h"
+#include "System/Core/FileSystem/FileStreams.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/Serialization/BinaryArchive.h"
+#include "System/Core/Math/Math.h"
+#include "System/Core/Logging/Log.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Resource
+{
+    ResourcePackageBuilder::ResourcePackageBuilder( CompilerRegistry const& compilerRegistry, FileSystem::Path const& compiledResourceDirectoryPath )
+        : m_compilerRegistry( compilerRegistry )
+        , m_compiledResourceDirectoryPath( compiledResourceDirectoryPath )
+    {
+        KRG_ASSERT( m_compiledResourceDirectoryPath.IsDirectory() );
+    }
+
+    bool ResourcePackageBuilder::Build( FileSystem::Path const& packagePath )
+    {
+        KRG_ASSERT( packagePath.IsFile() );
+
+        m_resources.clear();
+        m_resourceIndices.clear();
+        m_placementOrder.clear();
+
+        if ( !CollectResources() )
+        {
+            return false;
+        }
+
+        SortByLocality();
+        return WritePackage( packagePath );
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool ResourcePackageBuilder::CollectResources()
+    {
+        TVector<FileSystem::ScannedFile> compiledFiles;
+        if ( !FileSystem::ScanDirectory( m_compiledResourceDirectoryPath, compiledFiles ) )
+        {
+            KRG_LOG_ERROR( "ResourcePackageBuilder", "Failed to scan compiled resource directory: %s", m_compiledResourceDirectoryPath.c_str() );
+            return false;
+        }
+
+        TVector<Byte> fileData;
+        TVector<Byte> decompressedData;
+        for ( auto const& compiledFile : compiledFiles )
+        {
+            // Only package files that were produced by a resource compiler
+            ResourceID const resourceID = ResourceID::FromFileSystemPath( m_compiledResourceDirectoryPath, compiledFile.m_path );
+            if ( !resourceID.IsValid() || !m_compilerRegistry.HasCompilerForResourceType( resourceID.GetResourceTypeID() ) )
+            {
+                continue;
+            }
+
+            // The package index only stores the path hash, so any collision would make one of the resources unreachable
+            auto collisionIter = m_resourceIndices.find( resourceID.GetID() );
+            if ( collisionIter != m_resourceIndices.end() )
+            {
+                KRG_LOG_ERROR( "ResourcePackageBuilder", "Resource path hash collision: %s and %s", resourceID.c_str(), m_resources[collisionIter->second].m_resourceID.c_str() );
+                return false;
+            }
+
+            if ( !FileSystem::LoadFile( compiledFile.m_path, fileData ) || fileData.empty() )
+            {
+                KRG_LOG_ERROR( "ResourcePackageBuilder", "Failed to read compiled resource: %s", compiledFile.m_path.c_str() );
+                return false;
+            }
+
+            // Read the header to get the dependencies
+            //-------------------------------------------------------------------------
+
+            bool const isCompressed = ResourceCompression::IsCompressed( fileData );
+            if ( isCompressed && !ResourceCompression::Decompress( fileData, decompressedData ) )
+            {
+                KRG_LOG_ERROR( "ResourcePackageBuilder", "Failed to decompress compiled resource: %s", compiledFile.m_path.c_str() );
+                return false;
+            }
+
+            TVector<Byte> const& uncompressedData = isCompressed ? decompressedData : fileData;
+            Serialization::BinaryMemoryArchive archive( uncompressedData.data(), uncompressedData.size() );
+            if ( !archive.IsValid() )
+            {
+                KRG_LOG_ERROR( "ResourcePackageBuilder", "Failed to read compiled resource header: %s", compiledFile.m_path.c_str() );
+                return false;
+            }
+
+            ResourceHeader header;
+            archive >> header;
+
+            //-------------------------------------------------------------------------
+
+            m_resourceIndices[resourceID.GetID()] = (int32) m_resources.size();
+
+            auto& resource = m_resources.emplace_back();
+            resource.m_resourceID = resourceID;
+            resource.m_filePath = compiledFile.m_path;
+            resource.m_dependencies = header.m_installDependencies;
+            resource.m_size = fileData.size();
+            resource.m_isCompressed = isCompressed;
+        }
+
+        if ( m_resources.empty() )
+        {
+            KRG_LOG_ERROR( "ResourcePackageBuilder", "No compiled resources found in: %s", m_compiledResourceDirectoryPath.c_str() );
+            return false;
+        }
+
+        return true;
+    }
+
+    void ResourcePackageBuilder::SortByLocality()
+    {
+        // Deterministic base order: root resources first, then by path
+        //-------------------------------------------------------------------------
+
+        TVector<int32> sortedIndices;
+        sortedIndices.reserve( m_resources.size() );
+        for ( int32 i = 0; i < (int32) m_resources.size(); i++ )
+        {
+            sortedIndices.emplace_back( i );
+        }
+
+        auto IsRootResource = [this] ( PackagedResource const& resource )
+        {
+            return VectorContains( m_rootResourceTypes, resource.m_resourceID.GetResourceTypeID() );
+        };
+
+        auto comparator = [&] ( int32 a, int32 b )
+        {
+            bool const isRootA = IsRootResource( m_resources[a] );
+            bool const isRootB = IsRootResource( m_resources[b] );
+            if ( isRootA != isRootB )
+            {
+                return isRootA;
+            }
+
+            return m_resources[a].m_resourceID.ToString() < m_resources[b].m_resourceID.ToString();
+        };
+
+        eastl::sort( sortedIndices.begin(), sortedIndices.end(), comparator );
+
+        // Place each resource followed by its dependency tree (this matches the order in which they are requested)
+        //-------------------------------------------------------------------------
+
+        m_placementOrder.reserve( m_resources.size() );
+        for ( auto resourceIdx : sortedIndices )
+        {
+            PlaceResource( resourceIdx );
+        }
+
+        KRG_ASSERT( m_placementOrder.size() == m_resources.size() );
+    }
+
+    void ResourcePackageBuilder::PlaceResource( int32 resourceIdx )
+    {
+        auto& resource = m_resources[resourceIdx];
+        if ( resource.m_isPlaced )
+        {
+            return;
+        }
+
+        resource.m_isPlaced = true;
+        m_placementOrder.emplace_back( resourceIdx );
+
+        for ( auto const& dependencyID : resource.m_dependencies )
+        {
+            auto dependencyIter = m_resourceIndices.find( dependencyID.GetID() );
+            if ( dependencyIter != m_resourceIndices.end() )
+            {
+                PlaceResource( dependencyIter->second );
+            }
+            else
+            {
+                KRG_LOG_WARNING( "ResourcePackageBuilder", "Resource %s has a dependency that is not compiled: %s", resource.m_resourceID.c_str(), dependencyID.c_str() );
+            }
+        }
+    }
+
+    bool ResourcePackageBuilder::WritePackage( FileSystem::Path const& packagePath )
+    {
+        FileSystem::EnsurePathExists( packagePath );
+        FileSystem::OutputFileStream packageFile( packagePath );
+        if ( !packageFile.IsValid() )
+        {
+            KRG_LOG_ERROR( "ResourcePackageBuilder", "Failed to create package file: %s", packagePath.c_str() );
+            return false;
+        }
+
+        Byte padding[ResourcePackageFormat::g_dataAlignment] = { 0 };
+        auto WritePadding = [&] ( uint64& currentOffset )
+        {
+            uint64 const alignedOffset = Math::RoundUpToNearestMultiple64( currentOffset, ResourcePackageFormat::g_dataAlignment );
+            packageFile.Write( padding, alignedOffset - currentOffset );
+            currentOffset = alignedOffset;
+        };
+
+        // Write a placeholder header, it is rewritten once we know where the index is
+        ResourcePackageFormat::Header header;
+        header.m_numEntries = (uint32) m_resources.size();
+        packageFile.Write( &header, sizeof( header ) );
+        uint64 currentOffset = sizeof( header );
+
+        // Write resource data
+        //-------------------------------------------------------------------------
+
+        TVector<ResourcePackageFormat::IndexEntry> index;
+        index.reserve( m_resources.size() );
+
+        TVector<Byte> fileData;
+        for ( auto resourceIdx : m_placementOrder )
+        {
+            auto const& resource = m_resources[resourceIdx];
+            if ( !FileSystem::LoadFile( resource.m_filePath, fileData ) || fileData.size() != resource.m_size )
+            {
+                KRG_LOG_ERROR( "ResourcePackageBuilder", "Compiled resource changed while building package: %s", resource.m_filePath.c_str() );
+                return false;
+            }
+
+            WritePadding( currentOffset );
+
+            auto& entry = index.emplace_back();
+            entry.m_resourcePathID = resource.m_resourceID.GetID();
+            entry.m_flags = resource.m_isCompressed ? ResourcePackageFormat::IndexEntry::Compressed : 0;
+            entry.m_offset = currentOffset;
+            entry.m_size = fileData.size();
+
+            packageFile.Write( fileData.data(), fileData.size() );
+            currentOffset += fileData.size();
+        }
+
+        // Write the index and finalize the header
+        //-------------------------------------------------------------------------
+
+        auto comparator = [] ( ResourcePackageFormat::IndexEntry const& a, ResourcePackageFormat::IndexEntry const& b ) { return a.m_resourcePathID < b.m_resourcePathID; };
+        eastl::sort( index.begin(), index.end(), comparator );
+
+        WritePadding( currentOffset );
+        header.m_indexOffset = currentOffset;
+        packageFile.Write( index.data(), index.size() * sizeof( ResourcePackageFormat::IndexEntry ) );
+        currentOffset += index.size() * sizeof( ResourcePackageFormat::IndexEntry );
+
+        packageFile.GetStream().seekp( 0 );
+        packageFile.Write( &header, sizeof( header ) );
+
+        if ( !packageFile.GetStream().good() )
+        {
+            KRG_LOG_ERROR( "ResourcePackageBuilder", "Failed to write package file: %s", packagePath.c_str() );
+            return false;
+        }
+
+        packageFile.Close();
+
+        KRG_LOG_MESSAGE( "ResourcePackageBuilder", "Built resource package (%s): %u resources, %.2fMB", packagePath.c_str(), header.m_numEntries, currentOffset / ( 1024.0f * 1024.0f ) );
+        return true;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Tools/Core/_Module/API.h"
+#include "System/Resource/ResourceID.h"
+#include "System/Core/FileSystem/FileSystemPath.h"
+#include "System/Core/Types/Containers.h"
+
+//-------------------------------------------------------------------------
+// Resource Package Builder
+//-------------------------------------------------------------------------
+// Builds a resource package from the contents of the compiled resource directory
+// Resources are laid out in locality order: each root resource (e.g. a map) is followed by its dependency tree, so that loading it
+// reads a mostly contiguous region of the package. Resources not reachable from any root are appended in path order.
+
+namespace KRG::Resource
+{
+    class CompilerRegistry;
+
+    //-------------------------------------------------------------------------
+
+    class KRG_TOOLS_CORE_API ResourcePackageBuilder
+    {
+        struct PackagedResource
+        {
+            ResourceID                          m_resourceID;
+            FileSystem::Path                    m_filePath;
+            TVector<ResourceID>                 m_dependencies;
+            uint64                              m_size = 0;
+            bool                                m_isCompressed = false;
+            bool                                m_isPlaced = false;
+        };
+
+    public:
+
+        ResourcePackageBuilder( CompilerRegistry const& compilerRegistry, FileSystem::Path const& compiledResourceDirectoryPath );
+
+        // Resources of these types are placed first and start a new locality group
+        inline void SetRootResourceTypes( TVector<ResourceTypeID> const& rootResourceTypes ) { m_rootResourceTypes = rootResourceTypes; }
+
+        bool Build( FileSystem::Path const& packagePath );
+
+    private:
+
+        bool CollectResources();
+        void SortByLocality();
+        void PlaceResource( int32 resourceIdx );
+        bool WritePackage( FileSystem::Path const& packagePath );
+
+    private:
+
+        CompilerRegistry const&                 m_compilerRegistry;
+        FileSystem::Path const                  m_compiledResourceDirectoryPath;
+        TVector<ResourceTypeID>                 m_rootResourceTypes;
+        TVector<PackagedResource>               m_resources;
+        THashMap<uint32, int32>                 m_resourceIndices;
+        TVector<int32>                          m_placementOrder;
+    };
+}
@@ -3,6 +3,8 @@
 #include "Engine/Core/Entity/EntityDescriptors.h"
 #include "Engine/Core/Entity/EntitySerialization.h"
 #include "Engine/Navmesh/Components/Component_Navmesh.h"
+#include "Tools/Core/Resource/Compilers/ResourceDescriptor.h"
+#include "System/TypeSystem/TypeRegistry.h"
 #include "System/Core/Serialization/BinaryArchive.h"
 #include "System/Core/FileSystem/FileSystem.h"
 #include "System/Core/Time/Timers.h"
@@ -11,11 +13,78 @@
 
 namespace KRG::EntityModel
 {
+    static void CollectReferencedResources( TypeSystem::TypeRegistry const& typeRegistry, EntityCollectionDescriptor const& collectionDesc, TVector<ResourceID>& outResourceIDs )
+    {
+        TypeSystem::TypeID const resourcePtrTypeID = TypeSystem::GetCoreTypeID( TypeSystem::CoreTypeID::ResourcePtr );
+        TypeSystem::TypeID const templatedResourcePtrTypeID = TypeSystem::GetCoreTypeID( TypeSystem::CoreTypeID::TResourcePtr );
+
+        for ( auto const& entityDesc : collectionDesc.GetEntityDescriptors() )
+        {
+            for ( auto const& componentDesc : entityDesc.m_components )
+            {
+                auto pTypeInfo = typeRegistry.GetTypeInfo( componentDesc.m_typeID );
+                if ( pTypeInfo == nullptr )
+                {
+                    continue;
+                }
+
+                for ( auto const& propertyDesc : componentDesc.m_properties )
+                {
+                    auto pPropertyInfo = typeRegistry.ResolvePropertyPath( pTypeInfo, propertyDesc.m_path );
+                    if ( pPropertyInfo == nullptr || ( pPropertyInfo->m_typeID != resourcePtrTypeID && pPropertyInfo->m_typeID != templatedResourcePtrTypeID ) )
+                    {
+                        continue;
+                    }
+
+                    ResourceID const resourceID( propertyDesc.m_stringValue );
+                    if ( resourceID.IsValid() && !VectorContains( outResourceIDs, resourceID ) )
+                    {
+                        outResourceIDs.emplace_back( resourceID );
+                    }
+                }
+            }
+        }
+    }
+
+    // Reads the resources referenced by a resource's source descriptor, source assets (e.g. FBX or PNG files) are not resources so they are skipped
+    // We only read descriptors since these are all compile dependencies (directly or transitively), the compiled outputs of other resources are not
+    static bool ReadDescriptorDependencies( Resource::CompileContext const& ctx, ResourceID const& resourceID, TVector<ResourceID>& outDependencies )
+    {
+        outDependencies.clear();
+
+        FileSystem::Path const descriptorFilePath = resourceID.GetResourcePath().ToFileSystemPath( ctx.m_rawResourceDirectoryPath );
+
+        TVector<Byte> fileData;
+        if ( !FileSystem::Exists( descriptorFilePath ) || !FileSystem::LoadFile( descriptorFilePath, fileData ) )
+        {
+            return false;
+        }
+
+        TVector<ResourcePath> dependencyPaths;
+        String const fileContents( (char const*) fileData.data(), fileData.size() );
+        Resource::ResourceDescriptor::ReadCompileDependencies( fileContents, dependencyPaths );
+
+        for ( auto const& dependencyPath : dependencyPaths )
+        {
+            ResourceID const dependencyID( dependencyPath );
+            if ( ctx.m_typeRegistry.IsRegisteredResourceType( dependencyID.GetResourceTypeID() ) )
+            {
+                outDependencies.emplace_back( dependencyID );
+            }
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+
     EntityCollectionCompiler::EntityCollectionCompiler()
         : Resource::Compiler( "EntityMapCompiler", s_version )
     {
         m_outputTypes.push_back( EntityCollectionDescriptor::GetStaticResourceTypeID() );
         m_outputTypes.push_back( EntityMapDescriptor::GetStaticResourceTypeID() );
+        m_compressedOutputTypes.push_back( EntityCollectionDescriptor::GetStaticResourceTypeID() );
+        m_compressedOutputTypes.push_back( EntityMapDescriptor::GetStaticResourceTypeID() );
         m_virtualTypes.push_back( Navmesh::NavmeshData::GetStaticResourceTypeID() );
     }
 
@@ -48,6 +117,8 @@ namespace KRG::EntityModel
         }
         Message( "Entity collection read in: %.2fms", elapsedTime.ToFloat() );
 
+        GenerateResourceManifest( ctx, collectionDesc );
+
         //-------------------------------------------------------------------------
         // Serialize
         //-------------------------------------------------------------------------
@@ -138,6 +209,12 @@ namespace KRG::EntityModel
         }
         #endif
 
+        //-------------------------------------------------------------------------
+        // Resource Manifest
+        //-------------------------------------------------------------------------
+
+        GenerateResourceManifest( ctx, map );
+
         //-------------------------------------------------------------------------
         // Serialize
         //-------------------------------------------------------------------------
@@ -154,4 +231,52 @@ namespace KRG::EntityModel
             return CompilationFailed( ctx );
         }
     }
+
+    void EntityCollectionCompiler::GenerateResourceManifest( Resource::CompileContext const& ctx, EntityCollectionDescriptor& collectionDesc ) const
+    {
+        Milliseconds elapsedTime = 0.0f;
+        uint32 numMissingDescriptors = 0;
+
+        {
+            ScopedTimer<PlatformClock> timer( elapsedTime );
+
+            auto& manifest = collectionDesc.m_resourceManifest;
+            manifest.clear();
+            CollectReferencedResources( ctx.m_typeRegistry, collectionDesc, manifest );
+
+            // Breadth-first expansion, the manifest doubles as the queue so closer dependencies are listed first
+            THashSet<uint32> visitedResources;
+            visitedResources.insert( ctx.m_resourceID.GetID() );
+            for ( auto const& resourceID : manifest )
+            {
+                visitedResources.insert( resourceID.GetID() );
+            }
+
+            TVector<ResourceID> dependencies;
+            for ( size_t i = 0; i < manifest.size(); i++ )
+            {
+                ResourceID const resourceID = manifest[i];
+                if ( !ReadDescriptorDependencies( ctx, resourceID, dependencies ) )
+                {
+                    numMissingDescriptors++;
+                    continue;
+                }
+
+                for ( auto const& dependencyID : dependencies )
+                {
+                    if ( dependencyID.IsValid() && visitedResources.insert( dependencyID.GetID() ).second )
+                    {
+                        manifest.emplace_back( dependencyID );
+                    }
+                }
+            }
+        }
+
+        Message( "Resource manifest generated in %.2fms: %u resources", elapsedTime.ToFloat(), (uint32) collectionDesc.m_resourceManifest.size() );
+
+        if ( numMissingDescriptors > 0 )
+        {
+            Message( "%u referenced resources have missing source files, their dependencies are not included in the manifest", numMissingDescriptors );
+        }
+    }
 }
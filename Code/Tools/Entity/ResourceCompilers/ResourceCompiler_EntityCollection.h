@@ -7,12 +7,13 @@
 namespace KRG::EntityModel
 {
     class EntityMapDescriptor;
+    class EntityCollectionDescriptor;
 
     //-------------------------------------------------------------------------
 
     class EntityCollectionCompiler final : public Resource::Compiler
     {
-        static const int32 s_version = 7;
+        static const int32 s_version = 9;
 
     public:
 
@@ -23,5 +24,9 @@ namespace KRG::EntityModel
 
         Resource::CompilationResult CompileCollection( Resource::CompileContext const& ctx ) const;
         Resource::CompilationResult CompileMap( Resource::CompileContext const& ctx ) const;
+
+        // Flattens all the resources referenced by the collection's components (and their dependencies) into the collection's manifest
+        // Transitive dependencies are read from the source descriptors, which are covered by the up-to-date check, so the manifest never depends on compilation order
+        void GenerateResourceManifest( Resource::CompileContext const& ctx, EntityCollectionDescriptor& collectionDesc ) const;
     };
 }
@@ -45,6 +45,7 @@ namespace KRG
             : Resource::Compiler( "PhysicsMeshCompiler", s_version )
         {
             m_outputTypes.push_back( PhysicsMesh::GetStaticResourceTypeID() );
+            m_compressedOutputTypes.push_back( PhysicsMesh::GetStaticResourceTypeID() );
         }
 
         Resource::CompilationResult PhysicsMeshCompiler::Compile( Resource::CompileContext const& ctx ) const
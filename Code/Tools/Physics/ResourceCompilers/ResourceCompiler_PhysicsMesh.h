@@ -13,7 +13,7 @@ namespace KRG::Physics
 {
     class PhysicsMeshCompiler : public Resource::Compiler
     {
-        static const int32 s_version = 4;
+        static const int32 s_version = 5;
 
     public:
 
@@ -13,6 +13,51 @@
 
 namespace KRG::Render
 {
+    // Quantize the bone weights, if the weights are normalized then the rounding error is assigned to the largest weight so that they still sum to one
+    template<typename T>
+    static void QuantizeBoneInfluences( SkeletalMeshVertex const& vertex, uint8 compactBoneIndices[4], T compactBoneWeights[4] )
+    {
+        constexpr int32 const maxWeightValue = std::numeric_limits<T>::max();
+
+        float weightSum = 0.0f;
+        int32 quantizedWeightSum = 0;
+        int32 largestWeightIdx = 0;
+        float largestWeight = -1.0f;
+
+        for ( int32 i = 0; i < 4; i++ )
+        {
+            if ( vertex.m_boneIndices[i] == InvalidIndex )
+            {
+                compactBoneIndices[i] = VertexCompression::InvalidCompactBoneIndex;
+                compactBoneWeights[i] = 0;
+                continue;
+            }
+
+            KRG_ASSERT( vertex.m_boneIndices[i] >= 0 && vertex.m_boneIndices[i] < VertexCompression::InvalidCompactBoneIndex );
+            compactBoneIndices[i] = (uint8) vertex.m_boneIndices[i];
+
+            float const weight = Math::Clamp( vertex.m_boneWeights[i], 0.0f, 1.0f );
+            int32 const quantizedWeight = Math::RoundToInt( weight * maxWeightValue );
+            compactBoneWeights[i] = (T) quantizedWeight;
+
+            weightSum += weight;
+            quantizedWeightSum += quantizedWeight;
+            if ( weight > largestWeight )
+            {
+                largestWeight = weight;
+                largestWeightIdx = i;
+            }
+        }
+
+        if ( quantizedWeightSum > 0 && Math::IsNearEqual( weightSum, 1.0f, 0.01f ) )
+        {
+            int32 const correctedWeight = compactBoneWeights[largestWeightIdx] + ( maxWeightValue - quantizedWeightSum );
+            compactBoneWeights[largestWeightIdx] = (T) Math::Clamp( correctedWeight, 0, maxWeightValue );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     void MeshCompiler::TransferMeshGeometry( RawAssets::RawMesh const& rawMesh, Mesh& mesh, int32 maxBoneInfluences ) const
     {
         KRG_ASSERT( maxBoneInfluences > 0 && maxBoneInfluences <= 8 );
@@ -150,15 +195,187 @@ namespace KRG::Render
     {
         size_t const vertexSize = (size_t) mesh.m_vertexBuffer.m_byteStride;
         size_t const numVertices = (size_t) mesh.GetNumVertices();
+        float const* pPositions = (float const*) mesh.m_vertices.data();
+
+        // Triangles are only reordered within each section, otherwise the section index ranges would be invalidated
+        for ( auto const& section : mesh.m_sections )
+        {
+            uint32* pSectionIndices = &mesh.m_indices[section.m_startIndex];
+            meshopt_optimizeVertexCache( pSectionIndices, pSectionIndices, section.m_numIndices, numVertices );
+
+            // Reorder indices for overdraw, balancing overdraw and vertex cache efficiency
+            const float kThreshold = 1.01f; // allow up to 1% worse ACMR to get more reordering opportunities for overdraw
+            meshopt_optimizeOverdraw( pSectionIndices, pSectionIndices, section.m_numIndices, pPositions, numVertices, vertexSize, kThreshold );
+        }
+    }
+
+    void MeshCompiler::GenerateMeshLODs( MeshResourceDescriptor const& descriptor, Mesh& mesh ) const
+    {
+        KRG_ASSERT( mesh.m_LODs.empty() );
+
+        if ( descriptor.m_maxLODs <= 0 )
+        {
+            return;
+        }
+
+        if ( descriptor.m_LODTriangleRatio <= 0.0f || descriptor.m_LODTriangleRatio >= 1.0f || descriptor.m_maxLODError <= 0.0f || descriptor.m_LODScreenSpaceError <= 0.0f )
+        {
+            Warning( "Invalid LOD settings, LOD generation skipped!" );
+            return;
+        }
+
+        size_t const vertexSize = (size_t) mesh.m_vertexBuffer.m_byteStride;
+        size_t const numVertices = (size_t) mesh.GetNumVertices();
+        float const* pPositions = (float const*) mesh.m_vertices.data();
+
+        // The simplification error is relative to the largest mesh extent, we store it relative to the bounds diameter
+        float const meshScale = meshopt_simplifyScale( pPositions, numVertices, vertexSize );
+        float const boundsDiameter = 2.0f * mesh.m_bounds.m_extents.GetLength3();
+        if ( meshScale <= 0.0f || boundsDiameter <= 0.0f )
+        {
+            return;
+        }
+
+        float const errorScale = meshScale / boundsDiameter;
+        float const targetError = descriptor.m_maxLODError / errorScale;
 
-        meshopt_optimizeVertexCache( &mesh.m_indices[0], &mesh.m_indices[0], mesh.m_indices.size(), mesh.m_vertices.size() );
+        // Generate LODs
+        //-------------------------------------------------------------------------
+        // Each LOD is simplified from LOD0 so that the reported error is the error relative to the full detail mesh
+
+        uint32 const numLOD0Indices = (uint32) mesh.m_indices.size();
+        uint32 previousNumIndices = numLOD0Indices;
+        float previousMaxScreenSize = FLT_MAX;
+        TVector<uint32> simplifiedIndices;
+
+        for ( int32 lodIdx = 1; lodIdx <= descriptor.m_maxLODs; lodIdx++ )
+        {
+            float const targetRatio = Math::Pow( descriptor.m_LODTriangleRatio, (float) lodIdx );
+
+            Mesh::LOD lod;
+            uint32 numLODIndices = 0;
+            float maxSectionError = 0.0f;
+
+            for ( auto const& section : mesh.m_sections )
+            {
+                size_t const targetNumIndices = size_t( section.m_numIndices * targetRatio ) / 3 * 3;
+                simplifiedIndices.resize( section.m_numIndices );
 
-        // Reorder indices for overdraw, balancing overdraw and vertex cache efficiency
-        const float kThreshold = 1.01f; // allow up to 1% worse ACMR to get more reordering opportunities for overdraw
-        meshopt_optimizeOverdraw( &mesh.m_indices[0], &mesh.m_indices[0], mesh.m_indices.size(), (float*) &mesh.m_vertices[0], numVertices, vertexSize, kThreshold );
+                float sectionError = 0.0f;
+                uint32 const* pSectionIndices = &mesh.m_indices[section.m_startIndex];
+                size_t const numSimplifiedIndices = meshopt_simplify( simplifiedIndices.data(), pSectionIndices, section.m_numIndices, pPositions, numVertices, vertexSize, targetNumIndices, targetError, &sectionError );
+                meshopt_optimizeVertexCache( simplifiedIndices.data(), simplifiedIndices.data(), numSimplifiedIndices, numVertices );
+
+                lod.m_sections.emplace_back( section.m_ID, (uint32) mesh.m_indices.size(), (uint32) numSimplifiedIndices );
+                mesh.m_indices.insert( mesh.m_indices.end(), simplifiedIndices.begin(), simplifiedIndices.begin() + numSimplifiedIndices );
+
+                numLODIndices += (uint32) numSimplifiedIndices;
+                maxSectionError = Math::Max( maxSectionError, sectionError );
+            }
+
+            // Stop once the simplifier hits the error limit, since LODs that barely reduce the triangle count are a waste of memory
+            if ( numLODIndices == 0 || numLODIndices > previousNumIndices * s_minLODReduction )
+            {
+                mesh.m_indices.resize( mesh.m_indices.size() - numLODIndices );
+                break;
+            }
 
-        // Vertex fetch optimization should go last as it depends on the final index order
-        meshopt_optimizeVertexFetch( &mesh.m_vertices[0], &mesh.m_indices[0], mesh.m_indices.size(), &mesh.m_vertices[0], numVertices, vertexSize );
+            // The LOD can be used once its projected error is below the acceptable screen space error
+            lod.m_error = maxSectionError * errorScale;
+            lod.m_maxScreenSize = ( lod.m_error > 0.0f ) ? Math::Min( descriptor.m_LODScreenSpaceError / lod.m_error, previousMaxScreenSize ) : previousMaxScreenSize;
+
+            Message( "LOD %d: %u triangles (%.1f%% of LOD0), error: %.4f, max screen size: %.3f", lodIdx, numLODIndices / 3, 100.0f * numLODIndices / numLOD0Indices, lod.m_error, lod.m_maxScreenSize );
+
+            previousNumIndices = numLODIndices;
+            previousMaxScreenSize = lod.m_maxScreenSize;
+            mesh.m_LODs.emplace_back( eastl::move( lod ) );
+        }
+    }
+
+    void MeshCompiler::OptimizeVertexFetch( Mesh& mesh ) const
+    {
+        size_t const vertexSize = (size_t) mesh.m_vertexBuffer.m_byteStride;
+        size_t const numVertices = (size_t) mesh.GetNumVertices();
+
+        // Vertex fetch optimization should go last as it depends on the final index order (of all LODs), unused vertices are removed
+        size_t const numUsedVertices = meshopt_optimizeVertexFetch( &mesh.m_vertices[0], &mesh.m_indices[0], mesh.m_indices.size(), &mesh.m_vertices[0], numVertices, vertexSize );
+        mesh.m_vertices.resize( numUsedVertices * vertexSize );
+
+        // Update buffer sizes since the LOD indices were added and unused vertices were removed
+        mesh.m_vertexBuffer.m_byteSize = (uint32) mesh.m_vertices.size();
+        mesh.m_indexBuffer.m_byteSize = (uint32) mesh.m_indices.size() * sizeof( uint32 );
+    }
+
+    void MeshCompiler::CompressVertices( Mesh& mesh, VertexFormat compactFormat ) const
+    {
+        KRG_ASSERT( VertexCompression::IsCompactFormat( compactFormat ) );
+
+        VertexFormat const sourceFormat = mesh.m_vertexBuffer.m_vertexFormat;
+        KRG_ASSERT( sourceFormat == ( ( compactFormat == VertexFormat::StaticMeshCompact ) ? VertexFormat::StaticMesh : VertexFormat::SkeletalMesh ) );
+
+        int32 const numVertices = mesh.GetNumVertices();
+        uint32 const sourceVertexSize = mesh.m_vertexBuffer.m_byteStride;
+        uint32 const compactVertexSize = VertexLayoutRegistry::GetDescriptorForFormat( compactFormat ).m_byteSize;
+
+        // Positions are normalized to the mesh bounds, so decoded positions always lie within the bounds
+        AABB const meshAlignedBounds( mesh.m_bounds );
+        Float3 const positionOffset = meshAlignedBounds.GetMin().ToFloat3();
+        Float3 const positionScale = ( meshAlignedBounds.GetExtents() * 2.0f ).ToFloat3();
+
+        auto QuantizePositionComponent = [] ( float value, float offset, float scale )
+        {
+            return ( scale > 0.0f ) ? VertexCompression::QuantizeUNorm16( ( value - offset ) / scale ) : uint16( 0 );
+        };
+
+        //-------------------------------------------------------------------------
+
+        TVector<Byte> compactVertices;
+        compactVertices.resize( numVertices * compactVertexSize );
+
+        for ( int32 i = 0; i < numVertices; i++ )
+        {
+            auto pSourceVertex = reinterpret_cast<StaticMeshVertex const*>( &mesh.m_vertices[i * sourceVertexSize] );
+            auto pCompactVertex = reinterpret_cast<StaticMeshCompactVertex*>( &compactVertices[i * compactVertexSize] );
+
+            pCompactVertex->m_position[0] = QuantizePositionComponent( pSourceVertex->m_position.m_x, positionOffset.m_x, positionScale.m_x );
+            pCompactVertex->m_position[1] = QuantizePositionComponent( pSourceVertex->m_position.m_y, positionOffset.m_y, positionScale.m_y );
+            pCompactVertex->m_position[2] = QuantizePositionComponent( pSourceVertex->m_position.m_z, positionOffset.m_z, positionScale.m_z );
+            pCompactVertex->m_position[3] = 0;
+
+            VertexCompression::EncodeOctahedralNormal( Vector( pSourceVertex->m_normal ), pCompactVertex->m_normal );
+
+            pCompactVertex->m_UV0[0] = VertexCompression::FloatToHalf( pSourceVertex->m_UV0.m_x );
+            pCompactVertex->m_UV0[1] = VertexCompression::FloatToHalf( pSourceVertex->m_UV0.m_y );
+            pCompactVertex->m_UV1[0] = VertexCompression::FloatToHalf( pSourceVertex->m_UV1.m_x );
+            pCompactVertex->m_UV1[1] = VertexCompression::FloatToHalf( pSourceVertex->m_UV1.m_y );
+
+            if ( compactFormat == VertexFormat::SkeletalMeshCompact )
+            {
+                auto pSkeletalVertex = static_cast<SkeletalMeshVertex const*>( pSourceVertex );
+                auto pCompactSkeletalVertex = static_cast<SkeletalMeshCompactVertex*>( pCompactVertex );
+                QuantizeBoneInfluences( *pSkeletalVertex, pCompactSkeletalVertex->m_boneIndices, pCompactSkeletalVertex->m_boneWeights );
+            }
+            else if ( compactFormat == VertexFormat::SkeletalMeshCompactWeights16 )
+            {
+                auto pSkeletalVertex = static_cast<SkeletalMeshVertex const*>( pSourceVertex );
+                auto pCompactSkeletalVertex = static_cast<SkeletalMeshCompactWeights16Vertex*>( pCompactVertex );
+                QuantizeBoneInfluences( *pSkeletalVertex, pCompactSkeletalVertex->m_boneIndices, pCompactSkeletalVertex->m_boneWeights );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        size_t const originalByteSize = mesh.m_vertices.size();
+        mesh.m_vertices.swap( compactVertices );
+        mesh.m_positionDequantizationOffset = Vector( positionOffset, 0.0f );
+        mesh.m_positionDequantizationScale = Vector( positionScale, 0.0f );
+
+        mesh.m_vertexBuffer.m_vertexFormat = compactFormat;
+        mesh.m_vertexBuffer.m_byteStride = compactVertexSize;
+        mesh.m_vertexBuffer.m_byteSize = (uint32) mesh.m_vertices.size();
+
+        float const maxPositionError = Math::Max( positionScale.m_x, Math::Max( positionScale.m_y, positionScale.m_z ) ) / ( 2.0f * 65535.0f );
+        Message( "Compact vertex format: %u bytes per vertex (was %u), vertex memory reduced by %.1f%%, max position error: %.6f", compactVertexSize, sourceVertexSize, 100.0f * ( 1.0f - float( mesh.m_vertices.size() ) / originalByteSize ), maxPositionError );
     }
 
     void MeshCompiler::SetMeshDefaultMaterials( MeshResourceDescriptor const& descriptor, Mesh& mesh ) const
@@ -195,6 +412,7 @@ namespace KRG::Render
         : MeshCompiler( "StaticMeshCompiler", s_version )
     {
         m_outputTypes.push_back( StaticMesh::GetStaticResourceTypeID() );
+        m_compressedOutputTypes.push_back( StaticMesh::GetStaticResourceTypeID() );
     }
 
     Resource::CompilationResult StaticMeshCompiler::Compile( Resource::CompileContext const& ctx ) const
@@ -229,6 +447,14 @@ namespace KRG::Render
         StaticMesh staticMesh;
         TransferMeshGeometry( *pRawMesh, staticMesh, 4 );
         OptimizeMeshGeometry( staticMesh );
+        GenerateMeshLODs( resourceDescriptor, staticMesh );
+        OptimizeVertexFetch( staticMesh );
+
+        if ( resourceDescriptor.m_useCompactVertexFormat )
+        {
+            CompressVertices( staticMesh, VertexFormat::StaticMeshCompact );
+        }
+
         SetMeshDefaultMaterials( resourceDescriptor, staticMesh );
 
         // Serialize
@@ -265,6 +491,7 @@ namespace KRG::Render
         : MeshCompiler( "SkeletalMeshCompiler", s_version )
     {
         m_outputTypes.push_back( SkeletalMesh::GetStaticResourceTypeID() );
+        m_compressedOutputTypes.push_back( SkeletalMesh::GetStaticResourceTypeID() );
     }
 
     Resource::CompilationResult SkeletalMeshCompiler::Compile( Resource::CompileContext const& ctx ) const
@@ -302,7 +529,23 @@ namespace KRG::Render
         SkeletalMesh skeletalMesh;
         TransferMeshGeometry( *pRawMesh, skeletalMesh, maxBoneInfluences );
         OptimizeMeshGeometry( skeletalMesh );
+        GenerateMeshLODs( resourceDescriptor, skeletalMesh );
+        OptimizeVertexFetch( skeletalMesh );
         TransferSkeletalMeshData( *pRawMesh, skeletalMesh );
+
+        if ( resourceDescriptor.m_useCompactVertexFormat )
+        {
+            // Compact vertices use 8-bit bone indices, with the highest index reserved for unused influences
+            if ( skeletalMesh.GetNumBones() > VertexCompression::InvalidCompactBoneIndex )
+            {
+                Warning( "Mesh has %d bones, the compact vertex format supports at most %d bones! Using the full precision vertex format.", skeletalMesh.GetNumBones(), VertexCompression::InvalidCompactBoneIndex );
+            }
+            else
+            {
+                CompressVertices( skeletalMesh, resourceDescriptor.m_use16BitBoneWeights ? VertexFormat::SkeletalMeshCompactWeights16 : VertexFormat::SkeletalMeshCompact );
+            }
+        }
+
         SetMeshDefaultMaterials( resourceDescriptor, skeletalMesh );
 
         // Serialize
@@ -2,6 +2,7 @@
 
 #include "Tools/Render/_Module/API.h"
 #include "Tools/Core/Resource/Compilers/ResourceCompiler.h"
+#include "System/Render/RenderVertexFormats.h"
 
 //-------------------------------------------------------------------------
 
@@ -19,6 +20,11 @@ namespace KRG::Render
 
     class MeshCompiler : public Resource::Compiler
     {
+    protected:
+
+        // Generated LODs need to have at most this fraction of the indices of the previous LOD
+        constexpr static float const s_minLODReduction = 0.9f;
+
     protected:
 
         using Resource::Compiler::Compiler;
@@ -27,6 +33,9 @@ namespace KRG::Render
 
         void TransferMeshGeometry( RawAssets::RawMesh const& rawMesh, Mesh& mesh, int32 maxBoneInfluences ) const;
         void OptimizeMeshGeometry( Mesh& mesh ) const;
+        void GenerateMeshLODs( MeshResourceDescriptor const& descriptor, Mesh& mesh ) const;
+        void OptimizeVertexFetch( Mesh& mesh ) const;
+        void CompressVertices( Mesh& mesh, VertexFormat compactFormat ) const;
         void SetMeshDefaultMaterials( MeshResourceDescriptor const& descriptor, Mesh& mesh ) const;
         void SetMeshInstallDependencies( Mesh const& mesh, Resource::ResourceHeader& hdr ) const;
     };
@@ -35,7 +44,7 @@ namespace KRG::Render
 
     class StaticMeshCompiler : public MeshCompiler
     {
-        static const int32 s_version = 1;
+        static const int32 s_version = 4;
 
     public:
 
@@ -47,7 +56,7 @@ namespace KRG::Render
 
     class SkeletalMeshCompiler : public MeshCompiler
     {
-        static const int32 s_version = 4;
+        static const int32 s_version = 7;
 
     public:
 
@@ -51,7 +51,18 @@ namespace KRG::Render
         Texture texture;
         texture.m_format = TextureFormat::DDS;
 
-        if ( !ConvertTexture( textureFilePath, resourceDescriptor.m_type, texture.m_rawData ) )
+        // Use the CPU compressor for all source formats it supports, the texture converter handles everything else
+        if ( CanCompressTexture( textureFilePath ) )
+        {
+            TextureCompressionStats stats;
+            if ( !CompressTexture( textureFilePath, resourceDescriptor.m_type, resourceDescriptor.m_quality, ctx.m_pTaskSystem, texture.m_rawData, stats ) )
+            {
+                return Error( "Failed to compress texture!" );
+            }
+
+            Message( "Compressed %ux%u texture (%u mips) to %s - Mips: %.2fms, Encoding: %.2fms, Throughput: %.2f MTexels/s, PSNR: %.2fdB", stats.m_width, stats.m_height, stats.m_numMips, stats.m_pFormatName, stats.m_mipGenerationTime.ToFloat(), stats.m_encodingTime.ToFloat(), stats.GetThroughput(), stats.m_psnr );
+        }
+        else if ( !ConvertTexture( textureFilePath, resourceDescriptor.m_type, texture.m_rawData ) )
         {
             return Error( "Failed to convert texture!" );
         }
@@ -31,6 +31,21 @@ namespace KRG::Render
 
         // Optional value that specifies the specific sub-mesh to compile, if this is not set, all sub-meshes contained in the source will be combined into a single mesh object
         KRG_EXPOSE String                               m_meshName;
+
+        // The max number of lower detail LODs to generate, set to 0 to disable LOD generation
+        KRG_EXPOSE int32                                m_maxLODs = 3;
+
+        // The fraction of triangles that each LOD tries to keep relative to the previous LOD
+        KRG_EXPOSE float                                m_LODTriangleRatio = 0.5f;
+
+        // The max simplification error (relative to the mesh bounds diameter) that is allowed for any LOD
+        KRG_EXPOSE float                                m_maxLODError = 0.05f;
+
+        // The acceptable projected simplification error (relative to the viewport width), this is used to calculate the LOD screen size thresholds
+        KRG_EXPOSE float                                m_LODScreenSpaceError = 0.001f;
+
+        // Should we use the compact vertex format (quantized positions, octahedral normals and half precision UVs)
+        KRG_EXPOSE bool                                 m_useCompactVertexFormat = true;
     };
 
     //-------------------------------------------------------------------------
@@ -51,5 +66,10 @@ namespace KRG::Render
 
         virtual bool IsUserCreateableDescriptor() const override { return true; }
         virtual ResourceTypeID GetCompiledResourceTypeID() const override { return SkeletalMesh::GetStaticResourceTypeID(); }
+
+    public:
+
+        // Should the compact vertex format use 16-bit bone weights instead of 8-bit weights
+        KRG_EXPOSE bool                                 m_use16BitBoneWeights = false;
     };
 }
\ No newline at end of file
@@ -17,6 +17,16 @@ namespace KRG::Render
         TangentSpaceNormals,
     };
 
+    // Controls the block compression format and the encoder effort for textures compressed by the CPU texture compressor
+    enum class TextureCompressionQuality
+    {
+        KRG_REGISTER_ENUM
+
+        Fast,       // BC1 (or BC3 with alpha) color textures, no endpoint refinement
+        Normal,     // BC7 color textures, single refinement pass
+        High,       // BC7 color textures (also searches two subset partitions for opaque blocks), multiple refinement passes
+    };
+
     //-------------------------------------------------------------------------
 
     struct KRG_TOOLS_RENDER_API TextureResourceDescriptor : public Resource::ResourceDescriptor
@@ -30,6 +40,7 @@ namespace KRG::Render
 
         KRG_EXPOSE ResourcePath     m_path;
         KRG_EXPOSE TextureType      m_type = TextureType::Default;
+        KRG_EXPOSE TextureCompressionQuality m_quality = TextureCompressionQuality::Normal;
         KRG_EXPOSE String           m_name; // Optional property needed for extracting textures out of container files (e.g. glb, fbx)
     };
 
@@ -0,0 +1,1017 @@
+#include "BlockCompression.h"
+#include "System/Core/Math/Math.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Render::BlockCompression
+{
+    namespace
+    {
+        // Writes bits from LSB to MSB, the output is expected to be zeroed
+        struct BitWriter
+        {
+            BitWriter( uint8* pData ) : m_pData( pData ) {}
+
+            inline void Write( uint32 value, uint32 numBits )
+            {
+                for ( uint32 i = 0; i < numBits; i++ )
+                {
+                    if ( ( value >> i ) & 1 )
+                    {
+                        m_pData[m_bitOffset >> 3] |= uint8( 1 << ( m_bitOffset & 7 ) );
+                    }
+                    m_bitOffset++;
+                }
+            }
+
+        public:
+
+            uint8*      m_pData = nullptr;
+            uint32      m_bitOffset = 0;
+        };
+
+        inline int32 RoundToInt( float value )
+        {
+            return (int32) ( value + 0.5f );
+        }
+
+        inline int32 ClampInt( int32 value, int32 min, int32 max )
+        {
+            return ( value < min ) ? min : ( value > max ) ? max : value;
+        }
+
+        inline uint32 GetNumRefinementIterations( TextureCompressionQuality quality )
+        {
+            switch ( quality )
+            {
+                case TextureCompressionQuality::Fast: return 0;
+                case TextureCompressionQuality::Normal: return 1;
+                default: return 3;
+            }
+        }
+
+        //-------------------------------------------------------------------------
+        // Endpoint Fitting
+        //-------------------------------------------------------------------------
+
+        // Fit a line through the specified texels and return the extents of their projection onto it, also returns the squared distance of the texels to the line
+        static float FitEndpoints( TexelBlock const& block, uint8 const* pTexelIndices, uint32 numTexels, uint32 numChannels, float endpoint0[4], float endpoint1[4] )
+        {
+            KRG_ASSERT( numTexels > 0 && numChannels <= 4 );
+
+            float mean[4] = { 0, 0, 0, 0 };
+            for ( uint32 i = 0; i < numTexels; i++ )
+            {
+                for ( uint32 c = 0; c < numChannels; c++ )
+                {
+                    mean[c] += block.m_texels[pTexelIndices[i]][c];
+                }
+            }
+
+            for ( uint32 c = 0; c < numChannels; c++ )
+            {
+                mean[c] /= numTexels;
+            }
+
+            // Calculate covariance matrix
+            //-------------------------------------------------------------------------
+
+            float covariance[4][4] = {};
+            float totalVariance = 0.0f;
+            for ( uint32 i = 0; i < numTexels; i++ )
+            {
+                float delta[4];
+                for ( uint32 c = 0; c < numChannels; c++ )
+                {
+                    delta[c] = block.m_texels[pTexelIndices[i]][c] - mean[c];
+                    totalVariance += delta[c] * delta[c];
+                }
+
+                for ( uint32 r = 0; r < numChannels; r++ )
+                {
+                    for ( uint32 c = 0; c < numChannels; c++ )
+                    {
+                        covariance[r][c] += delta[r] * delta[c];
+                    }
+                }
+            }
+
+            // Find principal axis via power iteration, start from the channel with the largest variance
+            //-------------------------------------------------------------------------
+
+            float axis[4] = { 0, 0, 0, 0 };
+            uint32 largestVarianceChannel = 0;
+            for ( uint32 c = 1; c < numChannels; c++ )
+            {
+                if ( covariance[c][c] > covariance[largestVarianceChannel][largestVarianceChannel] )
+                {
+                    largestVarianceChannel = c;
+                }
+            }
+            axis[largestVarianceChannel] = 1.0f;
+
+            for ( uint32 iteration = 0; iteration < 8; iteration++ )
+            {
+                float newAxis[4] = { 0, 0, 0, 0 };
+                float lengthSq = 0.0f;
+                for ( uint32 r = 0; r < numChannels; r++ )
+                {
+                    for ( uint32 c = 0; c < numChannels; c++ )
+                    {
+                        newAxis[r] += covariance[r][c] * axis[c];
+                    }
+                    lengthSq += newAxis[r] * newAxis[r];
+                }
+
+                // Degenerate case, all texels are the same
+                if ( lengthSq < 1e-12f )
+                {
+                    break;
+                }
+
+                float const invLength = 1.0f / Math::Sqrt( lengthSq );
+                for ( uint32 c = 0; c < numChannels; c++ )
+                {
+                    axis[c] = newAxis[c] * invLength;
+                }
+            }
+
+            // Project texels onto axis
+            //-------------------------------------------------------------------------
+
+            float minT = FLT_MAX, maxT = -FLT_MAX;
+            float projectedVariance = 0.0f;
+            for ( uint32 i = 0; i < numTexels; i++ )
+            {
+                float t = 0.0f;
+                for ( uint32 c = 0; c < numChannels; c++ )
+                {
+                    t += ( block.m_texels[pTexelIndices[i]][c] - mean[c] ) * axis[c];
+                }
+
+                minT = Math::Min( minT, t );
+                maxT = Math::Max( maxT, t );
+                projectedVariance += t * t;
+            }
+
+            for ( uint32 c = 0; c < numChannels; c++ )
+            {
+                endpoint0[c] = Math::Clamp( mean[c] + minT * axis[c], 0.0f, 255.0f );
+                endpoint1[c] = Math::Clamp( mean[c] + maxT * axis[c], 0.0f, 255.0f );
+            }
+
+            return Math::Max( totalVariance - projectedVariance, 0.0f );
+        }
+
+        // Solve for the endpoints that minimize the error for the current interpolation weights (0 = endpoint0, 1 = endpoint1)
+        static bool RefineEndpoints( TexelBlock const& block, uint8 const* pTexelIndices, float const* pWeights, uint32 numTexels, uint32 numChannels, float endpoint0[4], float endpoint1[4] )
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = { 0, 0, 0, 0 };
+            float bx[4] = { 0, 0, 0, 0 };
+
+            for ( uint32 i = 0; i < numTexels; i++ )
+            {
+                float const b = pWeights[i];
+                float const a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+
+                for ( uint32 c = 0; c < numChannels; c++ )
+                {
+                    float const x = block.m_texels[pTexelIndices[i]][c];
+                    ax[c] += a * x;
+                    bx[c] += b * x;
+                }
+            }
+
+            float const determinant = aa * bb - ab * ab;
+            if ( Math::Abs( determinant ) < 1e-6f )
+            {
+                return false;
+            }
+
+            float const invDeterminant = 1.0f / determinant;
+            for ( uint32 c = 0; c < numChannels; c++ )
+            {
+                endpoint0[c] = Math::Clamp( ( bb * ax[c] - ab * bx[c] ) * invDeterminant, 0.0f, 255.0f );
+                endpoint1[c] = Math::Clamp( ( aa * bx[c] - ab * ax[c] ) * invDeterminant, 0.0f, 255.0f );
+            }
+
+            return true;
+        }
+
+        static uint8 const g_allTexelIndices[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+        //-------------------------------------------------------------------------
+        // BC1
+        //-------------------------------------------------------------------------
+
+        struct BC1Block
+        {
+            uint16      m_color0 = 0;
+            uint16      m_color1 = 0;
+            uint8       m_indices[16] = {};
+            uint8       m_palette[4][3] = {};
+            uint32      m_error = UINT32_MAX;
+        };
+
+        inline uint16 PackRGB565( float const color[4] )
+        {
+            uint32 const r = ClampInt( RoundToInt( color[0] * 31.0f / 255.0f ), 0, 31 );
+            uint32 const g = ClampInt( RoundToInt( color[1] * 63.0f / 255.0f ), 0, 63 );
+            uint32 const b = ClampInt( RoundToInt( color[2] * 31.0f / 255.0f ), 0, 31 );
+            return uint16( ( r << 11 ) | ( g << 5 ) | b );
+        }
+
+        inline void UnpackRGB565( uint16 color, uint8 rgb[3] )
+        {
+            uint32 const r = ( color >> 11 ) & 31;
+            uint32 const g = ( color >> 5 ) & 63;
+            uint32 const b = color & 31;
+            rgb[0] = uint8( ( r << 3 ) | ( r >> 2 ) );
+            rgb[1] = uint8( ( g << 2 ) | ( g >> 4 ) );
+            rgb[2] = uint8( ( b << 3 ) | ( b >> 2 ) );
+        }
+
+        // Evaluate a pair of 565 endpoints in four color mode, the encoded block requires color0 > color1 which is handled when writing the block
+        static void EvaluateBC1Endpoints( TexelBlock const& block, uint16 color0, uint16 color1, BC1Block& result )
+        {
+            result.m_color0 = color0;
+            result.m_color1 = color1;
+            result.m_error = 0;
+
+            UnpackRGB565( color0, result.m_palette[0] );
+            UnpackRGB565( color1, result.m_palette[1] );
+            for ( uint32 c = 0; c < 3; c++ )
+            {
+                result.m_palette[2][c] = uint8( ( 2 * result.m_palette[0][c] + result.m_palette[1][c] + 1 ) / 3 );
+                result.m_palette[3][c] = uint8( ( result.m_palette[0][c] + 2 * result.m_palette[1][c] + 1 ) / 3 );
+            }
+
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                uint32 bestError = UINT32_MAX;
+                for ( uint8 p = 0; p < 4; p++ )
+                {
+                    uint32 error = 0;
+                    for ( uint32 c = 0; c < 3; c++ )
+                    {
+                        int32 const delta = int32( block.m_texels[i][c] ) - result.m_palette[p][c];
+                        error += delta * delta;
+                    }
+
+                    if ( error < bestError )
+                    {
+                        bestError = error;
+                        result.m_indices[i] = p;
+                    }
+                }
+
+                result.m_error += bestError;
+            }
+        }
+
+        static void EncodeBC1Color( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+        {
+            float endpoint0[4], endpoint1[4];
+            FitEndpoints( block, g_allTexelIndices, 16, 3, endpoint0, endpoint1 );
+
+            BC1Block bestBlock;
+            EvaluateBC1Endpoints( block, PackRGB565( endpoint0 ), PackRGB565( endpoint1 ), bestBlock );
+
+            // Least squares refinement
+            //-------------------------------------------------------------------------
+
+            static float const s_indexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+            uint32 const numIterations = GetNumRefinementIterations( quality );
+            for ( uint32 iteration = 0; iteration < numIterations && bestBlock.m_error > 0; iteration++ )
+            {
+                float weights[16];
+                for ( uint32 i = 0; i < 16; i++ )
+                {
+                    weights[i] = s_indexWeights[bestBlock.m_indices[i]];
+                }
+
+                if ( !RefineEndpoints( block, g_allTexelIndices, weights, 16, 3, endpoint0, endpoint1 ) )
+                {
+                    break;
+                }
+
+                BC1Block refinedBlock;
+                EvaluateBC1Endpoints( block, PackRGB565( endpoint0 ), PackRGB565( endpoint1 ), refinedBlock );
+                if ( refinedBlock.m_error >= bestBlock.m_error )
+                {
+                    break;
+                }
+
+                bestBlock = refinedBlock;
+            }
+
+            // Four color mode requires color0 > color1
+            //-------------------------------------------------------------------------
+
+            static uint8 const s_swappedIndices[4] = { 1, 0, 3, 2 };
+
+            if ( bestBlock.m_color0 < bestBlock.m_color1 )
+            {
+                eastl::swap( bestBlock.m_color0, bestBlock.m_color1 );
+                for ( uint32 i = 0; i < 16; i++ )
+                {
+                    bestBlock.m_indices[i] = s_swappedIndices[bestBlock.m_indices[i]];
+                }
+            }
+            else if ( bestBlock.m_color0 == bestBlock.m_color1 )
+            {
+                // Identical endpoints would select the three color mode, so only use the first palette entry
+                memset( bestBlock.m_indices, 0, sizeof( bestBlock.m_indices ) );
+            }
+
+            // Write block
+            //-------------------------------------------------------------------------
+
+            // The palette needs to be rebuilt since the endpoints might have been swapped
+            uint8 palette[4][3];
+            UnpackRGB565( bestBlock.m_color0, palette[0] );
+            UnpackRGB565( bestBlock.m_color1, palette[1] );
+            for ( uint32 c = 0; c < 3; c++ )
+            {
+                palette[2][c] = uint8( ( 2 * palette[0][c] + palette[1][c] + 1 ) / 3 );
+                palette[3][c] = uint8( ( palette[0][c] + 2 * palette[1][c] + 1 ) / 3 );
+            }
+
+            uint32 indices = 0;
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                indices |= uint32( bestBlock.m_indices[i] ) << ( i * 2 );
+                for ( uint32 c = 0; c < 3; c++ )
+                {
+                    decodedBlock.m_texels[i][c] = palette[bestBlock.m_indices[i]][c];
+                }
+            }
+
+            pOutput[0] = uint8( bestBlock.m_color0 & 0xFF );
+            pOutput[1] = uint8( bestBlock.m_color0 >> 8 );
+            pOutput[2] = uint8( bestBlock.m_color1 & 0xFF );
+            pOutput[3] = uint8( bestBlock.m_color1 >> 8 );
+            pOutput[4] = uint8( indices & 0xFF );
+            pOutput[5] = uint8( ( indices >> 8 ) & 0xFF );
+            pOutput[6] = uint8( ( indices >> 16 ) & 0xFF );
+            pOutput[7] = uint8( indices >> 24 );
+        }
+
+        //-------------------------------------------------------------------------
+        // BC4
+        //-------------------------------------------------------------------------
+
+        struct BC4Block
+        {
+            uint8       m_endpoint0 = 0;
+            uint8       m_endpoint1 = 0;
+            uint8       m_indices[16] = {};
+            uint8       m_palette[8] = {};
+            uint32      m_error = UINT32_MAX;
+        };
+
+        // The interpolation mode is selected by the endpoint order: endpoint0 > endpoint1 is the eight value mode, otherwise the six value mode (with explicit 0 and 255)
+        static void EvaluateBC4Endpoints( TexelBlock const& block, uint32 channel, uint8 endpoint0, uint8 endpoint1, BC4Block& result )
+        {
+            result.m_endpoint0 = endpoint0;
+            result.m_endpoint1 = endpoint1;
+            result.m_error = 0;
+            result.m_palette[0] = endpoint0;
+            result.m_palette[1] = endpoint1;
+
+            if ( endpoint0 > endpoint1 )
+            {
+                for ( uint32 i = 2; i < 8; i++ )
+                {
+                    result.m_palette[i] = uint8( ( ( 8 - i ) * endpoint0 + ( i - 1 ) * endpoint1 + 3 ) / 7 );
+                }
+            }
+            else
+            {
+                for ( uint32 i = 2; i < 6; i++ )
+                {
+                    result.m_palette[i] = uint8( ( ( 6 - i ) * endpoint0 + ( i - 1 ) * endpoint1 + 2 ) / 5 );
+                }
+                result.m_palette[6] = 0;
+                result.m_palette[7] = 255;
+            }
+
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                uint32 bestError = UINT32_MAX;
+                for ( uint8 p = 0; p < 8; p++ )
+                {
+                    int32 const delta = int32( block.m_texels[i][channel] ) - result.m_palette[p];
+                    uint32 const error = delta * delta;
+                    if ( error < bestError )
+                    {
+                        bestError = error;
+                        result.m_indices[i] = p;
+                    }
+                }
+
+                result.m_error += bestError;
+            }
+        }
+
+        static void RefineBC4Block( TexelBlock const& block, uint32 channel, uint32 numIterations, bool isEightValueMode, BC4Block& bestBlock )
+        {
+            TexelBlock channelBlock;
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                channelBlock.m_texels[i][0] = block.m_texels[i][channel];
+            }
+
+            for ( uint32 iteration = 0; iteration < numIterations && bestBlock.m_error > 0; iteration++ )
+            {
+                // Only the interpolated entries take part in the fit, the six value mode constants are excluded
+                uint8 texelIndices[16];
+                float weights[16];
+                uint32 numTexels = 0;
+                for ( uint8 i = 0; i < 16; i++ )
+                {
+                    uint8 const idx = bestBlock.m_indices[i];
+                    if ( idx == 0 || idx == 1 )
+                    {
+                        weights[numTexels] = float( idx );
+                    }
+                    else if ( isEightValueMode )
+                    {
+                        weights[numTexels] = ( idx - 1 ) / 7.0f;
+                    }
+                    else if ( idx < 6 )
+                    {
+                        weights[numTexels] = ( idx - 1 ) / 5.0f;
+                    }
+                    else
+                    {
+                        continue;
+                    }
+
+                    texelIndices[numTexels++] = i;
+                }
+
+                float endpoint0[4], endpoint1[4];
+                if ( numTexels < 2 || !RefineEndpoints( channelBlock, texelIndices, weights, numTexels, 1, endpoint0, endpoint1 ) )
+                {
+                    break;
+                }
+
+                int32 e0 = RoundToInt( endpoint0[0] );
+                int32 e1 = RoundToInt( endpoint1[0] );
+                if ( isEightValueMode )
+                {
+                    if ( e0 < e1 )
+                    {
+                        eastl::swap( e0, e1 );
+                    }
+                    else if ( e0 == e1 )
+                    {
+                        if ( e0 < 255 )
+                        {
+                            e0++;
+                        }
+                        else
+                        {
+                            e1--;
+                        }
+                    }
+                }
+                else if ( e0 > e1 )
+                {
+                    eastl::swap( e0, e1 );
+                }
+
+                BC4Block refinedBlock;
+                EvaluateBC4Endpoints( block, channel, uint8( e0 ), uint8( e1 ), refinedBlock );
+                if ( refinedBlock.m_error >= bestBlock.m_error )
+                {
+                    break;
+                }
+
+                bestBlock = refinedBlock;
+            }
+        }
+
+        static void EncodeBC4Channel( TexelBlock const& block, uint32 channel, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+        {
+            uint8 minValue = 255, maxValue = 0;
+            uint8 minInnerValue = 255, maxInnerValue = 0;
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                uint8 const value = block.m_texels[i][channel];
+                minValue = Math::Min( minValue, value );
+                maxValue = Math::Max( maxValue, value );
+
+                if ( value != 0 && value != 255 )
+                {
+                    minInnerValue = Math::Min( minInnerValue, value );
+                    maxInnerValue = Math::Max( maxInnerValue, value );
+                }
+            }
+
+            uint32 const numIterations = GetNumRefinementIterations( quality );
+
+            BC4Block bestBlock;
+            if ( minValue == maxValue )
+            {
+                EvaluateBC4Endpoints( block, channel, minValue, maxValue, bestBlock );
+            }
+            else
+            {
+                EvaluateBC4Endpoints( block, channel, maxValue, minValue, bestBlock );
+                RefineBC4Block( block, channel, numIterations, true, bestBlock );
+
+                // The six value mode is better for blocks that mix extreme values with a narrow range of other values
+                if ( quality == TextureCompressionQuality::High && bestBlock.m_error > 0 )
+                {
+                    if ( minInnerValue > maxInnerValue )
+                    {
+                        minInnerValue = maxInnerValue = minValue;
+                    }
+
+                    BC4Block sixValueBlock;
+                    EvaluateBC4Endpoints( block, channel, minInnerValue, maxInnerValue, sixValueBlock );
+                    RefineBC4Block( block, channel, numIterations, false, sixValueBlock );
+
+                    if ( sixValueBlock.m_error < bestBlock.m_error )
+                    {
+                        bestBlock = sixValueBlock;
+                    }
+                }
+            }
+
+            // Write block
+            //-------------------------------------------------------------------------
+
+            uint64 indices = 0;
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                indices |= uint64( bestBlock.m_indices[i] ) << ( i * 3 );
+                decodedBlock.m_texels[i][channel] = bestBlock.m_palette[bestBlock.m_indices[i]];
+            }
+
+            pOutput[0] = bestBlock.m_endpoint0;
+            pOutput[1] = bestBlock.m_endpoint1;
+            for ( uint32 i = 0; i < 6; i++ )
+            {
+                pOutput[2 + i] = uint8( ( indices >> ( i * 8 ) ) & 0xFF );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+        // BC7
+        //-------------------------------------------------------------------------
+
+        static uint32 const g_bc7Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+        static uint32 const g_bc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        // Bit N is set if texel N belongs to the second subset
+        static uint16 const g_bc7PartitionTable2[64] =
+        {
+            0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+            0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+            0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+            0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+            0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+            0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+            0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+            0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+        };
+
+        // The anchor texel of the second subset, the anchor of the first subset is always texel 0
+        static uint8 const g_bc7AnchorTable2[64] =
+        {
+            15, 15, 15, 15, 15, 15, 15, 15,
+            15, 15, 15, 15, 15, 15, 15, 15,
+            15, 2, 8, 2, 2, 8, 8, 15,
+            2, 8, 2, 2, 8, 8, 2, 2,
+            15, 15, 6, 8, 2, 8, 15, 15,
+            2, 8, 2, 2, 2, 15, 15, 6,
+            6, 2, 6, 8, 15, 15, 2, 2,
+            15, 15, 15, 15, 15, 2, 2, 15,
+        };
+
+        // Number of candidate partitions that are fully encoded after the initial estimate
+        static uint32 const g_bc7NumPartitionCandidates = 8;
+
+        inline uint8 InterpolateBC7( uint32 e0, uint32 e1, uint32 weight )
+        {
+            return uint8( ( ( 64 - weight ) * e0 + weight * e1 + 32 ) >> 6 );
+        }
+
+        struct BC7Subset
+        {
+            uint8       m_quantized[2][4] = {};             // Stored endpoint values (without p-bits)
+            uint8       m_pBits[2] = {};                    // Per endpoint p-bits (mode 1 uses the same value for both)
+            uint8       m_endpoints[2][4] = {};             // Reconstructed 8-bit endpoints
+        };
+
+        // Quantize a float endpoint for the specified precision and p-bit, returns the stored value
+        inline uint8 QuantizeBC7Component( float value, uint32 numBits, uint32 pBit )
+        {
+            // The stored value is expanded as ( ( q << 1 ) | p ) with (numBits + 1) total bits and then replicated to 8 bits
+            uint32 const maxValue = ( 1u << numBits ) - 1;
+            float const scale = float( ( 1u << ( numBits + 1 ) ) - 1 ) / 255.0f;
+            return uint8( ClampInt( RoundToInt( ( value * scale - pBit ) * 0.5f ), 0, maxValue ) );
+        }
+
+        inline uint8 ExpandBC7Component( uint32 quantized, uint32 numBits, uint32 pBit )
+        {
+            uint32 const totalBits = numBits + 1;
+            uint32 const value = ( quantized << 1 ) | pBit;
+            return uint8( ( value << ( 8 - totalBits ) ) | ( value >> ( 2 * totalBits - 8 ) ) );
+        }
+
+        static void QuantizeBC7Endpoint( float const endpoint[4], uint32 numChannels, uint32 numBits, uint32 pBit, uint8 quantized[4], uint8 reconstructed[4] )
+        {
+            for ( uint32 c = 0; c < numChannels; c++ )
+            {
+                quantized[c] = QuantizeBC7Component( endpoint[c], numBits, pBit );
+                reconstructed[c] = ExpandBC7Component( quantized[c], numBits, pBit );
+            }
+
+            for ( uint32 c = numChannels; c < 4; c++ )
+            {
+                quantized[c] = 0;
+                reconstructed[c] = 255;
+            }
+        }
+
+        // Assign the best palette index to each texel of a subset, returns the squared error
+        static uint32 AssignBC7Indices( TexelBlock const& block, uint8 const* pTexelIndices, uint32 numTexels, uint32 numChannels, uint8 const endpoints[2][4], uint32 const* pWeights, uint32 numWeights, uint8* pIndices )
+        {
+            uint8 palette[16][4];
+            for ( uint32 p = 0; p < numWeights; p++ )
+            {
+                for ( uint32 c = 0; c < 4; c++ )
+                {
+                    palette[p][c] = InterpolateBC7( endpoints[0][c], endpoints[1][c], pWeights[p] );
+                }
+            }
+
+            uint32 totalError = 0;
+            for ( uint32 i = 0; i < numTexels; i++ )
+            {
+                uint8 const* pTexel = block.m_texels[pTexelIndices[i]];
+                uint32 bestError = UINT32_MAX;
+                for ( uint8 p = 0; p < numWeights; p++ )
+                {
+                    uint32 error = 0;
+                    for ( uint32 c = 0; c < numChannels; c++ )
+                    {
+                        int32 const delta = int32( pTexel[c] ) - palette[p][c];
+                        error += delta * delta;
+                    }
+
+                    if ( error < bestError )
+                    {
+                        bestError = error;
+                        pIndices[pTexelIndices[i]] = p;
+                    }
+                }
+
+                totalError += bestError;
+            }
+
+            return totalError;
+        }
+
+        // Find the quantized endpoints and indices for a single subset, tries all allowed p-bit combinations
+        static uint32 EncodeBC7Subset( TexelBlock const& block, uint8 const* pTexelIndices, uint32 numTexels, uint32 numChannels, uint32 numEndpointBits, bool sharedPBit, uint32 const* pWeights, uint32 numWeights, uint32 numIterations, BC7Subset& subset, uint8* pIndices )
+        {
+            float endpoints[2][4];
+            FitEndpoints( block, pTexelIndices, numTexels, numChannels, endpoints[0], endpoints[1] );
+
+            uint32 bestError = UINT32_MAX;
+            uint8 candidateIndices[16];
+
+            for ( uint32 iteration = 0; iteration <= numIterations; iteration++ )
+            {
+                bool wasImproved = false;
+
+                uint32 const numPBitCombinations = sharedPBit ? 2 : 4;
+                for ( uint32 pBitCombination = 0; pBitCombination < numPBitCombinations; pBitCombination++ )
+                {
+                    BC7Subset candidate;
+                    candidate.m_pBits[0] = uint8( pBitCombination & 1 );
+                    candidate.m_pBits[1] = sharedPBit ? candidate.m_pBits[0] : uint8( pBitCombination >> 1 );
+
+                    for ( uint32 e = 0; e < 2; e++ )
+                    {
+                        QuantizeBC7Endpoint( endpoints[e], numChannels, numEndpointBits, candidate.m_pBits[e], candidate.m_quantized[e], candidate.m_endpoints[e] );
+                    }
+
+                    uint32 const error = AssignBC7Indices( block, pTexelIndices, numTexels, numChannels, candidate.m_endpoints, pWeights, numWeights, candidateIndices );
+                    if ( error < bestError )
+                    {
+                        bestError = error;
+                        subset = candidate;
+                        for ( uint32 i = 0; i < numTexels; i++ )
+                        {
+                            pIndices[pTexelIndices[i]] = candidateIndices[pTexelIndices[i]];
+                        }
+                        wasImproved = true;
+                    }
+                }
+
+                // Least squares refinement of the unquantized endpoints using the current best indices
+                //-------------------------------------------------------------------------
+
+                if ( iteration == numIterations || bestError == 0 || ( iteration > 0 && !wasImproved ) )
+                {
+                    break;
+                }
+
+                float weights[16];
+                for ( uint32 i = 0; i < numTexels; i++ )
+                {
+                    weights[i] = pWeights[pIndices[pTexelIndices[i]]] / 64.0f;
+                }
+
+                if ( !RefineEndpoints( block, pTexelIndices, weights, numTexels, numChannels, endpoints[0], endpoints[1] ) )
+                {
+                    break;
+                }
+            }
+
+            return bestError;
+        }
+
+        // Make sure the MSB of the anchor index is zero by swapping the subset endpoints
+        static void FixupBC7AnchorIndex( uint8 anchorTexelIdx, uint8 const* pTexelIndices, uint32 numTexels, uint32 numWeights, BC7Subset& subset, uint8* pIndices )
+        {
+            if ( pIndices[anchorTexelIdx] < ( numWeights >> 1 ) )
+            {
+                return;
+            }
+
+            eastl::swap( subset.m_pBits[0], subset.m_pBits[1] );
+            for ( uint32 c = 0; c < 4; c++ )
+            {
+                eastl::swap( subset.m_quantized[0][c], subset.m_quantized[1][c] );
+                eastl::swap( subset.m_endpoints[0][c], subset.m_endpoints[1][c] );
+            }
+
+            for ( uint32 i = 0; i < numTexels; i++ )
+            {
+                pIndices[pTexelIndices[i]] = uint8( numWeights - 1 - pIndices[pTexelIndices[i]] );
+            }
+        }
+
+        static void DecodeBC7Subset( BC7Subset const& subset, uint8 const* pTexelIndices, uint32 numTexels, uint32 const* pWeights, uint8 const* pIndices, TexelBlock& decodedBlock )
+        {
+            for ( uint32 i = 0; i < numTexels; i++ )
+            {
+                uint8 const texelIdx = pTexelIndices[i];
+                for ( uint32 c = 0; c < 4; c++ )
+                {
+                    decodedBlock.m_texels[texelIdx][c] = InterpolateBC7( subset.m_endpoints[0][c], subset.m_endpoints[1][c], pWeights[pIndices[texelIdx]] );
+                }
+            }
+        }
+
+        // Mode 6: single subset, RGBA 7.7.7.7 endpoints with unique p-bits, 4-bit indices
+        static uint32 EncodeBC7Mode6( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+        {
+            BC7Subset subset;
+            uint8 indices[16];
+            uint32 const error = EncodeBC7Subset( block, g_allTexelIndices, 16, 4, 7, false, g_bc7Weights4, 16, GetNumRefinementIterations( quality ), subset, indices );
+            FixupBC7AnchorIndex( 0, g_allTexelIndices, 16, 16, subset, indices );
+            DecodeBC7Subset( subset, g_allTexelIndices, 16, g_bc7Weights4, indices, decodedBlock );
+
+            // Write block
+            //-------------------------------------------------------------------------
+
+            memset( pOutput, 0, 16 );
+            BitWriter writer( pOutput );
+            writer.Write( 1 << 6, 7 );
+
+            for ( uint32 c = 0; c < 4; c++ )
+            {
+                writer.Write( subset.m_quantized[0][c], 7 );
+                writer.Write( subset.m_quantized[1][c], 7 );
+            }
+
+            writer.Write( subset.m_pBits[0], 1 );
+            writer.Write( subset.m_pBits[1], 1 );
+
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                writer.Write( indices[i], ( i == 0 ) ? 3 : 4 );
+            }
+
+            KRG_ASSERT( writer.m_bitOffset == 128 );
+            return error;
+        }
+
+        // Mode 1: two subsets, RGB 6.6.6 endpoints with a shared p-bit per subset, 3-bit indices
+        static uint32 EncodeBC7Mode1( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+        {
+            struct PartitionSubsets
+            {
+                uint8   m_texelIndices[2][16];
+                uint32  m_numTexels[2] = { 0, 0 };
+            };
+
+            auto GetPartitionSubsets = [] ( uint32 partitionIdx, PartitionSubsets& subsets )
+            {
+                for ( uint8 i = 0; i < 16; i++ )
+                {
+                    uint32 const subsetIdx = ( g_bc7PartitionTable2[partitionIdx] >> i ) & 1;
+                    subsets.m_texelIndices[subsetIdx][subsets.m_numTexels[subsetIdx]++] = i;
+                }
+            };
+
+            // Estimate the error of each partition from the distance of the texels to the best fit line of each subset
+            //-------------------------------------------------------------------------
+
+            uint32 candidatePartitions[g_bc7NumPartitionCandidates];
+            float candidateErrors[g_bc7NumPartitionCandidates];
+            uint32 numCandidates = 0;
+
+            for ( uint32 p = 0; p < 64; p++ )
+            {
+                PartitionSubsets subsets;
+                GetPartitionSubsets( p, subsets );
+
+                float estimatedError = 0.0f;
+                for ( uint32 s = 0; s < 2; s++ )
+                {
+                    float endpoint0[4], endpoint1[4];
+                    estimatedError += FitEndpoints( block, subsets.m_texelIndices[s], subsets.m_numTexels[s], 3, endpoint0, endpoint1 );
+                }
+
+                // Insertion sort into the candidate list
+                uint32 insertIdx = numCandidates;
+                while ( insertIdx > 0 && candidateErrors[insertIdx - 1] > estimatedError )
+                {
+                    insertIdx--;
+                }
+
+                if ( insertIdx < g_bc7NumPartitionCandidates )
+                {
+                    uint32 const numToMove = Math::Min( numCandidates, g_bc7NumPartitionCandidates - 1 ) - insertIdx;
+                    for ( uint32 i = numToMove; i > 0; i-- )
+                    {
+                        candidatePartitions[insertIdx + i] = candidatePartitions[insertIdx + i - 1];
+                        candidateErrors[insertIdx + i] = candidateErrors[insertIdx + i - 1];
+                    }
+
+                    candidatePartitions[insertIdx] = p;
+                    candidateErrors[insertIdx] = estimatedError;
+                    numCandidates = Math::Min( numCandidates + 1, g_bc7NumPartitionCandidates );
+                }
+            }
+
+            // Fully encode the best candidates
+            //-------------------------------------------------------------------------
+
+            uint32 const numIterations = GetNumRefinementIterations( quality );
+
+            uint32 bestError = UINT32_MAX;
+            uint32 bestPartition = 0;
+            BC7Subset bestSubsets[2];
+            uint8 bestIndices[16];
+
+            for ( uint32 c = 0; c < numCandidates; c++ )
+            {
+                PartitionSubsets subsets;
+                GetPartitionSubsets( candidatePartitions[c], subsets );
+
+                BC7Subset encodedSubsets[2];
+                uint8 indices[16];
+                uint32 error = 0;
+                for ( uint32 s = 0; s < 2; s++ )
+                {
+                    error += EncodeBC7Subset( block, subsets.m_texelIndices[s], subsets.m_numTexels[s], 3, 6, true, g_bc7Weights3, 8, numIterations, encodedSubsets[s], indices );
+                }
+
+                if ( error < bestError )
+                {
+                    bestError = error;
+                    bestPartition = candidatePartitions[c];
+                    bestSubsets[0] = encodedSubsets[0];
+                    bestSubsets[1] = encodedSubsets[1];
+                    memcpy( bestIndices, indices, sizeof( indices ) );
+                }
+            }
+
+            PartitionSubsets subsets;
+            GetPartitionSubsets( bestPartition, subsets );
+            uint8 const anchorTexels[2] = { 0, g_bc7AnchorTable2[bestPartition] };
+            for ( uint32 s = 0; s < 2; s++ )
+            {
+                FixupBC7AnchorIndex( anchorTexels[s], subsets.m_texelIndices[s], subsets.m_numTexels[s], 8, bestSubsets[s], bestIndices );
+                DecodeBC7Subset( bestSubsets[s], subsets.m_texelIndices[s], subsets.m_numTexels[s], g_bc7Weights3, bestIndices, decodedBlock );
+            }
+
+            // Write block
+            //-------------------------------------------------------------------------
+
+            memset( pOutput, 0, 16 );
+            BitWriter writer( pOutput );
+            writer.Write( 1 << 1, 2 );
+            writer.Write( bestPartition, 6 );
+
+            for ( uint32 c = 0; c < 3; c++ )
+            {
+                for ( uint32 s = 0; s < 2; s++ )
+                {
+                    writer.Write( bestSubsets[s].m_quantized[0][c], 6 );
+                    writer.Write( bestSubsets[s].m_quantized[1][c], 6 );
+                }
+            }
+
+            writer.Write( bestSubsets[0].m_pBits[0], 1 );
+            writer.Write( bestSubsets[1].m_pBits[0], 1 );
+
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                writer.Write( bestIndices[i], ( i == anchorTexels[0] || i == anchorTexels[1] ) ? 2 : 3 );
+            }
+
+            KRG_ASSERT( writer.m_bitOffset == 128 );
+            return bestError;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void EncodeBC1( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+    {
+        EncodeBC1Color( block, quality, pOutput, decodedBlock );
+        for ( uint32 i = 0; i < 16; i++ )
+        {
+            decodedBlock.m_texels[i][3] = 255;
+        }
+    }
+
+    void EncodeBC3( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+    {
+        EncodeBC4Channel( block, 3, quality, pOutput, decodedBlock );
+        EncodeBC1Color( block, quality, pOutput + 8, decodedBlock );
+    }
+
+    void EncodeBC4( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+    {
+        EncodeBC4Channel( block, 0, quality, pOutput, decodedBlock );
+        for ( uint32 i = 0; i < 16; i++ )
+        {
+            decodedBlock.m_texels[i][1] = 0;
+            decodedBlock.m_texels[i][2] = 0;
+            decodedBlock.m_texels[i][3] = 255;
+        }
+    }
+
+    void EncodeBC5( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+    {
+        EncodeBC4Channel( block, 0, quality, pOutput, decodedBlock );
+        EncodeBC4Channel( block, 1, quality, pOutput + 8, decodedBlock );
+        for ( uint32 i = 0; i < 16; i++ )
+        {
+            decodedBlock.m_texels[i][2] = 0;
+            decodedBlock.m_texels[i][3] = 255;
+        }
+    }
+
+    void EncodeBC7( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock )
+    {
+        uint32 bestError = EncodeBC7Mode6( block, quality, pOutput, decodedBlock );
+
+        // Try the two subset mode for opaque blocks
+        //-------------------------------------------------------------------------
+
+        if ( quality == TextureCompressionQuality::High && bestError > 0 )
+        {
+            bool isOpaque = true;
+            for ( uint32 i = 0; i < 16; i++ )
+            {
+                if ( block.m_texels[i][3] != 255 )
+                {
+                    isOpaque = false;
+                    break;
+                }
+            }
+
+            if ( isOpaque )
+            {
+                uint8 mode1Output[16];
+                TexelBlock mode1DecodedBlock;
+                uint32 const mode1Error = EncodeBC7Mode1( block, quality, mode1Output, mode1DecodedBlock );
+
+                // Mode 6 error includes alpha, which is always exact for opaque blocks in mode 1
+                if ( mode1Error < bestError )
+                {
+                    memcpy( pOutput, mode1Output, 16 );
+                    decodedBlock = mode1DecodedBlock;
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
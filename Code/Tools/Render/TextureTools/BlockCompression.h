@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Tools/Render/ResourceDescriptors/ResourceDescriptor_RenderTexture.h"
+
+//-------------------------------------------------------------------------
+// CPU Block Compression
+//-------------------------------------------------------------------------
+// Portable encoders for the BC1/BC3/BC4/BC5/BC7 block formats, each call encodes a single 4x4 block of texels
+// The texels are 8-bit RGBA in row-major order, and the decoded texels are returned so that the caller can measure the error
+//
+// Endpoints are found via a principal axis fit and then refined via least squares, the number of refinement iterations depends on the quality
+// BC7 blocks are encoded using mode 6 (single subset RGBA), the high quality preset also tries mode 1 (two subset RGB) for opaque blocks
+
+namespace KRG::Render::BlockCompression
+{
+    struct TexelBlock
+    {
+        uint8       m_texels[16][4];
+    };
+
+    //-------------------------------------------------------------------------
+
+    // Encodes the RGB channels, outputs 8 bytes
+    void EncodeBC1( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock );
+
+    // Encodes the RGBA channels, outputs 16 bytes
+    void EncodeBC3( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock );
+
+    // Encodes the R channel, outputs 8 bytes
+    void EncodeBC4( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock );
+
+    // Encodes the RG channels, outputs 16 bytes
+    void EncodeBC5( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock );
+
+    // Encodes the RGBA channels, outputs 16 bytes
+    void EncodeBC7( TexelBlock const& block, TextureCompressionQuality quality, uint8* pOutput, TexelBlock& decodedBlock );
+}
\ No newline at end of file
@@ -0,0 +1,549 @@
+#include "TextureTools.h"
+#include "BlockCompression.h"
+#include "System/Core/Threading/TaskSystem.h"
+#include "System/Core/FileSystem/FileSystem.h"
+#include "System/Core/Time/Timers.h"
+#include "System/Core/Math/Math.h"
+#include "System/Core/Logging/Log.h"
+#include "System/Core/ThirdParty/stb/stb_image.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG::Render
+{
+    namespace
+    {
+        enum class BlockFormat
+        {
+            BC1 = 0,
+            BC3,
+            BC4,
+            BC5,
+            BC7,
+        };
+
+        struct BlockFormatInfo
+        {
+            char const*     m_pName;
+            uint32          m_dxgiFormat;
+            uint32          m_blockSize;
+            uint32          m_numChannels; // Number of channels used when calculating the error
+        };
+
+        static BlockFormatInfo const g_blockFormatInfos[] =
+        {
+            { "BC1_UNORM_SRGB", 72, 8, 3 },
+            { "BC3_UNORM_SRGB", 78, 16, 4 },
+            { "BC4_UNORM", 80, 8, 1 },
+            { "BC5_UNORM", 83, 16, 2 },
+            { "BC7_UNORM_SRGB", 99, 16, 4 },
+        };
+
+        enum class MipFilter
+        {
+            Color,          // RGB filtered in linear space, alpha filtered as is
+            Linear,         // All channels filtered as is
+            Normal,         // RGB decoded to a unit vector and renormalized after filtering
+        };
+
+        struct MipLevel
+        {
+            uint32                      m_width = 0;
+            uint32                      m_height = 0;
+            uint32                      m_numBlocksX = 0;
+            uint32                      m_numBlocksY = 0;
+            uint32                      m_firstBlockIdx = 0;
+            TVector<uint8>              m_texels; // RGBA8
+        };
+
+        // Minimum amount of work per task, to keep the scheduling overhead low for small mips
+        static uint32 const g_minRowsPerTask = 16;
+        static uint32 const g_minBlocksPerTask = 64;
+
+        //-------------------------------------------------------------------------
+
+        static BlockFormat SelectBlockFormat( TextureType type, TextureCompressionQuality quality, bool hasAlpha )
+        {
+            switch ( type )
+            {
+                case TextureType::TangentSpaceNormals: return BlockFormat::BC5;
+                case TextureType::AmbientOcclusion: return BlockFormat::BC4;
+                default: break;
+            }
+
+            if ( quality == TextureCompressionQuality::Fast )
+            {
+                return hasAlpha ? BlockFormat::BC3 : BlockFormat::BC1;
+            }
+
+            return BlockFormat::BC7;
+        }
+
+        static MipFilter SelectMipFilter( TextureType type )
+        {
+            switch ( type )
+            {
+                case TextureType::TangentSpaceNormals: return MipFilter::Normal;
+                case TextureType::AmbientOcclusion: return MipFilter::Linear;
+                default: return MipFilter::Color;
+            }
+        }
+
+        // Execute a task set on the task system or inline if no task system is available
+        template<typename TaskType>
+        static void ExecuteTask( TaskSystem* pTaskSystem, TaskType& task )
+        {
+            if ( pTaskSystem != nullptr && task.m_SetSize > task.m_MinRange )
+            {
+                pTaskSystem->ScheduleTask( &task );
+                pTaskSystem->WaitForTask( &task );
+            }
+            else
+            {
+                TaskSetPartition range;
+                range.start = 0;
+                range.end = task.m_SetSize;
+                task.ExecuteRange( range, 0 );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+        // Mip Generation
+        //-------------------------------------------------------------------------
+
+        struct ColorSpaceConverter
+        {
+            ColorSpaceConverter()
+            {
+                for ( uint32 i = 0; i < 256; i++ )
+                {
+                    float const value = i / 255.0f;
+                    m_srgbToLinear[i] = ( value <= 0.04045f ) ? value / 12.92f : Math::Pow( ( value + 0.055f ) / 1.055f, 2.4f );
+                }
+            }
+
+            inline float ToLinear( uint8 value ) const { return m_srgbToLinear[value]; }
+
+            inline uint8 ToSRGB( float value ) const
+            {
+                value = Math::Clamp( value, 0.0f, 1.0f );
+                float const srgb = ( value <= 0.0031308f ) ? value * 12.92f : 1.055f * Math::Pow( value, 1.0f / 2.4f ) - 0.055f;
+                return uint8( srgb * 255.0f + 0.5f );
+            }
+
+        private:
+
+            float m_srgbToLinear[256];
+        };
+
+        static ColorSpaceConverter const g_colorSpaceConverter;
+
+        inline uint8 ToUNorm8( float value )
+        {
+            return uint8( Math::Clamp( value, 0.0f, 1.0f ) * 255.0f + 0.5f );
+        }
+
+        // 2x2 box filter, the last row/column is reused for odd dimensions
+        static void GenerateMipRow( MipLevel const& sourceMip, MipLevel& destinationMip, MipFilter filter, uint32 y )
+        {
+            uint32 const sourceRows[2] = { Math::Min( y * 2, sourceMip.m_height - 1 ), Math::Min( y * 2 + 1, sourceMip.m_height - 1 ) };
+
+            for ( uint32 x = 0; x < destinationMip.m_width; x++ )
+            {
+                uint32 const sourceColumns[2] = { Math::Min( x * 2, sourceMip.m_width - 1 ), Math::Min( x * 2 + 1, sourceMip.m_width - 1 ) };
+
+                float sum[4] = { 0, 0, 0, 0 };
+                for ( uint32 row : sourceRows )
+                {
+                    for ( uint32 column : sourceColumns )
+                    {
+                        uint8 const* pSourceTexel = &sourceMip.m_texels[( row * sourceMip.m_width + column ) * 4];
+                        switch ( filter )
+                        {
+                            case MipFilter::Color:
+                            {
+                                for ( uint32 c = 0; c < 3; c++ )
+                                {
+                                    sum[c] += g_colorSpaceConverter.ToLinear( pSourceTexel[c] );
+                                }
+                            }
+                            break;
+
+                            case MipFilter::Linear:
+                            {
+                                for ( uint32 c = 0; c < 3; c++ )
+                                {
+                                    sum[c] += pSourceTexel[c] / 255.0f;
+                                }
+                            }
+                            break;
+
+                            case MipFilter::Normal:
+                            {
+                                for ( uint32 c = 0; c < 3; c++ )
+                                {
+                                    sum[c] += pSourceTexel[c] / 127.5f - 1.0f;
+                                }
+                            }
+                            break;
+                        }
+
+                        sum[3] += pSourceTexel[3] / 255.0f;
+                    }
+                }
+
+                //-------------------------------------------------------------------------
+
+                uint8* pDestinationTexel = &destinationMip.m_texels[( y * destinationMip.m_width + x ) * 4];
+                switch ( filter )
+                {
+                    case MipFilter::Color:
+                    {
+                        for ( uint32 c = 0; c < 3; c++ )
+                        {
+                            pDestinationTexel[c] = g_colorSpaceConverter.ToSRGB( sum[c] * 0.25f );
+                        }
+                    }
+                    break;
+
+                    case MipFilter::Linear:
+                    {
+                        for ( uint32 c = 0; c < 3; c++ )
+                        {
+                            pDestinationTexel[c] = ToUNorm8( sum[c] * 0.25f );
+                        }
+                    }
+                    break;
+
+                    case MipFilter::Normal:
+                    {
+                        float const lengthSq = sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2];
+                        float const invLength = ( lengthSq > 1e-8f ) ? 1.0f / Math::Sqrt( lengthSq ) : 0.0f;
+                        for ( uint32 c = 0; c < 3; c++ )
+                        {
+                            pDestinationTexel[c] = ToUNorm8( sum[c] * invLength * 0.5f + 0.5f );
+                        }
+                    }
+                    break;
+                }
+
+                pDestinationTexel[3] = ToUNorm8( sum[3] * 0.25f );
+            }
+        }
+
+        static void GenerateMipChain( TVector<MipLevel>& mips, MipFilter filter, TaskSystem* pTaskSystem )
+        {
+            struct MipGenerationTask : public ITaskSet
+            {
+                MipGenerationTask( MipLevel const& sourceMip, MipLevel& destinationMip, MipFilter filter )
+                    : m_sourceMip( sourceMip )
+                    , m_destinationMip( destinationMip )
+                    , m_filter( filter )
+                {
+                    m_SetSize = destinationMip.m_height;
+                    m_MinRange = g_minRowsPerTask;
+                }
+
+                virtual void ExecuteRange( TaskSetPartition range, uint32 threadnum ) override final
+                {
+                    for ( uint32 y = range.start; y < range.end; y++ )
+                    {
+                        GenerateMipRow( m_sourceMip, m_destinationMip, m_filter, y );
+                    }
+                }
+
+            public:
+
+                MipLevel const&                 m_sourceMip;
+                MipLevel&                       m_destinationMip;
+                MipFilter                       m_filter;
+            };
+
+            //-------------------------------------------------------------------------
+
+            while ( mips.back().m_width > 1 || mips.back().m_height > 1 )
+            {
+                MipLevel& destinationMip = mips.emplace_back();
+                MipLevel const& sourceMip = mips[mips.size() - 2];
+                destinationMip.m_width = Math::Max( sourceMip.m_width / 2, 1u );
+                destinationMip.m_height = Math::Max( sourceMip.m_height / 2, 1u );
+                destinationMip.m_texels.resize( destinationMip.m_width * destinationMip.m_height * 4 );
+
+                MipGenerationTask task( sourceMip, destinationMip, filter );
+                ExecuteTask( pTaskSystem, task );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+        // Block Encoding
+        //-------------------------------------------------------------------------
+
+        // Encodes all blocks of all mips, also returns the squared error per block of the top mip
+        static void EncodeBlocks( TVector<MipLevel> const& mips, BlockFormat format, TextureCompressionQuality quality, TaskSystem* pTaskSystem, Byte* pOutput, TVector<uint64>& topMipBlockErrors )
+        {
+            struct BlockEncodingTask : public ITaskSet
+            {
+                BlockEncodingTask( TVector<MipLevel> const& mips, BlockFormat format, TextureCompressionQuality quality, Byte* pOutput, TVector<uint64>& topMipBlockErrors )
+                    : m_mips( mips )
+                    , m_format( format )
+                    , m_quality( quality )
+                    , m_pOutput( pOutput )
+                    , m_topMipBlockErrors( topMipBlockErrors )
+                {
+                    MipLevel const& lastMip = mips.back();
+                    m_SetSize = lastMip.m_firstBlockIdx + lastMip.m_numBlocksX * lastMip.m_numBlocksY;
+                    m_MinRange = g_minBlocksPerTask;
+                }
+
+                virtual void ExecuteRange( TaskSetPartition range, uint32 threadnum ) override final
+                {
+                    BlockFormatInfo const& formatInfo = g_blockFormatInfos[(int32) m_format];
+
+                    uint32 mipIdx = 0;
+                    for ( uint32 blockIdx = range.start; blockIdx < range.end; blockIdx++ )
+                    {
+                        while ( mipIdx + 1 < m_mips.size() && blockIdx >= m_mips[mipIdx + 1].m_firstBlockIdx )
+                        {
+                            mipIdx++;
+                        }
+
+                        MipLevel const& mip = m_mips[mipIdx];
+                        uint32 const mipBlockIdx = blockIdx - mip.m_firstBlockIdx;
+                        uint32 const blockX = ( mipBlockIdx % mip.m_numBlocksX ) * 4;
+                        uint32 const blockY = ( mipBlockIdx / mip.m_numBlocksX ) * 4;
+
+                        // Gather texels, edge texels are replicated for partial blocks
+                        BlockCompression::TexelBlock block;
+                        for ( uint32 i = 0; i < 16; i++ )
+                        {
+                            uint32 const x = Math::Min( blockX + ( i & 3 ), mip.m_width - 1 );
+                            uint32 const y = Math::Min( blockY + ( i >> 2 ), mip.m_height - 1 );
+                            memcpy( block.m_texels[i], &mip.m_texels[( y * mip.m_width + x ) * 4], 4 );
+                        }
+
+                        // Encode
+                        BlockCompression::TexelBlock decodedBlock;
+                        Byte* pBlockOutput = m_pOutput + blockIdx * formatInfo.m_blockSize;
+                        switch ( m_format )
+                        {
+                            case BlockFormat::BC1: BlockCompression::EncodeBC1( block, m_quality, pBlockOutput, decodedBlock ); break;
+                            case BlockFormat::BC3: BlockCompression::EncodeBC3( block, m_quality, pBlockOutput, decodedBlock ); break;
+                            case BlockFormat::BC4: BlockCompression::EncodeBC4( block, m_quality, pBlockOutput, decodedBlock ); break;
+                            case BlockFormat::BC5: BlockCompression::EncodeBC5( block, m_quality, pBlockOutput, decodedBlock ); break;
+                            case BlockFormat::BC7: BlockCompression::EncodeBC7( block, m_quality, pBlockOutput, decodedBlock ); break;
+                        }
+
+                        // Only the real texels of the top mip contribute to the error
+                        if ( mipIdx == 0 )
+                        {
+                            uint64 error = 0;
+                            for ( uint32 i = 0; i < 16; i++ )
+                            {
+                                if ( blockX + ( i & 3 ) >= mip.m_width || blockY + ( i >> 2 ) >= mip.m_height )
+                                {
+                                    continue;
+                                }
+
+                                for ( uint32 c = 0; c < formatInfo.m_numChannels; c++ )
+                                {
+                                    int32 const delta = int32( block.m_texels[i][c] ) - decodedBlock.m_texels[i][c];
+                                    error += delta * delta;
+                                }
+                            }
+
+                            m_topMipBlockErrors[mipBlockIdx] = error;
+                        }
+                    }
+                }
+
+            public:
+
+                TVector<MipLevel> const&        m_mips;
+                BlockFormat                     m_format;
+                TextureCompressionQuality       m_quality;
+                Byte*                           m_pOutput = nullptr;
+                TVector<uint64>&                m_topMipBlockErrors;
+            };
+
+            //-------------------------------------------------------------------------
+
+            topMipBlockErrors.resize( mips[0].m_numBlocksX * mips[0].m_numBlocksY, 0 );
+
+            BlockEncodingTask task( mips, format, quality, pOutput, topMipBlockErrors );
+            ExecuteTask( pTaskSystem, task );
+        }
+
+        //-------------------------------------------------------------------------
+        // DDS
+        //-------------------------------------------------------------------------
+
+        static void WriteDDSHeader( BlockFormatInfo const& formatInfo, TVector<MipLevel> const& mips, TVector<Byte>& rawData )
+        {
+            auto WriteUInt32 = [&rawData] ( uint32 value )
+            {
+                rawData.push_back( Byte( value & 0xFF ) );
+                rawData.push_back( Byte( ( value >> 8 ) & 0xFF ) );
+                rawData.push_back( Byte( ( value >> 16 ) & 0xFF ) );
+                rawData.push_back( Byte( value >> 24 ) );
+            };
+
+            auto MakeFourCC = [] ( char a, char b, char c, char d )
+            {
+                return uint32( a ) | ( uint32( b ) << 8 ) | ( uint32( c ) << 16 ) | ( uint32( d ) << 24 );
+            };
+
+            constexpr static uint32 const headerFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // Caps, Height, Width, PixelFormat, MipMapCount, LinearSize
+            constexpr static uint32 const pixelFormatFlags = 0x4; // FourCC
+            constexpr static uint32 const capsFlags = 0x8 | 0x1000 | 0x400000; // Complex, Texture, MipMap
+            constexpr static uint32 const resourceDimensionTexture2D = 3;
+
+            // Magic + DDS_HEADER
+            //-------------------------------------------------------------------------
+
+            WriteUInt32( MakeFourCC( 'D', 'D', 'S', ' ' ) );
+            WriteUInt32( 124 );
+            WriteUInt32( headerFlags );
+            WriteUInt32( mips[0].m_height );
+            WriteUInt32( mips[0].m_width );
+            WriteUInt32( mips[0].m_numBlocksX * mips[0].m_numBlocksY * formatInfo.m_blockSize );
+            WriteUInt32( 0 ); // Depth
+            WriteUInt32( (uint32) mips.size() );
+            for ( uint32 i = 0; i < 11; i++ )
+            {
+                WriteUInt32( 0 );
+            }
+
+            // DDS_PIXELFORMAT
+            WriteUInt32( 32 );
+            WriteUInt32( pixelFormatFlags );
+            WriteUInt32( MakeFourCC( 'D', 'X', '1', '0' ) );
+            for ( uint32 i = 0; i < 5; i++ )
+            {
+                WriteUInt32( 0 );
+            }
+
+            WriteUInt32( capsFlags );
+            for ( uint32 i = 0; i < 4; i++ )
+            {
+                WriteUInt32( 0 );
+            }
+
+            // DDS_HEADER_DXT10
+            //-------------------------------------------------------------------------
+
+            WriteUInt32( formatInfo.m_dxgiFormat );
+            WriteUInt32( resourceDimensionTexture2D );
+            WriteUInt32( 0 ); // Misc flags
+            WriteUInt32( 1 ); // Array size
+            WriteUInt32( 0 ); // Misc flags 2
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool CanCompressTexture( FileSystem::Path const& texturePath )
+    {
+        auto const extension = texturePath.GetLowercaseExtensionAsString();
+        return extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "tga" || extension == "bmp" || extension == "psd" || extension == "gif";
+    }
+
+    bool CompressTexture( FileSystem::Path const& texturePath, TextureType type, TextureCompressionQuality quality, TaskSystem* pTaskSystem, TVector<Byte>& rawData, TextureCompressionStats& stats )
+    {
+        KRG_ASSERT( texturePath.IsValid() );
+        KRG_ASSERT( pTaskSystem == nullptr || pTaskSystem->IsInitialized() );
+
+        stats = TextureCompressionStats();
+
+        // Load source texture
+        //-------------------------------------------------------------------------
+
+        TVector<Byte> fileData;
+        if ( !FileSystem::LoadFile( texturePath, fileData ) )
+        {
+            KRG_LOG_ERROR( "TextureCompressor", "Failed to read texture file: %s", texturePath.c_str() );
+            return false;
+        }
+
+        int32 width = 0, height = 0, channels = 0;
+        Byte* pImage = stbi_load_from_memory( fileData.data(), (int32) fileData.size(), &width, &height, &channels, 4 );
+        if ( pImage == nullptr )
+        {
+            KRG_LOG_ERROR( "TextureCompressor", "Failed to decode texture file (%s): %s", texturePath.c_str(), stbi_failure_reason() );
+            return false;
+        }
+
+        // The top mip reference is only valid until the mip chain is generated
+        TVector<MipLevel> mips;
+        MipLevel& topMip = mips.emplace_back();
+        topMip.m_width = (uint32) width;
+        topMip.m_height = (uint32) height;
+        topMip.m_texels.resize( topMip.m_width * topMip.m_height * 4 );
+        memcpy( topMip.m_texels.data(), pImage, topMip.m_texels.size() );
+        stbi_image_free( pImage );
+
+        bool hasAlpha = false;
+        for ( size_t i = 3; i < topMip.m_texels.size(); i += 4 )
+        {
+            if ( topMip.m_texels[i] != 255 )
+            {
+                hasAlpha = true;
+                break;
+            }
+        }
+
+        BlockFormat const format = SelectBlockFormat( type, quality, hasAlpha );
+        BlockFormatInfo const& formatInfo = g_blockFormatInfos[(int32) format];
+
+        // Generate mips
+        //-------------------------------------------------------------------------
+
+        {
+            ScopedTimer<PlatformClock> timer( stats.m_mipGenerationTime );
+            GenerateMipChain( mips, SelectMipFilter( type ), pTaskSystem );
+        }
+
+        uint32 numBlocks = 0;
+        for ( auto& mip : mips )
+        {
+            mip.m_numBlocksX = ( mip.m_width + 3 ) / 4;
+            mip.m_numBlocksY = ( mip.m_height + 3 ) / 4;
+            mip.m_firstBlockIdx = numBlocks;
+            numBlocks += mip.m_numBlocksX * mip.m_numBlocksY;
+            stats.m_numTexels += mip.m_width * mip.m_height;
+        }
+
+        // Encode blocks
+        //-------------------------------------------------------------------------
+
+        rawData.clear();
+        WriteDDSHeader( formatInfo, mips, rawData );
+
+        size_t const headerSize = rawData.size();
+        rawData.resize( headerSize + numBlocks * formatInfo.m_blockSize );
+
+        TVector<uint64> topMipBlockErrors;
+        {
+            ScopedTimer<PlatformClock> timer( stats.m_encodingTime );
+            EncodeBlocks( mips, format, quality, pTaskSystem, rawData.data() + headerSize, topMipBlockErrors );
+        }
+
+        // Stats
+        //-------------------------------------------------------------------------
+
+        uint64 totalError = 0;
+        for ( auto blockError : topMipBlockErrors )
+        {
+            totalError += blockError;
+        }
+
+        // Lossless results are reported as 100dB
+        double const meanSquaredError = double( totalError ) / ( double( width ) * height * formatInfo.m_numChannels );
+        stats.m_psnr = ( meanSquaredError > 0.0 ) ? float( 10.0 * log10( 255.0 * 255.0 / meanSquaredError ) ) : 100.0f;
+        stats.m_pFormatName = formatInfo.m_pName;
+        stats.m_width = mips[0].m_width;
+        stats.m_height = mips[0].m_height;
+        stats.m_numMips = (uint32) mips.size();
+
+        return true;
+    }
+}
\ No newline at end of file
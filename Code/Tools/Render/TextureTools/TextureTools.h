@@ -2,6 +2,11 @@
 
 #include "Tools/Render/ResourceDescriptors/ResourceDescriptor_RenderTexture.h"
 #include "System/Core/FileSystem/FileSystemPath.h"
+#include "System/Core/Time/Time.h"
+
+//-------------------------------------------------------------------------
+
+namespace KRG { class TaskSystem; }
 
 //-------------------------------------------------------------------------
 
@@ -9,4 +14,38 @@ namespace KRG::Render
 {
     // Create a DDS texture from the supplied texture
     bool ConvertTexture( FileSystem::Path const& texturePath, TextureType type, TVector<Byte>& rawData );
+
+    //-------------------------------------------------------------------------
+    // CPU Texture Compression
+    //-------------------------------------------------------------------------
+    // Portable alternative to the texture converter: generates the full mip chain and block compresses all mips on the CPU
+    // Color textures are filtered in linear space and stored as sRGB, normal maps are renormalized per mip
+    // Work is split across the task system (if supplied), rows for mip generation and blocks (across all mips) for the encoding
+
+    struct TextureCompressionStats
+    {
+        // Encoded mega-texels per second (across all mips)
+        inline float GetThroughput() const
+        {
+            float const totalTimeSeconds = ( m_mipGenerationTime.ToFloat() + m_encodingTime.ToFloat() ) / 1000.0f;
+            return ( totalTimeSeconds > 0.0f ) ? ( m_numTexels / 1000000.0f ) / totalTimeSeconds : 0.0f;
+        }
+
+    public:
+
+        char const*                 m_pFormatName = nullptr;
+        uint32                      m_width = 0;
+        uint32                      m_height = 0;
+        uint32                      m_numMips = 0;
+        uint64                      m_numTexels = 0;
+        Milliseconds                m_mipGenerationTime = 0;
+        Milliseconds                m_encodingTime = 0;
+        float                       m_psnr = 0.0f; // Peak signal to noise ratio (in dB) of the top mip over the encoded channels
+    };
+
+    // Can the CPU texture compressor read the supplied source texture
+    bool CanCompressTexture( FileSystem::Path const& texturePath );
+
+    // Create a block compressed DDS texture from the supplied texture
+    bool CompressTexture( FileSystem::Path const& texturePath, TextureType type, TextureCompressionQuality quality, TaskSystem* pTaskSystem, TVector<Byte>& rawData, TextureCompressionStats& stats );
 }
\ No newline at end of file